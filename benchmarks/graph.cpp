@@ -0,0 +1,61 @@
+#include <filesystem>
+#include <format>
+
+#include "benchmarks/harness.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+
+// A layered include graph: every file includes 4 files of the layer below, and the bottom layer is a single
+// header, so every node is reachable from it.
+static auto create_layered_graph(const int num_of_nodes) -> build_caching::DependencyGraph
+{
+    const auto NUM_OF_LAYERS = 8;
+    const auto FAN_OUT       = 4;
+    const auto layer_size    = num_of_nodes / NUM_OF_LAYERS;
+
+    const auto get_node = [](const int layer, const int index)
+    { return std::filesystem::path(std::format("layer_{}/file_{}.hpp", layer, index)); };
+
+    build_caching::DependencyGraph graph;
+
+    for (auto layer = 1; layer < NUM_OF_LAYERS; ++layer)
+    {
+        const auto lower_layer_size = (layer == 1) ? 1 : layer_size;
+
+        for (auto index = 0; index < layer_size; ++index)
+        {
+            for (auto i = 0; i < FAN_OUT; ++i)
+            {
+                // Edges go from the included file to the file that includes it.
+                graph.add_edge(get_node(layer - 1, (index * FAN_OUT + i) % lower_layer_size), get_node(layer, index));
+            }
+        }
+    }
+
+    return graph;
+}
+
+static auto run_graph_benchmarks(benchmarks::Runner& runner) -> void
+{
+    for (const auto num_of_nodes : {1'000, 10'000, 100'000})
+    {
+        const auto reachable_nodes_name = std::format("get_reachable_nodes/{}_nodes", num_of_nodes);
+        const auto check_for_cycle_name = std::format("check_for_cycle/{}_nodes", num_of_nodes);
+
+        if (!runner.is_selected(reachable_nodes_name) && !runner.is_selected(check_for_cycle_name))
+        {
+            continue;
+        }
+
+        const auto graph = create_layered_graph(num_of_nodes);
+
+        runner.run(reachable_nodes_name,
+                   0,
+                   [&] { benchmarks::keep(graph.get_reachable_nodes({"layer_0/file_0.hpp"})); });
+
+        runner.run(check_for_cycle_name,
+                   0,
+                   [&] { benchmarks::keep(graph.check_for_cycle()); });
+    }
+}
+
+static const auto registered = benchmarks::register_suite("graph", &run_graph_benchmarks);
@@ -0,0 +1,105 @@
+#include "benchmarks/harness.hpp"
+
+#include <chrono>
+#include <utility> // std::move
+
+#include "source/utils/allocation_counting.hpp"
+
+benchmarks::Runner::Runner(std::string filter) : filter(std::move(filter))
+{
+}
+
+auto benchmarks::Runner::run(const std::string_view name,
+                             const std::int64_t bytes_per_operation,
+                             const std::function<void()>& operation) -> void
+{
+    if (!is_selected(name))
+    {
+        return;
+    }
+
+    const auto MIN_MEASURED_DURATION = std::chrono::milliseconds(200);
+
+    operation(); // Warm up the caches.
+
+    // Double the number of iterations until the measurement is long enough to be stable.
+    auto iterations = 1LL;
+
+    while (true)
+    {
+        const auto allocations_before = allocation_counting::get_num_of_allocations();
+        const auto start_time         = std::chrono::steady_clock::now();
+
+        for (auto i = 0LL; i < iterations; ++i)
+        {
+            operation();
+        }
+
+        const auto duration          = std::chrono::steady_clock::now() - start_time;
+        const auto allocations_after = allocation_counting::get_num_of_allocations();
+
+        if (duration < MIN_MEASURED_DURATION)
+        {
+            iterations *= 2;
+            continue;
+        }
+
+        const auto nanoseconds = static_cast<double>(std::chrono::nanoseconds(duration).count());
+        const auto seconds     = nanoseconds / 1e9;
+
+        results.push_back({
+            .name                      = std::string(name),
+            .iterations                = iterations,
+            .nanoseconds_per_operation = nanoseconds / iterations,
+            .bytes_per_second          = static_cast<double>(bytes_per_operation) * iterations / seconds,
+            .allocations_per_operation =
+                allocations_before.has_value()
+                    ? std::optional(static_cast<double>(*allocations_after - *allocations_before) / iterations)
+                    : std::nullopt,
+        });
+
+        return;
+    }
+}
+
+auto benchmarks::Runner::is_selected(const std::string_view name) const -> bool
+{
+    return name.contains(filter);
+}
+
+auto benchmarks::Runner::get_results() const -> const std::vector<Result>&
+{
+    return results;
+}
+
+auto benchmarks::get_suites() -> std::vector<std::pair<std::string, Suite>>&
+{
+    static std::vector<std::pair<std::string, Suite>> suites;
+
+    return suites;
+}
+
+auto benchmarks::register_suite(std::string name, Suite suite) -> bool
+{
+    get_suites().emplace_back(std::move(name), std::move(suite));
+
+    return true;
+}
+
+benchmarks::TemporaryDirectory::TemporaryDirectory(const std::string_view name)
+    : path(std::filesystem::temp_directory_path() / "easy-make-benchmarks" / name)
+{
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+}
+
+benchmarks::TemporaryDirectory::~TemporaryDirectory()
+{
+    std::error_code error;
+    std::filesystem::remove_all(path, error);
+}
+
+auto benchmarks::TemporaryDirectory::get_path() const -> const std::filesystem::path&
+{
+    return path;
+}
@@ -0,0 +1,77 @@
+#ifndef BENCHMARKS_HARNESS_HPP
+#define BENCHMARKS_HARNESS_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <vector>
+
+namespace benchmarks
+{
+    struct Result
+    {
+        std::string name;
+        std::int64_t iterations;
+        double nanoseconds_per_operation;
+        double bytes_per_second; // 0 if the benchmark does not process a known number of bytes.
+        std::optional<double> allocations_per_operation; // Only counted with `EASY_MAKE_COUNT_ALLOCATIONS`.
+    };
+
+    class Runner
+    {
+      public:
+        explicit Runner(std::string filter);
+
+        // Calls `operation` until enough time has passed for a stable measurement.
+        // Skipped unless `name` contains the filter.
+        auto run(std::string_view name, std::int64_t bytes_per_operation, const std::function<void()>& operation)
+            -> void;
+
+        // Suites check this before generating the inputs of a benchmark, so that filtering skips them too.
+        auto is_selected(std::string_view name) const -> bool;
+
+        auto get_results() const -> const std::vector<Result>&;
+
+      private:
+        std::string filter;
+        std::vector<Result> results;
+    };
+
+    // A suite creates the inputs of the benchmarks that the runner selects, and then runs them with it.
+    using Suite = std::function<void(Runner&)>;
+
+    // Suites register themselves from their own translation unit, so adding one needs no other change.
+    // Returns `true` so the result can initialize a static variable.
+    auto register_suite(std::string name, Suite suite) -> bool;
+
+    auto get_suites() -> std::vector<std::pair<std::string, Suite>>&;
+
+    // Prevents the compiler from optimizing away a result that is otherwise unused.
+    template <typename T>
+    auto keep(const T& value) -> void
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    // A directory for generated inputs that is removed with all of its contents.
+    class TemporaryDirectory
+    {
+      public:
+        explicit TemporaryDirectory(std::string_view name);
+        ~TemporaryDirectory();
+
+        TemporaryDirectory(const TemporaryDirectory&)                    = delete;
+        auto operator=(const TemporaryDirectory&) -> TemporaryDirectory& = delete;
+
+        auto get_path() const -> const std::filesystem::path&;
+
+      private:
+        std::filesystem::path path;
+    };
+}
+
+#endif // BENCHMARKS_HARNESS_HPP
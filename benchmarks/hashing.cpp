@@ -0,0 +1,41 @@
+#include <format>
+#include <fstream>
+#include <string>
+
+#include "benchmarks/harness.hpp"
+#include "source/commands/build/build_caching/build_caching.hpp"
+
+static auto run_hashing_benchmarks(benchmarks::Runner& runner) -> void
+{
+    for (const auto size : {16, 1'024, 64 * 1'024})
+    {
+        const auto text = std::string(size, 'x');
+
+        runner.run(std::format("hash_string/{}B", size),
+                   size,
+                   [&] { benchmarks::keep(build_caching::hash_string(text)); });
+    }
+
+    const benchmarks::TemporaryDirectory directory("hashing");
+
+    for (const auto size : {1'024, 64 * 1'024, 1'024 * 1'024})
+    {
+        const auto name = std::format("hash_file_contents/{}B", size);
+
+        if (!runner.is_selected(name))
+        {
+            continue;
+        }
+
+        const auto path = directory.get_path() / std::format("file_{}.cpp", size);
+        std::ofstream(path) << std::string(size, 'x');
+
+        std::string buffer;
+
+        runner.run(name,
+                   size,
+                   [&] { benchmarks::keep(build_caching::hash_file_contents(path, buffer)); });
+    }
+}
+
+static const auto registered = benchmarks::register_suite("hashing", &run_hashing_benchmarks);
@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "benchmarks/harness.hpp"
+
+// Usage: benchmark [--filter <substring>] [--json <file>]
+auto main(const int num_of_arguments, const char* arguments[]) -> int
+{
+    std::string filter;
+    std::string json_file;
+
+    const auto actual_arguments = std::span(arguments + 1, num_of_arguments - 1);
+
+    for (auto index = 0UZ; index < actual_arguments.size(); ++index)
+    {
+        const auto argument       = std::string_view(actual_arguments[index]);
+        const auto has_next_value = index + 1 < actual_arguments.size();
+
+        if (argument == "--filter" && has_next_value)
+        {
+            filter = actual_arguments[++index];
+        }
+        else if (argument == "--json" && has_next_value)
+        {
+            json_file = actual_arguments[++index];
+        }
+        else
+        {
+            std::println(stderr, "Usage: {} [--filter <substring>] [--json <file>]", arguments[0]);
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    benchmarks::Runner runner(filter);
+
+    for (const auto& [name, suite] : benchmarks::get_suites())
+    {
+        suite(runner);
+    }
+
+    std::println("{:<48} {:>14} {:>14} {:>12} {:>12}", "Benchmark", "ns/op", "MB/s", "allocs/op", "iterations");
+
+    for (const auto& result : runner.get_results())
+    {
+        // Allocations are only counted if the benchmarks were compiled with `EASY_MAKE_COUNT_ALLOCATIONS` defined.
+        const auto allocations = result.allocations_per_operation.has_value()
+                                     ? std::format("{:.1f}", *result.allocations_per_operation)
+                                     : std::string("-");
+
+        std::println("{:<48} {:>14.1f} {:>14.1f} {:>12} {:>12}",
+                     result.name,
+                     result.nanoseconds_per_operation,
+                     result.bytes_per_second / 1e6,
+                     allocations,
+                     result.iterations);
+    }
+
+    if (json_file.empty())
+    {
+        return EXIT_SUCCESS;
+    }
+
+    auto json = nlohmann::json::array();
+
+    for (const auto& result : runner.get_results())
+    {
+        auto result_json = nlohmann::json{
+            {"name",                      result.name                     },
+            {"iterations",                result.iterations               },
+            {"nanoseconds_per_operation", result.nanoseconds_per_operation},
+            {"bytes_per_second",          result.bytes_per_second         },
+        };
+
+        if (result.allocations_per_operation.has_value())
+        {
+            result_json["allocations_per_operation"] = *result.allocations_per_operation;
+        }
+
+        json.push_back(result_json);
+    }
+
+    auto file = std::ofstream(json_file);
+
+    if (!file.is_open())
+    {
+        std::println(stderr, "Error: Failed to open '{}'.", json_file);
+
+        return EXIT_FAILURE;
+    }
+
+    file << json.dump(4) << '\n';
+
+    return EXIT_SUCCESS;
+}
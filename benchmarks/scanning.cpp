@@ -0,0 +1,122 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "benchmarks/harness.hpp"
+#include "source/commands/build/build.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+// Real files mix includes with code, so only every fourth line is an include.
+static auto write_file_with_includes(const std::filesystem::path& path, const int num_of_includes) -> void
+{
+    auto file = std::ofstream(path);
+
+    for (auto index = 0; index < num_of_includes; ++index)
+    {
+        std::println(file, "#include \"header_{}.hpp\"", index);
+        std::println(file, "int value_{} = {};", index, index);
+        std::println(file, "// A comment that the scanner has to read through.");
+        std::println(file, "");
+    }
+}
+
+static auto run_include_scanning_benchmarks(benchmarks::Runner& runner) -> void
+{
+    const benchmarks::TemporaryDirectory directory("include_scanning");
+
+    for (const auto num_of_includes : {10, 100, 1'000})
+    {
+        const auto name = std::format("get_included_files/{}_includes", num_of_includes);
+
+        if (!runner.is_selected(name))
+        {
+            continue;
+        }
+
+        const auto path = directory.get_path() / std::format("file_{}.cpp", num_of_includes);
+        write_file_with_includes(path, num_of_includes);
+
+        runner.run(name,
+                   static_cast<std::int64_t>(std::filesystem::file_size(path)),
+                   [&] { benchmarks::keep(build_caching::get_included_files(path)); });
+    }
+}
+
+// The included file is found in the last include directory, so every directory is searched.
+static auto run_include_resolution_benchmarks(benchmarks::Runner& runner) -> void
+{
+    const benchmarks::TemporaryDirectory directory("include_resolution");
+    const auto& path_to_root = directory.get_path();
+
+    for (const auto num_of_include_directories : {1, 8, 32})
+    {
+        const auto name = std::format("resolve_include/{}_directories", num_of_include_directories);
+
+        if (!runner.is_selected(name))
+        {
+            continue;
+        }
+
+        std::vector<std::string> include_directories;
+
+        for (auto index = 0; index < num_of_include_directories; ++index)
+        {
+            include_directories.push_back(std::format("include_{}_{}", num_of_include_directories, index));
+            std::filesystem::create_directories(path_to_root / include_directories.back());
+        }
+
+        std::ofstream(path_to_root / include_directories.back() / "header.hpp") << "#pragma once\n";
+
+        runner.run(name,
+                   0,
+                   [&]
+                   {
+                       benchmarks::keep(build_caching::resolve_include(
+                           "header.hpp", "source/main.cpp", path_to_root, include_directories));
+                   });
+    }
+}
+
+static auto run_code_file_discovery_benchmarks(benchmarks::Runner& runner) -> void
+{
+    const benchmarks::TemporaryDirectory directory("code_file_discovery");
+
+    for (const auto num_of_files : {100, 1'000, 10'000})
+    {
+        const auto name = std::format("get_code_files/{}_files", num_of_files);
+
+        if (!runner.is_selected(name))
+        {
+            continue;
+        }
+
+        const auto path_to_root = directory.get_path() / std::format("project_{}", num_of_files);
+
+        // 100 files per directory, like in a real source tree.
+        for (auto index = 0; index < num_of_files; ++index)
+        {
+            const auto path = path_to_root / std::format("group_{:03}/file_{:05}.cpp", index / 100, index);
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path) << "int main() {}\n";
+        }
+
+        Configuration configuration;
+        configuration.name               = "benchmark";
+        configuration.source_directories = {"."};
+
+        runner.run(name,
+                   0,
+                   [&] { benchmarks::keep(get_code_files(configuration, path_to_root)); });
+    }
+}
+
+static const auto registered_include_scanning =
+    benchmarks::register_suite("include_scanning", &run_include_scanning_benchmarks);
+static const auto registered_include_resolution =
+    benchmarks::register_suite("include_resolution", &run_include_resolution_benchmarks);
+static const auto registered_code_file_discovery =
+    benchmarks::register_suite("code_file_discovery", &run_code_file_discovery_benchmarks);
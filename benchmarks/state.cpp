@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string_view>
+#include <unordered_map>
+
+#include "benchmarks/harness.hpp"
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/parameters/parameters.hpp"
+
+// The data files that every build reads at its start and writes at its end.
+static auto run_state_benchmarks(benchmarks::Runner& runner) -> void
+{
+    const benchmarks::TemporaryDirectory directory("state");
+    const auto& path_to_root = directory.get_path();
+
+    for (const auto num_of_files : {100, 1'000, 10'000})
+    {
+        const auto write_build_data_name = std::format("write_to_build_data_file/{}_files", num_of_files);
+        const auto read_build_data_name  = std::format("get_old_file_hashes/{}_files", num_of_files);
+        const auto write_graph_name      = std::format("write_to_dependency_graph_data_file/{}_files", num_of_files);
+        const auto read_graph_name       = std::format("get_old_dependency_graph/{}_files", num_of_files);
+        const auto names                 = std::array<std::string_view, 4>{
+            write_build_data_name, read_build_data_name, write_graph_name, read_graph_name};
+
+        if (std::ranges::none_of(names, [&](const auto name) { return runner.is_selected(name); }))
+        {
+            continue;
+        }
+
+        const auto configuration_name = std::format("configuration_{}", num_of_files);
+        std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name);
+
+        std::unordered_map<std::filesystem::path, std::uint64_t> file_hashes;
+        build_caching::DependencyGraph dependency_graph;
+
+        for (auto index = 0; index < num_of_files; ++index)
+        {
+            const auto source_file = std::format("source/group_{:03}/file_{:05}.cpp", index / 100, index);
+            const auto header_file = std::format("source/group_{:03}/file_{:05}.hpp", index / 100, index);
+
+            file_hashes[source_file] = build_caching::hash_string(source_file);
+            dependency_graph.add_edge(header_file, source_file);
+        }
+
+        const auto build_data_file =
+            path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::BUILD_DATA_FILE_NAME;
+
+        // Written up front, since the write benchmark may be filtered out.
+        build_caching::write_to_build_data_file(configuration_name, path_to_root, file_hashes);
+
+        runner.run(write_build_data_name,
+                   0,
+                   [&] { build_caching::write_to_build_data_file(configuration_name, path_to_root, file_hashes); });
+
+        runner.run(read_build_data_name,
+                   static_cast<std::int64_t>(std::filesystem::file_size(build_data_file)),
+                   [&] { benchmarks::keep(build_caching::get_old_file_hashes(configuration_name, path_to_root)); });
+
+        runner.run(write_graph_name,
+                   0,
+                   [&]
+                   {
+                       build_caching::write_to_dependency_graph_data_file(
+                           configuration_name, path_to_root, dependency_graph);
+                   });
+
+        runner.run(read_graph_name,
+                   0,
+                   [&]
+                   {
+                       benchmarks::keep(build_caching::get_old_dependency_graph(configuration_name, path_to_root));
+                   });
+    }
+}
+
+static const auto registered = benchmarks::register_suite("state", &run_state_benchmarks);
@@ -0,0 +1,100 @@
+#include <algorithm> // std::max
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "benchmarks/harness.hpp"
+#include "source/commands/build/compilation/thread_pool.hpp"
+#include "source/utils/work_stealing_pool.hpp"
+
+// Many tiny tasks, similar in size to hashing a small file or scanning a short include list.
+static auto do_tiny_amount_of_work(const std::uint64_t seed) -> std::uint64_t
+{
+    // FNV-1a over a few bytes.
+    auto result = 1'469'598'103'934'665'603ULL;
+
+    for (auto i = 0ULL; i < 16; ++i)
+    {
+        result ^= seed + i;
+        result *= 1'099'511'628'211ULL;
+    }
+
+    return result;
+}
+
+static auto run_work_stealing_pool_benchmarks(benchmarks::Runner& runner) -> void
+{
+    const auto num_of_threads           = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    std::atomic<std::uint64_t> checksum = 0;
+
+    for (const auto num_of_tasks : {1'000, 100'000})
+    {
+        const auto thread_pool_name  = std::format("thread_pool_add_task/{}_tasks", num_of_tasks);
+        const auto submit_name       = std::format("work_stealing_pool_submit_detached/{}_tasks", num_of_tasks);
+        const auto parallel_for_name = std::format("parallel_for/{}_indices", num_of_tasks);
+
+        if (!runner.is_selected(thread_pool_name) && !runner.is_selected(submit_name) &&
+            !runner.is_selected(parallel_for_name))
+        {
+            continue;
+        }
+
+        ThreadPool thread_pool(num_of_threads);
+        utils::WorkStealingPool pool(num_of_threads);
+
+        runner.run(thread_pool_name,
+                   0,
+                   [&]
+                   {
+                       std::vector<std::future<void>> futures;
+                       futures.reserve(num_of_tasks);
+
+                       for (auto index = 0; index < num_of_tasks; ++index)
+                       {
+                           futures.push_back(thread_pool.add_task(
+                               [&checksum, index]
+                               { checksum.fetch_add(do_tiny_amount_of_work(index), std::memory_order_relaxed); }));
+                       }
+
+                       for (auto& future : futures)
+                       {
+                           future.get();
+                       }
+                   });
+
+        runner.run(submit_name,
+                   0,
+                   [&]
+                   {
+                       for (auto index = 0; index < num_of_tasks; ++index)
+                       {
+                           pool.submit_detached(
+                               [&checksum, index]() noexcept
+                               { checksum.fetch_add(do_tiny_amount_of_work(index), std::memory_order_relaxed); });
+                       }
+
+                       pool.wait_for_all();
+                   });
+
+        runner.run(parallel_for_name,
+                   0,
+                   [&]
+                   {
+                       utils::parallel_for(pool,
+                                           0,
+                                           num_of_tasks,
+                                           [&](const std::size_t index)
+                                           {
+                                               const auto value = do_tiny_amount_of_work(index);
+                                               checksum.fetch_add(value, std::memory_order_relaxed);
+                                           });
+                   });
+    }
+
+    benchmarks::keep(checksum.load());
+}
+
+static const auto registered = benchmarks::register_suite("work_stealing_pool", &run_work_stealing_pool_benchmarks);
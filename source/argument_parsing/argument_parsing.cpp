@@ -5,34 +5,46 @@
 #include <string>
 #include <string_view>
 
+#include "source/argument_parsing/commands/analyze_includes.hpp"
 #include "source/argument_parsing/commands/build.hpp"
 #include "source/argument_parsing/commands/clean.hpp"
 #include "source/argument_parsing/commands/clean_all.hpp"
 #include "source/argument_parsing/commands/init.hpp"
 #include "source/argument_parsing/commands/list_configurations.hpp"
 #include "source/argument_parsing/commands/list_files.hpp"
+#include "source/argument_parsing/commands/pgo.hpp"
 #include "source/argument_parsing/commands/print_version.hpp"
+#include "source/argument_parsing/commands/report.hpp"
+#include "source/argument_parsing/commands/worker.hpp"
 #include "source/argument_parsing/error_formatting.hpp"
 #include "source/utils/macros/assert.hpp"
 
 using namespace std::literals;
 
+static const auto ANALYZE_INCLUDES_COMMAND    = "analyze-includes"sv;
 static const auto BUILD_COMMAND               = "build"sv;
 static const auto CLEAN_COMMAND               = "clean"sv;
 static const auto CLEAN_ALL_COMMAND           = "clean-all"sv;
 static const auto INIT_COMMAND                = "init"sv;
 static const auto LIST_CONFIGURATIONS_COMMAND = "list-configs"sv;
 static const auto LIST_FILES_COMMAND          = "list-files"sv;
+static const auto PGO_COMMAND                 = "pgo"sv;
 static const auto PRINT_VERSION_COMMAND       = "version"sv;
+static const auto REPORT_COMMAND              = "report"sv;
+static const auto WORKER_COMMAND              = "worker"sv;
 
 static const std::flat_set COMMANDS = {
+    ANALYZE_INCLUDES_COMMAND,
     BUILD_COMMAND,
     CLEAN_COMMAND,
     CLEAN_ALL_COMMAND,
     INIT_COMMAND,
     LIST_CONFIGURATIONS_COMMAND,
     LIST_FILES_COMMAND,
+    PGO_COMMAND,
     PRINT_VERSION_COMMAND,
+    REPORT_COMMAND,
+    WORKER_COMMAND,
 };
 
 auto parse_arguments(const std::span<const char* const> arguments) -> std::expected<CommandInfo, std::string>
@@ -54,7 +66,11 @@ auto parse_arguments(const std::span<const char* const> arguments) -> std::expec
 
     const auto command = std::string_view(arguments[1]);
 
-    if (command == BUILD_COMMAND)
+    if (command == ANALYZE_INCLUDES_COMMAND)
+    {
+        return parse_analyze_includes_command_arguments(arguments);
+    }
+    else if (command == BUILD_COMMAND)
     {
         return parse_build_command_arguments(arguments);
     }
@@ -78,10 +94,22 @@ auto parse_arguments(const std::span<const char* const> arguments) -> std::expec
     {
         return parse_list_files_command_arguments(arguments);
     }
+    else if (command == PGO_COMMAND)
+    {
+        return parse_pgo_command_arguments(arguments);
+    }
     else if (command == PRINT_VERSION_COMMAND)
     {
         return parse_print_version_command_arguments(arguments);
     }
+    else if (command == REPORT_COMMAND)
+    {
+        return parse_report_command_arguments(arguments);
+    }
+    else if (command == WORKER_COMMAND)
+    {
+        return parse_worker_command_arguments(arguments);
+    }
 
     // All valid commands should have been handled above.
     // If we reach this point, the command is unknown.
@@ -5,12 +5,33 @@
 #include <string>
 #include <variant>
 
+struct AnalyzeIncludesCommandInfo
+{
+    std::string configuration_name;
+    bool show_all_headers;
+    bool porcelain_output;
+};
+
+enum class OutputFormat
+{
+    TEXT,
+    JSONL, // One JSON event per line, for tools.
+};
+
 struct BuildCommandInfo
 {
     std::optional<std::string> configuration_name;
     bool build_all_configurations;
     bool is_quiet;
     bool use_parallel_compilation;
+    std::optional<std::string> trace_file; // Written after the build if set.
+    bool analyze_compile_time;
+    bool print_statistics;
+    std::optional<std::string> statistics_file; // Written after the build if set.
+    bool explain;                               // Print why every outdated file is compiled.
+    bool is_dry_run;                            // Decide what to compile without compiling or linking.
+    std::optional<std::string> workers;         // `easy-make worker` daemons to compile on, if set.
+    OutputFormat output_format;
 };
 
 struct CleanCommandInfo
@@ -48,16 +69,41 @@ struct ListFilesCommandInfo
     bool source_only;
 };
 
+struct PgoCommandInfo
+{
+    std::string configuration_name;
+    std::string training_command;
+    bool is_quiet;
+    bool use_parallel_compilation;
+};
+
 struct PrintVersionCommandInfo
 {
 };
 
-using CommandInfo = std::variant<BuildCommandInfo,
+struct ReportCommandInfo
+{
+    std::optional<std::string> configuration_name; // Every configuration if not set.
+    bool show_all_entries;
+};
+
+struct WorkerCommandInfo
+{
+    std::string address; // `host:port` or `unix:<path>` to listen on.
+    bool use_parallel_compilation;
+    bool is_quiet;
+};
+
+using CommandInfo = std::variant<AnalyzeIncludesCommandInfo,
+                                 BuildCommandInfo,
                                  CleanCommandInfo,
                                  CleanAllCommandInfo,
                                  InitCommandInfo,
                                  ListConfigurationsCommandInfo,
                                  ListFilesCommandInfo,
-                                 PrintVersionCommandInfo>;
+                                 PgoCommandInfo,
+                                 PrintVersionCommandInfo,
+                                 ReportCommandInfo,
+                                 WorkerCommandInfo>;
 
 #endif // SOURCE_ARGUMENT_PARSING_COMMAND_INFO_HPP
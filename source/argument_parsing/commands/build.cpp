@@ -1,8 +1,10 @@
 #include "source/argument_parsing/commands/build.hpp"
 
 #include <algorithm>
+#include <expected>
 #include <flat_set>
 #include <format>
+#include <optional>
 #include <string_view>
 
 #include "source/argument_parsing/error_formatting.hpp"
@@ -11,14 +13,33 @@
 
 using namespace std::literals;
 
+static const auto ANALYZE_COMPILE_TIME_FLAG     = "--analyze-compile-time"sv;
 static const auto BUILD_ALL_CONFIGURATIONS_FLAG = "--all"sv;
+static const auto DRY_RUN_FLAG                  = "--dry-run"sv;
+static const auto EXPLAIN_FLAG                  = "--explain"sv;
+static const auto OUTPUT_FORMAT_FLAG            = "--output-format"sv; // Followed by `=text` or `=jsonl`.
 static const auto PARALLEL_COMPILATION_FLAG     = "--parallel"sv;
 static const auto QUIET_FLAG                    = "--quiet"sv;
+static const auto STATISTICS_FLAG               = "--stats"sv;
+static const auto STATISTICS_FILE_FLAG          = "--stats-json"sv;    // Followed by the path of the statistics file.
+static const auto TRACE_FLAG                    = "--trace"sv;         // Followed by the path of the trace file.
+static const auto WORKERS_FLAG                  = "--workers"sv;       // Followed by a list of worker addresses.
+
+// Named in the errors about the flags that cannot be used together with it.
+static const auto JSONL_OUTPUT_FORMAT_FLAG = "--output-format=jsonl"sv;
 
 static const std::flat_set FLAGS = {
+    ANALYZE_COMPILE_TIME_FLAG,
     BUILD_ALL_CONFIGURATIONS_FLAG,
+    DRY_RUN_FLAG,
+    EXPLAIN_FLAG,
+    OUTPUT_FORMAT_FLAG,
     PARALLEL_COMPILATION_FLAG,
     QUIET_FLAG,
+    STATISTICS_FLAG,
+    STATISTICS_FILE_FLAG,
+    TRACE_FLAG,
+    WORKERS_FLAG,
 };
 
 // Validates `flag` and updates `info` if recognized.
@@ -27,6 +48,13 @@ static auto parse_flag(const std::string_view flag,
                        const std::string_view command_name,
                        BuildCommandInfo& info) -> std::optional<std::string>
 {
+    if (flag == ANALYZE_COMPILE_TIME_FLAG)
+    {
+        info.analyze_compile_time = true;
+
+        return std::nullopt;
+    }
+
     if (flag == BUILD_ALL_CONFIGURATIONS_FLAG)
     {
         info.build_all_configurations = true;
@@ -34,6 +62,29 @@ static auto parse_flag(const std::string_view flag,
         return std::nullopt;
     }
 
+    if (flag == DRY_RUN_FLAG)
+    {
+        // A dry run is only useful if it shows what would be compiled.
+        info.is_dry_run = true;
+        info.explain    = true;
+
+        return std::nullopt;
+    }
+
+    if (flag == EXPLAIN_FLAG)
+    {
+        info.explain = true;
+
+        return std::nullopt;
+    }
+
+    if (flag == OUTPUT_FORMAT_FLAG)
+    {
+        return std::format("Error: Flag '{}' of command '{}' must be followed by '=text' or '=jsonl'.",
+                           OUTPUT_FORMAT_FLAG,
+                           command_name);
+    }
+
     if (flag == PARALLEL_COMPILATION_FLAG)
     {
         info.use_parallel_compilation = true;
@@ -48,12 +99,50 @@ static auto parse_flag(const std::string_view flag,
         return std::nullopt;
     }
 
+    if (flag == STATISTICS_FLAG)
+    {
+        info.print_statistics = true;
+
+        return std::nullopt;
+    }
+
     // Make sure we did not forget to handle a valid flag.
     ASSERT(!FLAGS.contains(flag));
 
     return create_unknown_flag_error(command_name, flag, FLAGS);
 }
 
+// Returns the value of `argument` if it is `flag=<value>`.
+static auto get_flag_value(const std::string_view argument, const std::string_view flag)
+    -> std::optional<std::string_view>
+{
+    if (!argument.starts_with(flag) || !argument.substr(flag.size()).starts_with('='))
+    {
+        return std::nullopt;
+    }
+
+    return argument.substr(flag.size() + 1);
+}
+
+static auto parse_output_format(const std::string_view output_format,
+                                const std::string_view command_name) -> std::expected<OutputFormat, std::string>
+{
+    if (output_format == "text")
+    {
+        return OutputFormat::TEXT;
+    }
+
+    if (output_format == "jsonl")
+    {
+        return OutputFormat::JSONL;
+    }
+
+    return std::unexpected(std::format("Error: Unknown output format '{}' for command '{}'. "
+                                       "Expected 'text' or 'jsonl'.",
+                                       output_format,
+                                       command_name));
+}
+
 static auto check_for_conflicting_flags(const BuildCommandInfo& info,
                                         const std::string_view command_name) -> std::optional<std::string>
 {
@@ -70,6 +159,28 @@ static auto check_for_conflicting_flags(const BuildCommandInfo& info,
         return create_missing_configuration_name_error(command_name);
     }
 
+    // Measuring the compilation requires compiling.
+    if (info.is_dry_run && info.analyze_compile_time)
+    {
+        return create_conflicting_flags_error(command_name, ANALYZE_COMPILE_TIME_FLAG, DRY_RUN_FLAG);
+    }
+
+    // Their reports are not events, so they would break the stream.
+    if (info.output_format == OutputFormat::JSONL)
+    {
+        if (info.analyze_compile_time)
+        {
+            return create_conflicting_flags_error(command_name, ANALYZE_COMPILE_TIME_FLAG, JSONL_OUTPUT_FORMAT_FLAG);
+        }
+
+        if (info.explain)
+        {
+            const auto explain_flag = info.is_dry_run ? DRY_RUN_FLAG : EXPLAIN_FLAG;
+
+            return create_conflicting_flags_error(command_name, explain_flag, JSONL_OUTPUT_FORMAT_FLAG);
+        }
+    }
+
     return std::nullopt;
 }
 
@@ -83,9 +194,66 @@ auto parse_build_command_arguments(std::span<const char* const> arguments)
 
     ASSERT(std::ranges::all_of(FLAGS, &utils::is_flag)); // Make sure all the flags are valid.
     BuildCommandInfo info{};
+    std::optional<std::string_view> flag_expecting_value; // Set after a flag that is followed by a value.
+    auto output_format_provided = false;
 
     for (const std::string_view argument : actual_arguments)
     {
+        if (flag_expecting_value == TRACE_FLAG)
+        {
+            info.trace_file = argument;
+            flag_expecting_value.reset();
+
+            continue;
+        }
+
+        if (flag_expecting_value == STATISTICS_FILE_FLAG)
+        {
+            // Writing the statistics implies printing them.
+            info.statistics_file  = argument;
+            info.print_statistics = true;
+            flag_expecting_value.reset();
+
+            continue;
+        }
+
+        if (flag_expecting_value == WORKERS_FLAG)
+        {
+            info.workers = argument;
+            flag_expecting_value.reset();
+
+            continue;
+        }
+
+        if (argument == TRACE_FLAG || argument == STATISTICS_FILE_FLAG || argument == WORKERS_FLAG)
+        {
+            flag_expecting_value = argument;
+
+            continue;
+        }
+
+        if (const auto output_format = get_flag_value(argument, OUTPUT_FORMAT_FLAG); output_format.has_value())
+        {
+            if (output_format_provided)
+            {
+                return std::unexpected(create_duplicate_flag_error(command_name, OUTPUT_FORMAT_FLAG));
+            }
+
+            const auto parsed_output_format = parse_output_format(*output_format, command_name);
+
+            if (!parsed_output_format.has_value())
+            {
+                return std::unexpected(parsed_output_format.error());
+            }
+
+            // The human-readable progress is replaced by the events.
+            info.output_format     = *parsed_output_format;
+            info.is_quiet          = info.is_quiet || info.output_format == OutputFormat::JSONL;
+            output_format_provided = true;
+
+            continue;
+        }
+
         if (utils::is_flag(argument))
         {
             const auto flag_parse_error = parse_flag(argument, command_name, info);
@@ -118,6 +286,16 @@ auto parse_build_command_arguments(std::span<const char* const> arguments)
         }
     }
 
+    if (flag_expecting_value.has_value())
+    {
+        const auto expected_value = flag_expecting_value == WORKERS_FLAG ? "a list of workers" : "a file name";
+
+        return std::unexpected(std::format("Error: Flag '{}' of command '{}' must be followed by {}.",
+                                           *flag_expecting_value,
+                                           command_name,
+                                           expected_value));
+    }
+
     const auto conflicting_flags_error        = check_for_conflicting_flags(info, command_name);
     const auto conflicting_flags_error_exists = conflicting_flags_error.has_value();
 
@@ -0,0 +1,138 @@
+#include "source/argument_parsing/commands/pgo.hpp"
+
+#include <algorithm>
+#include <flat_set>
+#include <format>
+#include <ranges>
+#include <string_view>
+
+#include "source/argument_parsing/error_formatting.hpp"
+#include "source/argument_parsing/utils.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::literals;
+
+static const auto PARALLEL_COMPILATION_FLAG = "--parallel"sv;
+static const auto QUIET_FLAG                = "--quiet"sv;
+
+// Everything after it is the training command.
+static const auto TRAINING_COMMAND_SEPARATOR = "--"sv;
+
+static const std::flat_set FLAGS = {
+    PARALLEL_COMPILATION_FLAG,
+    QUIET_FLAG,
+};
+
+// Validates `flag` and updates `info` if recognized.
+// Returns `std::nullopt` on success, or an error message otherwise.
+static auto parse_flag(const std::string_view flag,
+                       const std::string_view command_name,
+                       PgoCommandInfo& info) -> std::optional<std::string>
+{
+    if (flag == PARALLEL_COMPILATION_FLAG)
+    {
+        info.use_parallel_compilation = true;
+
+        return std::nullopt;
+    }
+
+    if (flag == QUIET_FLAG)
+    {
+        info.is_quiet = true;
+
+        return std::nullopt;
+    }
+
+    // Make sure we did not forget to handle a valid flag.
+    ASSERT(!FLAGS.contains(flag));
+
+    return create_unknown_flag_error(command_name, flag, FLAGS);
+}
+
+static auto is_separator(const std::string_view argument) -> bool
+{
+    return argument == TRAINING_COMMAND_SEPARATOR;
+}
+
+static auto to_string_view(const char* const argument) -> std::string_view
+{
+    return argument;
+}
+
+auto parse_pgo_command_arguments(std::span<const char* const> arguments) -> std::expected<PgoCommandInfo, std::string>
+{
+    // The first 2 elements are the program name and the command (which is "pgo").
+    ASSERT(arguments.size() >= 2);
+    const auto command_name     = std::string_view(arguments[1]);
+    const auto separator        = std::ranges::find_if(arguments.begin() + 2, arguments.end(), &is_separator);
+    const auto actual_arguments = std::span(arguments.begin() + 2, separator);
+
+    ASSERT(std::ranges::all_of(FLAGS, &utils::is_flag)); // Make sure all the flags are valid.
+    PgoCommandInfo info{};
+    auto configuration_name_provided = false;
+
+    for (const std::string_view argument : actual_arguments)
+    {
+        if (utils::is_flag(argument))
+        {
+            const auto flag_parse_error = parse_flag(argument, command_name, info);
+            const auto flag_is_valid    = !flag_parse_error.has_value();
+
+            if (flag_is_valid)
+            {
+                continue;
+            }
+            else
+            {
+                return std::unexpected(*flag_parse_error);
+            }
+        }
+
+        // Assume `argument` is a configuration name.
+        // If `configuration_name_provided` was already set before handling the current argument,
+        // it means that multiple configuration names were provided.
+        const auto multiple_configuration_names_provided = configuration_name_provided;
+
+        if (multiple_configuration_names_provided)
+        {
+            const auto& name_1 = info.configuration_name;
+            const auto& name_2 = argument;
+
+            return std::unexpected(create_multiple_configuration_names_error(command_name, name_1, name_2));
+        }
+
+        info.configuration_name     = argument;
+        configuration_name_provided = true;
+    }
+
+    if (!configuration_name_provided)
+    {
+        return std::unexpected(create_missing_configuration_name_error(command_name));
+    }
+
+    const auto duplicate_flag        = utils::check_for_duplicate_flags(actual_arguments);
+    const auto duplicate_flag_exists = duplicate_flag.has_value();
+
+    if (duplicate_flag_exists)
+    {
+        return std::unexpected(create_duplicate_flag_error(command_name, *duplicate_flag));
+    }
+
+    // The training command is passed to the shell as is.
+    const auto training_command_provided = separator != arguments.end() && separator + 1 != arguments.end();
+
+    if (!training_command_provided)
+    {
+        return std::unexpected(std::format("Error: Must specify a training command after '{}' when using '{}' command.",
+                                           TRAINING_COMMAND_SEPARATOR,
+                                           command_name));
+    }
+
+    const auto training_arguments = std::span(separator + 1, arguments.end());
+    info.training_command         = training_arguments                       //
+                                    | std::views::transform(&to_string_view) //
+                                    | std::views::join_with(" "sv)           //
+                                    | std::ranges::to<std::string>();        //
+
+    return info;
+}
@@ -0,0 +1,12 @@
+#ifndef SOURCE_ARGUMENT_PARSING_COMMANDS_PGO_HPP
+#define SOURCE_ARGUMENT_PARSING_COMMANDS_PGO_HPP
+
+#include <expected>
+#include <span>
+#include <string>
+
+#include "source/argument_parsing/command_info.hpp"
+
+auto parse_pgo_command_arguments(std::span<const char* const> arguments) -> std::expected<PgoCommandInfo, std::string>;
+
+#endif // SOURCE_ARGUMENT_PARSING_COMMANDS_PGO_HPP
@@ -0,0 +1,85 @@
+#include "source/argument_parsing/commands/report.hpp"
+
+#include <algorithm>
+#include <flat_set>
+#include <string>
+#include <string_view>
+
+#include "source/argument_parsing/error_formatting.hpp"
+#include "source/argument_parsing/utils.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::literals;
+
+static const auto ALL_ENTRIES_FLAG = "--all"sv;
+
+static const std::flat_set FLAGS = {
+    ALL_ENTRIES_FLAG,
+};
+
+// Validates `flag` and updates `info` if recognized.
+// Returns `std::nullopt` on success, or an error message otherwise.
+static auto parse_flag(const std::string_view flag,
+                       const std::string_view command_name,
+                       ReportCommandInfo& info) -> std::optional<std::string>
+{
+    if (flag == ALL_ENTRIES_FLAG)
+    {
+        info.show_all_entries = true;
+        return std::nullopt;
+    }
+
+    // Make sure we did not forget to handle a valid flag.
+    ASSERT(!FLAGS.contains(flag));
+
+    return create_unknown_flag_error(command_name, flag, FLAGS);
+}
+
+auto parse_report_command_arguments(std::span<const char* const> arguments)
+    -> std::expected<ReportCommandInfo, std::string>
+{
+    // The first 2 elements are the program name and the command (which is "report").
+    ASSERT(arguments.size() >= 2);
+    const auto command_name     = std::string_view(arguments[1]);
+    const auto actual_arguments = std::span(arguments.begin() + 2, arguments.end());
+
+    ASSERT(std::ranges::all_of(FLAGS, &utils::is_flag)); // Make sure all the flags are valid.
+    ReportCommandInfo info{};
+
+    for (const std::string_view argument : actual_arguments)
+    {
+        if (utils::is_flag(argument))
+        {
+            const auto flag_parse_error = parse_flag(argument, command_name, info);
+            const auto flag_is_valid    = !flag_parse_error.has_value();
+
+            if (!flag_is_valid)
+            {
+                return std::unexpected(*flag_parse_error);
+            }
+
+            continue;
+        }
+
+        // `argument` is a configuration name, which is optional.
+        if (info.configuration_name.has_value())
+        {
+            const auto& name_1 = *info.configuration_name;
+            const auto& name_2 = argument;
+
+            return std::unexpected(create_multiple_configuration_names_error(command_name, name_1, name_2));
+        }
+
+        info.configuration_name = argument;
+    }
+
+    const auto duplicate_flag        = utils::check_for_duplicate_flags(actual_arguments);
+    const auto duplicate_flag_exists = duplicate_flag.has_value();
+
+    if (duplicate_flag_exists)
+    {
+        return std::unexpected(create_duplicate_flag_error(command_name, *duplicate_flag));
+    }
+
+    return info;
+}
@@ -0,0 +1,13 @@
+#ifndef SOURCE_ARGUMENT_PARSING_COMMANDS_REPORT_HPP
+#define SOURCE_ARGUMENT_PARSING_COMMANDS_REPORT_HPP
+
+#include <expected>
+#include <span>
+#include <string>
+
+#include "source/argument_parsing/command_info.hpp"
+
+auto parse_report_command_arguments(std::span<const char* const> arguments)
+    -> std::expected<ReportCommandInfo, std::string>;
+
+#endif // SOURCE_ARGUMENT_PARSING_COMMANDS_REPORT_HPP
@@ -0,0 +1,106 @@
+#include "source/argument_parsing/commands/worker.hpp"
+
+#include <algorithm>
+#include <flat_set>
+#include <format>
+#include <optional>
+#include <string_view>
+
+#include "source/argument_parsing/error_formatting.hpp"
+#include "source/argument_parsing/utils.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::literals;
+
+static const auto PARALLEL_COMPILATION_FLAG = "--parallel"sv;
+static const auto QUIET_FLAG                = "--quiet"sv;
+
+static const std::flat_set FLAGS = {
+    PARALLEL_COMPILATION_FLAG,
+    QUIET_FLAG,
+};
+
+// Validates `flag` and updates `info` if recognized.
+// Returns `std::nullopt` on success, or an error message otherwise.
+static auto parse_flag(const std::string_view flag,
+                       const std::string_view command_name,
+                       WorkerCommandInfo& info) -> std::optional<std::string>
+{
+    if (flag == PARALLEL_COMPILATION_FLAG)
+    {
+        info.use_parallel_compilation = true;
+
+        return std::nullopt;
+    }
+
+    if (flag == QUIET_FLAG)
+    {
+        info.is_quiet = true;
+
+        return std::nullopt;
+    }
+
+    // Make sure we did not forget to handle a valid flag.
+    ASSERT(!FLAGS.contains(flag));
+
+    return create_unknown_flag_error(command_name, flag, FLAGS);
+}
+
+auto parse_worker_command_arguments(std::span<const char* const> arguments)
+    -> std::expected<WorkerCommandInfo, std::string>
+{
+    // The first 2 elements are the program name and the command (which is "worker").
+    ASSERT(arguments.size() >= 2);
+    const auto command_name     = std::string_view(arguments[1]);
+    const auto actual_arguments = std::span(arguments.begin() + 2, arguments.end());
+
+    ASSERT(std::ranges::all_of(FLAGS, &utils::is_flag)); // Make sure all the flags are valid.
+    WorkerCommandInfo info{};
+    auto address_provided = false;
+
+    for (const std::string_view argument : actual_arguments)
+    {
+        if (utils::is_flag(argument))
+        {
+            const auto flag_parse_error = parse_flag(argument, command_name, info);
+            const auto flag_is_valid    = !flag_parse_error.has_value();
+
+            if (flag_is_valid)
+            {
+                continue;
+            }
+            else
+            {
+                return std::unexpected(*flag_parse_error);
+            }
+        }
+
+        // Assume `argument` is the address to listen on.
+        if (address_provided)
+        {
+            return std::unexpected(std::format(
+                "Error: Command '{}' requires one address, instead got both '{}' and '{}'.",
+                command_name,
+                info.address,
+                argument));
+        }
+
+        info.address     = argument;
+        address_provided = true;
+    }
+
+    if (!address_provided)
+    {
+        return std::unexpected(std::format("Error: Must specify an address when using '{}' command.", command_name));
+    }
+
+    const auto duplicate_flag        = utils::check_for_duplicate_flags(actual_arguments);
+    const auto duplicate_flag_exists = duplicate_flag.has_value();
+
+    if (duplicate_flag_exists)
+    {
+        return std::unexpected(create_duplicate_flag_error(command_name, *duplicate_flag));
+    }
+
+    return info;
+}
@@ -0,0 +1,13 @@
+#ifndef SOURCE_ARGUMENT_PARSING_COMMANDS_WORKER_HPP
+#define SOURCE_ARGUMENT_PARSING_COMMANDS_WORKER_HPP
+
+#include <expected>
+#include <span>
+#include <string>
+
+#include "source/argument_parsing/command_info.hpp"
+
+auto parse_worker_command_arguments(std::span<const char* const> arguments)
+    -> std::expected<WorkerCommandInfo, std::string>;
+
+#endif // SOURCE_ARGUMENT_PARSING_COMMANDS_WORKER_HPP
@@ -0,0 +1,209 @@
+#include "source/commands/analyze_includes/analyze_includes.hpp"
+
+#include <algorithm>
+#include <cstdlib> // `EXIT_SUCCESS`, `EXIT_FAILURE`
+#include <deque>
+#include <functional>
+#include <print>
+#include <ranges>
+#include <string>
+
+#include "source/commands/build/build.hpp"
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/configuration_resolution.hpp"
+#include "source/utils/print.hpp"
+#include "source/utils/utils.hpp"
+
+/// @brief  Computes the cost of changing each header in the dependency graph.
+/// @param  dependency_graph    There is an edge from `f_1` to `f_2` if `f_2` includes `f_1`.
+/// @param  compilation_times   The compilation time of each source file in the last build.
+/// @return Every header that is included by at least one source file, most expensive first.
+/// @note   Changing a header recompiles every source file that transitively includes it, so its cost is the sum
+///         of their compilation times. Files without history are assumed to be average.
+auto include_analysis::get_header_costs(const build_caching::DependencyGraph& dependency_graph,
+                                        const std::unordered_map<std::filesystem::path, double>& compilation_times)
+    -> std::vector<HeaderCost>
+{
+    const auto times_sum            = std::ranges::fold_left(std::views::values(compilation_times), 0.0, std::plus{});
+    const auto average_time         = compilation_times.empty() ? 1.0 : times_sum / compilation_times.size();
+    const auto get_compilation_time = [&](const std::filesystem::path& file)
+    { return compilation_times.contains(file) ? compilation_times.at(file) : average_time; };
+
+    std::vector<HeaderCost> costs;
+
+    for (const auto& header : std::views::keys(dependency_graph.data()))
+    {
+        if (!utils::is_header_file(header))
+        {
+            continue;
+        }
+
+        const auto dependent_source_files = dependency_graph.get_reachable_nodes({header}) //
+                                            | std::views::filter(&utils::is_source_file)    //
+                                            | std::ranges::to<std::vector>();               //
+
+        if (dependent_source_files.empty())
+        {
+            continue;
+        }
+
+        const auto rebuild_time = std::ranges::fold_left(
+            dependent_source_files | std::views::transform(get_compilation_time), 0.0, std::plus{});
+
+        costs.push_back({.header                   = header,
+                         .num_of_translation_units = static_cast<int>(dependent_source_files.size()),
+                         .rebuild_time_in_seconds  = rebuild_time});
+    }
+
+    // Break ties by path so the output is deterministic.
+    const auto by_cost_then_path = [](const HeaderCost& a, const HeaderCost& b)
+    {
+        return (a.rebuild_time_in_seconds != b.rebuild_time_in_seconds)
+                   ? (a.rebuild_time_in_seconds > b.rebuild_time_in_seconds)
+                   : (a.header < b.header);
+    };
+
+    std::ranges::sort(costs, by_cost_then_path);
+
+    return costs;
+}
+
+auto include_analysis::get_include_chain(const build_caching::DependencyGraph& dependency_graph,
+                                         const std::filesystem::path& header) -> std::vector<std::filesystem::path>
+{
+    // Breadth-first search from the header towards the files that include it.
+    // Neighbors are visited in sorted order so the same chain is chosen every time.
+    std::unordered_map<std::filesystem::path, std::filesystem::path> parents;
+    std::deque<std::filesystem::path> queue = {header};
+    parents.emplace(header, header);
+
+    while (!queue.empty())
+    {
+        const auto file = queue.front();
+        queue.pop_front();
+
+        if (utils::is_source_file(file))
+        {
+            std::vector<std::filesystem::path> chain = {file};
+
+            while (chain.back() != header)
+            {
+                chain.push_back(parents.at(chain.back()));
+            }
+
+            return chain;
+        }
+
+        if (!dependency_graph.data().contains(file))
+        {
+            continue;
+        }
+
+        auto includers = dependency_graph.data().at(file) | std::ranges::to<std::vector>();
+        std::ranges::sort(includers);
+
+        for (const auto& includer : includers)
+        {
+            if (parents.try_emplace(includer, file).second)
+            {
+                queue.push_back(includer);
+            }
+        }
+    }
+
+    return {header};
+}
+
+static auto print_porcelain_output(const std::vector<include_analysis::HeaderCost>& costs, std::ostream& output)
+    -> void
+{
+    for (const auto& [header, num_of_translation_units, rebuild_time] : costs)
+    {
+        std::println(output, "{:.3f} {} {}", rebuild_time, num_of_translation_units, header.native());
+    }
+}
+
+static auto print_verbose_output(const AnalyzeIncludesCommandInfo& info,
+                                 const build_caching::DependencyGraph& dependency_graph,
+                                 const std::vector<include_analysis::HeaderCost>& costs,
+                                 const bool has_compilation_times,
+                                 std::ostream& output) -> void
+{
+    if (costs.empty())
+    {
+        std::println(output, "No headers are included in the '{}' configuration.", info.configuration_name);
+
+        return;
+    }
+
+    if (!has_compilation_times)
+    {
+        std::println(output,
+                     "No compilation times were recorded for '{}', every file is assumed to take 1 second. "
+                     "Build the configuration first for more accurate results.",
+                     info.configuration_name);
+    }
+
+    std::println(output, "Most expensive headers to change in the '{}' configuration:", info.configuration_name);
+
+    const auto max_index_width = utils::count_digits(costs.size()); // For formatting.
+
+    for (const auto [index, cost] : std::views::enumerate(costs) | std::views::as_const)
+    {
+        const auto chain = include_analysis::get_include_chain(dependency_graph, cost.header)           //
+                           | std::views::transform([](const auto& file) { return file.string(); }) //
+                           | std::views::join_with(std::string(" -> "))                            //
+                           | std::ranges::to<std::string>();                                       //
+
+        std::println(output,
+                     "{0:>{4}} {1} ({2:.2f}s, {3} translation {5})",
+                     index + 1,
+                     cost.header.native(),
+                     cost.rebuild_time_in_seconds,
+                     cost.num_of_translation_units,
+                     max_index_width,
+                     cost.num_of_translation_units == 1 ? "unit" : "units");
+        std::println(output, "{0:>{1}} {2}", "", max_index_width, chain);
+    }
+}
+
+auto commands::analyze_includes(const AnalyzeIncludesCommandInfo& info,
+                                const std::vector<Configuration>& configurations,
+                                const std::filesystem::path& path_to_root,
+                                std::ostream& output) -> int
+{
+    const auto MAX_NUM_OF_HEADERS = 10UZ;
+
+    const auto configuration                  = get_resolved_configuration(configurations, info.configuration_name);
+    const auto found_error_with_configuration = !configuration.has_value();
+
+    if (found_error_with_configuration)
+    {
+        utils::print_error(output, "{}", configuration.error());
+
+        return EXIT_FAILURE;
+    }
+
+    const auto code_files = get_code_files(*configuration, path_to_root);
+    const auto dependency_graph =
+        build_caching::get_dependency_graph(path_to_root, code_files, configuration->include_directories.value_or({}));
+    const auto compilation_times = build_caching::get_old_compilation_times(info.configuration_name, path_to_root);
+
+    auto costs = include_analysis::get_header_costs(dependency_graph, compilation_times);
+
+    if (!info.show_all_headers && costs.size() > MAX_NUM_OF_HEADERS)
+    {
+        costs.resize(MAX_NUM_OF_HEADERS);
+    }
+
+    if (info.porcelain_output)
+    {
+        print_porcelain_output(costs, output);
+    }
+    else
+    {
+        print_verbose_output(info, dependency_graph, costs, !compilation_times.empty(), output);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#ifndef SOURCE_COMMANDS_ANALYZE_INCLUDES_ANALYZE_INCLUDES_HPP
+#define SOURCE_COMMANDS_ANALYZE_INCLUDES_ANALYZE_INCLUDES_HPP
+
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "source/argument_parsing/command_info.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace include_analysis
+{
+    struct HeaderCost
+    {
+        std::filesystem::path header;
+        int num_of_translation_units;   // Source files that transitively include the header.
+        double rebuild_time_in_seconds; // Time it takes to recompile them after the header changes.
+    };
+
+    // Sorted by rebuild time, most expensive first.
+    auto get_header_costs(const build_caching::DependencyGraph& dependency_graph,
+                          const std::unordered_map<std::filesystem::path, double>& compilation_times)
+        -> std::vector<HeaderCost>;
+
+    // The shortest chain of includes from a source file to `header`, starting with the source file.
+    auto get_include_chain(const build_caching::DependencyGraph& dependency_graph,
+                           const std::filesystem::path& header) -> std::vector<std::filesystem::path>;
+}
+
+namespace commands
+{
+    auto analyze_includes(const AnalyzeIncludesCommandInfo& info,
+                          const std::vector<Configuration>& configurations,
+                          const std::filesystem::path& path_to_root,
+                          std::ostream& output = std::cout) -> int;
+}
+
+#endif // SOURCE_COMMANDS_ANALYZE_INCLUDES_ANALYZE_INCLUDES_HPP
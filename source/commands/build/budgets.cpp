@@ -0,0 +1,143 @@
+#include "source/commands/build/budgets.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator> // std::back_inserter, std::distance
+#include <limits>
+
+#include "source/utils/macros/assert.hpp"
+
+// Removes "." and ".." components and the trailing separator of a directory ("source/generated/").
+// The root of the project (".") becomes an empty path, which every file is under.
+static auto normalize_path(const std::filesystem::path& path) -> std::filesystem::path
+{
+    const auto normal_path = path.lexically_normal();
+    const auto directory   = normal_path.has_filename() ? normal_path : normal_path.parent_path();
+
+    return directory == "." ? std::filesystem::path() : directory;
+}
+
+// Whether `file` is `path` itself or inside the directory `path`.
+static auto is_under_path(const std::filesystem::path& file, const std::filesystem::path& path) -> bool
+{
+    const auto normal_path = normalize_path(path);
+    const auto normal_file = normalize_path(file);
+
+    return std::mismatch(normal_path.begin(), normal_path.end(), normal_file.begin(), normal_file.end()).first ==
+           normal_path.end();
+}
+
+static auto get_num_of_components(const std::filesystem::path& path) -> long
+{
+    const auto normal_path = normalize_path(path);
+
+    return std::distance(normal_path.begin(), normal_path.end());
+}
+
+static auto get_action(const Configuration& configuration) -> budgets::Action
+{
+    if (configuration.budget_action == "fail")
+    {
+        return budgets::Action::Fail;
+    }
+    else if (configuration.budget_action == "kill")
+    {
+        return budgets::Action::Kill;
+    }
+
+    return budgets::Action::Warn;
+}
+
+auto budgets::get_budget(const Configuration& configuration, const std::filesystem::path& file) -> Budget
+{
+    Budget budget = {
+        .max_compile_seconds     = configuration.max_compile_seconds,
+        .max_memory_in_megabytes = configuration.max_memory_in_megabytes,
+        .action                  = get_action(configuration),
+    };
+
+    if (!configuration.budget_overrides.has_value())
+    {
+        return budget;
+    }
+
+    const BudgetOverride* closest_override = nullptr;
+
+    for (const auto& budget_override : *configuration.budget_overrides)
+    {
+        if (is_under_path(file, budget_override.path) &&
+            (closest_override == nullptr ||
+             get_num_of_components(budget_override.path) > get_num_of_components(closest_override->path)))
+        {
+            closest_override = &budget_override;
+        }
+    }
+
+    if (closest_override != nullptr && closest_override->max_compile_seconds.has_value())
+    {
+        budget.max_compile_seconds = closest_override->max_compile_seconds;
+    }
+
+    if (closest_override != nullptr && closest_override->max_memory_in_megabytes.has_value())
+    {
+        budget.max_memory_in_megabytes = closest_override->max_memory_in_megabytes;
+    }
+
+    return budget;
+}
+
+auto budgets::check(const Budget& budget,
+                    const double duration_in_seconds,
+                    const long peak_memory_in_kilobytes) -> std::optional<std::string>
+{
+    ASSERT(duration_in_seconds >= 0);
+    ASSERT(peak_memory_in_kilobytes >= 0);
+
+    constexpr auto no_limit             = std::numeric_limits<double>::infinity();
+    const auto peak_memory_in_megabytes = peak_memory_in_kilobytes / 1024.0;
+    const auto exceeds_time             = duration_in_seconds > budget.max_compile_seconds.value_or(no_limit);
+    const auto exceeds_memory           = peak_memory_in_megabytes > budget.max_memory_in_megabytes.value_or(no_limit);
+
+    if (!exceeds_time && !exceeds_memory)
+    {
+        return std::nullopt;
+    }
+
+    std::string description;
+
+    if (exceeds_time)
+    {
+        std::format_to(std::back_inserter(description),
+                       "took {:.2f} seconds to compile, which exceeds its budget of {} seconds",
+                       duration_in_seconds,
+                       *budget.max_compile_seconds);
+    }
+
+    if (exceeds_time && exceeds_memory)
+    {
+        description += ", and ";
+    }
+
+    if (exceeds_memory)
+    {
+        std::format_to(std::back_inserter(description),
+                       "used {:.0f} MB of memory to compile, which exceeds its budget of {} MB",
+                       peak_memory_in_megabytes,
+                       *budget.max_memory_in_megabytes);
+    }
+
+    return description;
+}
+
+auto budgets::get_limits(const Budget& budget) -> jobs::Limits
+{
+    if (budget.action != Action::Kill)
+    {
+        return {};
+    }
+
+    return {
+        .max_seconds             = budget.max_compile_seconds,
+        .max_memory_in_megabytes = budget.max_memory_in_megabytes,
+    };
+}
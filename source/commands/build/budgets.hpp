@@ -0,0 +1,41 @@
+#ifndef SOURCE_COMMANDS_BUILD_BUDGETS_HPP
+#define SOURCE_COMMANDS_BUILD_BUDGETS_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "source/commands/build/jobs.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+// The compile time and memory that a translation unit may use, from the `budgets` of its configuration.
+namespace budgets
+{
+    enum class Action
+    {
+        Warn, // The build succeeds.
+        Fail, // The translation unit fails to compile.
+        Kill, // Same, and the compiler is stopped once it exceeds the budget.
+    };
+
+    struct Budget
+    {
+        std::optional<double> max_compile_seconds{};
+        std::optional<double> max_memory_in_megabytes{};
+        Action action;
+    };
+
+    // The override with the longest path that contains `file` takes precedence over the configuration's budget.
+    // A limit that the override does not set is taken from the configuration.
+    auto get_budget(const Configuration& configuration, const std::filesystem::path& file) -> Budget;
+
+    // Describes the limits that a compilation exceeded, or returns `std::nullopt` if it kept to its budget.
+    auto check(const Budget& budget,
+               double duration_in_seconds,
+               long peak_memory_in_kilobytes) -> std::optional<std::string>;
+
+    // The limits that stop a compiler once it exceeds `budget`. Unlimited unless the action is `Action::Kill`.
+    auto get_limits(const Budget& budget) -> jobs::Limits;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_BUDGETS_HPP
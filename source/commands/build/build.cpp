@@ -1,23 +1,60 @@
 #include "source/commands/build/build.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <expected>
+#include <format>
+#include <functional> // std::cref
+#include <future>
+#include <map>
+#include <optional>
 #include <print>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <system_error> // std::error_code
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "source/commands/build/build_caching/analysis_cache.hpp"
 #include "source/commands/build/build_caching/build_caching.hpp"
 #include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/compile_time_analysis/compile_time_analysis.hpp"
 #include "source/commands/build/configuration_resolution.hpp"
+#include "source/commands/build/distributed/distributed.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/explain.hpp"
+#include "source/commands/build/history.hpp"
+#include "source/commands/build/jobs.hpp"
 #include "source/commands/build/linking.hpp"
+#include "source/commands/build/modules/modules.hpp"
+#include "source/commands/build/precompiled_headers/precompiled_headers.hpp"
+#include "source/commands/build/profile_guided_optimization/profile_guided_optimization.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/commands/build/unity_build/unity_build.hpp"
 #include "source/parameters/parameters.hpp"
 #include "source/utils/print.hpp"
 #include "source/utils/utils.hpp"
 
+namespace
+{
+    // A library that a configuration links against.
+    struct Dependency
+    {
+        Configuration configuration;
+        std::shared_future<BuildCommandResult> result; // Ready once the library is built.
+    };
+}
+
 auto get_code_files(const Configuration& configuration,
                     const std::filesystem::path& path_to_root) -> std::vector<std::filesystem::path>
 {
+    const trace::Span span("get_code_files", "analysis", {{"configuration", configuration.name.value_or("")}});
+
     std::unordered_set<std::filesystem::path> code_files;
 
     if (configuration.source_files.has_value())
@@ -37,13 +74,9 @@ auto get_code_files(const Configuration& configuration,
     {
         for (const auto& directory : *configuration.source_directories)
         {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(path_to_root / directory))
+            for (auto& file : analysis_cache::get_code_files_in_directory(path_to_root, directory))
             {
-                if (entry.is_regular_file() && utils::is_code_file(entry))
-                {
-                    auto relative_path = std::filesystem::relative(entry, path_to_root);
-                    code_files.insert(std::move(relative_path));
-                }
+                code_files.insert(std::move(file));
             }
         }
     }
@@ -60,13 +93,9 @@ auto get_code_files(const Configuration& configuration,
     {
         for (const auto& directory : *configuration.excluded_directories)
         {
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(path_to_root / directory))
+            for (const auto& file : analysis_cache::get_code_files_in_directory(path_to_root, directory))
             {
-                if (entry.is_regular_file() && utils::is_code_file(entry))
-                {
-                    auto relative_path = std::filesystem::relative(entry, path_to_root);
-                    code_files.erase(std::move(relative_path));
-                }
+                code_files.erase(file);
             }
         }
     }
@@ -74,9 +103,9 @@ auto get_code_files(const Configuration& configuration,
     return code_files | std::ranges::to<std::vector>();
 }
 
-static auto remove_object_files_of_deleted_files(const std::string_view configuration_name,
-                                                 const std::vector<std::filesystem::path>& deleted_files,
-                                                 const std::filesystem::path& path_to_root) -> void
+static auto remove_object_files(const std::string_view configuration_name,
+                                const std::vector<std::filesystem::path>& files,
+                                const std::filesystem::path& path_to_root) -> void
 {
     const auto object_files_directory        = path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name;
     const auto object_files_directory_exists = std::filesystem::is_directory(object_files_directory);
@@ -86,30 +115,146 @@ static auto remove_object_files_of_deleted_files(const std::string_view configur
         return;
     }
 
-    for (const auto& file_name : deleted_files)
+    for (const auto& file_name : files)
     {
-        const auto object_file_path = object_files_directory / utils::get_object_file_name(file_name);
         std::error_code error;
-        std::filesystem::remove(object_file_path, error);
+        utils::remove_object_file(object_files_directory, file_name, error);
 
         if (error)
         {
-            std::println("Error: Failed to remove old object file for '{}': {}", file_name.native(), error.message());
+            events::report_error(std::format(
+                "Error: Failed to remove old object file for '{}': {}", file_name.native(), error.message()));
+        }
+    }
+}
+
+/// @brief  Appends a record for every compiled source file of the configuration to the history.
+///         The files that were up to date are only counted, by the record of the build.
+/// @param  reasons  Why each of the compiled files was compiled.
+static auto record_translation_units(const std::string& configuration_name,
+                                     const std::filesystem::path& path_to_root,
+                                     const std::int64_t timestamp,
+                                     const std::vector<std::filesystem::path>& compiled_files,
+                                     const std::map<std::filesystem::path, explain::Reason>& reasons,
+                                     const CompilationResult& compilation_result) -> void
+{
+    std::vector<history::TranslationUnitRecord> records;
+
+    for (const auto& file : compiled_files)
+    {
+        const auto reason = reasons.find(file);
+
+        if (reason == reasons.end())
+        {
+            continue;
         }
+
+        const auto compilation_time = compilation_result.compilation_times.find(file);
+        const auto peak_memory      = compilation_result.peak_memory_in_kilobytes.find(file);
+        const auto is_successful    = compilation_time != compilation_result.compilation_times.end();
+        const auto has_peak_memory  = peak_memory != compilation_result.peak_memory_in_kilobytes.end();
+
+        records.push_back({
+            .timestamp                = timestamp,
+            .configuration            = configuration_name,
+            .file                     = file,
+            .cause                    = std::string(history::get_cause_name(reason->second.cause)),
+            .reason                   = explain::to_string(reason->second),
+            .is_successful            = is_successful,
+            .duration_in_seconds      = is_successful ? compilation_time->second : 0.0,
+            .peak_memory_in_kilobytes = has_peak_memory ? peak_memory->second : 0,
+        });
     }
+
+    history::append(path_to_root, records);
 }
 
+/// @param timestamp  Of the build, for the records of its translation units in the history.
 static auto build_configuration(const BuildCommandInfo& info,
-                                const Configuration& configuration,
-                                const std::filesystem::path& path_to_root) -> BuildCommandResult
+                                const Configuration& resolved_configuration,
+                                const std::filesystem::path& path_to_root,
+                                const std::vector<Dependency>& dependencies,
+                                const std::int64_t timestamp) -> BuildCommandResult
 {
+    const trace::Span span("Build configuration", "build", {{"configuration", *resolved_configuration.name}});
+
+    // Once `easy-make pgo` recorded a profile, every build of the configuration uses it.
+    auto configuration    = resolved_configuration;
+    configuration.profile = profile_guided_optimization::find_profile(configuration, path_to_root);
+
+    if (info.analyze_compile_time)
+    {
+        // Forgetting the configuration hash recompiles every file, so that the report covers all of them.
+        // The flag does not change the object files, so the next regular build does not recompile them.
+        std::filesystem::remove(path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name /
+                                params::CONFIGURATION_HASH_DATA_FILE_NAME);
+
+        auto compilation_flags = configuration.compilation_flags.value_or({});
+        compilation_flags.push_back(compile_time_analysis::get_compilation_flag(configuration));
+        configuration.compilation_flags = compilation_flags;
+    }
+
     const auto code_files            = get_code_files(configuration, path_to_root);
-    const auto build_info            = build_caching::handle_build_caching(configuration, path_to_root, code_files);
+    const auto unity_build_requested = configuration.unity.value_or(false);
+
+    // A unity batch cannot contain more than one module unit, so unity builds scan for modules up front.
+    // Otherwise the scan runs after the analysis, while outdated files are already compiling.
+    // Either way, only files that changed since the previous scan are scanned.
+    auto module_scan_cache = modules::read_scan_cache(*configuration.name, path_to_root);
+    auto module_infos      = unity_build_requested
+                                 ? modules::scan_files(path_to_root, code_files, module_scan_cache)
+                                 : std::unordered_map<std::filesystem::path, modules::ModuleInfo>{};
+    const auto use_unity_build = unity_build_requested && module_infos.empty();
+
+    if (unity_build_requested && !use_unity_build && !info.is_quiet)
+    {
+        std::println("Note: Configuration '{}' uses C++20 modules, so it is not built as a unity build.",
+                     *configuration.name);
+    }
+
+    if (!use_unity_build && !info.is_dry_run)
+    {
+        // Objects of a previous unity build would be linked together with the regular ones.
+        unity_build::remove_unity_build_files(*configuration.name, path_to_root);
+    }
+
+    // Source files that are compiled on their own with the configuration's flags start compiling as soon as
+    // they are known to be outdated, overlapping with the rest of the analysis.
+    // Unity batches and precompiled headers are only decided once the analysis is done.
+    const auto use_pipeline =
+        !unity_build_requested && !configuration.precompiled_headers.value_or(false) && !info.is_dry_run;
+    CompilationPipeline pipeline(configuration, path_to_root, info.use_parallel_compilation, std::nullopt);
+
+    if (use_pipeline)
+    {
+        // In a first build, files start compiling before the analysis writes the build data into this directory.
+        std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name);
+    }
+
+    const auto start_compiling = [&](const std::filesystem::path& file)
+    {
+        // Module units have to wait for the module graph.
+        // The calls never overlap, and the scan of the whole configuration only starts after the analysis.
+        if (!modules::uses_modules(modules::scan_file(path_to_root, file, module_scan_cache)))
+        {
+            pipeline.add(file);
+        }
+    };
+
+    const auto translation_units = use_unity_build
+                                       ? unity_build::get_translation_units(*configuration.name, path_to_root)
+                                       : build_caching::TranslationUnits{};
+    const auto on_outdated_file =
+        use_pipeline ? build_caching::OutdatedFileCallback(start_compiling) : build_caching::OutdatedFileCallback{};
+    const auto build_info = build_caching::handle_build_caching(
+        configuration, path_to_root, code_files, translation_units, on_outdated_file, info.is_dry_run);
     const auto error_exists_in_build = !build_info.has_value();
 
     if (error_exists_in_build)
     {
-        utils::print_error("{}", build_info.error());
+        // The files that already started compiling belong to a build that cannot succeed.
+        pipeline.cancel();
+        events::report_error(build_info.error());
 
         return {
             .num_of_files_compiled       = 0,
@@ -118,69 +263,599 @@ static auto build_configuration(const BuildCommandInfo& info,
         };
     }
 
+    if (!unity_build_requested)
+    {
+        module_infos = modules::scan_files(path_to_root, code_files, module_scan_cache);
+    }
+
+    if (!info.is_dry_run)
+    {
+        modules::write_scan_cache(*configuration.name, path_to_root, module_scan_cache);
+    }
+
+    const auto uses_modules        = !module_infos.empty();
+    const auto num_of_source_files = std::ranges::count_if(code_files, &utils::is_source_file);
+
+    if (info.is_dry_run)
+    {
+        // The precompiled header is not checked, since that may require compiling it.
+        const auto reasons = explain::get_reasons(*build_info);
+        std::print("{}", explain::format_reasons(*configuration.name, reasons, num_of_source_files));
+
+        return {
+            .num_of_files_compiled       = 0,
+            .num_of_compilation_failures = 0,
+            .exit_status                 = EXIT_SUCCESS,
+        };
+    }
+
     // Delete object files for deleted source files to prevent the linker from using stale objects,
     // which can cause linker errors or violate the ODR.
-    remove_object_files_of_deleted_files(*configuration.name, build_info->files_to_delete, path_to_root);
+    remove_object_files(*configuration.name, build_info->files_to_delete, path_to_root);
+
+    auto files_to_compile           = build_info->files_to_compile;
+    auto precompiled_header_changed = false;
+    std::optional<std::filesystem::path> precompiled_header;
+
+    if (configuration.precompiled_headers.value_or(false))
+    {
+        const auto pch_info = precompiled_headers::handle_precompiled_headers(
+            configuration, path_to_root, *build_info, info.is_quiet);
+
+        if (!pch_info.has_value())
+        {
+            events::report_error(pch_info.error());
+
+            return {
+                .num_of_files_compiled       = 0,
+                .num_of_compilation_failures = 0,
+                .exit_status                 = EXIT_FAILURE,
+            };
+        }
+
+        // Object files that were compiled with a different PCH (or without one) are stale.
+        if (pch_info->requires_full_rebuild)
+        {
+            files_to_compile = code_files                                   //
+                               | std::views::filter(&utils::is_source_file) //
+                               | std::ranges::to<std::vector>();            //
+            std::ranges::sort(files_to_compile);
+            precompiled_header_changed = true;
+        }
+
+        precompiled_header = pch_info->header_path;
+    }
+
+    // The reasons are recorded in the history as well.
+    auto reasons = explain::get_reasons(*build_info);
 
-    const auto num_of_compilation_failures = compile_files(
-        configuration, path_to_root, build_info->files_to_compile, info.is_quiet, info.use_parallel_compilation);
+    if (precompiled_header_changed)
+    {
+        for (const auto& file : files_to_compile)
+        {
+            reasons.try_emplace(file, explain::Reason{.cause = explain::Cause::PRECOMPILED_HEADER_CHANGED});
+        }
+    }
+
+    if (info.explain)
+    {
+        // Printed at once, since configurations are built concurrently.
+        std::print("{}", explain::format_reasons(*configuration.name, reasons, num_of_source_files));
+    }
+
+    statistics::add(statistics::Counter::TRANSLATION_UNITS_COMPILED, std::ssize(files_to_compile));
+    statistics::add(statistics::Counter::TRANSLATION_UNITS_UP_TO_DATE,
+                    std::max(0Z, num_of_source_files - std::ssize(files_to_compile)));
+
+    const auto is_not_compiling = [&](const std::filesystem::path& file) { return !pipeline.contains(file); };
+
+    const auto compilation_result = [&]() -> std::expected<CompilationResult, std::string>
+    {
+        if (uses_modules)
+        {
+            // Files that started compiling during the analysis do not use modules.
+            const auto remaining_files = files_to_compile                       //
+                                         | std::views::filter(is_not_compiling) //
+                                         | std::ranges::to<std::vector>();      //
+
+            auto result = modules::compile_with_modules(configuration,
+                                                        path_to_root,
+                                                        *build_info,
+                                                        remaining_files,
+                                                        module_infos,
+                                                        info.is_quiet,
+                                                        info.use_parallel_compilation,
+                                                        precompiled_header);
+
+            if (result.has_value() && !pipeline.is_empty())
+            {
+                const auto pipeline_result = pipeline.finish(info.is_quiet);
+                result->num_of_failures += pipeline_result.num_of_failures;
+                result->compilation_times.insert(pipeline_result.compilation_times.begin(),
+                                                 pipeline_result.compilation_times.end());
+                result->peak_memory_in_kilobytes.insert(pipeline_result.peak_memory_in_kilobytes.begin(),
+                                                        pipeline_result.peak_memory_in_kilobytes.end());
+            }
+
+            return result;
+        }
 
+        if (use_unity_build)
+        {
+            return unity_build::compile_in_batches(configuration,
+                                                   path_to_root,
+                                                   *build_info,
+                                                   files_to_compile,
+                                                   info.is_quiet,
+                                                   info.use_parallel_compilation,
+                                                   precompiled_header);
+        }
+
+        if (use_pipeline)
+        {
+            for (const auto& file : files_to_compile | std::views::filter(is_not_compiling))
+            {
+                pipeline.add(file);
+            }
+
+            return pipeline.finish(info.is_quiet);
+        }
+
+        return compile_files(configuration,
+                             path_to_root,
+                             files_to_compile,
+                             info.is_quiet,
+                             info.use_parallel_compilation,
+                             precompiled_header);
+    }();
+
+    if (!compilation_result.has_value())
+    {
+        // None of the outdated files were compiled, so they must be compiled by the next build.
+        pipeline.cancel();
+        remove_object_files(*configuration.name, files_to_compile, path_to_root);
+        events::report_error(compilation_result.error());
+
+        return {
+            .num_of_files_compiled       = 0,
+            .num_of_compilation_failures = 0,
+            .exit_status                 = EXIT_FAILURE,
+        };
+    }
+
+    auto compilation_times = build_caching::get_old_compilation_times(*configuration.name, path_to_root);
+
+    for (const auto& file : build_info->files_to_delete)
+    {
+        compilation_times.erase(file);
+    }
+
+    for (const auto& [file, seconds] : compilation_result->compilation_times)
+    {
+        compilation_times[file] = seconds;
+    }
+
+    // The instrumented compilations of `--analyze-compile-time` would distort the scheduling of later builds
+    // and the history.
+    if (!info.analyze_compile_time)
+    {
+        build_caching::write_to_compilation_times_data_file(*configuration.name, path_to_root, compilation_times);
+        record_translation_units(
+            *configuration.name, path_to_root, timestamp, files_to_compile, reasons, *compilation_result);
+    }
+
+    if (info.analyze_compile_time && compilation_result->num_of_failures == 0)
+    {
+        const auto report = compile_time_analysis::create_report(configuration, path_to_root, compilation_times);
+        compile_time_analysis::print_report(report, *configuration.name);
+        compile_time_analysis::write_report(report,
+                                            path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name /
+                                                params::COMPILE_TIME_REPORT_FILE_NAME);
+    }
+
+    const auto num_of_compilation_failures = compilation_result->num_of_failures;
+    const auto num_of_files_up_to_date =
+        static_cast<int>(std::max(0Z, num_of_source_files - std::ssize(files_to_compile)));
     ASSERT(num_of_compilation_failures >= 0);
     const auto compilation_successful = (num_of_compilation_failures == 0);
 
     if (!compilation_successful)
     {
         return {
-            .num_of_files_compiled       = static_cast<int>(build_info->files_to_compile.size()),
+            .num_of_files_compiled       = static_cast<int>(files_to_compile.size()),
             .num_of_compilation_failures = num_of_compilation_failures,
             .exit_status                 = EXIT_FAILURE,
+            .num_of_files_up_to_date     = num_of_files_up_to_date,
         };
     }
 
+    // Only linking needs the libraries, so the dependencies are built while this configuration compiles.
+    for (const auto& dependency : dependencies)
+    {
+        if (dependency.result.get().exit_status != EXIT_SUCCESS)
+        {
+            events::report_error(
+                std::format("Configuration '{}' was not linked, since its dependency '{}' failed to build.",
+                            *configuration.name,
+                            *dependency.configuration.name));
+
+            return {
+                .num_of_files_compiled       = static_cast<int>(files_to_compile.size()),
+                .num_of_compilation_failures = 0,
+                .exit_status                 = EXIT_FAILURE,
+                .num_of_files_up_to_date     = num_of_files_up_to_date,
+            };
+        }
+    }
+
+    const auto libraries = dependencies                                           //
+                           | std::views::transform(&Dependency::configuration) //
+                           | std::ranges::to<std::vector>();                     //
     const auto linking_successful =
-        link_object_files(configuration, path_to_root, configuration.link_flags.value_or({}), info.is_quiet);
+        link_object_files(configuration, path_to_root, configuration.link_flags.value_or({}), libraries, info.is_quiet);
 
     if (!linking_successful)
     {
         return {
-            .num_of_files_compiled       = static_cast<int>(build_info->files_to_compile.size()),
+            .num_of_files_compiled       = static_cast<int>(files_to_compile.size()),
             .num_of_compilation_failures = 0,
             .exit_status                 = EXIT_FAILURE,
+            .num_of_files_up_to_date     = num_of_files_up_to_date,
         };
     }
 
     return {
-        .num_of_files_compiled       = static_cast<int>(build_info->files_to_compile.size()),
+        .num_of_files_compiled       = static_cast<int>(files_to_compile.size()),
         .num_of_compilation_failures = 0,
         .exit_status                 = EXIT_SUCCESS,
+        .num_of_files_up_to_date     = num_of_files_up_to_date,
+    };
+}
+
+// Builds the configuration and appends the build to the history, unless it was a dry run or an analysis of
+// the compile times.
+static auto build_and_record_configuration(const BuildCommandInfo& info,
+                                           const Configuration& configuration,
+                                           const std::filesystem::path& path_to_root,
+                                           const std::vector<Dependency>& dependencies) -> BuildCommandResult
+{
+    const auto timestamp  = history::get_current_timestamp();
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto result     = build_configuration(info, configuration, path_to_root, dependencies, timestamp);
+    const auto duration   = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+
+    if (info.is_dry_run || info.analyze_compile_time)
+    {
+        return result;
+    }
+
+    history::append(path_to_root,
+                    history::BuildRecord{
+                        .timestamp               = timestamp,
+                        .configuration           = *configuration.name,
+                        .duration_in_seconds     = duration.count(),
+                        .exit_status             = result.exit_status,
+                        .num_of_files_compiled   = result.num_of_files_compiled,
+                        .num_of_files_up_to_date = result.num_of_files_up_to_date,
+                    });
+
+    return result;
+}
+
+static auto print_configuration_result(const std::string_view configuration_name,
+                                       const BuildCommandResult& result) -> void
+{
+    if (result.exit_status == EXIT_SUCCESS)
+    {
+        utils::print_success("Configuration '{}' built successfully ({} files compiled).",
+                             configuration_name,
+                             result.num_of_files_compiled);
+    }
+    else if (result.num_of_compilation_failures > 0)
+    {
+        utils::print_error("Configuration '{}' failed to build ({} of {} files failed to compile).",
+                           configuration_name,
+                           result.num_of_compilation_failures,
+                           result.num_of_files_compiled);
+    }
+    else
+    {
+        utils::print_error("Configuration '{}' failed to build.", configuration_name);
+    }
+}
+
+static auto get_name_to_configuration(const std::vector<Configuration>& configurations)
+    -> std::unordered_map<std::string, Configuration>
+{
+    std::unordered_map<std::string, Configuration> name_to_configuration;
+
+    for (const auto& configuration : configurations)
+    {
+        name_to_configuration.emplace(*configuration.name, configuration);
+    }
+
+    return name_to_configuration;
+}
+
+// Adds the dependencies of `dependent` to `result` in post-order, so that every library
+// is added after the libraries it depends on.
+static auto add_dependencies(const Configuration& dependent,
+                             const std::unordered_map<std::string, Configuration>& name_to_configuration,
+                             std::unordered_set<std::string>& visited,
+                             std::unordered_set<std::string>& in_progress,
+                             std::vector<Configuration>& result) -> std::optional<std::string>
+{
+    for (const auto& name : dependent.dependencies.value_or(std::vector<std::string>{}))
+    {
+        // Validation rejects cycles, but configurations that were not validated must not recurse forever.
+        if (in_progress.contains(name))
+        {
+            return std::format(
+                "Error: Configuration '{}' depends on '{}', which depends on it.", *dependent.name, name);
+        }
+
+        const auto already_visited = !visited.insert(name).second;
+
+        if (already_visited)
+        {
+            continue;
+        }
+
+        const auto dependency = name_to_configuration.find(name);
+
+        if (dependency == name_to_configuration.end())
+        {
+            return std::format(
+                "Error: Configuration '{}' depends on '{}', which is incomplete.", *dependent.name, name);
+        }
+
+        if (dependency->second.type != "static" && dependency->second.type != "shared")
+        {
+            return std::format(
+                "Error: Configuration '{}' depends on '{}', which is not a library.", *dependent.name, name);
+        }
+
+        in_progress.insert(name);
+
+        if (const auto error =
+                add_dependencies(dependency->second, name_to_configuration, visited, in_progress, result);
+            error.has_value())
+        {
+            return error;
+        }
+
+        in_progress.erase(name);
+        result.push_back(dependency->second);
+    }
+
+    return std::nullopt;
+}
+
+auto get_dependencies(const Configuration& configuration,
+                      const std::unordered_map<std::string, Configuration>& name_to_configuration)
+    -> std::expected<std::vector<Configuration>, std::string>
+{
+    std::vector<Configuration> result;
+    std::unordered_set<std::string> visited;
+    std::unordered_set<std::string> in_progress{*configuration.name};
+
+    if (const auto error = add_dependencies(configuration, name_to_configuration, visited, in_progress, result);
+        error.has_value())
+    {
+        return std::unexpected(*error);
+    }
+
+    std::ranges::reverse(result);
+
+    return result;
+}
+
+auto get_position_independent_configurations(const std::vector<Configuration>& configurations)
+    -> std::unordered_set<std::string>
+{
+    const auto name_to_configuration = get_name_to_configuration(configurations);
+    std::unordered_set<std::string> result;
+
+    for (const auto& configuration : configurations)
+    {
+        if (configuration.type != "shared")
+        {
+            continue;
+        }
+
+        // Invalid dependencies are reported when the configuration is built.
+        const auto dependencies = get_dependencies(configuration, name_to_configuration);
+
+        if (!dependencies.has_value())
+        {
+            continue;
+        }
+
+        for (const auto& dependency : *dependencies)
+        {
+            result.insert(*dependency.name);
+        }
+    }
+
+    return result;
+}
+
+/// @brief  Builds the configurations concurrently.
+/// @param  configurations              The configurations to build, including the dependencies of each of them.
+/// @param  verbose_configuration_name  The configuration whose progress is printed file by file, if any.
+/// @note   The configurations share one limit on the number of compiler and linker processes,
+///         so the link of one configuration overlaps with the compilation of the others instead of
+///         leaving the threads idle. The progress of each file is only printed for the verbose configuration,
+///         since the output of several configurations would be interleaved; a summary is printed when each
+///         of the others is done.
+///         Every configuration compiles right away and only waits for its dependencies before linking,
+///         so the configurations are built as a DAG.
+static auto build_configurations(const BuildCommandInfo& info,
+                                 const std::vector<Configuration>& configurations,
+                                 const std::filesystem::path& path_to_root,
+                                 const std::optional<std::string>& verbose_configuration_name) -> BuildCommandResult
+{
+    jobs::set_max_num_of_jobs(get_num_of_compilation_threads(info.use_parallel_compilation));
+
+    const auto name_to_configuration = get_name_to_configuration(configurations);
+
+    // Every configuration is built once, even if several configurations depend on it.
+    std::unordered_map<std::string, std::promise<BuildCommandResult>> promises;
+    std::unordered_map<std::string, std::shared_future<BuildCommandResult>> results;
+
+    for (const auto& configuration : configurations)
+    {
+        results[*configuration.name] = promises[*configuration.name].get_future().share();
+    }
+
+    std::unordered_map<std::string, std::vector<Dependency>> dependencies;
+
+    for (const auto& configuration : configurations)
+    {
+        const auto configuration_dependencies = get_dependencies(configuration, name_to_configuration);
+
+        if (!configuration_dependencies.has_value())
+        {
+            events::report_error(configuration_dependencies.error());
+
+            return {
+                .num_of_files_compiled       = 0,
+                .num_of_compilation_failures = 0,
+                .exit_status                 = EXIT_FAILURE,
+            };
+        }
+
+        // Every configuration gets an entry, so the tasks below do not modify the map.
+        auto& dependency_list = dependencies[*configuration.name];
+
+        for (const auto& dependency : *configuration_dependencies)
+        {
+            dependency_list.push_back({
+                .configuration = dependency,
+                .result        = results.at(*dependency.name),
+            });
+        }
+    }
+
+    auto quiet_info     = info;
+    quiet_info.is_quiet = info.is_quiet || configurations.size() > 1;
+
+    const auto build = [&](const Configuration& configuration)
+    {
+        auto& promise         = promises.at(*configuration.name);
+        const auto is_verbose = (configuration.name == verbose_configuration_name);
+
+        // The dependents of a configuration wait for its result, so it must be set even if the build throws.
+        // A build that throws fails like any other, so that the other configurations still finish theirs.
+        const auto fail = [&](const std::string_view reason)
+        {
+            events::report_error(std::format("Error: Failed to build '{}': {}", *configuration.name, reason));
+            promise.set_value({
+                .num_of_files_compiled       = 0,
+                .num_of_compilation_failures = 0,
+                .exit_status                 = EXIT_FAILURE,
+            });
+        };
+
+        try
+        {
+            const auto result = build_and_record_configuration(
+                is_verbose ? info : quiet_info, configuration, path_to_root, dependencies.at(*configuration.name));
+
+            if (!info.is_quiet && !info.is_dry_run && configurations.size() > 1 && !is_verbose)
+            {
+                print_configuration_result(*configuration.name, result);
+            }
+
+            promise.set_value(result);
+        }
+        catch (const std::exception& exception)
+        {
+            fail(exception.what());
+        }
+        catch (...)
+        {
+            fail("unknown error");
+        }
     };
+
+    // The tasks are waited for before the promises they fulfill are destroyed.
+    std::vector<std::future<void>> futures;
+
+    for (const auto& configuration : configurations)
+    {
+        futures.push_back(std::async(std::launch::async, build, std::cref(configuration)));
+    }
+
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    BuildCommandResult total_result{};
+
+    for (const auto& result : results | std::views::values)
+    {
+        const auto& build_result = result.get();
+        total_result.num_of_files_compiled += build_result.num_of_files_compiled;
+        total_result.num_of_compilation_failures += build_result.num_of_compilation_failures;
+        total_result.exit_status |= build_result.exit_status;
+        total_result.num_of_files_up_to_date += build_result.num_of_files_up_to_date;
+    }
+
+    return total_result;
 }
 
 auto commands::build(const BuildCommandInfo& info,
                      const std::vector<Configuration>& configurations,
                      const std::filesystem::path& path_to_root) -> BuildCommandResult
 {
-    if (info.build_all_configurations)
+    // Configurations mostly share their source trees, so each file is read once per invocation.
+    const analysis_cache::Scope analysis_cache_scope;
+
+    distributed::set_workers({});
+
+    if (info.workers.has_value())
     {
-        BuildCommandResult total_result{};
+        const auto workers = distributed::parse_workers(*info.workers);
 
-        for (const auto& configuration : get_resolved_configurations(configurations, ConfigurationType::COMPLETE))
+        if (!workers.has_value())
         {
-            const auto build_result = build_configuration(info, configuration, path_to_root);
-            total_result.num_of_files_compiled += build_result.num_of_files_compiled;
-            total_result.num_of_compilation_failures += build_result.num_of_compilation_failures;
-            total_result.exit_status |= build_result.exit_status;
+            events::report_error(workers.error());
+
+            return {
+                .num_of_files_compiled       = 0,
+                .num_of_compilation_failures = 0,
+                .exit_status                 = EXIT_FAILURE,
+            };
         }
 
-        return total_result;
+        distributed::set_workers(*workers);
+
+        // The compilation threads also wait for the workers, so they no longer limit the local compilers.
+        jobs::set_max_num_of_jobs(get_num_of_compilation_threads(info.use_parallel_compilation));
+    }
+
+    auto complete_configurations = get_resolved_configurations(configurations, ConfigurationType::COMPLETE);
+    const auto position_independent_configurations = get_position_independent_configurations(complete_configurations);
+
+    for (auto& complete_configuration : complete_configurations)
+    {
+        complete_configuration.position_independent_code =
+            position_independent_configurations.contains(*complete_configuration.name);
+    }
+
+    if (info.build_all_configurations)
+    {
+        return build_configurations(info, complete_configurations, path_to_root, std::nullopt);
     }
 
-    const auto configuration                  = get_resolved_configuration(configurations, *info.configuration_name);
+    auto configuration                        = get_resolved_configuration(configurations, *info.configuration_name);
     const auto found_error_with_configuration = !configuration.has_value();
 
     if (found_error_with_configuration)
     {
-        utils::print_error("{}", configuration.error());
+        events::report_error(configuration.error());
 
         return {
             .num_of_files_compiled       = 0,
@@ -188,8 +863,30 @@ auto commands::build(const BuildCommandInfo& info,
             .exit_status                 = EXIT_FAILURE,
         };
     }
-    else
+
+    configuration->position_independent_code = position_independent_configurations.contains(*configuration->name);
+
+    auto configurations_to_build =
+        get_dependencies(*configuration, get_name_to_configuration(complete_configurations));
+
+    if (!configurations_to_build.has_value())
     {
-        return build_configuration(info, *configuration, path_to_root);
+        events::report_error(configurations_to_build.error());
+
+        return {
+            .num_of_files_compiled       = 0,
+            .num_of_compilation_failures = 0,
+            .exit_status                 = EXIT_FAILURE,
+        };
+    }
+
+    if (configurations_to_build->empty())
+    {
+        return build_and_record_configuration(info, *configuration, path_to_root, {});
     }
+
+    // The dependencies are built as well, concurrently with the configuration itself.
+    configurations_to_build->push_back(*configuration);
+
+    return build_configurations(info, *configurations_to_build, path_to_root, configuration->name);
 }
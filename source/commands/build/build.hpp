@@ -1,7 +1,11 @@
 #ifndef SOURCE_COMMANDS_BUILD_BUILD_HPP
 #define SOURCE_COMMANDS_BUILD_BUILD_HPP
 
+#include <expected>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "source/argument_parsing/command_info.hpp"
@@ -10,11 +14,27 @@
 auto get_code_files(const Configuration& configuration,
                     const std::filesystem::path& path_to_root) -> std::vector<std::filesystem::path>;
 
+/// @brief  Returns the configurations that a configuration depends on, directly or transitively.
+/// @param  configuration          The configuration whose dependencies are returned.
+/// @param  name_to_configuration  The configurations that can be built, by name.
+/// @return The dependencies, ordered so that every library comes before the libraries it depends on
+///         (the order in which static libraries must be given to the linker), or an error message
+///         if one of them cannot be built, is not a library or depends on `configuration`.
+auto get_dependencies(const Configuration& configuration,
+                      const std::unordered_map<std::string, Configuration>& name_to_configuration)
+    -> std::expected<std::vector<Configuration>, std::string>;
+
+// Returns the names of the configurations that a shared library depends on, directly or transitively.
+// Their code ends up in the shared library, so it has to be position independent.
+auto get_position_independent_configurations(const std::vector<Configuration>& configurations)
+    -> std::unordered_set<std::string>;
+
 struct BuildCommandResult
 {
     int num_of_files_compiled;       // Both successes and failures.
     int num_of_compilation_failures; // Number of files that failed to compile.
     int exit_status;
+    int num_of_files_up_to_date{}; // Source files whose object files were reused. Zero if the build stopped early.
 };
 
 namespace commands
@@ -0,0 +1,180 @@
+#include "source/commands/build/build_caching/analysis_cache.hpp"
+
+#include <format>
+#include <mutex>
+#include <unordered_map>
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+namespace
+{
+    // Configurations are built concurrently, so every table is guarded by a mutex.
+    // Values are computed outside the lock; two threads may compute the same value, but the results are equal.
+    template <typename Key, typename Value>
+    class Table
+    {
+      public:
+        template <typename F>
+        auto get(const Key& key, F&& compute) -> Value
+        {
+            {
+                std::lock_guard lock(mutex);
+
+                if (values.contains(key))
+                {
+                    statistics::add(statistics::Counter::ANALYSIS_CACHE_HITS);
+                    return values.at(key);
+                }
+            }
+
+            statistics::add(statistics::Counter::ANALYSIS_CACHE_MISSES);
+            auto value = compute();
+
+            {
+                std::lock_guard lock(mutex);
+                values.try_emplace(key, value);
+            }
+
+            return value;
+        }
+
+        auto clear() -> void
+        {
+            std::lock_guard lock(mutex);
+            values.clear();
+        }
+
+      private:
+        std::mutex mutex;
+        std::unordered_map<Key, Value> values;
+    };
+
+    struct Cache
+    {
+        bool is_active = false;
+        Table<std::filesystem::path, std::vector<std::filesystem::path>> directories;
+        Table<std::filesystem::path, std::uint64_t> file_hashes;
+        Table<std::filesystem::path, std::vector<std::filesystem::path>> included_files;
+        Table<std::string, std::optional<std::filesystem::path>> resolved_includes;
+    };
+}
+
+static auto get_cache() -> Cache&
+{
+    static Cache cache;
+
+    return cache;
+}
+
+analysis_cache::Scope::Scope()
+{
+    ASSERT(!get_cache().is_active); // Scopes do not nest.
+    get_cache().is_active = true;
+}
+
+analysis_cache::Scope::~Scope()
+{
+    auto& cache     = get_cache();
+    cache.is_active = false;
+    cache.directories.clear();
+    cache.file_hashes.clear();
+    cache.included_files.clear();
+    cache.resolved_includes.clear();
+}
+
+static auto walk_directory(const std::filesystem::path& path_to_root,
+                           const std::filesystem::path& directory) -> std::vector<std::filesystem::path>
+{
+    std::vector<std::filesystem::path> code_files;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(path_to_root / directory))
+    {
+        statistics::add(statistics::Counter::FILES_LISTED);
+
+        if (entry.is_regular_file() && utils::is_code_file(entry))
+        {
+            auto relative_path = std::filesystem::relative(entry, path_to_root);
+
+            // Skip files that easy-make generated itself, such as unity build sources.
+            if (*relative_path.begin() != params::BUILD_DIRECTORY_NAME)
+            {
+                code_files.push_back(std::move(relative_path));
+            }
+        }
+    }
+
+    return code_files;
+}
+
+auto analysis_cache::get_code_files_in_directory(const std::filesystem::path& path_to_root,
+                                                 const std::filesystem::path& directory)
+    -> std::vector<std::filesystem::path>
+{
+    auto& cache = get_cache();
+
+    if (!cache.is_active)
+    {
+        return walk_directory(path_to_root, directory);
+    }
+
+    return cache.directories.get((path_to_root / directory).lexically_normal(),
+                                 [&] { return walk_directory(path_to_root, directory); });
+}
+
+auto analysis_cache::hash_file_contents(const std::filesystem::path& path, std::string& buffer) -> std::uint64_t
+{
+    auto& cache = get_cache();
+
+    if (!cache.is_active)
+    {
+        return build_caching::hash_file_contents(path, buffer);
+    }
+
+    return cache.file_hashes.get(path, [&] { return build_caching::hash_file_contents(path, buffer); });
+}
+
+auto analysis_cache::get_included_files(const std::filesystem::path& path) -> std::vector<std::filesystem::path>
+{
+    auto& cache = get_cache();
+
+    if (!cache.is_active)
+    {
+        return build_caching::get_included_files(path);
+    }
+
+    return cache.included_files.get(path, [&] { return build_caching::get_included_files(path); });
+}
+
+auto analysis_cache::resolve_include(const std::filesystem::path& include_path,
+                                     const std::filesystem::path& including_file,
+                                     const std::filesystem::path& path_to_root,
+                                     const std::vector<std::string>& include_directories)
+    -> std::optional<std::filesystem::path>
+{
+    auto& cache = get_cache();
+
+    if (!cache.is_active)
+    {
+        return build_caching::resolve_include(include_path, including_file, path_to_root, include_directories);
+    }
+
+    // The result only depends on the directory of the including file, not on the file itself.
+    auto key = std::format(
+        "{}\n{}\n{}", path_to_root.native(), including_file.parent_path().native(), include_path.native());
+
+    for (const auto& include_directory : include_directories)
+    {
+        key += '\n';
+        key += include_directory;
+    }
+
+    const auto resolve = [&]
+    { return build_caching::resolve_include(include_path, including_file, path_to_root, include_directories); };
+
+    return cache.resolved_includes.get(key, resolve);
+}
@@ -0,0 +1,42 @@
+#ifndef SOURCE_BUILD_CACHING_ANALYSIS_CACHE_HPP
+#define SOURCE_BUILD_CACHING_ANALYSIS_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Results of walking directories, hashing files and scanning includes, shared by every configuration
+// that is processed during one invocation of a command.
+// The cache is only active while an `analysis_cache::Scope` exists; otherwise every call is computed directly.
+// Files are assumed not to change while the scope exists.
+namespace analysis_cache
+{
+    class Scope
+    {
+      public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&)                    = delete;
+        auto operator=(const Scope&) -> Scope& = delete;
+    };
+
+    // Code files in `directory` and its subdirectories, relative to `path_to_root`.
+    // Files that easy-make generated itself are skipped.
+    auto get_code_files_in_directory(const std::filesystem::path& path_to_root,
+                                     const std::filesystem::path& directory) -> std::vector<std::filesystem::path>;
+
+    auto hash_file_contents(const std::filesystem::path& path, std::string& buffer) -> std::uint64_t;
+
+    auto get_included_files(const std::filesystem::path& path) -> std::vector<std::filesystem::path>;
+
+    // Resolutions are shared between configurations with the same include directories.
+    auto resolve_include(const std::filesystem::path& include_path,
+                         const std::filesystem::path& including_file,
+                         const std::filesystem::path& path_to_root,
+                         const std::vector<std::string>& include_directories) -> std::optional<std::filesystem::path>;
+}
+
+#endif // SOURCE_BUILD_CACHING_ANALYSIS_CACHE_HPP
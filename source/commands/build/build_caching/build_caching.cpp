@@ -4,25 +4,30 @@
 #include <format>
 #include <fstream>
 #include <iterator> // std::istreambuf_iterator, std::make_move_iterator
-#include <print>
+#include <mutex>
 #include <ranges>
 #include <set>
 #include <stdexcept>
+#include <system_error> // std::error_code
 
 #include "third_party/nlohmann/json.hpp"
 
+#include "source/commands/build/build_caching/analysis_cache.hpp"
 #include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/configuration_parsing/json_keys.hpp"
 #include "source/parameters/parameters.hpp"
 #include "source/utils/graph.hpp"
 #include "source/utils/macros/assert.hpp"
 #include "source/utils/utils.hpp"
+#include "source/utils/work_stealing_pool.hpp"
 
 using build_caching::DependencyGraph;
 
-static const auto FNV_OFFSET_BASIS = 1'469'598'103'934'665'603ULL;
-
 // Hashes `s` using the FNV hash function.
-static auto hash_string(const std::string_view s, const std::uint64_t initial_value) -> std::uint64_t
+auto build_caching::hash_string(const std::string_view s, const std::uint64_t initial_value) -> std::uint64_t
 {
     const auto FNV_PRIME = 1'099'511'628'211ULL;
     auto result          = initial_value;
@@ -51,9 +56,44 @@ auto build_caching::hash_file_contents(const std::filesystem::path& path, std::s
     buffer.resize(file_size);
     file.read(buffer.data(), file_size);
 
+    statistics::add(statistics::Counter::FILES_HASHED);
+    statistics::add(statistics::Counter::STAT_CALLS);
+    statistics::add(statistics::Counter::BYTES_READ, static_cast<std::int64_t>(file_size));
+
     return hash_string(buffer, FNV_OFFSET_BASIS);
 }
 
+// Hashes the profile file, or every file in the profile directory.
+static auto hash_profile(const std::filesystem::path& profile, std::uint64_t result) -> std::uint64_t
+{
+    std::vector<std::filesystem::path> profile_files;
+    std::error_code error_code;
+
+    if (std::filesystem::is_directory(profile, error_code))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(profile, error_code))
+        {
+            profile_files.push_back(entry.path());
+        }
+
+        std::ranges::sort(profile_files); // The iteration order is unspecified.
+    }
+    else if (std::filesystem::is_regular_file(profile, error_code))
+    {
+        profile_files.push_back(profile);
+    }
+
+    std::string buffer;
+
+    for (const auto& profile_file : profile_files)
+    {
+        result = build_caching::hash_string(profile_file.filename().native(), result);
+        result ^= build_caching::hash_file_contents(profile_file, buffer);
+    }
+
+    return result;
+}
+
 /// @brief  Hashes the critical fields in a configuration.
 /// @param  configuration contents to hash.
 /// @return An integer hash value.
@@ -78,6 +118,26 @@ auto build_caching::hash_configuration(const Configuration& configuration) -> st
         result = hash_string(*configuration.optimization, result);
     }
 
+    if (configuration.debug_info.has_value())
+    {
+        result = hash_string(*configuration.debug_info, result);
+    }
+
+    if (configuration.lto.has_value())
+    {
+        result = hash_string(*configuration.lto, result);
+    }
+
+    // Only shared libraries, and the libraries they depend on, are compiled differently.
+    if (configuration.type == "shared")
+    {
+        result = hash_string(*configuration.type, result);
+    }
+    else if (configuration.position_independent_code.value_or(false))
+    {
+        result = hash_string("positionIndependentCode", result);
+    }
+
     if (configuration.warnings.has_value())
     {
         for (const auto& warning : *configuration.warnings)
@@ -102,9 +162,124 @@ auto build_caching::hash_configuration(const Configuration& configuration) -> st
         }
     }
 
+    // Only hashed when enabled, so that existing configurations keep their hash.
+    if (configuration.precompiled_headers.value_or(false))
+    {
+        result = hash_string("precompiledHeaders", result);
+    }
+
+    // Switching unity builds on or off changes which object files exist, so everything is recompiled.
+    if (configuration.unity.value_or(false))
+    {
+        result = hash_string("unity", result);
+    }
+
+    // The profile is an input of every translation unit, so recording a new one recompiles everything.
+    if (configuration.profile.has_value())
+    {
+        result = hash_string(*configuration.profile, result);
+        result = hash_profile(*configuration.profile, result);
+    }
+
+    return result;
+}
+
+// Hashes the same fields as `hash_configuration`, each on its own, so that a rebuild can name the field that changed.
+auto build_caching::hash_configuration_fields(const Configuration& configuration) -> ConfigurationFieldHashes
+{
+    using json_keys::JsonKey;
+
+    ConfigurationFieldHashes result;
+
+    const auto add_field = [&](const JsonKey key, const std::optional<std::string>& value)
+    {
+        if (value.has_value())
+        {
+            result[json_keys::key_to_string(key)] = hash_string(*value);
+        }
+    };
+
+    const auto add_list_field = [&](const JsonKey key, const std::optional<std::vector<std::string>>& values)
+    {
+        // An empty list is hashed like a missing one.
+        if (values.has_value() && !values->empty())
+        {
+            auto hash = FNV_OFFSET_BASIS;
+
+            for (const auto& value : *values)
+            {
+                hash = hash_string(value, hash);
+            }
+
+            result[json_keys::key_to_string(key)] = hash;
+        }
+    };
+
+    add_field(JsonKey::Compiler, configuration.compiler);
+    add_field(JsonKey::Standard, configuration.standard);
+    add_field(JsonKey::Optimization, configuration.optimization);
+    add_field(JsonKey::DebugInfo, configuration.debug_info);
+    add_field(JsonKey::Lto, configuration.lto);
+    add_list_field(JsonKey::Warnings, configuration.warnings);
+    add_list_field(JsonKey::Defines, configuration.defines);
+    add_list_field(JsonKey::IncludeDirectories, configuration.include_directories);
+
+    if (configuration.type == "shared")
+    {
+        add_field(JsonKey::Type, configuration.type);
+    }
+    else if (configuration.position_independent_code.value_or(false))
+    {
+        // Set by the build when a shared library starts or stops depending on the configuration.
+        result["positionIndependentCode"] = hash_string("positionIndependentCode");
+    }
+
+    if (configuration.precompiled_headers.value_or(false))
+    {
+        result[json_keys::key_to_string(JsonKey::PrecompiledHeaders)] = hash_string("precompiledHeaders");
+    }
+
+    if (configuration.unity.value_or(false))
+    {
+        result[json_keys::key_to_string(JsonKey::Unity)] = hash_string("unity");
+    }
+
+    // The profile is recorded by `easy-make pgo` rather than written in the configurations file.
+    if (configuration.profile.has_value())
+    {
+        result["profile"] = hash_profile(*configuration.profile, hash_string(*configuration.profile));
+    }
+
     return result;
 }
 
+auto build_caching::get_changed_configuration_fields(const ConfigurationFieldHashes& old_field_hashes,
+                                                     const ConfigurationFieldHashes& new_field_hashes)
+    -> std::vector<std::string>
+{
+    std::set<std::string> changed_fields;
+
+    for (const auto& [field, hash] : old_field_hashes)
+    {
+        const auto new_hash = new_field_hashes.find(field);
+
+        if (new_hash == new_field_hashes.end() || new_hash->second != hash)
+        {
+            changed_fields.insert(field);
+        }
+    }
+
+    for (const auto& field : new_field_hashes | std::views::keys)
+    {
+        if (!old_field_hashes.contains(field))
+        {
+            changed_fields.insert(field);
+        }
+    }
+
+    return changed_fields | std::ranges::to<std::vector>();
+}
+
 auto build_caching::get_old_file_hashes(const std::string_view configuration_name,
                                         const std::filesystem::path& path_to_root)
     -> std::unordered_map<std::filesystem::path, std::uint64_t>
@@ -159,7 +334,7 @@ auto build_caching::get_old_configuration_hash(const std::string_view configurat
 
     if (!data_file.is_open())
     {
-        std::println("Failed to open '{}'.", hash_data_file_path.native());
+        events::report_error(std::format("Failed to open '{}'.", hash_data_file_path.native()));
 
         return DEFAULT_VALUE;
     }
@@ -172,7 +347,8 @@ auto build_caching::get_old_configuration_hash(const std::string_view configurat
     }
     catch (const nlohmann::json::parse_error& e)
     {
-        std::println("Error: Invalid JSON in '{}' - {}", params::CONFIGURATIONS_FILE_NAME.native(), e.what());
+        events::report_error(
+            std::format("Error: Invalid JSON in '{}' - {}", params::CONFIGURATIONS_FILE_NAME.native(), e.what()));
 
         return DEFAULT_VALUE;
     }
@@ -183,6 +359,40 @@ auto build_caching::get_old_configuration_hash(const std::string_view configurat
     return json["hash"].get<std::uint64_t>();
 }
 
+auto build_caching::get_old_configuration_field_hashes(const std::string_view configuration_name,
+                                                       const std::filesystem::path& path_to_root)
+    -> ConfigurationFieldHashes
+{
+    const auto hash_data_file_path =
+        path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::CONFIGURATION_HASH_DATA_FILE_NAME;
+
+    auto data_file = std::ifstream(hash_data_file_path);
+
+    if (!data_file.is_open())
+    {
+        return {};
+    }
+
+    nlohmann::json json;
+
+    try
+    {
+        data_file >> json;
+    }
+    catch (const nlohmann::json::parse_error&)
+    {
+        return {};
+    }
+
+    // Builds by older versions recorded only the combined hash.
+    if (!json.contains("fields"))
+    {
+        return {};
+    }
+
+    return json["fields"].get<ConfigurationFieldHashes>();
+}
+
 auto build_caching::get_old_dependency_graph(const std::string_view configuration_name,
                                              const std::filesystem::path& path_to_root) -> DependencyGraph
 {
@@ -222,20 +432,72 @@ auto build_caching::get_old_dependency_graph(const std::string_view configuratio
     return dependency_graph;
 }
 
-auto build_caching::get_new_file_hashes(const std::vector<std::filesystem::path>& code_files)
+auto build_caching::get_old_compilation_times(const std::string_view configuration_name,
+                                              const std::filesystem::path& path_to_root)
+    -> std::unordered_map<std::filesystem::path, double>
+{
+    const auto data_file_path =
+        path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::COMPILATION_TIMES_DATA_FILE_NAME;
+
+    if (!std::filesystem::is_regular_file(data_file_path))
+    {
+        return {};
+    }
+
+    auto data_file = std::ifstream(data_file_path);
+
+    if (!data_file.is_open())
+    {
+        return {};
+    }
+
+    nlohmann::json json;
+    data_file >> json;
+    ASSERT(json.is_object());
+
+    std::unordered_map<std::filesystem::path, double> compilation_times;
+
+    for (const auto& [file, seconds] : json.items())
+    {
+        ASSERT(seconds.is_number());
+        compilation_times[file] = seconds.get<double>();
+    }
+
+    return compilation_times;
+}
+
+auto build_caching::get_new_file_hashes(const std::vector<std::filesystem::path>& code_files,
+                                        const FileHashedCallback& on_file_hashed)
     -> std::unordered_map<std::filesystem::path, std::uint64_t>
 {
+    const trace::Span span("Hash files", "analysis", {{"files", std::ssize(code_files)}});
+
+    std::vector<std::uint64_t> hashes(code_files.size());
+    std::mutex callback_mutex;
+
+    utils::parallel_for(utils::get_shared_pool(),
+                        0,
+                        code_files.size(),
+                        [&](const std::size_t index)
+                        {
+                            // Using a buffer is only advantageous if its size never decreases,
+                            // so every thread keeps its own.
+                            thread_local std::string buffer;
+                            hashes[index] = analysis_cache::hash_file_contents(code_files[index], buffer);
+
+                            if (on_file_hashed)
+                            {
+                                std::lock_guard lock(callback_mutex);
+                                on_file_hashed(code_files[index], hashes[index]);
+                            }
+                        });
+
     std::unordered_map<std::filesystem::path, std::uint64_t> file_hashes;
-    std::string buffer;
-    [[maybe_unused]] auto previous_capacity = buffer.capacity();
+    file_hashes.reserve(code_files.size());
 
-    for (const auto& file : code_files)
+    for (auto index = 0UZ; index < code_files.size(); ++index)
     {
-        file_hashes[file] = hash_file_contents(file, buffer);
-
-        // Using a buffer is only advantageous if its size never decreases.
-        ASSERT(previous_capacity <= buffer.capacity());
-        previous_capacity = buffer.capacity();
+        file_hashes[code_files[index]] = hashes[index];
     }
 
     return file_hashes;
@@ -258,24 +520,39 @@ auto build_caching::get_files_to_delete(const std::unordered_map<std::filesystem
     return files_to_delete;
 }
 
+static auto is_changed_file(const std::string_view configuration_name,
+                            const std::filesystem::path& path_to_root,
+                            const std::unordered_map<std::filesystem::path, std::uint64_t>& old_file_hashes,
+                            const build_caching::TranslationUnits& translation_units,
+                            const std::filesystem::path& file,
+                            const std::uint64_t contents_hash) -> bool
+{
+    const auto& translation_unit = translation_units.contains(file) ? translation_units.at(file) : file;
+    const auto object_file_path  = path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name /
+                                  utils::get_object_file_name(translation_unit);
+
+    if (old_file_hashes.contains(file))
+    {
+        statistics::add(statistics::Counter::STAT_CALLS);
+    }
+
+    const auto old_object_file_exists = old_file_hashes.contains(file) && std::filesystem::exists(object_file_path);
+    const auto file_contents_changed  = old_file_hashes.contains(file) && (old_file_hashes.at(file) != contents_hash);
+
+    return (utils::is_source_file(file) && !old_object_file_exists) || file_contents_changed;
+}
+
 auto build_caching::get_changed_files(std::string_view configuration_name,
                                       const std::filesystem::path& path_to_root,
                                       const std::unordered_map<std::filesystem::path, std::uint64_t>& old_file_hashes,
-                                      const std::unordered_map<std::filesystem::path, std::uint64_t>& new_file_hashes)
-    -> std::vector<std::filesystem::path>
+                                      const std::unordered_map<std::filesystem::path, std::uint64_t>& new_file_hashes,
+                                      const TranslationUnits& translation_units) -> std::vector<std::filesystem::path>
 {
     std::vector<std::filesystem::path> changed_files;
 
     for (const auto& [file, contents_hash] : new_file_hashes)
     {
-        const auto object_file_path =
-            path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / utils::get_object_file_name(file);
-
-        const auto old_object_file_exists = old_file_hashes.contains(file) && std::filesystem::exists(object_file_path);
-        const auto file_contents_changed =
-            old_file_hashes.contains(file) && (old_file_hashes.at(file) != contents_hash);
-
-        if ((utils::is_source_file(file) && !old_object_file_exists) || file_contents_changed)
+        if (is_changed_file(configuration_name, path_to_root, old_file_hashes, translation_units, file, contents_hash))
         {
             changed_files.push_back(file);
         }
@@ -370,7 +647,8 @@ auto build_caching::write_to_build_data_file(const std::string_view configuratio
 
 auto build_caching::write_to_configuration_hash_data_file(const std::string_view configuration_name,
                                                           const std::filesystem::path& path_to_root,
-                                                          const uint64_t value) -> void
+                                                          const uint64_t value,
+                                                          const ConfigurationFieldHashes& field_hashes) -> void
 {
     std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name);
 
@@ -385,7 +663,8 @@ auto build_caching::write_to_configuration_hash_data_file(const std::string_view
     }
 
     auto json = nlohmann::json{
-        {"hash", value}
+        {"hash",   value       },
+        {"fields", field_hashes}
     };
 
     data_file << json.dump();
@@ -431,6 +710,33 @@ auto build_caching::write_to_dependency_graph_data_file(const std::string_view c
     }
 }
 
+auto build_caching::write_to_compilation_times_data_file(
+    const std::string_view configuration_name,
+    const std::filesystem::path& path_to_root,
+    const std::unordered_map<std::filesystem::path, double>& times) -> void
+{
+    std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name);
+
+    const auto data_file_path =
+        path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::COMPILATION_TIMES_DATA_FILE_NAME;
+
+    auto data_file = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    auto json = nlohmann::json::object();
+
+    for (const auto& [file, seconds] : times)
+    {
+        json[file.native()] = seconds;
+    }
+
+    data_file << json.dump(); // Write to file.
+}
+
 static auto create_circular_dependencies_error_message(const std::string_view cycle) -> std::string
 {
     return std::format("Error: Circular header dependency detected.\n\n"
@@ -442,24 +748,48 @@ static auto create_circular_dependencies_error_message(const std::string_view cy
 
 auto build_caching::handle_build_caching(const Configuration& configuration,
                                          const std::filesystem::path& path_to_root,
-                                         const std::vector<std::filesystem::path>& code_files)
-    -> std::expected<Info, std::string>
+                                         const std::vector<std::filesystem::path>& code_files,
+                                         const TranslationUnits& translation_units,
+                                         const OutdatedFileCallback& on_outdated_source_file,
+                                         const bool is_dry_run) -> std::expected<Info, std::string>
 {
     ASSERT(configuration.name.has_value());
 
     // Gather information about the previous state.
-    const auto old_file_hashes        = get_old_file_hashes(*configuration.name, path_to_root);
+    auto old_file_hashes              = get_old_file_hashes(*configuration.name, path_to_root);
     const auto old_configuration_hash = get_old_configuration_hash(*configuration.name, path_to_root);
-    const auto old_dependency_graph   = get_old_dependency_graph(*configuration.name, path_to_root);
+    const auto old_field_hashes       = get_old_configuration_field_hashes(*configuration.name, path_to_root);
+    auto old_dependency_graph         = get_old_dependency_graph(*configuration.name, path_to_root);
+    const auto new_configuration_hash = hash_configuration(configuration);
+    const auto new_field_hashes       = hash_configuration_fields(configuration);
+
+    // A source file whose own contents changed is outdated regardless of what it includes,
+    // so it is reported while the rest of the project is still being hashed and scanned.
+    const auto on_file_hashed = [&](const std::filesystem::path& file, const std::uint64_t contents_hash)
+    {
+        const auto is_outdated =
+            old_configuration_hash != new_configuration_hash ||
+            is_changed_file(*configuration.name, path_to_root, old_file_hashes, translation_units, file, contents_hash);
+
+        if (utils::is_source_file(file) && is_outdated)
+        {
+            on_outdated_source_file(file);
+        }
+    };
 
     // Gather information about the current state.
-    const auto new_file_hashes        = get_new_file_hashes(code_files);
-    const auto new_configuration_hash = hash_configuration(configuration);
+    const auto new_file_hashes =
+        get_new_file_hashes(code_files, on_outdated_source_file ? FileHashedCallback(on_file_hashed) : nullptr);
     const auto new_dependency_graph =
         get_dependency_graph(path_to_root, code_files, configuration.include_directories.value_or({}));
 
     // Make sure new state does not contain any circular includes.
-    const auto cycle_in_new_dependency_graph = new_dependency_graph.check_for_cycle();
+    const auto cycle_in_new_dependency_graph = [&]
+    {
+        const trace::Span span("Check for cycles", "analysis", {{"configuration", *configuration.name}});
+
+        return new_dependency_graph.check_for_cycle();
+    }();
     const auto detected_cycle                = cycle_in_new_dependency_graph.has_value();
 
     if (detected_cycle)
@@ -468,11 +798,17 @@ auto build_caching::handle_build_caching(const Configuration& configuration,
     }
 
     // Update data files.
-    write_to_build_data_file(*configuration.name, path_to_root, new_file_hashes);
-    write_to_configuration_hash_data_file(*configuration.name, path_to_root, new_configuration_hash);
-    write_to_dependency_graph_data_file(*configuration.name, path_to_root, new_dependency_graph);
+    if (!is_dry_run)
+    {
+        write_to_build_data_file(*configuration.name, path_to_root, new_file_hashes);
+        write_to_configuration_hash_data_file(
+            *configuration.name, path_to_root, new_configuration_hash, new_field_hashes);
+        write_to_dependency_graph_data_file(*configuration.name, path_to_root, new_dependency_graph);
+    }
 
     const auto files_to_delete = get_files_to_delete(old_file_hashes, new_file_hashes);
+    auto changed_files =
+        get_changed_files(*configuration.name, path_to_root, old_file_hashes, new_file_hashes, translation_units);
 
     // Decide which files to compile.
     // If some critical change happened to the configuration (e.g different optimization level or warning),
@@ -482,17 +818,32 @@ auto build_caching::handle_build_caching(const Configuration& configuration,
     if (detected_critical_changes_to_configuration)
     {
         return Info{
-            .files_to_delete  = files_to_delete,
-            .files_to_compile = sanitize_code_files(code_files), // Compile all the source files.
+            .files_to_delete              = files_to_delete,
+            .files_to_compile             = sanitize_code_files(code_files), // Compile all the source files.
+            .changed_files                = std::move(changed_files),
+            .file_hashes                  = new_file_hashes,
+            .dependency_graph             = new_dependency_graph,
+            .old_file_hashes              = std::move(old_file_hashes),
+            .old_dependency_graph         = std::move(old_dependency_graph),
+            .is_first_build               = old_configuration_hash == 0,
+            .configuration_changed        = true,
+            .changed_configuration_fields = get_changed_configuration_fields(old_field_hashes, new_field_hashes),
         };
     };
 
     // The configuration did not change meaningfully; compile only files affected by changes and removals.
-    const auto changed_files = get_changed_files(*configuration.name, path_to_root, old_file_hashes, new_file_hashes);
-    const auto files_to_compile = get_files_to_compile(old_dependency_graph, new_dependency_graph, changed_files);
+    auto files_to_compile = get_files_to_compile(old_dependency_graph, new_dependency_graph, changed_files);
 
     return Info{
-        .files_to_delete  = files_to_delete,
-        .files_to_compile = files_to_compile,
+        .files_to_delete              = files_to_delete,
+        .files_to_compile             = std::move(files_to_compile),
+        .changed_files                = std::move(changed_files),
+        .file_hashes                  = new_file_hashes,
+        .dependency_graph             = new_dependency_graph,
+        .old_file_hashes              = std::move(old_file_hashes),
+        .old_dependency_graph         = std::move(old_dependency_graph),
+        .is_first_build               = false,
+        .configuration_changed        = false,
+        .changed_configuration_fields = {},
     };
 }
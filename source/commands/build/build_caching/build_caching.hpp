@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <functional>
+#include <map>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -18,33 +20,70 @@ namespace build_caching
     {
         std::vector<std::filesystem::path> files_to_delete;
         std::vector<std::filesystem::path> files_to_compile;
+        std::vector<std::filesystem::path> changed_files;                     // Files whose contents changed.
+        std::unordered_map<std::filesystem::path, std::uint64_t> file_hashes; // Current hash of every code file.
+        DependencyGraph dependency_graph;                                     // Current include graph.
+
+        // The state recorded by the previous build, used to explain why files are compiled.
+        std::unordered_map<std::filesystem::path, std::uint64_t> old_file_hashes;
+        DependencyGraph old_dependency_graph;
+        bool is_first_build;                                   // No configuration hash was recorded.
+        bool configuration_changed;                            // A critical field of the configuration changed.
+        std::vector<std::string> changed_configuration_fields; // Empty if the fields were not recorded.
     };
 
+    inline constexpr auto FNV_OFFSET_BASIS = 1'469'598'103'934'665'603ULL;
+
+    auto hash_string(std::string_view s, std::uint64_t initial_value = FNV_OFFSET_BASIS) -> std::uint64_t;
+
     auto hash_file_contents(const std::filesystem::path& path, std::string& buffer) -> std::uint64_t;
 
     auto hash_configuration(const Configuration& configuration) -> std::uint64_t;
 
+    // Maps every critical field that is set to its hash, by its name in the configurations file.
+    using ConfigurationFieldHashes = std::map<std::string, std::uint64_t>;
+
+    auto hash_configuration_fields(const Configuration& configuration) -> ConfigurationFieldHashes;
+
+    auto get_changed_configuration_fields(const ConfigurationFieldHashes& old_field_hashes,
+                                          const ConfigurationFieldHashes& new_field_hashes)
+        -> std::vector<std::string>;
+
     auto get_old_file_hashes(std::string_view configuration_name, const std::filesystem::path& path_to_root)
         -> std::unordered_map<std::filesystem::path, std::uint64_t>;
 
     auto get_old_configuration_hash(std::string_view configuration_name,
                                     const std::filesystem::path& path_to_root) -> std::uint64_t;
 
+    auto get_old_configuration_field_hashes(std::string_view configuration_name,
+                                            const std::filesystem::path& path_to_root) -> ConfigurationFieldHashes;
+
     auto get_old_dependency_graph(std::string_view configuration_name,
                                   const std::filesystem::path& path_to_root) -> DependencyGraph;
 
-    auto get_new_file_hashes(const std::vector<std::filesystem::path>& code_files)
+    auto get_old_compilation_times(std::string_view configuration_name, const std::filesystem::path& path_to_root)
+        -> std::unordered_map<std::filesystem::path, double>;
+
+    // Called with every file right after it is hashed. Files are hashed in parallel, so the order is unspecified,
+    // but the calls never overlap.
+    using FileHashedCallback = std::function<void(const std::filesystem::path&, std::uint64_t)>;
+
+    auto get_new_file_hashes(const std::vector<std::filesystem::path>& code_files,
+                             const FileHashedCallback& on_file_hashed = {})
         -> std::unordered_map<std::filesystem::path, std::uint64_t>;
 
     auto get_files_to_delete(const std::unordered_map<std::filesystem::path, std::uint64_t>& old_file_hashes,
                              const std::unordered_map<std::filesystem::path, std::uint64_t>& new_file_hashes)
         -> std::vector<std::filesystem::path>;
 
+    // Maps a source file to the translation unit it is compiled in, if that is not the file itself.
+    using TranslationUnits = std::unordered_map<std::filesystem::path, std::filesystem::path>;
+
     auto get_changed_files(std::string_view configuration_name,
                            const std::filesystem::path& path_to_root,
                            const std::unordered_map<std::filesystem::path, std::uint64_t>& old_file_hashes,
-                           const std::unordered_map<std::filesystem::path, std::uint64_t>& new_file_hashes)
-        -> std::vector<std::filesystem::path>;
+                           const std::unordered_map<std::filesystem::path, std::uint64_t>& new_file_hashes,
+                           const TranslationUnits& translation_units = {}) -> std::vector<std::filesystem::path>;
 
     auto
     get_files_to_compile(const DependencyGraph& old_dependency_graph,
@@ -57,15 +96,28 @@ namespace build_caching
 
     auto write_to_configuration_hash_data_file(std::string_view configuration_name,
                                                const std::filesystem::path& path_to_root,
-                                               std::uint64_t value) -> void;
+                                               std::uint64_t value,
+                                               const ConfigurationFieldHashes& field_hashes = {}) -> void;
 
     auto write_to_dependency_graph_data_file(std::string_view configuration_name,
                                              const std::filesystem::path& path_to_root,
                                              const DependencyGraph& graph) -> void;
 
+    auto write_to_compilation_times_data_file(std::string_view configuration_name,
+                                              const std::filesystem::path& path_to_root,
+                                              const std::unordered_map<std::filesystem::path, double>& times) -> void;
+
+    // Called with every source file that is known to be outdated before the dependency graph is built.
+    using OutdatedFileCallback = std::function<void(const std::filesystem::path&)>;
+
+    // A dry run decides which files to compile without updating the data files.
     auto handle_build_caching(const Configuration& configuration,
                               const std::filesystem::path& path_to_root,
-                              const std::vector<std::filesystem::path>& code_files) -> std::expected<Info, std::string>;
+                              const std::vector<std::filesystem::path>& code_files,
+                              const TranslationUnits& translation_units           = {},
+                              const OutdatedFileCallback& on_outdated_source_file = {},
+                              bool is_dry_run                                     = false)
+        -> std::expected<Info, std::string>;
 }
 
 #endif // SOURCE_BUILD_CACHING_BUILD_CACHING_HPP
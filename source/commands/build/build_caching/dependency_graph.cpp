@@ -4,13 +4,21 @@
 #include <regex>
 #include <vector>
 
+#include "source/commands/build/build_caching/analysis_cache.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/utils/work_stealing_pool.hpp"
+
 auto build_caching::get_included_files(const std::filesystem::path& path) -> std::vector<std::filesystem::path>
 {
+    statistics::add(statistics::Counter::STAT_CALLS);
+
     if (!std::filesystem::exists(path))
     {
         return {};
     }
 
+    statistics::add(statistics::Counter::FILES_SCANNED);
     std::ifstream file(path);
 
     if (!file.is_open())
@@ -18,19 +26,25 @@ auto build_caching::get_included_files(const std::filesystem::path& path) -> std
         return {};
     }
 
-    const std::regex include_regex(R"(^\s*#\s*include\s*\"([^\"]+)\")");
+    // Imported header units (`import "foo.hpp";`) are tracked like includes.
+    const std::regex include_regex(R"(^\s*(?:#\s*include|(?:export\s+)?import)\s*\"([^\"]+)\")");
     std::string line;
     std::smatch match;
     std::vector<std::filesystem::path> includes;
+    auto bytes_read = 0Z;
 
     while (std::getline(file, line))
     {
+        bytes_read += std::ssize(line) + 1; // Including the newline.
+
         if (std::regex_search(line, match, include_regex))
         {
             includes.push_back(match[1].str());
         }
     }
 
+    statistics::add(statistics::Counter::BYTES_READ, bytes_read);
+
     return includes;
 }
 
@@ -40,8 +54,14 @@ auto build_caching::resolve_include(const std::filesystem::path& include_path,
                                     const std::vector<std::string>& include_directories)
     -> std::optional<std::filesystem::path>
 {
+    statistics::add(statistics::Counter::INCLUDE_RESOLUTIONS);
+
     const auto is_valid_file = [](const std::filesystem::path& p)
-    { return std::filesystem::exists(p) && std::filesystem::is_regular_file(p); };
+    {
+        statistics::add(statistics::Counter::STAT_CALLS);
+
+        return std::filesystem::exists(p) && std::filesystem::is_regular_file(p);
+    };
 
     const auto including_file_directory = including_file.parent_path();
 
@@ -66,23 +86,41 @@ auto build_caching::get_dependency_graph(const std::filesystem::path& path_to_ro
                                          const std::vector<std::filesystem::path>& code_files,
                                          const std::vector<std::string>& include_directories) -> DependencyGraph
 {
+    const trace::Span span("Scan includes", "analysis", {{"files", std::ssize(code_files)}});
+
+    // Files are scanned in parallel, and the graph is built from the results in the order of `code_files`.
+    std::vector<std::vector<std::filesystem::path>> resolved_includes(code_files.size());
+
+    utils::parallel_for(utils::get_shared_pool(),
+                        0,
+                        code_files.size(),
+                        [&](const std::size_t index)
+                        {
+                            const auto& file = code_files[index];
+
+                            for (const auto& include : analysis_cache::get_included_files(path_to_root / file))
+                            {
+                                auto actual_include =
+                                    analysis_cache::resolve_include(include, file, path_to_root, include_directories);
+
+                                if (actual_include.has_value())
+                                {
+                                    resolved_includes[index].push_back(std::move(*actual_include));
+                                }
+                            }
+                        });
+
     DependencyGraph graph;
 
     // There is an edge from file `f_1` to `f_2` if `f_2` includes `f_1`.
     // This way if `f_2` changes we can check for all the files that are
     // reachable from it and see that `f_1` also requires recompilation.
 
-    for (const auto& file : code_files)
+    for (auto index = 0UZ; index < code_files.size(); ++index)
     {
-        for (const auto& include : get_included_files(path_to_root / file))
+        for (const auto& include : resolved_includes[index])
         {
-            const auto actual_include = resolve_include(include, file, path_to_root, include_directories);
-            const auto include_resolved_successfully = actual_include.has_value();
-
-            if (include_resolved_successfully)
-            {
-                graph.add_edge(*actual_include, file);
-            }
+            graph.add_edge(include, code_files[index]);
         }
     }
 
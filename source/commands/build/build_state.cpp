@@ -0,0 +1,101 @@
+#include "source/commands/build/build_state.hpp"
+
+#include <format>
+#include <fstream>
+#include <print>
+#include <ranges>
+#include <stdexcept>
+
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+
+auto build_state::update_cooldowns(const bool previous_state_exists,
+                                   const Cooldowns& previous_cooldowns,
+                                   const std::vector<std::filesystem::path>& changed_files,
+                                   bool (*is_relevant)(const std::filesystem::path&)) -> Cooldowns
+{
+    Cooldowns cooldowns;
+
+    if (!previous_state_exists)
+    {
+        return cooldowns;
+    }
+
+    for (const auto& [file, num_of_builds] : previous_cooldowns)
+    {
+        if (num_of_builds > 1)
+        {
+            cooldowns[file] = num_of_builds - 1;
+        }
+    }
+
+    for (const auto& file : changed_files | std::views::filter(is_relevant))
+    {
+        cooldowns[file] = STABILITY_WINDOW;
+    }
+
+    return cooldowns;
+}
+
+auto build_state::get_data_file_path(const std::string_view configuration_name,
+                                     const std::filesystem::path& path_to_root,
+                                     const std::string_view file_name) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / file_name;
+}
+
+auto build_state::read_data_file(const std::filesystem::path& data_file_path) -> std::optional<nlohmann::json>
+{
+    if (!std::filesystem::is_regular_file(data_file_path))
+    {
+        return std::nullopt;
+    }
+
+    auto data_file = std::ifstream(data_file_path);
+
+    if (!data_file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    nlohmann::json json;
+    data_file >> json;
+    ASSERT(json.is_object());
+
+    return json;
+}
+
+auto build_state::write_data_file(const std::filesystem::path& data_file_path, const nlohmann::json& json) -> void
+{
+    std::filesystem::create_directories(data_file_path.parent_path());
+    auto data_file = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    data_file << json.dump(); // Write to file.
+}
+
+auto build_state::write_including_file(const std::filesystem::path& file_path,
+                                       const std::vector<std::filesystem::path>& files,
+                                       const std::filesystem::path& path_to_root) -> void
+{
+    std::filesystem::create_directories(file_path.parent_path());
+    auto file = std::ofstream(file_path, std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", file_path.native()));
+    }
+
+    std::println(file, "// Generated by easy-make. Do not edit.");
+
+    for (const auto& included_file : files)
+    {
+        // Absolute paths, since quoted includes are searched relative to the generated file first.
+        const auto absolute_path = std::filesystem::absolute(path_to_root / included_file).lexically_normal();
+        std::println(file, "#include \"{}\"", absolute_path.native());
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SOURCE_COMMANDS_BUILD_BUILD_STATE_HPP
+#define SOURCE_COMMANDS_BUILD_BUILD_STATE_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/nlohmann/json.hpp"
+
+// State that automatic build features (precompiled headers, unity builds) keep between builds,
+// and the source files they generate.
+namespace build_state
+{
+    // Number of builds a file is considered unstable after it changes.
+    // Features that rebuild many files whenever one of their inputs changes leave unstable files out.
+    inline constexpr auto STABILITY_WINDOW = 5;
+
+    using Cooldowns = std::unordered_map<std::filesystem::path, int>; // File -> number of builds left in cooldown.
+
+    // Ages the previous cooldowns and starts one for every changed file that `is_relevant` accepts.
+    // Without a previous state (a first build) every file counts as changed, so no cooldown is started.
+    auto update_cooldowns(bool previous_state_exists,
+                          const Cooldowns& previous_cooldowns,
+                          const std::vector<std::filesystem::path>& changed_files,
+                          bool (*is_relevant)(const std::filesystem::path&)) -> Cooldowns;
+
+    auto get_data_file_path(std::string_view configuration_name,
+                            const std::filesystem::path& path_to_root,
+                            std::string_view file_name) -> std::filesystem::path;
+
+    // Returns `std::nullopt` if the data file was not written yet.
+    auto read_data_file(const std::filesystem::path& data_file_path) -> std::optional<nlohmann::json>;
+
+    auto write_data_file(const std::filesystem::path& data_file_path, const nlohmann::json& json) -> void;
+
+    // Writes a source file that includes `files` (relative to `path_to_root`) in order.
+    auto write_including_file(const std::filesystem::path& file_path,
+                              const std::vector<std::filesystem::path>& files,
+                              const std::filesystem::path& path_to_root) -> void;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_BUILD_STATE_HPP
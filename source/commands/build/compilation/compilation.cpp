@@ -3,16 +3,24 @@
 #include <algorithm>
 #include <cstdlib>
 #include <format>
+#include <fstream>
 #include <future>
 #include <iterator> // std::istreambuf_iterator
+#include <mutex>
 #include <print>
 #include <ranges>
 #include <string>
 #include <string_view>
 #include <system_error> // std::error_code
 #include <thread>       // std::thread::hardware_concurrency
-
-#include "source/commands/build/compilation/thread_pool.hpp"
+#include <unordered_map>
+
+#include "source/commands/build/budgets.hpp"
+#include "source/commands/build/compile_time_analysis/compile_time_analysis.hpp"
+#include "source/commands/build/distributed/distributed.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/commands/build/trace.hpp"
 #include "source/parameters/parameters.hpp"
 #include "source/utils/macros/assert.hpp"
 #include "source/utils/print.hpp"
@@ -20,13 +28,36 @@
 
 namespace
 {
-    struct CompilationInfo
+    struct SharedObject
     {
         bool is_successful;
-        std::string compiler_output;
+        std::filesystem::path object_file_path;
+        double duration_in_seconds;
+        std::string compiler_output{};
+        int exit_code{};
+    };
+
+    // Object files compiled during this run, by their compilation command without the output path.
+    struct SharedObjects
+    {
+        struct Entry
+        {
+            std::string configuration_name; // Configuration that compiled the object file.
+            std::shared_future<SharedObject> object;
+        };
+
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
     };
 }
 
+static auto get_shared_objects() -> SharedObjects&
+{
+    static SharedObjects shared_objects;
+
+    return shared_objects;
+}
+
 static auto print_number_of_files_to_compile(const int number_of_files,
                                              const std::string_view configuration_name) -> void
 {
@@ -48,24 +79,16 @@ static auto print_number_of_files_to_compile(const int number_of_files,
     }
 }
 
-static auto remove_outdated_object_files(const std::filesystem::path& object_files_directory,
-                                         const std::vector<std::filesystem::path>& files_to_compile) -> void
+static auto remove_outdated_object_file(const std::filesystem::path& object_files_directory,
+                                        const std::filesystem::path& file_name) -> void
 {
-    if (!std::filesystem::is_directory(object_files_directory))
-    {
-        return;
-    }
+    std::error_code error;
+    utils::remove_object_file(object_files_directory, file_name, error);
 
-    for (const auto& file_name : files_to_compile)
+    if (error)
     {
-        const auto object_file_path = object_files_directory / utils::get_object_file_name(file_name);
-        std::error_code error;
-        std::filesystem::remove(object_file_path, error);
-
-        if (error)
-        {
-            std::println("Error: Failed to remove stale object file for '{}': {}", file_name.native(), error.message());
-        }
+        events::report_error(std::format(
+            "Error: Failed to remove stale object file for '{}': {}", file_name.native(), error.message()));
     }
 }
 
@@ -106,6 +129,53 @@ auto create_compilation_flags_string(const Configuration& configuration) -> std:
         }
     }
 
+    if (configuration.debug_info.has_value())
+    {
+        if (*configuration.debug_info == "none")
+        {
+            result += "-g0 ";
+        }
+        else if (*configuration.debug_info == "full")
+        {
+            result += "-g ";
+        }
+        else // The object file keeps only references to the debug info, which is written to a `.dwo` file.
+        {
+            result += "-g -gsplit-dwarf ";
+        }
+    }
+
+    // The object files hold the compiler's intermediate representation, which is optimized when linking.
+    // Only Clang has ThinLTO; GCC parallelizes its link-time optimization instead.
+    if (configuration.lto == "full" || (configuration.lto == "thin" && !configuration.compiler->contains("clang")))
+    {
+        result += "-flto ";
+    }
+    else if (configuration.lto == "thin")
+    {
+        result += "-flto=thin ";
+    }
+
+    // A profile recorded before the sources changed is still useful, so its staleness is not reported.
+    if (configuration.profile.has_value() && configuration.compiler->contains("clang"))
+    {
+        std::format_to(std::back_inserter(result),
+                       "-fprofile-use={} -Wno-profile-instr-out-of-date -Wno-profile-instr-unprofiled ",
+                       *configuration.profile);
+    }
+    else if (configuration.profile.has_value()) // Code that the training did not run is optimized as usual.
+    {
+        std::format_to(std::back_inserter(result),
+                       "-fprofile-use={} -fprofile-partial-training -Wno-missing-profile -Wno-coverage-mismatch ",
+                       *configuration.profile);
+    }
+
+    // A shared library is loaded at an arbitrary address, and so are the libraries linked into it.
+    if (configuration.type == "shared" || configuration.position_independent_code.value_or(false))
+    {
+        result += "-fPIC ";
+    }
+
     if (configuration.defines.has_value())
     {
         for (const auto& define : *configuration.defines)
@@ -130,16 +200,53 @@ auto create_compilation_flags_string(const Configuration& configuration) -> std:
     return result;
 }
 
-static auto compile_file(const std::filesystem::path& file_name,
-                         const std::filesystem::path& object_files_directory,
+auto create_compilation_flags_string(const Configuration& configuration,
+                                     const std::filesystem::path& precompiled_header) -> std::string
+{
+    auto result = create_compilation_flags_string(configuration);
+
+    if (!result.empty())
+    {
+        result.push_back(' ');
+    }
+
+    // Both g++ and clang++ pick up the compiled `.gch`/`.pch` file that sits next to the header.
+    std::format_to(std::back_inserter(result), "-include {}", precompiled_header.native());
+
+    return result;
+}
+
+// A generated translation unit of a unity build holds several files, whose budgets are checked one by one.
+static auto is_unity_batch(const std::filesystem::path& file) -> bool
+{
+    return !file.empty() && *file.begin() == params::BUILD_DIRECTORY_NAME &&
+           file.filename().native().starts_with(params::UNITY_BATCH_FILE_PREFIX);
+}
+
+// A compiler that exceeds a budget whose action is to kill it is stopped by `jobs::run`.
+static auto get_compiler_limits(const Configuration& configuration, const std::filesystem::path& file_name)
+    -> jobs::Limits
+{
+    return is_unity_batch(file_name) ? jobs::Limits{}
+                                     : budgets::get_limits(budgets::get_budget(configuration, file_name));
+}
+
+static auto run_compiler(const std::filesystem::path& file_name,
+                         const std::filesystem::path& object_file_path,
                          const std::string_view compilation_flags,
                          const Configuration& configuration) -> CompilationInfo
 {
-    ASSERT(utils::is_source_file(file_name));
-    ASSERT(configuration.compiler.has_value());
+    if (auto remote_result = distributed::compile(file_name, object_file_path, compilation_flags, configuration);
+        remote_result.has_value())
+    {
+        return *remote_result;
+    }
 
-    const auto object_file_path    = object_files_directory / utils::get_object_file_name(file_name);
-    const auto temporary_file_path = std::filesystem::temp_directory_path() / utils::get_object_file_name(file_name);
+    // Next to the object file, in the build directory of the configuration, so that no other build writes it.
+    auto temporary_file_path = object_file_path;
+    temporary_file_path += ".out";
+
+    const auto limits = get_compiler_limits(configuration, file_name);
 
     // Compile the file with the given flag
     // and redirect stdout and stderr to the temporary file.
@@ -150,8 +257,12 @@ static auto compile_file(const std::filesystem::path& file_name,
                                                  object_file_path.native(),
                                                  temporary_file_path.native());
 
-    const auto file_compiled_successfully = std::system(compilation_command.c_str()) == EXIT_SUCCESS;
-    const auto compiler_output            = [&]
+    trace::Span span("Compile", "compile", {{"file", file_name.string()}, {"configuration", *configuration.name}});
+    const auto job_result = jobs::run(compilation_command, limits);
+    span.add_argument("peak_rss_kb", job_result.peak_memory_in_kilobytes);
+
+    const auto file_compiled_successfully = job_result.exit_status == EXIT_SUCCESS;
+    auto compiler_output                  = [&]
     {
         auto temporary_file = std::ifstream(temporary_file_path);
 
@@ -160,12 +271,138 @@ static auto compile_file(const std::filesystem::path& file_name,
 
     std::filesystem::remove(temporary_file_path);
 
+    // GCC prints its time report together with the diagnostics, so it is moved to a file of its own.
+    if (compilation_flags.contains("-ftime-report"))
+    {
+        auto time_report_file =
+            std::ofstream(compile_time_analysis::get_time_trace_path(configuration, object_file_path));
+        time_report_file << compile_time_analysis::extract_time_report(compiler_output);
+    }
+
     return {
-        .is_successful   = file_compiled_successfully,
-        .compiler_output = compiler_output,
+        .is_successful            = file_compiled_successfully,
+        .compiler_output          = compiler_output,
+        .duration_in_seconds      = job_result.duration_in_seconds,
+        .exit_code                = events::get_exit_code(job_result.exit_status),
+        .peak_memory_in_kilobytes = job_result.peak_memory_in_kilobytes,
     };
 }
 
+auto share_object_file(const std::filesystem::path& source, const std::filesystem::path& destination) -> bool
+{
+    std::error_code error;
+    std::filesystem::create_hard_link(source, destination, error);
+
+    if (!error)
+    {
+        return true;
+    }
+
+    error.clear();
+    std::filesystem::copy_file(source, destination, std::filesystem::copy_options::overwrite_existing, error);
+
+    return !error;
+}
+
+/// @brief  Compiles a single source file into the configuration's object files directory.
+/// @note   Configurations often differ only in fields that do not affect compilation (e.g. `output` or `linkFlags`).
+///         When another configuration compiles the same file with the same command in this run,
+///         the file is compiled once and the object file is shared through a hard link. If that compilation fails,
+///         the others fail with its diagnostics rather than compiling the file again.
+static auto compile_file(const std::filesystem::path& file_name,
+                         const std::filesystem::path& object_files_directory,
+                         const std::string_view compilation_flags,
+                         const Configuration& configuration) -> CompilationInfo
+{
+    ASSERT(utils::is_source_file(file_name));
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.compiler.has_value());
+
+    const auto object_file_path = object_files_directory / utils::get_object_file_name(file_name);
+
+    // The output path is the only part of the command that differs between such configurations.
+    // An object file with split debug info refers to its `.dwo` file by path, so it is never shared.
+    // Neither is one compiled for `--analyze-compile-time`, since every configuration reads its own time trace.
+    auto shared_object_key = std::format("{} {} -c {}", *configuration.compiler, compilation_flags, file_name.native());
+    const auto time_trace_flag = compile_time_analysis::get_compilation_flag(configuration);
+
+    if (compilation_flags.contains("-gsplit-dwarf") || compilation_flags.contains(time_trace_flag))
+    {
+        std::format_to(std::back_inserter(shared_object_key), " -o {}", object_file_path.native());
+    }
+
+    // A compiler that was stopped by the budget of one configuration may succeed within the budget of another.
+    if (const auto limits = get_compiler_limits(configuration, file_name);
+        limits.max_seconds.has_value() || limits.max_memory_in_megabytes.has_value())
+    {
+        std::format_to(std::back_inserter(shared_object_key),
+                       " (limits: {} s, {} MB)",
+                       limits.max_seconds.value_or(0.0),
+                       limits.max_memory_in_megabytes.value_or(0.0));
+    }
+
+    std::promise<SharedObject> promise; // Fulfilled if this call compiles the file.
+    std::shared_future<SharedObject> shared_object;
+    auto& shared_objects = get_shared_objects();
+
+    {
+        std::lock_guard lock(shared_objects.mutex);
+        auto& entry = shared_objects.entries[shared_object_key];
+
+        // A configuration that compiles the same file again in this run must not reuse its own old object.
+        if (!entry.object.valid() || entry.configuration_name == *configuration.name)
+        {
+            entry.configuration_name = *configuration.name;
+            entry.object             = promise.get_future().share();
+        }
+        else
+        {
+            shared_object = entry.object;
+        }
+    }
+
+    const auto is_compiled_elsewhere = shared_object.valid();
+
+    if (is_compiled_elsewhere)
+    {
+        // The other compilation already started, so waiting for it cannot deadlock.
+        const auto& object = shared_object.get();
+
+        // The same command fails the same way, so a failure is reported with the diagnostics of the other compilation.
+        if (!object.is_successful)
+        {
+            return {
+                .is_successful       = false,
+                .compiler_output     = object.compiler_output,
+                .duration_in_seconds = object.duration_in_seconds,
+                .exit_code           = object.exit_code,
+            };
+        }
+
+        if (share_object_file(object.object_file_path, object_file_path))
+        {
+            return {
+                .is_successful       = true,
+                .compiler_output     = "",
+                .duration_in_seconds = object.duration_in_seconds,
+            };
+        }
+
+        return run_compiler(file_name, object_file_path, compilation_flags, configuration);
+    }
+
+    auto result = run_compiler(file_name, object_file_path, compilation_flags, configuration);
+    promise.set_value({
+        .is_successful       = result.is_successful,
+        .object_file_path    = object_file_path,
+        .duration_in_seconds = result.duration_in_seconds,
+        .compiler_output     = result.is_successful ? "" : result.compiler_output,
+        .exit_code           = result.exit_code,
+    });
+
+    return result;
+}
+
 static auto print_file_compilation_status(const std::filesystem::path& file_name,
                                           const int index,
                                           const int total_num_of_files,
@@ -216,67 +453,204 @@ static auto print_compilation_result(const std::vector<std::filesystem::path>& f
     utils::print_error("Compilation failed.");
 }
 
-auto compile_files(const Configuration& configuration,
-                   const std::filesystem::path& path_to_root,
-                   const std::vector<std::filesystem::path>& files_to_compile,
-                   const bool is_quiet,
-                   const bool use_parallel_compilation) -> int
+// Emitted when the file is compiled, rather than when its result is reported in the order of the file names.
+static auto emit_compilation_events(const std::string& configuration_name,
+                                    const std::filesystem::path& file_name,
+                                    const CompilationInfo& result) -> void
 {
-    ASSERT(configuration.name.has_value());
-    ASSERT(std::ranges::is_sorted(files_to_compile));
+    if (!events::is_enabled())
+    {
+        return;
+    }
 
-    if (!is_quiet)
+    events::emit("tu_finished",
+                 {
+                     {"configuration", configuration_name                           },
+                     {"file",          file_name.string()                           },
+                     {"success",       result.is_successful                         },
+                     {"duration_s",    result.duration_in_seconds                   },
+                     {"exit_code",     std::int64_t{result.exit_code}               },
+                     {"peak_rss_kb",   std::int64_t{result.peak_memory_in_kilobytes}},
+                 });
+
+    if (!result.compiler_output.empty())
+    {
+        events::emit("diagnostics",
+                     {
+                         {"configuration", configuration_name    },
+                         {"file",          file_name.string()    },
+                         {"output",        result.compiler_output},
+                     });
+    }
+}
+
+// A file that exceeds its budget is reported by the build that makes it slower, rather than after every
+// build has become slower.
+auto enforce_budget(const Configuration& configuration,
+                    const std::filesystem::path& file_name,
+                    CompilationInfo& result) -> void
+{
+    const auto budget = budgets::get_budget(configuration, file_name);
+    const auto excess = budgets::check(budget, result.duration_in_seconds, result.peak_memory_in_kilobytes);
+
+    if (!excess.has_value())
+    {
+        return;
+    }
+
+    if (events::is_enabled())
+    {
+        events::emit("budget_exceeded",
+                     {
+                         {"configuration", *configuration.name                          },
+                         {"file",          file_name.string()                           },
+                         {"action",        configuration.budget_action.value_or("warn") },
+                         {"duration_s",    result.duration_in_seconds                   },
+                         {"peak_rss_kb",   std::int64_t{result.peak_memory_in_kilobytes}},
+                     });
+    }
+
+    if (budget.action == budgets::Action::Warn)
+    {
+        std::format_to(std::back_inserter(result.compiler_output), "Warning: '{}' {}.\n", file_name.native(), *excess);
+        return;
+    }
+
+    result.is_successful = false;
+    std::format_to(std::back_inserter(result.compiler_output), "Error: '{}' {}.\n", file_name.native(), *excess);
+}
+
+auto get_num_of_compilation_threads(const bool use_parallel_compilation) -> int
+{
+    return use_parallel_compilation ? std::max(1U, std::thread::hardware_concurrency() / 2) : 1;
+}
+
+CompilationPipeline::CompilationPipeline(const Configuration& configuration,
+                                         const std::filesystem::path& path_to_root,
+                                         const bool use_parallel_compilation,
+                                         const std::optional<std::filesystem::path>& precompiled_header)
+    : configuration(configuration),
+      object_files_directory(path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name),
+      compilation_flags(precompiled_header.has_value()
+                            ? create_compilation_flags_string(configuration, *precompiled_header)
+                            : create_compilation_flags_string(configuration)),
+      // Threads that wait for workers are not compiling, so there is one for every remote job as well.
+      // `jobs::run` still limits the compilers that run locally.
+      thread_pool(get_num_of_compilation_threads(use_parallel_compilation) + distributed::get_num_of_remote_jobs())
+{
+}
+
+auto CompilationPipeline::add(const std::filesystem::path& file) -> void
+{
+    ASSERT(!added_files.contains(file));
+
+    // If a previous build was interrupted or the file failed to compile, its object file
+    // may be left in an inconsistent state. Remove it, so that it is never treated as up-to-date.
+    remove_outdated_object_file(object_files_directory, file);
+
+    files.push_back(file);
+    added_files.insert(file);
+    if (events::is_enabled())
     {
-        print_number_of_files_to_compile(files_to_compile.size(), *configuration.name);
+        events::emit("tu_queued", {{"configuration", *configuration.name}, {"file", file.string()}});
     }
 
-    // If a previous build was interrupted or a file failed to compile, some object files
-    // may be left in an inconsistent state. Before starting a new build, we remove all
-    // object files for this configuration to ensure we don't incorrectly treat any of them
-    // as up-to-date. This guarantees that the next build recompiles everything cleanly.
-    const auto object_files_directory = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
-    remove_outdated_object_files(object_files_directory, files_to_compile);
+    futures.push_back(thread_pool.add_task(
+        [this, file, stop_token = stop_source.get_token()]
+        {
+            if (stop_token.stop_requested())
+            {
+                return CompilationInfo{.is_successful = false, .compiler_output = "", .duration_in_seconds = 0.0};
+            }
+
+            if (events::is_enabled())
+            {
+                events::emit("tu_started", {{"configuration", *configuration.name}, {"file", file.string()}});
+            }
+
+            auto result = compile_file(file, object_files_directory, compilation_flags, configuration);
+
+            // Files that fail their budget lose their object file, so that the next build checks them again.
+            if (!is_unity_batch(file))
+            {
+                const auto is_compiled = result.is_successful;
+                enforce_budget(configuration, file, result);
+
+                if (is_compiled && !result.is_successful)
+                {
+                    remove_outdated_object_file(object_files_directory, file);
+                }
+            }
+            emit_compilation_events(*configuration.name, file, result);
+
+            return result;
+        }));
+}
 
-    const auto compilation_flags = create_compilation_flags_string(configuration);
-    const auto max_index_width   = utils::count_digits(files_to_compile.size()); // For formatting.
-    const auto num_of_threads    = use_parallel_compilation ? std::max(1U, std::thread::hardware_concurrency() / 2) : 1;
-    ThreadPool thread_pool(num_of_threads);
-    std::vector<std::future<CompilationInfo>> futures;
+auto CompilationPipeline::contains(const std::filesystem::path& file) const -> bool
+{
+    return added_files.contains(file);
+}
+
+auto CompilationPipeline::is_empty() const -> bool
+{
+    return files.empty();
+}
 
-    for (const auto& path : files_to_compile)
+auto CompilationPipeline::finish(const bool is_quiet) -> CompilationResult
+{
+    ASSERT(configuration.name.has_value());
+
+    if (!is_quiet)
     {
-        futures.push_back(thread_pool.add_task(
-            [&] { return compile_file(path, object_files_directory, compilation_flags, configuration); }));
+        print_number_of_files_to_compile(files.size(), *configuration.name);
     }
 
+    // Files are added in the order they are discovered, but reported in the order of their names.
+    auto order = std::views::iota(0UZ, files.size()) | std::ranges::to<std::vector>();
+    std::ranges::sort(order, {}, [&](const auto index) -> const std::filesystem::path& { return files[index]; });
+
+    const auto max_index_width = utils::count_digits(files.size()); // For formatting.
     std::vector<std::filesystem::path> failed_compilation;
+    std::unordered_map<std::filesystem::path, double> compilation_times;
+    std::unordered_map<std::filesystem::path, long> peak_memory_in_kilobytes;
 
-    for (auto [index, future] : std::views::enumerate(futures))
+    for (const auto [index, file_index] : std::views::enumerate(order) | std::views::as_const)
     {
-        const auto& file_name = files_to_compile[index];
+        const auto& file_name = files[file_index];
 
         if (!is_quiet)
         {
             // Print the file's compilation status *before* starting the blocking `get()`.
             // This marks the file as "in progress" without a completion percentage.
-            print_file_compilation_status(file_name, index + 1, files_to_compile.size(), max_index_width, true);
+            print_file_compilation_status(file_name, index + 1, files.size(), max_index_width, true);
         }
 
-        const auto result = future.get(); // The call to `get` is blocking.
+        const auto result = futures[file_index].get(); // The call to `get` is blocking.
 
-        if (!result.is_successful)
+        if (result.is_successful)
+        {
+            compilation_times[file_name] = result.duration_in_seconds;
+        }
+        else
         {
             failed_compilation.push_back(file_name);
         }
 
+        if (result.peak_memory_in_kilobytes > 0)
+        {
+            peak_memory_in_kilobytes[file_name] = result.peak_memory_in_kilobytes;
+        }
+
         if (!is_quiet)
         {
             // Print the file's status *after* it finishes compiling.
             // This time we include the completion percentage to mark it as completed.
-            print_file_compilation_status(file_name, index + 1, files_to_compile.size(), max_index_width, false);
+            print_file_compilation_status(file_name, index + 1, files.size(), max_index_width, false);
         }
 
-        if (!result.compiler_output.empty())
+        // With `--output-format=jsonl`, the diagnostics were already emitted as events.
+        if (!result.compiler_output.empty() && !events::is_enabled())
         {
             std::print("{}", result.compiler_output);
         }
@@ -287,5 +661,49 @@ auto compile_files(const Configuration& configuration,
         print_compilation_result(failed_compilation);
     }
 
-    return failed_compilation.size();
+    return {
+        .num_of_failures          = static_cast<int>(failed_compilation.size()),
+        .compilation_times        = std::move(compilation_times),
+        .peak_memory_in_kilobytes = std::move(peak_memory_in_kilobytes),
+    };
+}
+
+auto CompilationPipeline::cancel() -> void
+{
+    stop_source.request_stop();
+
+    for (auto& future : futures)
+    {
+        future.wait();
+    }
+
+    // The build is abandoned, so the object files of this run are not trusted by the next one.
+    for (const auto& file : files)
+    {
+        remove_outdated_object_file(object_files_directory, file);
+    }
+
+    files.clear();
+    added_files.clear();
+    futures.clear();
+}
+
+auto compile_files(const Configuration& configuration,
+                   const std::filesystem::path& path_to_root,
+                   const std::vector<std::filesystem::path>& files_to_compile,
+                   const bool is_quiet,
+                   const bool use_parallel_compilation,
+                   const std::optional<std::filesystem::path>& precompiled_header) -> CompilationResult
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(std::ranges::is_sorted(files_to_compile));
+
+    CompilationPipeline pipeline(configuration, path_to_root, use_parallel_compilation, precompiled_header);
+
+    for (const auto& file : files_to_compile)
+    {
+        pipeline.add(file);
+    }
+
+    return pipeline.finish(is_quiet);
 }
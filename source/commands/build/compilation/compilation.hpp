@@ -2,17 +2,92 @@
 #define SOURCE_COMMANDS_BUILD_COMPILATION_COMPILATION_HPP
 
 #include <filesystem>
+#include <future>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "source/commands/build/compilation/thread_pool.hpp"
 #include "source/configuration_parsing/configuration.hpp"
 
+struct CompilationResult
+{
+    int num_of_failures;
+    std::unordered_map<std::filesystem::path, double> compilation_times;       // In seconds, successful files only.
+    std::unordered_map<std::filesystem::path, long> peak_memory_in_kilobytes{}; // Files that were not shared.
+};
+
+struct CompilationInfo
+{
+    bool is_successful;
+    std::string compiler_output;
+    double duration_in_seconds;
+    int exit_code{};                 // Of the compiler, as a shell reports it.
+    long peak_memory_in_kilobytes{}; // Zero if the object file was shared.
+};
+
 auto create_compilation_flags_string(const Configuration& configuration) -> std::string;
 
+// Same as above, but also force-includes `precompiled_header` in every translation unit.
+auto create_compilation_flags_string(const Configuration& configuration,
+                                     const std::filesystem::path& precompiled_header) -> std::string;
+
+auto get_num_of_compilation_threads(bool use_parallel_compilation) -> int;
+
+// Checks a compiled file against its budget, and appends the warning or error to its output.
+// A file over a budget whose action is not `warn` fails; the caller removes its object file.
+// The files of a unity batch are not checked when they compile, but one by one with their share of the batch.
+auto enforce_budget(const Configuration& configuration,
+                    const std::filesystem::path& file_name,
+                    CompilationInfo& result) -> void;
+
+// Places the object file that another configuration compiled at `destination`.
+// Hard links are preferred, so that sharing an object file costs neither time nor space.
+// Falls back to a copy where a hard link cannot be created (e.g. across file systems).
+auto share_object_file(const std::filesystem::path& source, const std::filesystem::path& destination) -> bool;
+
 auto compile_files(const Configuration& configuration,
                    const std::filesystem::path& path_to_root,
                    const std::vector<std::filesystem::path>& files_to_compile,
                    bool is_quiet,
-                   bool use_parallel_compilation) -> int;
+                   bool use_parallel_compilation,
+                   const std::optional<std::filesystem::path>& precompiled_header) -> CompilationResult;
+
+// Compiles source files as soon as they are added, so that compilation can overlap with the analysis
+// of the rest of the project. `compile_files` is a pipeline whose files are all known up front.
+class CompilationPipeline
+{
+  public:
+    CompilationPipeline(const Configuration& configuration,
+                        const std::filesystem::path& path_to_root,
+                        bool use_parallel_compilation,
+                        const std::optional<std::filesystem::path>& precompiled_header);
+
+    // Removes the file's stale object file and starts compiling it in the background.
+    auto add(const std::filesystem::path& file) -> void;
+
+    auto contains(const std::filesystem::path& file) const -> bool;
+
+    auto is_empty() const -> bool;
+
+    // Waits for every added file and reports the results in the order of the file names.
+    auto finish(bool is_quiet) -> CompilationResult;
+
+    // Skips the files that did not start compiling, waits for the others and removes their object files.
+    auto cancel() -> void;
+
+  private:
+    Configuration configuration;
+    std::filesystem::path object_files_directory;
+    std::string compilation_flags;
+    std::vector<std::filesystem::path> files;
+    std::unordered_set<std::filesystem::path> added_files;
+    std::vector<std::future<CompilationInfo>> futures;
+    std::stop_source stop_source;
+    ThreadPool thread_pool; // Declared last, so that the workers finish before the members they use are destroyed.
+};
 
 #endif // SOURCE_COMMANDS_BUILD_COMPILATION_COMPILATION_HPP
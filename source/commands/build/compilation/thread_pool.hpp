@@ -2,7 +2,9 @@
 #define SOURCE_COMMANDS_BUILD_COMPILATION_THREAD_POOL_HPP
 
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <mutex>
@@ -12,6 +14,8 @@
 #include <type_traits> // std::invoke_result
 #include <vector>
 
+#include "source/commands/build/statistics.hpp"
+
 class ThreadPool
 {
   public:
@@ -22,13 +26,25 @@ class ThreadPool
     auto add_task(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type>;
 
   private:
+    static auto to_microseconds(std::chrono::steady_clock::duration duration) -> std::int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+
+    struct QueuedTask
+    {
+        std::function<void()> function;
+        std::chrono::steady_clock::time_point queued_at; // For the queue wait reported by `build --stats`.
+    };
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
     std::vector<std::jthread> workers;
-    std::queue<std::function<void()>> task_queue;
+    std::queue<QueuedTask> task_queue;
     std::condition_variable condition;
     std::mutex queue_mutex;
 };
 
-ThreadPool::ThreadPool(const int num_of_threads)
+inline ThreadPool::ThreadPool(const int num_of_threads)
 {
     assert(num_of_threads > 0);
 
@@ -39,7 +55,7 @@ ThreadPool::ThreadPool(const int num_of_threads)
             {
                 while (true)
                 {
-                    std::function<void()> task;
+                    QueuedTask task;
 
                     {
                         std::unique_lock<std::mutex> lock(queue_mutex);
@@ -60,16 +76,24 @@ ThreadPool::ThreadPool(const int num_of_threads)
                         }
                     }
 
-                    if (task)
+                    if (task.function)
                     {
-                        task();
+                        const auto task_start_time = std::chrono::steady_clock::now();
+                        task.function();
+                        const auto task_end_time = std::chrono::steady_clock::now();
+
+                        statistics::add(statistics::Counter::POOL_TASKS);
+                        statistics::add(statistics::Counter::POOL_QUEUE_WAIT_MICROSECONDS,
+                                        to_microseconds(task_start_time - task.queued_at));
+                        statistics::add(statistics::Counter::POOL_BUSY_MICROSECONDS,
+                                        to_microseconds(task_end_time - task_start_time));
                     }
                 }
             });
     }
 }
 
-ThreadPool::~ThreadPool()
+inline ThreadPool::~ThreadPool()
 {
     for (auto& worker : workers)
     {
@@ -77,6 +101,15 @@ ThreadPool::~ThreadPool()
     }
 
     condition.notify_all();
+
+    // The queued tasks still run after the stop request.
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    const auto lifetime = std::chrono::steady_clock::now() - start_time;
+    statistics::add(statistics::Counter::POOL_AVAILABLE_MICROSECONDS, std::ssize(workers) * to_microseconds(lifetime));
 }
 
 template <typename F, typename... Args>
@@ -91,7 +124,7 @@ auto ThreadPool::add_task(F&& f, Args&&... args) -> std::future<typename std::in
 
     {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        task_queue.emplace([task]() { (*task)(); });
+        task_queue.push({.function = [task]() { (*task)(); }, .queued_at = std::chrono::steady_clock::now()});
     }
 
     condition.notify_one();
@@ -0,0 +1,278 @@
+#include "source/commands/build/compile_time_analysis/compile_time_analysis.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <print>
+#include <ranges>
+#include <regex>
+#include <stdexcept>
+#include <system_error> // std::error_code
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::literals;
+
+// Number of entries of every list that is printed. The JSON report contains all of them.
+static const auto NUM_OF_PRINTED_ENTRIES = 10;
+
+static auto uses_clang(const Configuration& configuration) -> bool
+{
+    ASSERT(configuration.compiler.has_value());
+
+    return configuration.compiler->contains("clang");
+}
+
+auto compile_time_analysis::get_compilation_flag(const Configuration& configuration) -> std::string
+{
+    return uses_clang(configuration) ? "-ftime-trace" : "-ftime-report";
+}
+
+auto compile_time_analysis::get_time_trace_path(const Configuration& configuration,
+                                                const std::filesystem::path& object_file_path)
+    -> std::filesystem::path
+{
+    const auto extension = uses_clang(configuration) ? ".json" : ".time-report";
+
+    return std::filesystem::path(object_file_path).replace_extension(extension);
+}
+
+auto compile_time_analysis::extract_time_report(std::string& compiler_output) -> std::string
+{
+    // The report starts with a header line and ends with the line of the total time.
+    const auto start = compiler_output.find("Time variable");
+
+    if (start == std::string::npos)
+    {
+        return "";
+    }
+
+    const auto total       = compiler_output.find(" TOTAL", start);
+    const auto end_of_line = total == std::string::npos ? std::string::npos : compiler_output.find('\n', total);
+    const auto end         = end_of_line == std::string::npos ? compiler_output.size() : end_of_line + 1;
+
+    auto report = compiler_output.substr(start, end - start);
+    compiler_output.erase(start, end - start);
+
+    // The report is preceded by an empty line, which is all that is left without diagnostics.
+    if (compiler_output.find_first_not_of(" \n") == std::string::npos)
+    {
+        compiler_output.clear();
+    }
+
+    return report;
+}
+
+auto compile_time_analysis::parse_clang_time_trace(const std::string_view contents) -> TranslationUnitTimes
+{
+    const auto json = nlohmann::json::parse(contents, nullptr, false);
+
+    if (json.is_discarded() || !json.contains("traceEvents"))
+    {
+        return {};
+    }
+
+    TranslationUnitTimes times;
+
+    for (const auto& event : json["traceEvents"])
+    {
+        // Only complete events have a duration. The durations are in microseconds.
+        if (event.value("ph", "") != "X" || !event.contains("dur"))
+        {
+            continue;
+        }
+
+        const auto name    = event.value("name", "");
+        const auto seconds = event["dur"].get<double>() / 1'000'000;
+        const auto detail  = event.contains("args") ? event["args"].value("detail", "") : "";
+
+        if (name == "Source")
+        {
+            times.headers[detail] += seconds;
+        }
+        else if (name == "InstantiateClass" || name == "InstantiateFunction")
+        {
+            times.templates[detail] += seconds;
+        }
+        else if (name == "Frontend" || name == "Backend")
+        {
+            times.phases[name] += seconds;
+        }
+    }
+
+    return times;
+}
+
+auto compile_time_analysis::parse_gcc_time_report(const std::string_view contents) -> TranslationUnitTimes
+{
+    // E.g. " phase parsing      :   0.51 ( 65%)   0.19 ( 86%)   0.71 ( 70%)    54M ( 73%)".
+    // The columns are user time, system time, wall time and memory.
+    static const std::regex line_regex(R"(^ (\S.*?)\s*:\s*[\d.]+ \(\s*\d+%\)\s*[\d.]+ \(\s*\d+%\)\s*([\d.]+) )");
+
+    TranslationUnitTimes times;
+
+    for (const auto line : contents | std::views::split('\n'))
+    {
+        const auto line_string = std::string(std::string_view(line));
+        std::smatch match;
+
+        if (std::regex_search(line_string, match, line_regex))
+        {
+            times.phases[match[1].str()] += std::stod(match[2].str());
+        }
+    }
+
+    return times;
+}
+
+static auto read_file(const std::filesystem::path& path) -> std::string
+{
+    auto file = std::ifstream(path);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Sorts the entries from the most expensive one.
+static auto to_entries(const std::unordered_map<std::string, compile_time_analysis::Entry>& entries)
+    -> std::vector<compile_time_analysis::Entry>
+{
+    auto result = entries | std::views::values | std::ranges::to<std::vector>();
+    std::ranges::sort(result, std::ranges::greater{}, &compile_time_analysis::Entry::total_in_seconds);
+
+    return result;
+}
+
+static auto add_durations(std::unordered_map<std::string, compile_time_analysis::Entry>& entries,
+                          const compile_time_analysis::Durations& durations) -> void
+{
+    for (const auto& [name, seconds] : durations)
+    {
+        auto& entry = entries.try_emplace(name, compile_time_analysis::Entry{name, 0.0, 0}).first->second;
+        entry.total_in_seconds += seconds;
+        ++entry.count;
+    }
+}
+
+auto compile_time_analysis::create_report(const Configuration& configuration,
+                                          const std::filesystem::path& path_to_root,
+                                          const std::unordered_map<std::filesystem::path, double>& compilation_times)
+    -> Report
+{
+    ASSERT(configuration.name.has_value());
+
+    const auto object_files_directory = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
+    std::unordered_map<std::string, Entry> headers;
+    std::unordered_map<std::string, Entry> templates;
+    std::unordered_map<std::string, Entry> phases;
+    std::unordered_map<std::string, Entry> translation_units;
+    auto error_code = std::error_code{};
+
+    // Only the time traces of existing object files, so that traces of deleted files are ignored.
+    for (const auto& entry : std::filesystem::directory_iterator(object_files_directory, error_code))
+    {
+        if (entry.path().extension() != ".o")
+        {
+            continue;
+        }
+
+        const auto time_trace_path = get_time_trace_path(configuration, entry.path());
+
+        if (!std::filesystem::is_regular_file(time_trace_path, error_code))
+        {
+            continue;
+        }
+
+        const auto contents = read_file(time_trace_path);
+        const auto times =
+            uses_clang(configuration) ? parse_clang_time_trace(contents) : parse_gcc_time_report(contents);
+
+        add_durations(headers, times.headers);
+        add_durations(templates, times.templates);
+        add_durations(phases, times.phases);
+    }
+
+    for (const auto& [file, seconds] : compilation_times)
+    {
+        translation_units[file.string()] = {.name = file.string(), .total_in_seconds = seconds, .count = 1};
+    }
+
+    return {
+        .headers           = to_entries(headers),
+        .templates         = to_entries(templates),
+        .phases            = to_entries(phases),
+        .translation_units = to_entries(translation_units),
+    };
+}
+
+static auto print_entries(const std::string_view title, const std::vector<compile_time_analysis::Entry>& entries)
+    -> void
+{
+    if (entries.empty())
+    {
+        return;
+    }
+
+    std::println("{}:", title);
+
+    for (const auto& entry : entries | std::views::take(NUM_OF_PRINTED_ENTRIES))
+    {
+        std::println("  {:9.3f}s  {:5}x  {}", entry.total_in_seconds, entry.count, entry.name);
+    }
+
+    std::println();
+}
+
+auto compile_time_analysis::print_report(const Report& report, const std::string_view configuration_name) -> void
+{
+    std::println("Compile time report for configuration '{}':", configuration_name);
+    std::println();
+
+    print_entries("Most expensive headers (total parse time, number of translation units)", report.headers);
+    print_entries("Most expensive template instantiations", report.templates);
+    print_entries("Compilation phases", report.phases);
+    print_entries("Slowest translation units", report.translation_units);
+
+    if (report.headers.empty() && report.templates.empty())
+    {
+        std::println("Note: Only Clang reports the time spent in every header and template instantiation.");
+    }
+}
+
+static auto to_json(const std::vector<compile_time_analysis::Entry>& entries) -> nlohmann::json
+{
+    auto result = nlohmann::json::array();
+
+    for (const auto& entry : entries)
+    {
+        result.push_back({
+            {"name",    entry.name            },
+            {"seconds", entry.total_in_seconds},
+            {"count",   entry.count           },
+        });
+    }
+
+    return result;
+}
+
+auto compile_time_analysis::write_report(const Report& report, const std::filesystem::path& path) -> void
+{
+    auto file = std::ofstream(path);
+
+    if (!file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", path.native()));
+    }
+
+    const nlohmann::json json = {
+        {"headers",          to_json(report.headers)          },
+        {"templates",        to_json(report.templates)        },
+        {"phases",           to_json(report.phases)           },
+        {"translationUnits", to_json(report.translation_units)},
+    };
+
+    file << json.dump(4);
+}
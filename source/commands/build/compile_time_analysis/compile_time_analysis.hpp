@@ -0,0 +1,66 @@
+#ifndef SOURCE_COMMANDS_BUILD_COMPILE_TIME_ANALYSIS_COMPILE_TIME_ANALYSIS_HPP
+#define SOURCE_COMMANDS_BUILD_COMPILE_TIME_ANALYSIS_COMPILE_TIME_ANALYSIS_HPP
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace compile_time_analysis
+{
+    using Durations = std::unordered_map<std::string, double>; // In seconds.
+
+    // Where a single translation unit spent its compilation time.
+    struct TranslationUnitTimes
+    {
+        Durations headers;   // Parse time, including the headers they include. Only reported by Clang.
+        Durations templates; // Instantiation time, including nested instantiations. Only reported by Clang.
+        Durations phases;    // E.g. parsing and optimization.
+    };
+
+    struct Entry
+    {
+        std::string name;
+        double total_in_seconds;
+        int count; // Number of translation units.
+    };
+
+    // Every list is sorted from the most expensive entry to the least expensive one.
+    struct Report
+    {
+        std::vector<Entry> headers;
+        std::vector<Entry> templates;
+        std::vector<Entry> phases;
+        std::vector<Entry> translation_units;
+    };
+
+    // `-ftime-trace` for Clang, `-ftime-report` otherwise.
+    auto get_compilation_flag(const Configuration& configuration) -> std::string;
+
+    // Clang writes the time trace of `x.cpp.o` to `x.cpp.json`.
+    // The time report that GCC prints is kept in `x.cpp.time-report`.
+    auto get_time_trace_path(const Configuration& configuration,
+                             const std::filesystem::path& object_file_path) -> std::filesystem::path;
+
+    // GCC prints its time report together with the diagnostics.
+    // Removes the report from `compiler_output` and returns it.
+    auto extract_time_report(std::string& compiler_output) -> std::string;
+
+    auto parse_clang_time_trace(std::string_view contents) -> TranslationUnitTimes;
+
+    auto parse_gcc_time_report(std::string_view contents) -> TranslationUnitTimes;
+
+    // Combines the time traces next to the object files of the configuration.
+    auto create_report(const Configuration& configuration,
+                       const std::filesystem::path& path_to_root,
+                       const std::unordered_map<std::filesystem::path, double>& compilation_times) -> Report;
+
+    auto print_report(const Report& report, std::string_view configuration_name) -> void;
+
+    auto write_report(const Report& report, const std::filesystem::path& path) -> void;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_COMPILE_TIME_ANALYSIS_COMPILE_TIME_ANALYSIS_HPP
@@ -98,6 +98,66 @@ static auto inherit_missing_fields_from_parent(const Configuration& original,
         result.output_path = parent.output_path;
     }
 
+    if (!original.precompiled_headers.has_value())
+    {
+        result.precompiled_headers = parent.precompiled_headers;
+    }
+
+    if (!original.unity.has_value())
+    {
+        result.unity = parent.unity;
+    }
+
+    if (!original.linker.has_value())
+    {
+        result.linker = parent.linker;
+    }
+
+    if (!original.debug_info.has_value())
+    {
+        result.debug_info = parent.debug_info;
+    }
+
+    if (!original.type.has_value())
+    {
+        result.type = parent.type;
+    }
+
+    if (!original.dependencies.has_value())
+    {
+        result.dependencies = parent.dependencies;
+    }
+
+    if (!original.lto.has_value())
+    {
+        result.lto = parent.lto;
+    }
+
+    if (!original.partial_links.has_value())
+    {
+        result.partial_links = parent.partial_links;
+    }
+
+    if (!original.max_compile_seconds.has_value())
+    {
+        result.max_compile_seconds = parent.max_compile_seconds;
+    }
+
+    if (!original.max_memory_in_megabytes.has_value())
+    {
+        result.max_memory_in_megabytes = parent.max_memory_in_megabytes;
+    }
+
+    if (!original.budget_action.has_value())
+    {
+        result.budget_action = parent.budget_action;
+    }
+
+    if (!original.budget_overrides.has_value())
+    {
+        result.budget_overrides = parent.budget_overrides;
+    }
+
     return result;
 }
 
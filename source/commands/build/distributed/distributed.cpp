@@ -0,0 +1,441 @@
+#include "source/commands/build/distributed/distributed.hpp"
+
+#include <algorithm> // std::max
+#include <atomic>
+#include <charconv> // std::from_chars
+#include <chrono>
+#include <cstdio> // popen
+#include <cstdlib>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <mutex>
+#include <ranges>
+#include <system_error> // std::errc
+#include <unordered_map>
+
+#include <sys/socket.h> // setsockopt
+
+#include "source/commands/build/budgets.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::chrono_literals;
+
+// A worker that does not accept the connection by then is treated as unreachable.
+static constexpr auto CONNECT_TIMEOUT = 500ms;
+
+// A worker that does not answer by then is treated as gone, and the file is compiled locally.
+static constexpr auto RESPONSE_TIMEOUT = 10min;
+
+// A worker that answered that it is busy (e.g. with the compilations of another client) is left alone for a while.
+static constexpr auto BUSY_BACKOFF = 1s;
+
+namespace
+{
+    struct WorkerState
+    {
+        distributed::Worker worker;
+        std::atomic<bool> is_unreachable = false; // Not contacted again for the rest of the build.
+        std::atomic<int> num_of_running_jobs = 0; // Compilations of this build that the worker has not answered yet.
+        std::atomic<std::chrono::steady_clock::rep> busy_until = 0; // Not contacted before then.
+    };
+
+    struct Workers
+    {
+        std::deque<WorkerState> states; // A deque, since the states cannot be moved.
+        std::atomic<std::size_t> next_worker = 0;
+    };
+
+    // One of the jobs of a worker, which is held while a file is preprocessed and compiled on it.
+    class WorkerReservation
+    {
+      public:
+        explicit WorkerReservation(WorkerState* state) : state(state)
+        {
+        }
+
+        WorkerReservation(const WorkerReservation&)                    = delete;
+        auto operator=(const WorkerReservation&) -> WorkerReservation& = delete;
+
+        ~WorkerReservation()
+        {
+            if (state != nullptr)
+            {
+                --state->num_of_running_jobs;
+            }
+        }
+
+        auto get() const -> WorkerState*
+        {
+            return state;
+        }
+
+      private:
+        WorkerState* state;
+    };
+}
+
+static auto get_workers() -> Workers&
+{
+    static Workers workers;
+
+    return workers;
+}
+
+auto distributed::parse_workers(const std::string_view workers) -> std::expected<std::vector<Worker>, std::string>
+{
+    std::vector<Worker> result;
+
+    for (const auto worker_range : workers | std::views::split(','))
+    {
+        auto worker          = std::string_view(worker_range.begin(), worker_range.end());
+        auto max_num_of_jobs = DEFAULT_NUM_OF_JOBS_PER_WORKER;
+
+        // The number of jobs is separated by the last slash, since Unix socket paths contain slashes as well.
+        if (const auto separator = worker.rfind('/');
+            separator != std::string_view::npos && worker.find_first_not_of("0123456789", separator + 1) ==
+                                                       std::string_view::npos)
+        {
+            const auto jobs         = worker.substr(separator + 1);
+            const auto [end, error] = std::from_chars(jobs.data(), jobs.data() + jobs.size(), max_num_of_jobs);
+
+            if (error != std::errc() || max_num_of_jobs <= 0)
+            {
+                return std::unexpected(std::format("Error: Invalid number of jobs in worker '{}'.", worker));
+            }
+
+            worker = worker.substr(0, separator);
+        }
+
+        const auto address = parse_address(worker);
+
+        if (!address.has_value())
+        {
+            return std::unexpected(address.error());
+        }
+
+        result.push_back({.address = *address, .max_num_of_jobs = max_num_of_jobs});
+    }
+
+    if (result.empty())
+    {
+        return std::unexpected("Error: The list of workers is empty.");
+    }
+
+    return result;
+}
+
+auto distributed::set_workers(const std::vector<Worker>& workers) -> void
+{
+    auto& state = get_workers();
+    state.states.clear();
+    state.next_worker = 0;
+
+    for (const auto& worker : workers)
+    {
+        state.states.emplace_back(worker);
+    }
+}
+
+auto distributed::get_num_of_remote_jobs() -> int
+{
+    auto result = 0;
+
+    for (const auto& state : get_workers().states)
+    {
+        result += state.worker.max_num_of_jobs;
+    }
+
+    return result;
+}
+
+auto distributed::can_compile_remotely(const Configuration& configuration,
+                                       const std::string_view compilation_flags) -> bool
+{
+    ASSERT(configuration.compiler.has_value());
+
+    // Each of these makes the compiler read or write a file next to the sources.
+    const auto uses_local_files = compilation_flags.contains("-include ") ||     // Precompiled header.
+                                  compilation_flags.contains("-fprofile-use") || //
+                                  compilation_flags.contains("-gsplit-dwarf") || // `.dwo` file.
+                                  compilation_flags.contains("-ftime-trace") ||  //
+                                  compilation_flags.contains("-ftime-report") || //
+                                  compilation_flags.contains("-fmodule");        // Module mapper and BMIs.
+
+    return *configuration.compiler != "cl" && !uses_local_files;
+}
+
+// Defines and include directories were already applied by the preprocessor.
+auto distributed::get_remote_compilation_flags(const std::string_view compilation_flags) -> std::string
+{
+    std::string result;
+
+    for (const auto flag_range : compilation_flags | std::views::split(' '))
+    {
+        const auto flag = std::string_view(flag_range.begin(), flag_range.end());
+
+        if (flag.empty() || flag.starts_with("-D") || flag.starts_with("-I"))
+        {
+            continue;
+        }
+
+        if (!result.empty())
+        {
+            result.push_back(' ');
+        }
+
+        result += flag;
+    }
+
+    return result;
+}
+
+// The first line of `--version` names the release, and `-dumpmachine` names the target.
+auto distributed::get_compiler_version(const std::string& compiler) -> std::string
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::string> versions;
+
+    const std::lock_guard lock(mutex);
+
+    if (const auto version = versions.find(compiler); version != versions.end())
+    {
+        return version->second;
+    }
+
+    const auto command =
+        std::format("{0} --version 2> /dev/null | head -n 1 && {0} -dumpmachine 2> /dev/null", compiler);
+    auto* const pipe = popen(command.c_str(), "r");
+    std::string version;
+
+    if (pipe != nullptr)
+    {
+        for (auto character = std::fgetc(pipe); character != EOF; character = std::fgetc(pipe))
+        {
+            version.push_back(static_cast<char>(character));
+        }
+
+        if (pclose(pipe) != EXIT_SUCCESS)
+        {
+            version.clear();
+        }
+    }
+
+    return versions[compiler] = version;
+}
+
+static auto read_file(const std::filesystem::path& path) -> std::string
+{
+    auto file = std::ifstream(path, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static auto get_current_time() -> std::chrono::steady_clock::rep
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/// @brief  Reserves a job on the next worker in turn that has one free.
+/// @return An empty reservation if every worker is busy or unreachable, so that the file is not preprocessed
+///         only to be compiled locally.
+static auto reserve_worker() -> WorkerReservation
+{
+    auto& workers     = get_workers();
+    const auto first  = workers.next_worker.fetch_add(1, std::memory_order_relaxed);
+    const auto length = workers.states.size();
+
+    for (auto attempt = 0UZ; attempt < length; ++attempt)
+    {
+        auto& state = workers.states[(first + attempt) % length];
+
+        if (state.is_unreachable.load(std::memory_order_relaxed) ||
+            get_current_time() < state.busy_until.load(std::memory_order_relaxed))
+        {
+            continue;
+        }
+
+        auto num_of_running_jobs = state.num_of_running_jobs.load();
+
+        while (num_of_running_jobs < state.worker.max_num_of_jobs &&
+               !state.num_of_running_jobs.compare_exchange_weak(num_of_running_jobs, num_of_running_jobs + 1))
+        {
+        }
+
+        if (num_of_running_jobs < state.worker.max_num_of_jobs)
+        {
+            return WorkerReservation(&state);
+        }
+    }
+
+    return WorkerReservation(nullptr);
+}
+
+/// @brief  Sends the preprocessed translation unit to the reserved worker.
+/// @return The response of the worker if it compiled the file, or `std::nullopt` if it is busy or unreachable.
+static auto send_to_worker(WorkerState& state, const distributed::Request& request)
+    -> std::optional<distributed::Response>
+{
+    const auto socket = distributed::connect(state.worker.address, CONNECT_TIMEOUT);
+
+    if (!socket.has_value())
+    {
+        state.is_unreachable.store(true, std::memory_order_relaxed);
+
+        return std::nullopt;
+    }
+
+    const timeval timeout{.tv_sec = std::chrono::seconds(RESPONSE_TIMEOUT).count(), .tv_usec = 0};
+    setsockopt(socket->get(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (!distributed::send_request(*socket, request))
+    {
+        return std::nullopt;
+    }
+
+    auto response = distributed::receive_response(*socket);
+
+    if (!response.has_value())
+    {
+        return std::nullopt;
+    }
+
+    if (response->status == distributed::Response::Status::BUSY)
+    {
+        const auto busy_until = std::chrono::steady_clock::now() + BUSY_BACKOFF;
+        state.busy_until.store(busy_until.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    const auto worker_compiled_file = response->status == distributed::Response::Status::COMPILED ||
+                                      response->status == distributed::Response::Status::FAILED;
+
+    return worker_compiled_file ? response : std::nullopt;
+}
+
+auto distributed::compile(const std::filesystem::path& file_name,
+                          const std::filesystem::path& object_file_path,
+                          const std::string_view compilation_flags,
+                          const Configuration& configuration) -> std::optional<CompilationInfo>
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.compiler.has_value());
+
+    if (get_workers().states.empty() || !can_compile_remotely(configuration, compilation_flags))
+    {
+        return std::nullopt;
+    }
+
+    const auto reservation = reserve_worker();
+
+    if (reservation.get() == nullptr)
+    {
+        statistics::add(statistics::Counter::LOCAL_FALLBACKS);
+
+        return std::nullopt;
+    }
+
+    // Next to the object file, in the build directory of the configuration, so that no other build writes them.
+    auto preprocessed_file_path = object_file_path;
+    auto output_file_path       = object_file_path;
+    preprocessed_file_path += ".ii";
+    output_file_path += ".out";
+
+    const auto preprocessing_command = std::format("{} {} -fdiagnostics-color=always -E {} -o {} > {} 2>&1",
+                                                   *configuration.compiler,
+                                                   compilation_flags,
+                                                   file_name.native(),
+                                                   preprocessed_file_path.native(),
+                                                   output_file_path.native());
+
+    const auto preprocessing_result = [&]
+    {
+        const trace::Span span(
+            "Preprocess", "compile", {{"file", file_name.string()}, {"configuration", *configuration.name}});
+
+        return jobs::run(preprocessing_command);
+    }();
+
+    const auto preprocessor_output = read_file(output_file_path);
+    const auto preprocessed_source = read_file(preprocessed_file_path);
+    std::filesystem::remove(output_file_path);
+    std::filesystem::remove(preprocessed_file_path);
+
+    // A file that cannot be preprocessed (e.g. a missing header) would not compile locally either.
+    if (preprocessing_result.exit_status != EXIT_SUCCESS)
+    {
+        return CompilationInfo{
+            .is_successful            = false,
+            .compiler_output          = preprocessor_output,
+            .duration_in_seconds      = preprocessing_result.duration_in_seconds,
+            .exit_code                = events::get_exit_code(preprocessing_result.exit_status),
+            .peak_memory_in_kilobytes = preprocessing_result.peak_memory_in_kilobytes,
+        };
+    }
+
+    // The worker stops the compiler at the limits of a `kill` budget, like a local compilation.
+    const auto budget  = budgets::get_budget(configuration, file_name);
+    const auto is_kill = budget.action == budgets::Action::Kill;
+    const auto request = Request{
+        .compiler                = *configuration.compiler,
+        .compilation_flags       = get_remote_compilation_flags(compilation_flags),
+        .preprocessed_source     = preprocessed_source,
+        .compiler_version        = get_compiler_version(*configuration.compiler),
+        .max_compile_seconds     = is_kill ? budget.max_compile_seconds : std::nullopt,
+        .max_memory_in_megabytes = is_kill ? budget.max_memory_in_megabytes : std::nullopt,
+    };
+
+    trace::Span span(
+        "Compile remotely", "compile", {{"file", file_name.string()}, {"configuration", *configuration.name}});
+    auto response = send_to_worker(*reservation.get(), request);
+
+    // A worker that turned out to be busy or unreachable is skipped for a while, so another one may take the file.
+    for (auto attempt = 1UZ; !response.has_value() && attempt < get_workers().states.size(); ++attempt)
+    {
+        const auto next_reservation = reserve_worker();
+
+        if (next_reservation.get() == nullptr)
+        {
+            break;
+        }
+
+        response = send_to_worker(*next_reservation.get(), request);
+    }
+
+    if (!response.has_value())
+    {
+        statistics::add(statistics::Counter::LOCAL_FALLBACKS);
+
+        return std::nullopt;
+    }
+
+    const auto is_successful = response->status == Response::Status::COMPILED;
+
+    if (is_successful)
+    {
+        auto object_file = std::ofstream(object_file_path, std::ios::binary | std::ios::trunc);
+        object_file.write(response->object_file.data(), static_cast<std::streamsize>(response->object_file.size()));
+
+        if (!object_file.good())
+        {
+            return std::nullopt;
+        }
+    }
+
+    statistics::add(statistics::Counter::REMOTE_COMPILATIONS);
+
+    const auto peak_memory_in_kilobytes =
+        std::max(preprocessing_result.peak_memory_in_kilobytes, response->peak_memory_in_kilobytes);
+
+    return CompilationInfo{
+        .is_successful            = is_successful,
+        .compiler_output          = preprocessor_output + response->compiler_output,
+        .duration_in_seconds      = preprocessing_result.duration_in_seconds + response->duration_in_seconds,
+        .exit_code                = is_successful ? EXIT_SUCCESS : EXIT_FAILURE,
+        .peak_memory_in_kilobytes = peak_memory_in_kilobytes,
+    };
+}
@@ -0,0 +1,57 @@
+#ifndef SOURCE_COMMANDS_BUILD_DISTRIBUTED_DISTRIBUTED_HPP
+#define SOURCE_COMMANDS_BUILD_DISTRIBUTED_DISTRIBUTED_HPP
+
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/distributed/protocol.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+// Sends translation units to `easy-make worker` daemons, like distcc.
+// Files are preprocessed locally, so the workers need only the compiler, not the sources or the headers.
+namespace distributed
+{
+    struct Worker
+    {
+        Address address;
+        int max_num_of_jobs; // Compilations that are sent to the worker at the same time.
+    };
+
+    inline constexpr auto DEFAULT_NUM_OF_JOBS_PER_WORKER = 4;
+
+    // Parses a comma-separated list of addresses, each optionally followed by `/<number of jobs>`,
+    // e.g. `build-box:3633/16,unix:/tmp/easy-make-worker.sock`.
+    auto parse_workers(std::string_view workers) -> std::expected<std::vector<Worker>, std::string>;
+
+    // Later compilations are sent to `workers`. Must not be called while compiling.
+    auto set_workers(const std::vector<Worker>& workers) -> void;
+
+    // The number of compilations that the workers run at the same time. Zero without workers.
+    auto get_num_of_remote_jobs() -> int;
+
+    // Whether the object file depends only on the preprocessed translation unit and the flags.
+    // E.g. a precompiled header or a profile is a file that the workers do not have.
+    auto can_compile_remotely(const Configuration& configuration, std::string_view compilation_flags) -> bool;
+
+    // The flags that the workers compile the preprocessed translation units with.
+    auto get_remote_compilation_flags(std::string_view compilation_flags) -> std::string;
+
+    // The version and target of `compiler`, which the client and the worker must agree on.
+    // Empty if the compiler cannot be run. Each compiler is run once per process.
+    auto get_compiler_version(const std::string& compiler) -> std::string;
+
+    /// @brief  Compiles a source file on one of the workers.
+    /// @return The result of the compilation, or `std::nullopt` if the file should be compiled locally:
+    ///         there are no workers, the file cannot be compiled remotely, or every worker is busy or unreachable.
+    auto compile(const std::filesystem::path& file_name,
+                 const std::filesystem::path& object_file_path,
+                 std::string_view compilation_flags,
+                 const Configuration& configuration) -> std::optional<CompilationInfo>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_DISTRIBUTED_DISTRIBUTED_HPP
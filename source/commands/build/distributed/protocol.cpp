@@ -0,0 +1,526 @@
+#include "source/commands/build/distributed/protocol.hpp"
+
+#include <array>
+#include <cerrno>
+#include <charconv> // std::from_chars
+#include <cstring>  // std::memcpy, std::strerror
+#include <format>
+#include <system_error> // std::error_code
+#include <utility>      // std::exchange
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "third_party/nlohmann/json.hpp"
+
+using distributed::Response;
+using distributed::Socket;
+
+static const auto UNIX_SOCKET_PREFIX = std::string_view("unix:");
+
+auto distributed::parse_address(const std::string_view address) -> std::expected<Address, std::string>
+{
+    if (address.starts_with(UNIX_SOCKET_PREFIX))
+    {
+        const auto path = address.substr(UNIX_SOCKET_PREFIX.size());
+
+        if (path.empty() || path.size() >= sizeof(sockaddr_un::sun_path))
+        {
+            return std::unexpected(std::format("Error: Invalid Unix socket path in worker address '{}'.", address));
+        }
+
+        return Address{.host = "", .port = 0, .socket_path = std::filesystem::path(path)};
+    }
+
+    const auto separator = address.rfind(':');
+
+    if (separator == std::string_view::npos || separator == 0)
+    {
+        return std::unexpected(std::format(
+            "Error: Invalid worker address '{}'. Expected 'host:port' or 'unix:<path>'.", address));
+    }
+
+    auto host       = address.substr(0, separator);
+    const auto port = address.substr(separator + 1);
+
+    // IPv6 addresses are written in brackets, e.g. `[::1]:3633`.
+    if (host.starts_with('[') && host.ends_with(']'))
+    {
+        host = host.substr(1, host.size() - 2);
+    }
+
+    std::uint16_t port_number = 0;
+    const auto [end, error]   = std::from_chars(port.data(), port.data() + port.size(), port_number);
+
+    if (error != std::errc() || end != port.data() + port.size() || port_number == 0)
+    {
+        return std::unexpected(std::format("Error: Invalid port '{}' in worker address '{}'.", port, address));
+    }
+
+    return Address{.host = std::string(host), .port = port_number, .socket_path = std::nullopt};
+}
+
+auto distributed::to_string(const Address& address) -> std::string
+{
+    if (address.socket_path.has_value())
+    {
+        return std::format("{}{}", UNIX_SOCKET_PREFIX, address.socket_path->native());
+    }
+
+    return address.host.contains(':') ? std::format("[{}]:{}", address.host, address.port)
+                                      : std::format("{}:{}", address.host, address.port);
+}
+
+Socket::Socket(const int file_descriptor) : file_descriptor(file_descriptor)
+{
+}
+
+Socket::Socket(Socket&& other) noexcept : file_descriptor(std::exchange(other.file_descriptor, -1))
+{
+}
+
+auto Socket::operator=(Socket&& other) noexcept -> Socket&
+{
+    if (this != &other)
+    {
+        if (file_descriptor != -1)
+        {
+            close(file_descriptor);
+        }
+
+        file_descriptor = std::exchange(other.file_descriptor, -1);
+    }
+
+    return *this;
+}
+
+Socket::~Socket()
+{
+    if (file_descriptor != -1)
+    {
+        close(file_descriptor);
+    }
+}
+
+auto Socket::get() const -> int
+{
+    return file_descriptor;
+}
+
+static auto create_unix_socket_address(const std::filesystem::path& path) -> sockaddr_un
+{
+    sockaddr_un result{};
+    result.sun_family = AF_UNIX;
+    std::memcpy(result.sun_path, path.c_str(), path.native().size()); // The length is checked when parsing.
+
+    return result;
+}
+
+// Connects without blocking for longer than `timeout`, so that an unreachable worker does not stall the build.
+static auto connect_with_timeout(const int file_descriptor,
+                                 const sockaddr* address,
+                                 const socklen_t address_length,
+                                 const std::chrono::milliseconds timeout) -> bool
+{
+    const auto flags = fcntl(file_descriptor, F_GETFL);
+    fcntl(file_descriptor, F_SETFL, flags | O_NONBLOCK);
+
+    if (connect(file_descriptor, address, address_length) != 0)
+    {
+        if (errno != EINPROGRESS)
+        {
+            return false;
+        }
+
+        pollfd poll_info{.fd = file_descriptor, .events = POLLOUT, .revents = 0};
+
+        if (poll(&poll_info, 1, static_cast<int>(timeout.count())) != 1)
+        {
+            return false;
+        }
+
+        auto error           = 0;
+        socklen_t error_size = sizeof(error);
+
+        if (getsockopt(file_descriptor, SOL_SOCKET, SO_ERROR, &error, &error_size) != 0 || error != 0)
+        {
+            return false;
+        }
+    }
+
+    fcntl(file_descriptor, F_SETFL, flags);
+
+    return true;
+}
+
+auto distributed::connect(const Address& address, const std::chrono::milliseconds timeout) -> std::optional<Socket>
+{
+    if (address.socket_path.has_value())
+    {
+        auto socket               = Socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        const auto socket_address = create_unix_socket_address(*address.socket_path);
+
+        if (socket.get() == -1 ||
+            !connect_with_timeout(
+                socket.get(), reinterpret_cast<const sockaddr*>(&socket_address), sizeof(socket_address), timeout))
+        {
+            return std::nullopt;
+        }
+
+        return socket;
+    }
+
+    addrinfo hints{};
+    hints.ai_family     = AF_UNSPEC;
+    hints.ai_socktype   = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+
+    if (getaddrinfo(address.host.c_str(), std::to_string(address.port).c_str(), &hints, &addresses) != 0)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Socket> result;
+
+    for (auto* info = addresses; info != nullptr && !result.has_value(); info = info->ai_next)
+    {
+        auto socket = Socket(::socket(info->ai_family, info->ai_socktype | SOCK_CLOEXEC, info->ai_protocol));
+
+        if (socket.get() != -1 && connect_with_timeout(socket.get(), info->ai_addr, info->ai_addrlen, timeout))
+        {
+            result = std::move(socket);
+        }
+    }
+
+    freeaddrinfo(addresses);
+
+    return result;
+}
+
+auto distributed::listen(const Address& address) -> std::expected<Socket, std::string>
+{
+    const auto create_error = [&](const std::string_view operation)
+    {
+        return std::unexpected(
+            std::format("Error: Failed to {} '{}': {}.", operation, to_string(address), std::strerror(errno)));
+    };
+
+    if (address.socket_path.has_value())
+    {
+        // A socket file left by a previous worker would make `bind` fail.
+        std::error_code error;
+
+        if (std::filesystem::is_socket(*address.socket_path, error))
+        {
+            std::filesystem::remove(*address.socket_path, error);
+        }
+
+        auto socket               = Socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        const auto socket_address = create_unix_socket_address(*address.socket_path);
+
+        if (socket.get() == -1 ||
+            bind(socket.get(), reinterpret_cast<const sockaddr*>(&socket_address), sizeof(socket_address)) != 0)
+        {
+            return create_error("bind to");
+        }
+
+        if (::listen(socket.get(), SOMAXCONN) != 0)
+        {
+            return create_error("listen on");
+        }
+
+        return socket;
+    }
+
+    addrinfo hints{};
+    hints.ai_family     = AF_UNSPEC;
+    hints.ai_socktype   = SOCK_STREAM;
+    hints.ai_flags      = AI_PASSIVE;
+    addrinfo* addresses = nullptr;
+
+    if (getaddrinfo(address.host.c_str(), std::to_string(address.port).c_str(), &hints, &addresses) != 0)
+    {
+        return std::unexpected(std::format("Error: Failed to resolve '{}'.", to_string(address)));
+    }
+
+    auto socket =
+        Socket(::socket(addresses->ai_family, addresses->ai_socktype | SOCK_CLOEXEC, addresses->ai_protocol));
+    const auto reuse_address = 1;
+    setsockopt(socket.get(), SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+
+    const auto bound = socket.get() != -1 && bind(socket.get(), addresses->ai_addr, addresses->ai_addrlen) == 0;
+    freeaddrinfo(addresses);
+
+    if (!bound)
+    {
+        return create_error("bind to");
+    }
+
+    if (::listen(socket.get(), SOMAXCONN) != 0)
+    {
+        return create_error("listen on");
+    }
+
+    return socket;
+}
+
+static auto send_all(const Socket& socket, const char* data, std::size_t size) -> bool
+{
+    while (size > 0)
+    {
+        const auto num_of_bytes_sent = send(socket.get(), data, size, MSG_NOSIGNAL);
+
+        if (num_of_bytes_sent == -1 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (num_of_bytes_sent <= 0)
+        {
+            return false;
+        }
+
+        data += num_of_bytes_sent;
+        size -= num_of_bytes_sent;
+    }
+
+    return true;
+}
+
+static auto receive_all(const Socket& socket, char* data, std::size_t size) -> bool
+{
+    while (size > 0)
+    {
+        const auto num_of_bytes_received = recv(socket.get(), data, size, 0);
+
+        if (num_of_bytes_received == -1 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (num_of_bytes_received <= 0)
+        {
+            return false;
+        }
+
+        data += num_of_bytes_received;
+        size -= num_of_bytes_received;
+    }
+
+    return true;
+}
+
+// The size is sent in big-endian order before the message itself.
+auto distributed::send_message(const Socket& socket, const std::string_view message) -> bool
+{
+    std::array<char, sizeof(std::uint64_t)> header{};
+    const auto size = static_cast<std::uint64_t>(message.size());
+
+    for (auto index = 0UZ; index < header.size(); ++index)
+    {
+        header[index] = static_cast<char>(size >> (8 * (header.size() - 1 - index)));
+    }
+
+    return send_all(socket, header.data(), header.size()) && send_all(socket, message.data(), message.size());
+}
+
+auto distributed::receive_message(const Socket& socket) -> std::optional<std::string>
+{
+    std::array<char, sizeof(std::uint64_t)> header{};
+
+    if (!receive_all(socket, header.data(), header.size()))
+    {
+        return std::nullopt;
+    }
+
+    std::uint64_t size = 0;
+
+    for (const auto byte : header)
+    {
+        size = (size << 8) | static_cast<unsigned char>(byte);
+    }
+
+    if (size > MAX_MESSAGE_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    std::string message(size, '\0');
+
+    if (!receive_all(socket, message.data(), message.size()))
+    {
+        return std::nullopt;
+    }
+
+    return message;
+}
+
+// The fields of a message are checked before they are read, since reading a field of another type throws.
+static auto has_string(const nlohmann::json& json, const std::string_view key) -> bool
+{
+    return json.contains(key) && json[key].is_string();
+}
+
+static auto has_integer(const nlohmann::json& json, const std::string_view key) -> bool
+{
+    return json.contains(key) && json[key].is_number_integer();
+}
+
+static auto has_number(const nlohmann::json& json, const std::string_view key) -> bool
+{
+    return json.contains(key) && json[key].is_number();
+}
+
+static auto has_optional_number(const nlohmann::json& json, const std::string_view key) -> bool
+{
+    return !json.contains(key) || json[key].is_number();
+}
+
+// A request is a JSON header followed by the preprocessed source.
+auto distributed::send_request(const Socket& socket, const Request& request) -> bool
+{
+    auto header = nlohmann::json{
+        {"protocol",         PROTOCOL_VERSION         },
+        {"compiler",         request.compiler         },
+        {"compilationFlags", request.compilation_flags},
+        {"compilerVersion",  request.compiler_version },
+    };
+
+    if (request.max_compile_seconds.has_value())
+    {
+        header["maxCompileSeconds"] = *request.max_compile_seconds;
+    }
+
+    if (request.max_memory_in_megabytes.has_value())
+    {
+        header["maxMemoryInMegabytes"] = *request.max_memory_in_megabytes;
+    }
+
+    return send_message(socket, header.dump()) && send_message(socket, request.preprocessed_source);
+}
+
+auto distributed::receive_request(const Socket& socket) -> std::optional<Request>
+{
+    const auto header = receive_message(socket);
+
+    if (!header.has_value())
+    {
+        return std::nullopt;
+    }
+
+    const auto json     = nlohmann::json::parse(*header, nullptr, false);
+    const auto is_valid = json.is_object() && has_integer(json, "protocol") &&
+                          json["protocol"].get<std::int64_t>() == PROTOCOL_VERSION && has_string(json, "compiler") &&
+                          has_string(json, "compilationFlags") && has_string(json, "compilerVersion") &&
+                          has_optional_number(json, "maxCompileSeconds") &&
+                          has_optional_number(json, "maxMemoryInMegabytes");
+
+    if (!is_valid)
+    {
+        return std::nullopt;
+    }
+
+    auto preprocessed_source = receive_message(socket);
+
+    if (!preprocessed_source.has_value())
+    {
+        return std::nullopt;
+    }
+
+    const auto get_limit = [&](const std::string& key) -> std::optional<double>
+    { return json.contains(key) ? std::optional(json[key].get<double>()) : std::nullopt; };
+
+    return Request{
+        .compiler                = json["compiler"].get<std::string>(),
+        .compilation_flags       = json["compilationFlags"].get<std::string>(),
+        .preprocessed_source     = std::move(*preprocessed_source),
+        .compiler_version        = json["compilerVersion"].get<std::string>(),
+        .max_compile_seconds     = get_limit("maxCompileSeconds"),
+        .max_memory_in_megabytes = get_limit("maxMemoryInMegabytes"),
+    };
+}
+
+static auto status_to_string(const Response::Status status) -> std::string_view
+{
+    switch (status)
+    {
+    case Response::Status::COMPILED:
+        return "compiled";
+    case Response::Status::FAILED:
+        return "failed";
+    case Response::Status::BUSY:
+        return "busy";
+    case Response::Status::REJECTED:
+        return "rejected";
+    }
+
+    std::unreachable();
+}
+
+// A response is a JSON header followed by the object file.
+auto distributed::send_response(const Socket& socket, const Response& response) -> bool
+{
+    const auto header = nlohmann::json{
+        {"status",              status_to_string(response.status)},
+        {"compilerOutput",      response.compiler_output          },
+        {"durationInSeconds",   response.duration_in_seconds      },
+        {"peakMemoryKilobytes", response.peak_memory_in_kilobytes },
+    };
+
+    return send_message(socket, header.dump()) && send_message(socket, response.object_file);
+}
+
+auto distributed::receive_response(const Socket& socket) -> std::optional<Response>
+{
+    const auto header      = receive_message(socket);
+    auto object_file       = receive_message(socket);
+    const auto is_complete = header.has_value() && object_file.has_value();
+
+    if (!is_complete)
+    {
+        return std::nullopt;
+    }
+
+    const auto json     = nlohmann::json::parse(*header, nullptr, false);
+    const auto is_valid = json.is_object() && has_string(json, "status") && has_string(json, "compilerOutput") &&
+                          has_number(json, "durationInSeconds") && has_integer(json, "peakMemoryKilobytes");
+
+    if (!is_valid)
+    {
+        return std::nullopt;
+    }
+
+    const auto status_name = json["status"].get<std::string>();
+    const auto status      = [&]() -> std::optional<Response::Status>
+    {
+        for (const auto status : {Response::Status::COMPILED,
+                                  Response::Status::FAILED,
+                                  Response::Status::BUSY,
+                                  Response::Status::REJECTED})
+        {
+            if (status_to_string(status) == status_name)
+            {
+                return status;
+            }
+        }
+
+        return std::nullopt;
+    }();
+
+    if (!status.has_value())
+    {
+        return std::nullopt;
+    }
+
+    return Response{
+        .status                   = *status,
+        .compiler_output          = json["compilerOutput"].get<std::string>(),
+        .object_file              = std::move(*object_file),
+        .duration_in_seconds      = json["durationInSeconds"].get<double>(),
+        .peak_memory_in_kilobytes = json["peakMemoryKilobytes"].get<long>(),
+    };
+}
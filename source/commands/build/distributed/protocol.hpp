@@ -0,0 +1,99 @@
+#ifndef SOURCE_COMMANDS_BUILD_DISTRIBUTED_PROTOCOL_HPP
+#define SOURCE_COMMANDS_BUILD_DISTRIBUTED_PROTOCOL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// The protocol between easy-make and the `easy-make worker` daemons.
+// Every connection carries a single compilation: easy-make sends a request with a preprocessed
+// translation unit, and the worker answers with the object file and the diagnostics.
+// Messages are length-prefixed frames, so that source and object files are sent as they are.
+namespace distributed
+{
+    inline constexpr auto PROTOCOL_VERSION = 2;
+
+    // Either `host:port` (TCP) or `unix:<path>` (Unix domain socket).
+    struct Address
+    {
+        std::string host;
+        std::uint16_t port;
+        std::optional<std::filesystem::path> socket_path; // Set for Unix domain sockets.
+    };
+
+    auto parse_address(std::string_view address) -> std::expected<Address, std::string>;
+
+    auto to_string(const Address& address) -> std::string;
+
+    // Owns a socket file descriptor.
+    class Socket
+    {
+      public:
+        explicit Socket(int file_descriptor);
+        Socket(Socket&& other) noexcept;
+        auto operator=(Socket&& other) noexcept -> Socket&;
+        Socket(const Socket&)                    = delete;
+        auto operator=(const Socket&) -> Socket& = delete;
+        ~Socket();
+
+        auto get() const -> int;
+
+      private:
+        int file_descriptor;
+    };
+
+    // Returns `std::nullopt` if the address cannot be reached within `timeout`.
+    auto connect(const Address& address, std::chrono::milliseconds timeout) -> std::optional<Socket>;
+
+    auto listen(const Address& address) -> std::expected<Socket, std::string>;
+
+    // Messages larger than this are treated as a broken connection.
+    inline constexpr std::uint64_t MAX_MESSAGE_SIZE = 1ULL << 30;
+
+    auto send_message(const Socket& socket, std::string_view message) -> bool;
+
+    auto receive_message(const Socket& socket) -> std::optional<std::string>;
+
+    struct Request
+    {
+        std::string compiler;
+        std::string compilation_flags; // Without the preprocessor flags.
+        std::string preprocessed_source;
+        std::string compiler_version{}; // The worker rejects the request unless its compiler has the same version.
+
+        // The limits of a `kill` budget, which the worker stops the compiler at.
+        std::optional<double> max_compile_seconds{};
+        std::optional<double> max_memory_in_megabytes{};
+    };
+
+    struct Response
+    {
+        enum class Status
+        {
+            COMPILED,
+            FAILED,   // The translation unit has errors; `compiler_output` has the diagnostics.
+            BUSY,     // Every job slot of the worker is taken.
+            REJECTED, // The worker cannot or will not run the compiler, e.g. it is not installed there.
+        };
+
+        Status status;
+        std::string compiler_output;
+        std::string object_file;    // Empty unless compiled.
+        double duration_in_seconds;         // Of the compilation on the worker.
+        long peak_memory_in_kilobytes = 0L; // Of the compiler on the worker.
+    };
+
+    auto send_request(const Socket& socket, const Request& request) -> bool;
+
+    auto receive_request(const Socket& socket) -> std::optional<Request>;
+
+    auto send_response(const Socket& socket, const Response& response) -> bool;
+
+    auto receive_response(const Socket& socket) -> std::optional<Response>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_DISTRIBUTED_PROTOCOL_HPP
@@ -0,0 +1,105 @@
+#include "source/commands/build/events.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+#include <sys/wait.h>
+
+#include "source/utils/print.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+namespace
+{
+    struct Emitter
+    {
+        std::atomic<bool> is_enabled = false;
+        std::chrono::steady_clock::time_point start_time;
+        std::FILE* output = nullptr;
+        std::mutex mutex; // Held while a line is written.
+    };
+}
+
+static auto get_emitter() -> Emitter&
+{
+    static Emitter emitter;
+
+    return emitter;
+}
+
+auto events::enable(std::FILE* const output) -> void
+{
+    auto& emitter = get_emitter();
+
+    {
+        std::lock_guard lock(emitter.mutex);
+        emitter.start_time = std::chrono::steady_clock::now();
+        emitter.output     = output;
+    }
+
+    emitter.is_enabled = true;
+}
+
+auto events::disable() -> void
+{
+    get_emitter().is_enabled = false;
+}
+
+auto events::is_enabled() -> bool
+{
+    return get_emitter().is_enabled.load(std::memory_order_relaxed);
+}
+
+auto events::emit(const std::string_view event, const Fields& fields) -> void
+{
+    if (!is_enabled())
+    {
+        return;
+    }
+
+    auto& emitter      = get_emitter();
+    const auto time    = std::chrono::steady_clock::now() - emitter.start_time;
+    const auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+
+    // Ordered, so that every line starts with the name of the event.
+    nlohmann::ordered_json json = {
+        {"event",   event  },
+        {"time_us", time_us},
+    };
+
+    for (const auto& [field_name, value] : fields)
+    {
+        std::visit([&](const auto& v) { json[field_name] = v; }, value);
+    }
+
+    // The line is serialized before the lock is taken, and written with a single call.
+    auto line = json.dump();
+    line.push_back('\n');
+
+    std::lock_guard lock(emitter.mutex);
+    std::fwrite(line.data(), 1, line.size(), emitter.output);
+    std::fflush(emitter.output);
+}
+
+auto events::report_error(const std::string_view message) -> void
+{
+    if (is_enabled())
+    {
+        emit("error", {{"message", std::string(message)}});
+    }
+    else
+    {
+        utils::print_error("{}", message);
+    }
+}
+
+auto events::get_exit_code(const int wait_status) -> int
+{
+    if (WIFSIGNALED(wait_status))
+    {
+        return 128 + WTERMSIG(wait_status);
+    }
+
+    return WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : wait_status;
+}
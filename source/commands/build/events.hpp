@@ -0,0 +1,38 @@
+#ifndef SOURCE_COMMANDS_BUILD_EVENTS_HPP
+#define SOURCE_COMMANDS_BUILD_EVENTS_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <variant>
+#include <vector>
+
+// The machine-readable output of `easy-make build --output-format=jsonl`.
+// Every event is a JSON object on a line of its own, written as soon as it happens.
+namespace events
+{
+    using Value  = std::variant<std::string, std::int64_t, double, bool>;
+    using Fields = std::vector<std::pair<std::string, Value>>;
+
+    // Nothing is written until the events are enabled, so that emitting costs a single check otherwise.
+    auto enable(std::FILE* output = stdout) -> void;
+
+    auto disable() -> void;
+
+    auto is_enabled() -> bool;
+
+    // Writes `{"event": <event>, "time_us": <microseconds since enable>, <fields>...}` as a single line.
+    // Lines of concurrent events are never interleaved.
+    auto emit(std::string_view event, const Fields& fields = {}) -> void;
+
+    // Emits an `error` event with `message` while the events are enabled, so that every line of the output stays
+    // JSON. Prints `message` in red otherwise.
+    auto report_error(std::string_view message) -> void;
+
+    // The exit code that a shell reports for a wait status, e.g. 128 + 9 for a compiler killed by `SIGKILL`.
+    auto get_exit_code(int wait_status) -> int;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_EVENTS_HPP
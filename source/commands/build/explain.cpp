@@ -0,0 +1,229 @@
+#include "source/commands/build/explain.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <format>
+#include <ranges>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility> // std::unreachable
+
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+using build_caching::DependencyGraph;
+
+static auto get_own_change_reason(const build_caching::Info& build_info,
+                                  const std::filesystem::path& file) -> explain::Reason
+{
+    const auto old_hash = build_info.old_file_hashes.find(file);
+
+    if (old_hash == build_info.old_file_hashes.end())
+    {
+        return {.cause = explain::Cause::NEW_FILE};
+    }
+
+    if (old_hash->second != build_info.file_hashes.at(file))
+    {
+        return {.cause = explain::Cause::CONTENTS_CHANGED};
+    }
+
+    return {.cause = explain::Cause::MISSING_OBJECT};
+}
+
+// Maps every file that includes a changed file, directly or not, to the next file on its shortest
+// include chain towards a changed file.
+// Files and neighbors are visited in sorted order so the same chain is chosen every time.
+static auto get_include_parents(const DependencyGraph& dependency_graph,
+                                const std::vector<std::filesystem::path>& changed_files)
+    -> std::unordered_map<std::filesystem::path, std::filesystem::path>
+{
+    std::unordered_map<std::filesystem::path, std::filesystem::path> parents;
+    std::deque<std::filesystem::path> queue;
+
+    auto sorted_changed_files = changed_files;
+    std::ranges::sort(sorted_changed_files);
+
+    for (const auto& file : sorted_changed_files)
+    {
+        parents.emplace(file, file);
+        queue.push_back(file);
+    }
+
+    while (!queue.empty())
+    {
+        const auto file = queue.front();
+        queue.pop_front();
+
+        if (!dependency_graph.data().contains(file))
+        {
+            continue;
+        }
+
+        auto includers = dependency_graph.data().at(file) | std::ranges::to<std::vector>();
+        std::ranges::sort(includers);
+
+        for (const auto& includer : includers)
+        {
+            if (parents.try_emplace(includer, file).second)
+            {
+                queue.push_back(includer);
+            }
+        }
+    }
+
+    return parents;
+}
+
+static auto join(const std::vector<std::string>& values, const std::string_view separator) -> std::string
+{
+    return values                                          //
+           | std::views::join_with(std::string(separator)) //
+           | std::ranges::to<std::string>();               //
+}
+
+/// @brief  Finds the reason every outdated translation unit is compiled.
+/// @param  build_info  The result of the analysis, including the state of the previous build.
+/// @return The reason of every file in `build_info.files_to_compile`.
+/// @note   A file can be outdated for several reasons, in which case the most direct one is reported:
+///         a change to the configuration, then a change to the file itself, then a removed include,
+///         and finally the shortest include chain to a changed file.
+auto explain::get_reasons(const build_caching::Info& build_info) -> std::map<std::filesystem::path, Reason>
+{
+    std::map<std::filesystem::path, Reason> reasons;
+
+    if (build_info.configuration_changed)
+    {
+        const auto reason = build_info.is_first_build
+                                ? Reason{.cause = Cause::FIRST_BUILD}
+                                : Reason{.cause          = Cause::CONFIGURATION_CHANGED,
+                                         .changed_fields = build_info.changed_configuration_fields};
+
+        for (const auto& file : build_info.files_to_compile)
+        {
+            reasons.emplace(file, reason);
+        }
+
+        return reasons;
+    }
+
+    const auto files_to_compile =
+        build_info.files_to_compile | std::ranges::to<std::unordered_set<std::filesystem::path>>();
+
+    for (const auto& file : build_info.changed_files)
+    {
+        if (files_to_compile.contains(file))
+        {
+            reasons.emplace(file, get_own_change_reason(build_info, file));
+        }
+    }
+
+    for (const auto& [file, dependent_files] : build_info.old_dependency_graph.data())
+    {
+        const auto file_was_removed = !build_info.dependency_graph.data().contains(file);
+
+        if (!file_was_removed)
+        {
+            continue;
+        }
+
+        for (const auto& dependent_file : dependent_files)
+        {
+            if (files_to_compile.contains(dependent_file))
+            {
+                reasons.try_emplace(dependent_file,
+                                    Reason{.cause = Cause::DEPENDENCY_REMOVED, .removed_file = file});
+            }
+        }
+    }
+
+    const auto parents = get_include_parents(build_info.dependency_graph, build_info.changed_files);
+
+    for (const auto& file : build_info.files_to_compile)
+    {
+        if (reasons.contains(file))
+        {
+            continue;
+        }
+
+        ASSERT(parents.contains(file));
+        std::vector<std::filesystem::path> chain = {file};
+
+        while (parents.at(chain.back()) != chain.back())
+        {
+            chain.push_back(parents.at(chain.back()));
+        }
+
+        reasons.emplace(file, Reason{.cause = Cause::INCLUDED_FILE_CHANGED, .include_chain = std::move(chain)});
+    }
+
+    return reasons;
+}
+
+auto explain::to_string(const Reason& reason) -> std::string
+{
+    switch (reason.cause)
+    {
+    case Cause::FIRST_BUILD:
+        return "no previous build of the configuration was recorded";
+    case Cause::CONFIGURATION_CHANGED:
+    {
+        if (reason.changed_fields.empty())
+        {
+            return "the configuration changed";
+        }
+
+        const auto fields = reason.changed_fields                                                                 //
+                            | std::views::transform([](const auto& field) { return std::format("'{}'", field); }) //
+                            | std::ranges::to<std::vector>();                                                     //
+
+        return std::format("the configuration changed ({})", join(fields, ", "));
+    }
+    case Cause::NEW_FILE:
+        return "it was not built before";
+    case Cause::MISSING_OBJECT:
+        return "its object file is missing";
+    case Cause::CONTENTS_CHANGED:
+        return "its contents changed";
+    case Cause::DEPENDENCY_REMOVED:
+        return std::format("it included '{}', which was removed", reason.removed_file.native());
+    case Cause::INCLUDED_FILE_CHANGED:
+    {
+        ASSERT(reason.include_chain.size() >= 2);
+
+        const auto chain = reason.include_chain                                                      //
+                           | std::views::transform([](const auto& file) { return file.string(); }) //
+                           | std::ranges::to<std::vector>();                                       //
+
+        return std::format("'{}' changed ({})", reason.include_chain.back().native(), join(chain, " -> "));
+    }
+    case Cause::PRECOMPILED_HEADER_CHANGED:
+        return "the precompiled header changed";
+    }
+
+    std::unreachable();
+}
+
+auto explain::format_reasons(const std::string_view configuration_name,
+                             const std::map<std::filesystem::path, Reason>& reasons,
+                             const std::ptrdiff_t num_of_source_files) -> std::string
+{
+    if (reasons.empty())
+    {
+        return std::format("Configuration '{}': all {} translation units are up to date.\n",
+                           configuration_name,
+                           num_of_source_files);
+    }
+
+    auto result = std::format("Configuration '{}': {} of {} translation units are outdated.\n",
+                              configuration_name,
+                              reasons.size(),
+                              num_of_source_files);
+
+    for (const auto& [file, reason] : reasons)
+    {
+        result += std::format("  {}: {}\n", file.native(), to_string(reason));
+    }
+
+    return result;
+}
@@ -0,0 +1,46 @@
+#ifndef SOURCE_COMMANDS_BUILD_EXPLAIN_HPP
+#define SOURCE_COMMANDS_BUILD_EXPLAIN_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+
+// Why each translation unit is compiled, printed by `easy-make build --explain`.
+namespace explain
+{
+    enum class Cause
+    {
+        FIRST_BUILD,                // No previous build of the configuration was recorded.
+        CONFIGURATION_CHANGED,
+        NEW_FILE,
+        MISSING_OBJECT,
+        CONTENTS_CHANGED,
+        DEPENDENCY_REMOVED,         // A file that it included was deleted.
+        INCLUDED_FILE_CHANGED,
+        PRECOMPILED_HEADER_CHANGED, // Decided after the analysis, see `handle_precompiled_headers`.
+    };
+
+    struct Reason
+    {
+        Cause cause;
+        std::vector<std::string> changed_fields{};          // For `CONFIGURATION_CHANGED`, if they were recorded.
+        std::filesystem::path removed_file{};               // For `DEPENDENCY_REMOVED`.
+        std::vector<std::filesystem::path> include_chain{}; // For `INCLUDED_FILE_CHANGED`, ends with the changed file.
+    };
+
+    // Returns the reason of every file in `build_info.files_to_compile`.
+    auto get_reasons(const build_caching::Info& build_info) -> std::map<std::filesystem::path, Reason>;
+
+    auto to_string(const Reason& reason) -> std::string;
+
+    auto format_reasons(std::string_view configuration_name,
+                        const std::map<std::filesystem::path, Reason>& reasons,
+                        std::ptrdiff_t num_of_source_files) -> std::string;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_EXPLAIN_HPP
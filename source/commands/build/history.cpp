@@ -0,0 +1,218 @@
+#include "source/commands/build/history.hpp"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error> // std::error_code
+#include <utility> // std::unreachable
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/parameters/parameters.hpp"
+
+// Configurations that are built concurrently append to the same file.
+static auto get_history_mutex() -> std::mutex&
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+auto history::get_history_file_path(const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / params::HISTORY_FILE_NAME;
+}
+
+auto history::get_old_history_file_path(const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / params::OLD_HISTORY_FILE_NAME;
+}
+
+auto history::get_current_timestamp() -> std::int64_t
+{
+    const auto now = std::chrono::system_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+}
+
+auto history::get_cause_name(const explain::Cause cause) -> std::string_view
+{
+    using enum explain::Cause;
+
+    switch (cause)
+    {
+    case FIRST_BUILD:
+        return "first_build";
+
+    case CONFIGURATION_CHANGED:
+        return "configuration_changed";
+
+    case NEW_FILE:
+        return "new_file";
+
+    case MISSING_OBJECT:
+        return "missing_object";
+
+    case CONTENTS_CHANGED:
+        return "contents_changed";
+
+    case DEPENDENCY_REMOVED:
+        return "dependency_removed";
+
+    case INCLUDED_FILE_CHANGED:
+        return "included_file_changed";
+
+    case PRECOMPILED_HEADER_CHANGED:
+        return "precompiled_header_changed";
+    }
+
+    std::unreachable();
+}
+
+static auto to_json(const history::BuildRecord& record) -> nlohmann::ordered_json
+{
+    return {
+        {"type",             "build"                       },
+        {"timestamp",        record.timestamp              },
+        {"configuration",    record.configuration          },
+        {"duration_s",       record.duration_in_seconds    },
+        {"exit_status",      record.exit_status            },
+        {"files_compiled",   record.num_of_files_compiled  },
+        {"files_up_to_date", record.num_of_files_up_to_date},
+    };
+}
+
+static auto to_json(const history::TranslationUnitRecord& record) -> nlohmann::ordered_json
+{
+    return {
+        {"type",          "tu"                           },
+        {"timestamp",     record.timestamp               },
+        {"configuration", record.configuration           },
+        {"file",          record.file.string()           },
+        {"cause",         record.cause                   },
+        {"reason",        record.reason                  },
+        {"success",       record.is_successful           },
+        {"duration_s",    record.duration_in_seconds     },
+        {"peak_rss_kb",   record.peak_memory_in_kilobytes},
+    };
+}
+
+static auto append_lines(const std::filesystem::path& path_to_root, const std::string& lines) -> void
+{
+    std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME);
+
+    const auto history_file_path = history::get_history_file_path(path_to_root);
+
+    std::lock_guard lock(get_history_mutex());
+    auto error = std::error_code{};
+
+    // The old log is replaced, so that the history of a long-lived project does not grow without bound.
+    if (std::filesystem::file_size(history_file_path, error) >= history::MAX_HISTORY_FILE_SIZE && !error)
+    {
+        std::filesystem::rename(history_file_path, history::get_old_history_file_path(path_to_root), error);
+    }
+
+    auto history_file = std::ofstream(history_file_path, std::ios::app);
+
+    if (!history_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", history_file_path.native()));
+    }
+
+    history_file << lines << std::flush;
+}
+
+auto history::append(const std::filesystem::path& path_to_root, const BuildRecord& record) -> void
+{
+    append_lines(path_to_root, to_json(record).dump() + '\n');
+}
+
+auto history::append(const std::filesystem::path& path_to_root,
+                     const std::vector<TranslationUnitRecord>& records) -> void
+{
+    if (records.empty())
+    {
+        return;
+    }
+
+    std::string lines;
+
+    for (const auto& record : records)
+    {
+        lines += to_json(record).dump();
+        lines += '\n';
+    }
+
+    append_lines(path_to_root, lines);
+}
+
+static auto parse_build_record(const nlohmann::json& json) -> history::BuildRecord
+{
+    return {
+        .timestamp               = json.at("timestamp").get<std::int64_t>(),
+        .configuration           = json.at("configuration").get<std::string>(),
+        .duration_in_seconds     = json.at("duration_s").get<double>(),
+        .exit_status             = json.at("exit_status").get<int>(),
+        .num_of_files_compiled   = json.at("files_compiled").get<int>(),
+        .num_of_files_up_to_date = json.value("files_up_to_date", 0),
+    };
+}
+
+static auto parse_translation_unit_record(const nlohmann::json& json) -> history::TranslationUnitRecord
+{
+    return {
+        .timestamp                = json.at("timestamp").get<std::int64_t>(),
+        .configuration            = json.at("configuration").get<std::string>(),
+        .file                     = json.at("file").get<std::string>(),
+        .cause                    = json.at("cause").get<std::string>(),
+        .reason                   = json.at("reason").get<std::string>(),
+        .is_successful            = json.at("success").get<bool>(),
+        .duration_in_seconds      = json.at("duration_s").get<double>(),
+        .peak_memory_in_kilobytes = json.at("peak_rss_kb").get<long>(),
+    };
+}
+
+static auto read_file(const std::filesystem::path& history_file_path, history::History& history) -> void
+{
+    auto history_file = std::ifstream(history_file_path);
+
+    for (std::string line; std::getline(history_file, line);)
+    {
+        const auto json = nlohmann::json::parse(line, nullptr, false);
+
+        if (json.is_discarded() || !json.is_object())
+        {
+            continue;
+        }
+
+        try
+        {
+            const auto type = json.at("type").get<std::string>();
+
+            if (type == "build")
+            {
+                history.builds.push_back(parse_build_record(json));
+            }
+            else if (type == "tu")
+            {
+                history.translation_units.push_back(parse_translation_unit_record(json));
+            }
+        }
+        catch (const nlohmann::json::exception&)
+        {
+            continue;
+        }
+    }
+}
+
+auto history::read(const std::filesystem::path& path_to_root) -> History
+{
+    History history;
+    read_file(get_old_history_file_path(path_to_root), history);
+    read_file(get_history_file_path(path_to_root), history);
+
+    return history;
+}
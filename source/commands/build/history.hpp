@@ -0,0 +1,66 @@
+#ifndef SOURCE_COMMANDS_BUILD_HISTORY_HPP
+#define SOURCE_COMMANDS_BUILD_HISTORY_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "source/commands/build/explain.hpp"
+
+// The append-only log of every build in `easy-make-build/history.jsonl`, read by `easy-make report`.
+// Every line is a JSON object, for a build of a configuration or for a translation unit that it compiled.
+// Once the log reaches `MAX_HISTORY_FILE_SIZE`, it replaces `history.old.jsonl` and a new one is started,
+// so the history never takes more than twice that size.
+namespace history
+{
+    inline constexpr std::uintmax_t MAX_HISTORY_FILE_SIZE = 16 * 1024 * 1024;
+
+    struct BuildRecord
+    {
+        std::int64_t timestamp; // Seconds since the Unix epoch, when the build started.
+        std::string configuration;
+        double duration_in_seconds;
+        int exit_status;
+        int num_of_files_compiled;
+        int num_of_files_up_to_date{}; // Source files whose object files were reused.
+    };
+
+    struct TranslationUnitRecord
+    {
+        std::int64_t timestamp;
+        std::string configuration;
+        std::filesystem::path file;
+        std::string cause;               // Why the file was compiled, see `get_cause_name`.
+        std::string reason;              // Same, as `--explain` prints it.
+        bool is_successful;              // Of the compilation.
+        double duration_in_seconds{};    // Zero if the compilation failed.
+        long peak_memory_in_kilobytes{}; // Zero if the object file was shared.
+    };
+
+    struct History
+    {
+        std::vector<BuildRecord> builds;                      // In the order they were recorded.
+        std::vector<TranslationUnitRecord> translation_units; // Same.
+    };
+
+    auto get_history_file_path(const std::filesystem::path& path_to_root) -> std::filesystem::path;
+
+    auto get_old_history_file_path(const std::filesystem::path& path_to_root) -> std::filesystem::path;
+
+    auto get_current_timestamp() -> std::int64_t;
+
+    auto get_cause_name(explain::Cause cause) -> std::string_view;
+
+    // The records are written with a single call, so that concurrent builds do not interleave them.
+    auto append(const std::filesystem::path& path_to_root, const BuildRecord& record) -> void;
+
+    auto append(const std::filesystem::path& path_to_root, const std::vector<TranslationUnitRecord>& records) -> void;
+
+    // Reads the old log before the current one. Lines that cannot be parsed (e.g. the last line of a build that was
+    // killed while writing it) are skipped.
+    auto read(const std::filesystem::path& path_to_root) -> History;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_HISTORY_HPP
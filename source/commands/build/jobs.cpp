@@ -0,0 +1,230 @@
+#include "source/commands/build/jobs.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "source/utils/macros/assert.hpp"
+
+extern char** environ;
+
+namespace
+{
+    struct JobSlots
+    {
+        std::mutex mutex;
+        std::condition_variable slot_freed;
+        int max_num_of_jobs     = std::numeric_limits<int>::max();
+        int num_of_running_jobs = 0;
+    };
+
+    struct ProcessResult
+    {
+        int exit_status;
+        long peak_memory_in_kilobytes;
+    };
+}
+
+static auto get_job_slots() -> JobSlots&
+{
+    static JobSlots job_slots;
+
+    return job_slots;
+}
+
+auto jobs::set_max_num_of_jobs(const int max_num_of_jobs) -> void
+{
+    ASSERT(max_num_of_jobs > 0);
+
+    auto& job_slots = get_job_slots();
+
+    {
+        std::lock_guard lock(job_slots.mutex);
+        job_slots.max_num_of_jobs = max_num_of_jobs;
+    }
+
+    job_slots.slot_freed.notify_all();
+}
+
+// The longest time between two checks of the limits of a command.
+// The checks start more often, so that short commands are not kept waiting.
+constexpr auto MAX_WATCHDOG_INTERVAL = std::chrono::milliseconds(50);
+
+// The peak resident set size of the largest process in the process group, from `/proc`.
+// Processes that exit while they are read are skipped.
+static auto get_peak_memory_of_process_group(const pid_t process_group_id) -> long
+{
+    long peak_memory_in_kilobytes = 0;
+    std::error_code error;
+
+    for (auto entry = std::filesystem::directory_iterator("/proc", error);
+         !error && entry != std::filesystem::directory_iterator();
+         entry.increment(error))
+    {
+        const auto& process_directory = entry->path();
+
+        if (!std::ranges::all_of(process_directory.filename().native(), [](const char c) { return std::isdigit(c); }))
+        {
+            continue;
+        }
+
+        // The process group is the fifth field. The second one is the name of the command in parentheses,
+        // which may contain spaces, so the fields are read from the last parenthesis.
+        auto stat_file = std::ifstream(process_directory / "stat");
+        std::string stat;
+        std::getline(stat_file, stat);
+
+        const auto end_of_name = stat.rfind(')');
+
+        if (end_of_name == std::string::npos) // The process exited.
+        {
+            continue;
+        }
+
+        auto fields             = std::istringstream(stat.substr(end_of_name + 1));
+        auto state              = ' ';
+        pid_t parent_process_id = 0;
+        pid_t group_id          = 0;
+
+        if (!(fields >> state >> parent_process_id >> group_id) || group_id != process_group_id)
+        {
+            continue;
+        }
+
+        auto status_file = std::ifstream(process_directory / "status");
+
+        for (std::string line; std::getline(status_file, line);)
+        {
+            // For example "VmHWM:     1234 kB".
+            if (line.starts_with("VmHWM:"))
+            {
+                const auto memory_in_kilobytes = std::strtol(line.c_str() + line.find(':') + 1, nullptr, 10);
+                peak_memory_in_kilobytes       = std::max(peak_memory_in_kilobytes, memory_in_kilobytes);
+                break;
+            }
+        }
+    }
+
+    return peak_memory_in_kilobytes;
+}
+
+// Behaves like `std::system`, but also reports the peak memory of the command.
+// The usage that `wait4` reports includes the processes that the shell and the compiler driver waited for.
+// A command with limits is checked until it exits, and its process group is killed once it exceeds them.
+static auto run_shell_command(const std::string& command, const jobs::Limits& limits) -> ProcessResult
+{
+    const char* const arguments[] = {"sh", "-c", command.c_str(), nullptr};
+    const auto is_limited         = limits.max_seconds.has_value() || limits.max_memory_in_megabytes.has_value();
+    pid_t process_id              = 0;
+
+    // The shell leads the new process group, so the compiler that it starts can be killed together with it.
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+
+    if (is_limited)
+    {
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+        posix_spawnattr_setpgroup(&attributes, 0);
+    }
+
+    const auto spawn_error =
+        posix_spawn(&process_id, "/bin/sh", nullptr, &attributes, const_cast<char* const*>(arguments), environ);
+    posix_spawnattr_destroy(&attributes);
+
+    if (spawn_error != 0)
+    {
+        return {.exit_status = EXIT_FAILURE, .peak_memory_in_kilobytes = 0};
+    }
+
+    constexpr auto no_limit  = std::numeric_limits<double>::infinity();
+    const auto start_time    = std::chrono::steady_clock::now();
+    auto interval            = std::chrono::milliseconds(1);
+    auto options             = is_limited ? WNOHANG : 0;
+    long watched_peak_memory = 0;
+    auto status              = 0;
+    rusage usage{};
+
+    while (true)
+    {
+        const auto waited_process_id = wait4(process_id, &status, options, &usage);
+
+        if (waited_process_id == process_id)
+        {
+            break;
+        }
+        else if (waited_process_id == -1)
+        {
+            if (errno != EINTR)
+            {
+                return {.exit_status = EXIT_FAILURE, .peak_memory_in_kilobytes = 0};
+            }
+
+            continue;
+        }
+
+        // The command is still running.
+        if (limits.max_memory_in_megabytes.has_value())
+        {
+            watched_peak_memory = std::max(watched_peak_memory, get_peak_memory_of_process_group(process_id));
+        }
+
+        const auto elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+
+        if (elapsed_time.count() > limits.max_seconds.value_or(no_limit) ||
+            watched_peak_memory / 1024.0 > limits.max_memory_in_megabytes.value_or(no_limit))
+        {
+            kill(-process_id, SIGKILL);
+            options = 0; // Wait for the shell to exit.
+            continue;
+        }
+
+        std::this_thread::sleep_for(interval);
+        interval = std::min(interval * 2, MAX_WATCHDOG_INTERVAL);
+    }
+
+    // A killed compiler is not waited for by its shell, so its memory is only known from the checks.
+    return {.exit_status = status, .peak_memory_in_kilobytes = std::max(usage.ru_maxrss, watched_peak_memory)};
+}
+
+auto jobs::run(const std::string& command, const Limits& limits) -> Result
+{
+    auto& job_slots = get_job_slots();
+
+    {
+        std::unique_lock lock(job_slots.mutex);
+        job_slots.slot_freed.wait(lock,
+                                  [&] { return job_slots.num_of_running_jobs < job_slots.max_num_of_jobs; });
+        ++job_slots.num_of_running_jobs;
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto process    = run_shell_command(command, limits);
+    const auto end_time   = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard lock(job_slots.mutex);
+        --job_slots.num_of_running_jobs;
+    }
+
+    job_slots.slot_freed.notify_one();
+
+    return {
+        .exit_status              = process.exit_status,
+        .duration_in_seconds      = std::chrono::duration<double>(end_time - start_time).count(),
+        .peak_memory_in_kilobytes = process.peak_memory_in_kilobytes,
+    };
+}
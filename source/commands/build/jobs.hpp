@@ -0,0 +1,32 @@
+#ifndef SOURCE_COMMANDS_BUILD_JOBS_HPP
+#define SOURCE_COMMANDS_BUILD_JOBS_HPP
+
+#include <optional>
+#include <string>
+
+namespace jobs
+{
+    // Limits the number of compiler and linker processes that run at the same time.
+    // Configurations that are built concurrently share the limit. Unlimited by default.
+    auto set_max_num_of_jobs(int max_num_of_jobs) -> void;
+
+    struct Result
+    {
+        int exit_status;
+        double duration_in_seconds;    // Excludes the time spent waiting for other jobs.
+        long peak_memory_in_kilobytes; // Peak resident set size of the largest process of the command.
+    };
+
+    // Once a command exceeds one of its limits, it is stopped. Unlimited by default.
+    struct Limits
+    {
+        std::optional<double> max_seconds{};             // Wall time, from when the command starts.
+        std::optional<double> max_memory_in_megabytes{}; // Peak resident set size of any process of the command.
+    };
+
+    // Runs `command` in a shell, like `std::system`, once fewer than the maximum number of jobs are running.
+    // A command with limits runs in a process group of its own, which is killed when the command exceeds them.
+    auto run(const std::string& command, const Limits& limits = {}) -> Result;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_JOBS_HPP
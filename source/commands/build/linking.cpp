@@ -1,21 +1,399 @@
 #include "source/commands/build/linking.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <format>
+#include <fstream>
+#include <optional>
 #include <ranges>
+#include <stdexcept>
 #include <string_view>
+#include <thread>
 
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build.hpp"
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/commands/build/partial_links/partial_links.hpp"
+#include "source/commands/build/trace.hpp"
 #include "source/parameters/parameters.hpp"
 #include "source/utils/macros/assert.hpp"
 #include "source/utils/print.hpp"
+#include "source/utils/utils.hpp"
 
 using namespace std::literals;
 
-static auto print_linking_result(const bool linking_successful, const std::string_view output_path) -> void
+static auto is_program_installed(const std::string_view program_name) -> bool
+{
+    const auto* const path_variable = std::getenv("PATH");
+
+    if (path_variable == nullptr)
+    {
+        return false;
+    }
+
+    for (const auto directory : std::string_view(path_variable) | std::views::split(':'))
+    {
+        const auto path_to_program = std::filesystem::path(std::string_view(directory)) / program_name;
+        auto error_code            = std::error_code{};
+
+        if (!std::filesystem::is_regular_file(path_to_program, error_code))
+        {
+            continue;
+        }
+
+        const auto permissions = std::filesystem::status(path_to_program, error_code).permissions();
+        const auto executable  = std::filesystem::perms::owner_exec | std::filesystem::perms::group_exec |
+                                std::filesystem::perms::others_exec;
+
+        if (!error_code && (permissions & executable) != std::filesystem::perms::none)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto detect_fastest_linker() -> std::string
+{
+    // The compiler drivers look for `ld.<linker>` when given `-fuse-ld=<linker>`.
+    static const auto fastest_linker = []() -> std::string
+    {
+        for (const auto linker : {"mold"sv, "lld"sv, "gold"sv})
+        {
+            if (is_program_installed(std::format("ld.{}", linker)))
+            {
+                return std::string(linker);
+            }
+        }
+
+        return "default";
+    }();
+
+    return fastest_linker;
+}
+
+auto get_linker_flags(const std::string_view linker, const int num_of_threads) -> std::vector<std::string>
+{
+    ASSERT(linker != "auto");
+    ASSERT(num_of_threads >= 1);
+
+    if (linker == "default")
+    {
+        return {};
+    }
+
+    std::vector<std::string> flags{std::format("-fuse-ld={}", linker)};
+
+    // `bfd` is single-threaded.
+    if (linker == "lld")
+    {
+        flags.push_back(std::format("-Wl,--threads={}", num_of_threads));
+    }
+    else if (linker == "gold")
+    {
+        flags.push_back("-Wl,--threads");
+        flags.push_back(std::format("-Wl,--thread-count={}", num_of_threads));
+    }
+    else if (linker == "mold")
+    {
+        flags.push_back(std::format("-Wl,--thread-count={}", num_of_threads));
+    }
+
+    return flags;
+}
+
+static auto get_linker(const Configuration& configuration) -> std::string
+{
+    const auto linker = configuration.linker.value_or("default");
+
+    return linker == "auto" ? detect_fastest_linker() : linker;
+}
+
+static auto get_link_data_file_path(const std::filesystem::path& object_files_path) -> std::filesystem::path
+{
+    return object_files_path / params::LINK_DATA_FILE_NAME;
+}
+
+// The libraries that `-l<name>` refers to, in the directories that are given with `-L<directory>`.
+// Libraries in the linker's default directories are not looked for, since they are not built by the project.
+static auto find_libraries(const std::vector<std::string>& arguments) -> std::vector<std::filesystem::path>
+{
+    std::vector<std::filesystem::path> library_directories;
+    std::vector<std::string> library_names;
+
+    for (auto index = 0UZ; index < arguments.size(); ++index)
+    {
+        const auto& argument = arguments[index];
+
+        if (!argument.starts_with("-L") && !argument.starts_with("-l"))
+        {
+            continue;
+        }
+
+        // Both `-lname` and `-l name` are accepted.
+        auto value = argument.substr(2);
+
+        if (value.empty() && index + 1 < arguments.size())
+        {
+            value = arguments[++index];
+        }
+
+        if (argument.starts_with("-L"))
+        {
+            library_directories.emplace_back(value);
+        }
+        else
+        {
+            library_names.push_back(value);
+        }
+    }
+
+    std::vector<std::filesystem::path> libraries;
+
+    for (const auto& name : library_names)
+    {
+        // `-l:file` names the file itself. Otherwise, the linker prefers a shared library in every directory.
+        const auto file_names = name.starts_with(':')
+                                    ? std::vector{name.substr(1)}
+                                    : std::vector{std::format("lib{}.so", name), std::format("lib{}.a", name)};
+
+        const auto find_library = [&]() -> std::optional<std::filesystem::path>
+        {
+            for (const auto& directory : library_directories)
+            {
+                for (const auto& file_name : file_names)
+                {
+                    auto error_code = std::error_code{};
+
+                    if (std::filesystem::is_regular_file(directory / file_name, error_code))
+                    {
+                        return directory / file_name;
+                    }
+                }
+            }
+
+            return std::nullopt;
+        };
+
+        if (const auto library = find_library(); library.has_value())
+        {
+            libraries.push_back(*library);
+        }
+    }
+
+    return libraries;
+}
+
+// Hashes the link command together with the timestamps of every file it reads,
+// so an unchanged signature means that linking again would produce the same output.
+static auto get_link_signature(const std::string_view link_command,
+                               const std::filesystem::path& object_files_path,
+                               const std::vector<std::string>& arguments) -> std::uint64_t
+{
+    auto input_files = std::filesystem::directory_iterator(object_files_path)                         //
+                       | std::views::filter([](const auto& entry) { return entry.is_regular_file(); }) //
+                       | std::views::transform([](const auto& entry) { return entry.path(); })         //
+                       | std::views::filter([](const auto& path) { return path.extension() == ".o"; }) //
+                       | std::ranges::to<std::vector>();                                              //
+    std::ranges::sort(input_files);
+
+    // Libraries and linker scripts that are passed by path.
+    for (const auto& argument : arguments)
+    {
+        auto error_code = std::error_code{};
+
+        if (std::filesystem::is_regular_file(argument, error_code))
+        {
+            input_files.emplace_back(argument);
+        }
+    }
+
+    // Libraries that are passed by name.
+    const auto libraries = find_libraries(arguments);
+    input_files.insert(input_files.end(), libraries.begin(), libraries.end());
+
+    auto result = build_caching::hash_string(link_command);
+
+    for (const auto& file : input_files)
+    {
+        const auto last_write_time = std::filesystem::last_write_time(file).time_since_epoch().count();
+
+        result = build_caching::hash_string(file.native(), result);
+        result = build_caching::hash_string(std::to_string(last_write_time), result);
+        result = build_caching::hash_string(std::to_string(std::filesystem::file_size(file)), result);
+    }
+
+    return result;
+}
+
+static auto get_old_link_signature(const std::filesystem::path& object_files_path) -> std::optional<std::uint64_t>
+{
+    auto data_file = std::ifstream(get_link_data_file_path(object_files_path));
+
+    if (!data_file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    nlohmann::json json;
+    data_file >> json;
+    ASSERT(json.is_object());
+
+    return json.at("signature").get<std::uint64_t>();
+}
+
+static auto write_link_signature(const std::filesystem::path& object_files_path, const std::uint64_t signature)
+    -> void
+{
+    const auto data_file_path = get_link_data_file_path(object_files_path);
+    auto data_file            = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    data_file << nlohmann::json{{"signature", signature}}.dump();
+}
+
+// The libraries of the dependencies, in the order they are given to the linker.
+static auto get_library_arguments(const std::vector<Configuration>& dependencies) -> std::vector<std::string>
+{
+    std::vector<std::string> arguments;
+
+    for (const auto& dependency : dependencies)
+    {
+        ASSERT(dependency.type == "static" || dependency.type == "shared");
+
+        const auto library_path = get_output_path(dependency);
+        arguments.push_back(library_path.string());
+
+        // Lets the output find the shared library at run time without installing it.
+        if (dependency.type == "shared")
+        {
+            const auto library_directory = std::filesystem::absolute(library_path).parent_path();
+            arguments.push_back(std::format("-Wl,-rpath,{}", library_directory.string()));
+        }
+    }
+
+    return arguments;
+}
+
+static auto uses_lto(const Configuration& configuration) -> bool
+{
+    return configuration.lto == "full" || configuration.lto == "thin";
+}
+
+/// @brief  Returns the flags that run the link-time optimization of the configuration.
+/// @note   ThinLTO (Clang only) keeps a cache of optimized modules in the build directory,
+///         so relinking after a change only optimizes the modules that are affected by it.
+///         GCC runs its link-time optimization in parallel instead.
+static auto get_lto_flags(const Configuration& configuration,
+                          const std::string_view linker,
+                          const std::filesystem::path& object_files_path,
+                          const int num_of_threads) -> std::vector<std::string>
+{
+    if (!uses_lto(configuration))
+    {
+        return {};
+    }
+
+    if (!configuration.compiler->contains("clang"))
+    {
+        return {"-flto=auto"};
+    }
+
+    if (configuration.lto == "full")
+    {
+        return {"-flto"};
+    }
+
+    const auto cache_directory = object_files_path / params::LTO_CACHE_DIRECTORY_NAME;
+    std::filesystem::create_directories(cache_directory);
+
+    // Other linkers load the LLVM plugin, which takes its options through `-plugin-opt`.
+    if (linker == "lld")
+    {
+        return {
+            "-flto=thin",
+            std::format("-Wl,--thinlto-cache-dir={}", cache_directory.string()),
+            std::format("-Wl,--thinlto-jobs={}", num_of_threads),
+        };
+    }
+
+    return {
+        "-flto=thin",
+        std::format("-Wl,-plugin-opt,cache-dir={}", cache_directory.string()),
+        std::format("-Wl,-plugin-opt,jobs={}", num_of_threads),
+    };
+}
+
+// The symbol index of an archive of LTO objects can only be created through the compiler's plugin.
+static auto get_archiver(const Configuration& configuration) -> std::string_view
+{
+    if (!uses_lto(configuration))
+    {
+        return "ar";
+    }
+
+    return configuration.compiler->contains("clang") ? "llvm-ar" : "gcc-ar";
+}
+
+static auto create_link_command(const Configuration& configuration,
+                                const std::filesystem::path& object_files_path,
+                                const std::string_view input_files,
+                                const std::string_view output_path,
+                                const std::vector<std::string>& arguments) -> std::string
+{
+    const auto type = configuration.type.value_or("executable");
+
+    // A thin archive only references the object files, so creating it copies nothing.
+    if (type == "static")
+    {
+        return std::format("{} rcsT {} {}", get_archiver(configuration), output_path, input_files);
+    }
+
+    const auto num_of_threads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    const auto linker         = get_linker(configuration);
+    auto flags                = get_linker_flags(linker, num_of_threads);
+    const auto lto_flags      = get_lto_flags(configuration, linker, object_files_path, num_of_threads);
+    flags.insert(flags.end(), lto_flags.begin(), lto_flags.end());
+
+    if (type == "shared")
+    {
+        const auto file_name = std::filesystem::path(output_path).filename().string();
+        flags.insert(flags.begin(), {"-shared"s, std::format("-Wl,-soname,{}", file_name)});
+    }
+
+    const auto flag_string     = flags | std::views::join_with(" "sv) | std::ranges::to<std::string>();
+    const auto argument_string = arguments | std::views::join_with(" "sv) | std::ranges::to<std::string>();
+
+    return std::format(
+        "{} {} {} {} -o {}", *configuration.compiler, flag_string, input_files, argument_string, output_path);
+}
+
+// Collects the `.dwo` files of the executable into `<executable>.dwp`, where debuggers look for them.
+static auto package_split_debug_info(const Configuration& configuration, const std::string_view output_path) -> bool
+{
+    const auto packager        = configuration.compiler->contains("clang") ? "llvm-dwp"sv : "dwp"sv;
+    const auto package_path    = utils::get_split_debug_info_package_path(output_path);
+    const auto package_command = std::format("{} -e {} -o {}", packager, output_path, package_path.native());
+
+    return jobs::run(package_command).exit_status == EXIT_SUCCESS;
+}
+
+static auto print_linking_result(const bool linking_successful,
+                                 const std::string_view output_kind,
+                                 const std::string_view output_path) -> void
 {
     if (linking_successful)
     {
-        utils::print_success("Linking complete. Executable located at '{}'.", output_path);
+        utils::print_success("Linking complete. {} located at '{}'.", output_kind, output_path);
     }
     else
     {
@@ -23,38 +401,149 @@ static auto print_linking_result(const bool linking_successful, const std::strin
     }
 }
 
+auto get_output_path(const Configuration& configuration) -> std::filesystem::path
+{
+    ASSERT(configuration.output_name.has_value());
+
+    return std::filesystem::path(configuration.output_path.value_or(".")) / *configuration.output_name;
+}
+
+/// @brief  Links the object files of the configuration into its executable or library.
+/// @note   Uses the linker selected by the `linker` field, with as many threads as the linker supports.
+///         Static libraries are thin archives instead.
+///         Linking is skipped if neither the link command nor any of its input files (including the libraries
+///         of the dependencies and `-l` libraries in `-L` directories) changed since the previous successful link
+///         and the output still exists.
+///         With `"debugInfo": "packaged"`, the split debug info is packaged after linking.
+///         With `"partialLinks": true`, the object files of every source directory are linked first,
+///         unless the configuration uses LTO.
 auto link_object_files(const Configuration& configuration,
                        const std::filesystem::path& path_to_root,
                        const std::vector<std::string>& flags,
+                       const std::vector<Configuration>& dependencies,
                        const bool is_quiet) -> bool
 {
     ASSERT(configuration.name.has_value());
     ASSERT(configuration.compiler.has_value());
     ASSERT(configuration.output_name.has_value());
 
-    const auto object_files_path = (path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name).string();
-    const auto output_path =
-        (std::filesystem::path(configuration.output_path.value_or(".")) / *configuration.output_name).string();
+    const auto object_files_path = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
+    const auto output_path       = get_output_path(configuration).string();
+    const auto is_library        = configuration.type == "static" || configuration.type == "shared";
 
     if (configuration.output_path.has_value())
     {
         std::filesystem::create_directories(*configuration.output_path);
     }
 
+    const auto library_arguments = get_library_arguments(dependencies);
+    auto arguments               = flags;
+    arguments.insert(arguments.end(), library_arguments.begin(), library_arguments.end());
+
+    // The final link reads one relocatable object per source directory instead of every object file.
+    auto input_files = std::format("{}/*.o", object_files_path.string());
+
+    // A partial link of LTO objects would either optimize each directory on its own or only combine the IR.
+    if (configuration.partial_links.value_or(false) && configuration.type != "static" && !uses_lto(configuration))
+    {
+        const auto source_files = get_code_files(configuration, path_to_root) //
+                                  | std::views::filter(&utils::is_source_file) //
+                                  | std::ranges::to<std::vector>();            //
+        const auto link_inputs  = partial_links::update_partial_links(configuration, path_to_root, source_files);
+
+        if (!link_inputs.has_value())
+        {
+            events::report_error(link_inputs.error());
+
+            return false;
+        }
+
+        input_files = *link_inputs                                                                 //
+                      | std::views::transform([](const auto& path) { return path.string(); }) //
+                      | std::views::join_with(" "sv)                                             //
+                      | std::ranges::to<std::string>();                                          //
+    }
+
+    const auto link_command =
+        create_link_command(configuration, object_files_path, input_files, output_path, arguments);
+
+    const auto signature             = get_link_signature(link_command, object_files_path, arguments);
+    const auto package_path          = utils::get_split_debug_info_package_path(output_path);
+    const auto packages_debug_info   = configuration.debug_info == "packaged" && !is_library;
+    const auto is_up_to_date         = std::filesystem::is_regular_file(output_path) &&
+                                       get_old_link_signature(object_files_path) == signature;
+    const auto is_package_up_to_date = !packages_debug_info || std::filesystem::is_regular_file(package_path);
+
+    if (is_up_to_date && is_package_up_to_date)
+    {
+        if (!is_quiet)
+        {
+            utils::print_success("Linking skipped. {} located at '{}' is up to date.",
+                                 is_library ? "Library" : "Executable",
+                                 output_path);
+        }
+
+        return true;
+    }
+
+    // A failed link must not leave the signature or the debug info of the previous output behind.
+    std::filesystem::remove(get_link_data_file_path(object_files_path));
+    std::filesystem::remove(package_path);
+
+    // `ar` adds to an existing archive, which would keep the members of deleted object files.
+    if (configuration.type == "static")
+    {
+        std::filesystem::remove(output_path);
+    }
+
     if (!is_quiet)
     {
         std::println("Linking...");
     }
 
-    const auto flag_string = flags | std::views::join_with(" "sv) | std::ranges::to<std::string>();
-    const auto link_command =
-        std::format("{} {} {}/*.o -o {}", *configuration.compiler, flag_string, object_files_path, output_path);
+    if (events::is_enabled())
+    {
+        events::emit("link_start", {{"configuration", *configuration.name}, {"output", output_path}});
+    }
+
+    trace::Span span("Link", "link", {{"output", output_path}});
+    const auto link_result  = jobs::run(link_command);
+    auto linking_successful = link_result.exit_status == EXIT_SUCCESS;
+    span.add_argument("peak_rss_kb", link_result.peak_memory_in_kilobytes);
 
-    const auto linking_successful = std::system(link_command.c_str()) == EXIT_SUCCESS;
+    if (events::is_enabled())
+    {
+        const auto exit_code = events::get_exit_code(link_result.exit_status);
+
+        events::emit("link_end",
+                     {
+                         {"configuration", *configuration.name                               },
+                         {"output",        output_path                                       },
+                         {"success",       linking_successful                                },
+                         {"duration_s",    link_result.duration_in_seconds                   },
+                         {"exit_code",     std::int64_t{exit_code}                           },
+                         {"peak_rss_kb",   std::int64_t{link_result.peak_memory_in_kilobytes}},
+                     });
+    }
+
+    if (linking_successful && packages_debug_info)
+    {
+        linking_successful = package_split_debug_info(configuration, output_path);
+
+        if (!linking_successful && !is_quiet)
+        {
+            utils::print_error("Packaging split debug info failed.");
+        }
+    }
+
+    if (linking_successful)
+    {
+        write_link_signature(object_files_path, signature);
+    }
 
     if (!is_quiet)
     {
-        print_linking_result(linking_successful, output_path);
+        print_linking_result(linking_successful, is_library ? "Library" : "Executable", output_path);
     }
 
     return linking_successful;
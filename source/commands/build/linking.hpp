@@ -3,13 +3,26 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "source/configuration_parsing/configuration.hpp"
 
+// Returns the fastest linker that is installed ("mold", "lld" or "gold"), or "default" if none of them is.
+auto detect_fastest_linker() -> std::string;
+
+// Returns the flags that make the compiler driver link with `linker` using `num_of_threads` threads.
+// `linker` must be resolved, i.e. it cannot be "auto".
+auto get_linker_flags(std::string_view linker, int num_of_threads) -> std::vector<std::string>;
+
+// The path of the executable or library, relative to the root of the project.
+auto get_output_path(const Configuration& configuration) -> std::filesystem::path;
+
+// `dependencies` are the libraries to link against, each before the libraries it depends on.
 auto link_object_files(const Configuration& configuration,
                        const std::filesystem::path& path_to_root,
                        const std::vector<std::string>& flags,
+                       const std::vector<Configuration>& dependencies,
                        bool is_quiet) -> bool;
 
 #endif // SOURCE_COMMANDS_BUILD_LINKING_HPP
@@ -0,0 +1,800 @@
+#include "source/commands/build/modules/modules.hpp"
+
+#include <algorithm>
+#include <cctype> // std::isalnum
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional> // std::not_fn
+#include <map>
+#include <print>
+#include <ranges>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <system_error> // std::error_code
+#include <unordered_set>
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_caching/analysis_cache.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/build_state.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+using modules::ModuleGraph;
+using modules::ModuleInfo;
+
+namespace
+{
+    struct State
+    {
+        std::uint64_t configuration_hash = 0;       // Hash of the configuration the BMIs were built with.
+        std::unordered_set<std::string> header_units; // Header units that were built.
+    };
+}
+
+auto modules::scan_file(const std::filesystem::path& path) -> ModuleInfo
+{
+    std::ifstream file(path);
+
+    if (!file.is_open())
+    {
+        return {};
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    // Most files use neither, so they are not matched line by line.
+    if (!contents.view().contains("module") && !contents.view().contains("import"))
+    {
+        return {};
+    }
+
+    // Like includes, module declarations and imports are matched line by line.
+    static const std::regex module_declaration_regex(R"(^\s*(export\s+)?module\s+([\w.]+(?::[\w.]+)?)\s*;)");
+    static const std::regex module_import_regex(R"(^\s*(?:export\s+)?import\s+([\w.]+|:[\w.]+)\s*;)");
+    static const std::regex header_unit_import_regex(R"(^\s*(?:export\s+)?import\s*(<[^>]+>|\"[^\"]+\")\s*;)");
+
+    ModuleInfo info;
+    std::string primary_module_name; // Used to complete partition imports.
+    std::string line;
+    std::smatch match;
+
+    while (std::getline(contents, line))
+    {
+        if (std::regex_search(line, match, module_declaration_regex))
+        {
+            const auto is_exported  = match[1].matched;
+            const auto module_name  = match[2].str();
+            const auto is_partition = module_name.contains(':');
+            primary_module_name     = module_name.substr(0, module_name.find(':'));
+
+            if (is_exported || is_partition)
+            {
+                info.provided_module = module_name;
+                info.is_interface    = is_exported;
+            }
+            else
+            {
+                // An implementation unit implicitly imports its primary module interface.
+                info.required_modules.push_back(module_name);
+            }
+        }
+        else if (std::regex_search(line, match, module_import_regex))
+        {
+            // A partition is imported by its name alone, e.g. `import :part;`.
+            const auto module_name = match[1].str();
+            info.required_modules.push_back(module_name.starts_with(':') ? primary_module_name + module_name
+                                                                         : module_name);
+        }
+        else if (std::regex_search(line, match, header_unit_import_regex))
+        {
+            info.header_units.push_back(match[1].str());
+        }
+    }
+
+    return info;
+}
+
+auto modules::uses_modules(const ModuleInfo& info) -> bool
+{
+    return info.provided_module.has_value() || !info.required_modules.empty() || !info.header_units.empty();
+}
+
+static auto get_scan_cache_path(const std::string_view configuration_name,
+                                const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return build_state::get_data_file_path(configuration_name, path_to_root, params::MODULE_SCAN_DATA_FILE_NAME);
+}
+
+auto modules::read_scan_cache(const std::string_view configuration_name, const std::filesystem::path& path_to_root)
+    -> ScanCache
+{
+    const auto json = build_state::read_data_file(get_scan_cache_path(configuration_name, path_to_root));
+
+    if (!json.has_value())
+    {
+        return {};
+    }
+
+    ScanCache scan_cache;
+
+    for (const auto& [file, scanned_file] : json->items())
+    {
+        ModuleInfo info;
+
+        // Only files that use modules store their module info.
+        if (scanned_file.contains("info"))
+        {
+            const auto& info_json = scanned_file.at("info");
+
+            if (!info_json.at("providedModule").is_null())
+            {
+                info.provided_module = info_json.at("providedModule").get<std::string>();
+            }
+
+            info.is_interface     = info_json.at("isInterface").get<bool>();
+            info.required_modules = info_json.at("requiredModules").get<std::vector<std::string>>();
+            info.header_units     = info_json.at("headerUnits").get<std::vector<std::string>>();
+        }
+
+        scan_cache[file] = {
+            .hash = scanned_file.at("hash").get<std::uint64_t>(),
+            .info = std::move(info),
+        };
+    }
+
+    return scan_cache;
+}
+
+auto modules::write_scan_cache(const std::string_view configuration_name,
+                               const std::filesystem::path& path_to_root,
+                               const ScanCache& scan_cache) -> void
+{
+    auto json = nlohmann::json::object();
+
+    for (const auto& [file, scanned_file] : scan_cache)
+    {
+        json[file.native()] = nlohmann::json{
+            {"hash", scanned_file.hash},
+        };
+
+        if (uses_modules(scanned_file.info))
+        {
+            const auto& info = scanned_file.info;
+
+            json[file.native()]["info"] = nlohmann::json{
+                {"providedModule",  info.provided_module.has_value() ? nlohmann::json(*info.provided_module) : nullptr},
+                {"isInterface",     info.is_interface                                                                 },
+                {"requiredModules", info.required_modules                                                             },
+                {"headerUnits",     info.header_units                                                                 },
+            };
+        }
+    }
+
+    build_state::write_data_file(get_scan_cache_path(configuration_name, path_to_root), json);
+}
+
+auto modules::scan_file(const std::filesystem::path& path_to_root,
+                        const std::filesystem::path& file,
+                        ScanCache& scan_cache) -> ModuleInfo
+{
+    std::string buffer;
+    const auto hash = analysis_cache::hash_file_contents(path_to_root / file, buffer);
+
+    if (!scan_cache.contains(file) || scan_cache.at(file).hash != hash)
+    {
+        scan_cache[file] = {.hash = hash, .info = scan_file(path_to_root / file)};
+    }
+
+    return scan_cache.at(file).info;
+}
+
+auto modules::scan_files(const std::filesystem::path& path_to_root,
+                         const std::vector<std::filesystem::path>& code_files,
+                         ScanCache& scan_cache) -> std::unordered_map<std::filesystem::path, ModuleInfo>
+{
+    const auto source_files = code_files | std::views::filter(&utils::is_source_file) | std::ranges::to<std::vector>();
+    std::unordered_map<std::filesystem::path, ModuleInfo> module_infos;
+
+    for (const auto& file : source_files)
+    {
+        auto info = scan_file(path_to_root, file, scan_cache);
+
+        if (uses_modules(info))
+        {
+            module_infos[file] = std::move(info);
+        }
+    }
+
+    // Forget the files that are no longer part of the configuration.
+    const auto current_files = source_files | std::ranges::to<std::unordered_set>();
+    std::erase_if(scan_cache, [&](const auto& entry) { return !current_files.contains(entry.first); });
+
+    return module_infos;
+}
+
+// Provided by the compiler rather than by a source file.
+static auto is_standard_library_module(const std::string_view module_name) -> bool
+{
+    return module_name == "std" || module_name == "std.compat";
+}
+
+auto modules::get_module_graph(const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos)
+    -> std::expected<ModuleGraph, std::string>
+{
+    // Sorted, so that errors do not depend on the iteration order.
+    auto files = std::views::keys(module_infos) | std::ranges::to<std::vector>();
+    std::ranges::sort(files);
+
+    ModuleGraph graph;
+    std::unordered_map<std::string, std::filesystem::path> providers;
+
+    for (const auto& file : files)
+    {
+        graph.add_node(file);
+        const auto& provided_module = module_infos.at(file).provided_module;
+
+        if (!provided_module.has_value())
+        {
+            continue;
+        }
+
+        if (providers.contains(*provided_module))
+        {
+            return std::unexpected(std::format("Error: Module '{}' is declared in both '{}' and '{}'.",
+                                               *provided_module,
+                                               providers.at(*provided_module).native(),
+                                               file.native()));
+        }
+
+        providers[*provided_module] = file;
+    }
+
+    for (const auto& file : files)
+    {
+        for (const auto& required_module : module_infos.at(file).required_modules)
+        {
+            if (is_standard_library_module(required_module))
+            {
+                continue;
+            }
+
+            if (!providers.contains(required_module))
+            {
+                return std::unexpected(std::format("Error: '{}' imports module '{}', which is not declared in any "
+                                                   "source file.",
+                                                   file.native(),
+                                                   required_module));
+            }
+
+            graph.add_edge(providers.at(required_module), file);
+        }
+    }
+
+    return graph;
+}
+
+static auto create_circular_imports_error_message(const std::string_view cycle) -> std::string
+{
+    return std::format("Error: Circular module dependency detected.\n\n"
+                       "The following files form a cycle:\n"
+                       "{}\n\n"
+                       "Consider restructuring the modules to break the circular dependency.",
+                       cycle);
+}
+
+// g++ names the compiled interface of a partition `module-partition.gcm`.
+static auto get_gcm_file_name(std::string module_name) -> std::string
+{
+    std::ranges::replace(module_name, ':', '-');
+
+    return module_name + ".gcm";
+}
+
+static auto get_header_unit_file_name(std::string header_unit) -> std::string
+{
+    std::ranges::replace_if(
+        header_unit, [](const char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '.'; }, '_');
+
+    return header_unit + ".pcm";
+}
+
+// clang++ writes the compiled interface next to the object file.
+static auto get_pcm_path(const std::filesystem::path& object_files_directory,
+                         const std::filesystem::path& file) -> std::filesystem::path
+{
+    auto pcm_path = object_files_directory / utils::get_object_file_name(file);
+    pcm_path.replace_extension(".pcm");
+
+    return pcm_path;
+}
+
+static auto get_data_file_path(const std::string_view configuration_name,
+                               const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::MODULES_DATA_FILE_NAME;
+}
+
+static auto read_state(const std::string_view configuration_name, const std::filesystem::path& path_to_root) -> State
+{
+    const auto data_file_path = get_data_file_path(configuration_name, path_to_root);
+
+    if (!std::filesystem::is_regular_file(data_file_path))
+    {
+        return {};
+    }
+
+    auto data_file = std::ifstream(data_file_path);
+
+    if (!data_file.is_open())
+    {
+        return {};
+    }
+
+    nlohmann::json json;
+    data_file >> json;
+    ASSERT(json.is_object());
+
+    State state;
+    state.configuration_hash = json.at("configurationHash").get<std::uint64_t>();
+
+    for (const auto& header_unit : json.at("headerUnits"))
+    {
+        state.header_units.insert(header_unit.get<std::string>());
+    }
+
+    return state;
+}
+
+static auto write_state(const std::string_view configuration_name,
+                        const std::filesystem::path& path_to_root,
+                        const State& state) -> void
+{
+    const auto data_file_path = get_data_file_path(configuration_name, path_to_root);
+    auto data_file            = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    auto header_units = state.header_units | std::ranges::to<std::vector>();
+    std::ranges::sort(header_units);
+
+    const auto json = nlohmann::json{
+        {"configurationHash", state.configuration_hash},
+        {"headerUnits",       header_units            },
+    };
+
+    data_file << json.dump(); // Write to file.
+}
+
+// Writes the result of the scan in the format of P1689 ("Format for describing dependencies of source files"),
+// so that other tools can consume it.
+static auto write_dependency_scan_file(const std::string_view configuration_name,
+                                       const std::filesystem::path& path_to_root,
+                                       const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos)
+    -> void
+{
+    const auto data_file_path =
+        path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name / params::MODULE_DEPENDENCIES_FILE_NAME;
+    auto data_file = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    auto files = std::views::keys(module_infos) | std::ranges::to<std::vector>();
+    std::ranges::sort(files);
+
+    auto rules = nlohmann::json::array();
+
+    for (const auto& file : files)
+    {
+        const auto& info = module_infos.at(file);
+        auto rule        = nlohmann::json{
+            {"primary-output", utils::get_object_file_name(file)},
+            {"provides",       nlohmann::json::array()          },
+            {"requires",       nlohmann::json::array()          },
+        };
+
+        if (info.provided_module.has_value())
+        {
+            rule["provides"].push_back({
+                {"logical-name", *info.provided_module},
+                {"source-path",  file.native()        },
+                {"is-interface", info.is_interface    },
+            });
+        }
+
+        for (const auto& required_module : info.required_modules)
+        {
+            rule["requires"].push_back({
+                {"logical-name",  required_module},
+                {"lookup-method", "by-name"      },
+            });
+        }
+
+        for (const auto& header_unit : info.header_units)
+        {
+            rule["requires"].push_back({
+                {"logical-name",  header_unit.substr(1, header_unit.size() - 2)              },
+                {"lookup-method", header_unit.starts_with('<') ? "include-angle" : "include-quote"},
+            });
+        }
+
+        rules.push_back(std::move(rule));
+    }
+
+    const auto json = nlohmann::json{
+        {"version",  1    },
+        {"revision", 0    },
+        {"rules",    rules},
+    };
+
+    data_file << json.dump(); // Write to file.
+}
+
+// g++ finds compiled interfaces through a module mapper. Header units and modules that are not listed
+// get a default name relative to `$root`, so every BMI of the configuration ends up in `bmi_directory`.
+static auto write_module_mapper(const std::filesystem::path& mapper_path,
+                                const std::filesystem::path& bmi_directory,
+                                const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos) -> void
+{
+    auto mapper = std::ofstream(mapper_path, std::ios::trunc);
+
+    if (!mapper.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", mapper_path.native()));
+    }
+
+    std::println(mapper, "$root {}", std::filesystem::absolute(bmi_directory).native());
+
+    for (const auto& info : std::views::values(module_infos))
+    {
+        if (info.provided_module.has_value())
+        {
+            std::println(mapper, "{} {}", *info.provided_module, get_gcm_file_name(*info.provided_module));
+        }
+    }
+}
+
+static auto build_header_unit(const Configuration& configuration,
+                              const std::string& header_unit,
+                              const std::filesystem::path& bmi_directory,
+                              const std::filesystem::path& mapper_path) -> bool
+{
+    ASSERT(configuration.compiler.has_value());
+
+    const auto header_kind = header_unit.starts_with('<') ? "system" : "user";
+    const auto header_name = header_unit.substr(1, header_unit.size() - 2);
+    const auto flags       = create_compilation_flags_string(configuration);
+
+    const auto command =
+        (*configuration.compiler == "g++")
+            ? std::format("{} {} -fmodules-ts -fmodule-mapper={} -fdiagnostics-color=always -x c++-{}-header {}",
+                          *configuration.compiler,
+                          flags,
+                          mapper_path.native(),
+                          header_kind,
+                          header_name)
+            : std::format("{} {} -fdiagnostics-color=always -fmodule-header={} -x c++-header {} -o {}",
+                          *configuration.compiler,
+                          flags,
+                          header_kind,
+                          header_name,
+                          (bmi_directory / get_header_unit_file_name(header_unit)).native());
+
+    return jobs::run(command).exit_status == EXIT_SUCCESS;
+}
+
+// Builds the header units that are new or whose header changed.
+// Returns the header units that were built.
+static auto build_header_units(const Configuration& configuration,
+                               const std::filesystem::path& path_to_root,
+                               const build_caching::Info& build_info,
+                               const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos,
+                               const std::filesystem::path& bmi_directory,
+                               const std::filesystem::path& mapper_path,
+                               const bool is_quiet,
+                               State& state) -> std::expected<std::unordered_set<std::string>, std::string>
+{
+    // Header unit -> a file that imports it, used to resolve quoted names. Sorted, so the build order is stable.
+    std::map<std::string, std::filesystem::path> importers;
+
+    for (const auto& [file, info] : module_infos)
+    {
+        for (const auto& header_unit : info.header_units)
+        {
+            if (!importers.contains(header_unit) || file < importers.at(header_unit))
+            {
+                importers[header_unit] = file;
+            }
+        }
+    }
+
+    std::unordered_set<std::string> built_header_units;
+
+    for (const auto& [header_unit, importer] : importers)
+    {
+        const auto header_changed = [&]
+        {
+            if (header_unit.starts_with('<'))
+            {
+                return false; // System headers are not tracked.
+            }
+
+            const auto header = build_caching::resolve_include(header_unit.substr(1, header_unit.size() - 2),
+                                                               importer,
+                                                               path_to_root,
+                                                               configuration.include_directories.value_or({}));
+
+            return header.has_value() && std::ranges::contains(build_info.changed_files, *header);
+        }();
+
+        if (state.header_units.contains(header_unit) && !header_changed)
+        {
+            continue;
+        }
+
+        if (!is_quiet)
+        {
+            std::println("Building header unit {}...", header_unit);
+        }
+
+        if (!build_header_unit(configuration, header_unit, bmi_directory, mapper_path))
+        {
+            state.header_units.erase(header_unit);
+
+            return std::unexpected(std::format("Error: Failed to build header unit {}.", header_unit));
+        }
+
+        state.header_units.insert(header_unit);
+        built_header_units.insert(header_unit);
+    }
+
+    std::erase_if(state.header_units, [&](const auto& header_unit) { return !importers.contains(header_unit); });
+
+    return built_header_units;
+}
+
+static auto get_module_flags(const Configuration& configuration,
+                             const std::filesystem::path& object_files_directory,
+                             const std::filesystem::path& bmi_directory,
+                             const std::filesystem::path& mapper_path,
+                             const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos,
+                             const State& state,
+                             const bool for_interfaces) -> std::vector<std::string>
+{
+    ASSERT(configuration.compiler.has_value());
+
+    std::vector<std::string> flags;
+
+    if (*configuration.compiler == "g++")
+    {
+        flags.push_back("-fmodules-ts");
+        flags.push_back(std::format("-fmodule-mapper={}", mapper_path.native()));
+
+        if (for_interfaces)
+        {
+            // g++ does not recognize `.cppm` and `.ixx` files.
+            flags.push_back("-x c++");
+        }
+
+        return flags;
+    }
+
+    // clang++ is told where every compiled interface is; it only reads the ones that are imported.
+    auto files = std::views::keys(module_infos) | std::ranges::to<std::vector>();
+    std::ranges::sort(files);
+
+    for (const auto& file : files)
+    {
+        const auto& provided_module = module_infos.at(file).provided_module;
+
+        if (provided_module.has_value())
+        {
+            const auto pcm_path = get_pcm_path(object_files_directory, file);
+            flags.push_back(std::format("-fmodule-file={}={}", *provided_module, pcm_path.native()));
+        }
+    }
+
+    auto header_units = state.header_units | std::ranges::to<std::vector>();
+    std::ranges::sort(header_units);
+
+    for (const auto& header_unit : header_units)
+    {
+        const auto pcm_path = bmi_directory / get_header_unit_file_name(header_unit);
+        flags.push_back(std::format("-fmodule-file={}", pcm_path.native()));
+    }
+
+    if (for_interfaces)
+    {
+        flags.push_back("-x c++-module");
+        flags.push_back("-fmodule-output");
+    }
+
+    return flags;
+}
+
+static auto with_compilation_flags(Configuration configuration, const std::vector<std::string>& flags) -> Configuration
+{
+    auto compilation_flags = configuration.compilation_flags.value_or({});
+    compilation_flags.insert(compilation_flags.end(), flags.begin(), flags.end());
+    configuration.compilation_flags = std::move(compilation_flags);
+
+    return configuration;
+}
+
+/// @brief  Compiles the configuration's source files in the order that their module imports require.
+/// @param  files_to_compile Source files that must be recompiled. Files that import them are recompiled as well.
+/// @param  module_infos     Result of `scan_files` for the configuration's source files.
+/// @note   Source files are compiled in levels: a file is compiled only after every file that provides
+///         a module it imports. Compiled interfaces (BMIs) are kept per configuration in `easy-make-build`
+///         and are discarded when the configuration changes.
+auto modules::compile_with_modules(const Configuration& configuration,
+                                   const std::filesystem::path& path_to_root,
+                                   const build_caching::Info& build_info,
+                                   const std::vector<std::filesystem::path>& files_to_compile,
+                                   const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos,
+                                   const bool is_quiet,
+                                   const bool use_parallel_compilation,
+                                   const std::optional<std::filesystem::path>& precompiled_header)
+    -> std::expected<CompilationResult, std::string>
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.compiler.has_value());
+
+    if (*configuration.compiler != "g++" && *configuration.compiler != "clang++")
+    {
+        return std::unexpected(std::format("Error: Configuration '{}' uses C++20 modules, which are only supported "
+                                           "with 'g++' and 'clang++'.",
+                                           *configuration.name));
+    }
+
+    auto module_graph = get_module_graph(module_infos);
+
+    if (!module_graph.has_value())
+    {
+        return std::unexpected(module_graph.error());
+    }
+
+    const auto cycle_in_module_graph = module_graph->check_for_cycle();
+    const auto detected_cycle        = cycle_in_module_graph.has_value();
+
+    if (detected_cycle)
+    {
+        return std::unexpected(create_circular_imports_error_message(*cycle_in_module_graph));
+    }
+
+    const auto object_files_directory = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
+    const auto bmi_directory          = object_files_directory / params::MODULES_DIRECTORY_NAME;
+    const auto mapper_path            = object_files_directory / params::MODULE_MAPPER_FILE_NAME;
+    const auto configuration_hash     = build_caching::hash_configuration(configuration);
+    auto state                        = read_state(*configuration.name, path_to_root);
+
+    // Interfaces compiled with different flags cannot be imported.
+    if (state.configuration_hash != configuration_hash)
+    {
+        std::error_code error;
+        std::filesystem::remove_all(bmi_directory, error);
+        state = {.configuration_hash = configuration_hash, .header_units = {}};
+    }
+
+    std::filesystem::create_directories(bmi_directory);
+    write_module_mapper(mapper_path, bmi_directory, module_infos);
+    write_dependency_scan_file(*configuration.name, path_to_root, module_infos);
+
+    const auto built_header_units = build_header_units(
+        configuration, path_to_root, build_info, module_infos, bmi_directory, mapper_path, is_quiet, state);
+
+    if (!built_header_units.has_value())
+    {
+        write_state(*configuration.name, path_to_root, state);
+
+        return std::unexpected(built_header_units.error());
+    }
+
+    // Every source file is a node, so files that do not import anything end up in the first level.
+    auto graph = std::move(*module_graph);
+
+    for (const auto& file : std::views::keys(build_info.file_hashes) | std::views::filter(&utils::is_source_file))
+    {
+        graph.add_node(file);
+    }
+
+    const auto interface_is_missing = [&](const std::filesystem::path& file)
+    {
+        const auto& provided_module = *module_infos.at(file).provided_module;
+
+        return (*configuration.compiler == "g++")
+                   ? !std::filesystem::exists(bmi_directory / get_gcm_file_name(provided_module))
+                   : !std::filesystem::exists(get_pcm_path(object_files_directory, file));
+    };
+
+    auto outdated_files = files_to_compile;
+
+    for (const auto& [file, info] : module_infos)
+    {
+        const auto imports_new_header_unit = std::ranges::any_of(
+            info.header_units, [&](const auto& header_unit) { return built_header_units->contains(header_unit); });
+
+        if ((info.provided_module.has_value() && interface_is_missing(file)) || imports_new_header_unit)
+        {
+            outdated_files.push_back(file);
+        }
+    }
+
+    // Files that import a recompiled interface must be recompiled as well.
+    const auto files_to_rebuild = graph.get_reachable_nodes(outdated_files) | std::ranges::to<std::unordered_set>();
+
+    // Remove the object files up front, so that files in levels that are skipped after a failure
+    // are recompiled in the next build.
+    for (const auto& file : files_to_rebuild)
+    {
+        std::error_code error;
+        utils::remove_object_file(object_files_directory, file, error);
+    }
+
+    const auto interface_flags =
+        get_module_flags(configuration, object_files_directory, bmi_directory, mapper_path, module_infos, state, true);
+    const auto module_flags =
+        get_module_flags(configuration, object_files_directory, bmi_directory, mapper_path, module_infos, state, false);
+    const auto interface_configuration = with_compilation_flags(configuration, interface_flags);
+    const auto module_configuration    = with_compilation_flags(configuration, module_flags);
+
+    CompilationResult total_result{
+        .num_of_failures   = 0,
+        .compilation_times = {},
+    };
+
+    const auto compile_group =
+        [&](const std::vector<std::filesystem::path>& files, const Configuration& group_configuration)
+    {
+        if (files.empty())
+        {
+            return;
+        }
+
+        const auto result = compile_files(
+            group_configuration, path_to_root, files, is_quiet, use_parallel_compilation, precompiled_header);
+
+        total_result.num_of_failures += result.num_of_failures;
+        total_result.compilation_times.insert(result.compilation_times.begin(), result.compilation_times.end());
+        total_result.peak_memory_in_kilobytes.insert(result.peak_memory_in_kilobytes.begin(),
+                                                     result.peak_memory_in_kilobytes.end());
+    };
+
+    const auto must_be_rebuilt = [&](const std::filesystem::path& file) { return files_to_rebuild.contains(file); };
+    const auto provides_module = [&](const std::filesystem::path& file)
+    { return module_infos.contains(file) && module_infos.at(file).provided_module.has_value(); };
+
+    for (const auto& level : graph.get_topological_levels())
+    {
+        const auto files       = level | std::views::filter(must_be_rebuilt) | std::ranges::to<std::vector>();
+        const auto interfaces  = files | std::views::filter(provides_module) | std::ranges::to<std::vector>();
+        const auto other_files = files                                             //
+                                 | std::views::filter(std::not_fn(provides_module)) //
+                                 | std::ranges::to<std::vector>();                  //
+
+        compile_group(interfaces, interface_configuration);
+        compile_group(other_files, module_configuration);
+
+        if (total_result.num_of_failures > 0)
+        {
+            break; // The next levels import modules from this one.
+        }
+    }
+
+    write_state(*configuration.name, path_to_root, state);
+
+    return total_result;
+}
@@ -0,0 +1,76 @@
+#ifndef SOURCE_COMMANDS_BUILD_MODULES_MODULES_HPP
+#define SOURCE_COMMANDS_BUILD_MODULES_MODULES_HPP
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/utils/graph.hpp"
+
+namespace modules
+{
+    struct ModuleInfo
+    {
+        std::optional<std::string> provided_module; // Module or partition ("name:partition") declared by the file.
+        bool is_interface = false;                  // Declared with `export module`.
+        std::vector<std::string> required_modules;  // Imported modules and partitions.
+        std::vector<std::string> header_units;      // Imported headers as written, e.g. `<vector>` or `"foo.hpp"`.
+    };
+
+    // There is an edge from `f_1` to `f_2` if `f_2` imports a module that `f_1` provides.
+    using ModuleGraph = utils::DirectedGraph<std::filesystem::path>;
+
+    auto scan_file(const std::filesystem::path& path) -> ModuleInfo;
+
+    // Whether the file declares or imports a module.
+    auto uses_modules(const ModuleInfo& info) -> bool;
+
+    struct ScannedFile
+    {
+        std::uint64_t hash; // Hash of the contents that were scanned.
+        ModuleInfo info;
+    };
+
+    // The scan of every source file in the previous build, so that unchanged files are not scanned again.
+    using ScanCache = std::unordered_map<std::filesystem::path, ScannedFile>;
+
+    auto read_scan_cache(std::string_view configuration_name, const std::filesystem::path& path_to_root) -> ScanCache;
+
+    auto write_scan_cache(std::string_view configuration_name,
+                          const std::filesystem::path& path_to_root,
+                          const ScanCache& scan_cache) -> void;
+
+    // Scans the file (relative to `path_to_root`), unless `scan_cache` has it with its current contents,
+    // and records the result.
+    auto scan_file(const std::filesystem::path& path_to_root, const std::filesystem::path& file, ScanCache& scan_cache)
+        -> ModuleInfo;
+
+    // Scans the source files that are not in `scan_cache` with their current contents, and updates it.
+    // Returns the files that use modules.
+    auto scan_files(const std::filesystem::path& path_to_root,
+                    const std::vector<std::filesystem::path>& code_files,
+                    ScanCache& scan_cache) -> std::unordered_map<std::filesystem::path, ModuleInfo>;
+
+    auto get_module_graph(const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos)
+        -> std::expected<ModuleGraph, std::string>;
+
+    auto compile_with_modules(const Configuration& configuration,
+                              const std::filesystem::path& path_to_root,
+                              const build_caching::Info& build_info,
+                              const std::vector<std::filesystem::path>& files_to_compile,
+                              const std::unordered_map<std::filesystem::path, ModuleInfo>& module_infos,
+                              bool is_quiet,
+                              bool use_parallel_compilation,
+                              const std::optional<std::filesystem::path>& precompiled_header)
+        -> std::expected<CompilationResult, std::string>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_MODULES_MODULES_HPP
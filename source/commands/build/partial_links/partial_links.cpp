@@ -0,0 +1,257 @@
+#include "source/commands/build/partial_links/partial_links.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional> // std::cref
+#include <future>
+#include <print>
+#include <ranges>
+#include <stdexcept>
+#include <system_error> // std::error_code
+#include <unordered_map>
+#include <unordered_set>
+#include <utility> // std::move
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+using Signatures = std::unordered_map<std::string, std::uint64_t>; // Partial link -> signature of its members.
+
+auto partial_links::group_by_directory(const std::vector<std::filesystem::path>& source_files) -> Groups
+{
+    Groups groups;
+
+    for (const auto& file : source_files)
+    {
+        groups[file.parent_path()].push_back(file);
+    }
+
+    for (auto& files : groups | std::views::values)
+    {
+        std::ranges::sort(files);
+    }
+
+    return groups;
+}
+
+static auto get_data_file_path(const std::filesystem::path& object_files_directory) -> std::filesystem::path
+{
+    return object_files_directory / params::PARTIAL_LINKS_DATA_FILE_NAME;
+}
+
+static auto get_partial_link_name(const std::filesystem::path& directory) -> std::string
+{
+    return directory.empty() ? "easy-make-root.o" : utils::get_object_file_name(directory);
+}
+
+static auto read_signatures(const std::filesystem::path& object_files_directory) -> Signatures
+{
+    auto data_file = std::ifstream(get_data_file_path(object_files_directory));
+
+    if (!data_file.is_open())
+    {
+        return {};
+    }
+
+    nlohmann::json json;
+    data_file >> json;
+    ASSERT(json.is_object());
+
+    Signatures signatures;
+
+    for (const auto& [name, signature] : json.items())
+    {
+        signatures[name] = signature.get<std::uint64_t>();
+    }
+
+    return signatures;
+}
+
+static auto write_signatures(const std::filesystem::path& object_files_directory, const Signatures& signatures)
+    -> void
+{
+    const auto data_file_path = get_data_file_path(object_files_directory);
+    auto data_file            = std::ofstream(data_file_path, std::ios::trunc); // Override file if it exists.
+
+    if (!data_file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", data_file_path.native()));
+    }
+
+    auto json = nlohmann::json::object();
+
+    for (const auto& [name, signature] : signatures)
+    {
+        json[name] = signature;
+    }
+
+    data_file << json.dump();
+}
+
+// Changes whenever a member is added, removed or recompiled.
+static auto get_signature(const std::vector<std::filesystem::path>& members) -> std::uint64_t
+{
+    auto result = build_caching::FNV_OFFSET_BASIS;
+
+    for (const auto& member : members)
+    {
+        const auto last_write_time = std::filesystem::last_write_time(member).time_since_epoch().count();
+
+        result = build_caching::hash_string(member.native(), result);
+        result = build_caching::hash_string(std::to_string(last_write_time), result);
+        result = build_caching::hash_string(std::to_string(std::filesystem::file_size(member)), result);
+    }
+
+    return result;
+}
+
+// The members are passed through a response file, since a directory may contain more objects
+// than fit in a single command.
+static auto create_partial_link(const Configuration& configuration,
+                                const std::filesystem::path& output_path,
+                                const std::vector<std::filesystem::path>& members) -> bool
+{
+    auto response_file_path = output_path;
+    response_file_path.replace_extension(".rsp");
+
+    {
+        auto response_file = std::ofstream(response_file_path, std::ios::trunc);
+
+        if (!response_file.is_open())
+        {
+            throw std::runtime_error(std::format("Failed to open '{}'.", response_file_path.native()));
+        }
+
+        for (const auto& member : members)
+        {
+            std::println(response_file, "{}", member.native());
+        }
+    }
+
+    // The compiler driver runs the default `ld -r`. Its output is an ordinary relocatable object that any linker
+    // reads, so the final link may still use the configured one. LTO builds are never partially linked.
+    const auto command = std::format(
+        "{} -r -nostdlib @{} -o {}", *configuration.compiler, response_file_path.native(), output_path.native());
+
+    return jobs::run(command).exit_status == EXIT_SUCCESS;
+}
+
+/// @brief  Combines the object files of every source directory into one relocatable object.
+/// @param  configuration  The configuration whose object files are combined.
+/// @param  path_to_root   Path to the root of the project.
+/// @param  source_files   The source files of the configuration.
+/// @return The files to link instead of the configuration's object files, or an error message.
+/// @note   A partial link is refreshed only when one of its members changes, so the final link reads
+///         one input per directory. Directories with a single object file and object files that do not
+///         belong to a source file (e.g. unity batches) are linked directly.
+auto partial_links::update_partial_links(const Configuration& configuration,
+                                         const std::filesystem::path& path_to_root,
+                                         const std::vector<std::filesystem::path>& source_files)
+    -> std::expected<std::vector<std::filesystem::path>, std::string>
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.compiler.has_value());
+
+    const auto object_files_directory  = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
+    const auto partial_links_directory = object_files_directory / params::PARTIAL_LINKS_DIRECTORY_NAME;
+    std::filesystem::create_directories(partial_links_directory);
+
+    const auto old_signatures = read_signatures(object_files_directory);
+    Signatures new_signatures;
+    std::vector<std::filesystem::path> link_inputs;
+    std::unordered_set<std::filesystem::path> grouped_object_files;
+    std::vector<std::pair<std::string, std::future<bool>>> partial_links_in_progress;
+
+    const auto get_object_file_path = [&](const std::filesystem::path& file)
+    { return object_files_directory / utils::get_object_file_name(file); };
+
+    for (const auto& [directory, files] : group_by_directory(source_files))
+    {
+        // Files that failed to compile in an earlier build have no object file.
+        const auto members = files                                                                                //
+                             | std::views::transform(get_object_file_path)                                        //
+                             | std::views::filter([](const auto& path) { return std::filesystem::exists(path); }) //
+                             | std::ranges::to<std::vector>();                                                    //
+
+        grouped_object_files.insert(members.begin(), members.end());
+
+        if (members.size() <= 1)
+        {
+            link_inputs.insert(link_inputs.end(), members.begin(), members.end());
+            continue;
+        }
+
+        const auto name        = get_partial_link_name(directory);
+        const auto output_path = partial_links_directory / name;
+        const auto signature   = get_signature(members);
+
+        new_signatures[name] = signature;
+        link_inputs.push_back(output_path);
+
+        const auto old_signature = old_signatures.find(name);
+        const auto is_up_to_date = old_signature != old_signatures.end() && old_signature->second == signature &&
+                                   std::filesystem::is_regular_file(output_path);
+
+        if (!is_up_to_date)
+        {
+            auto is_successful =
+                std::async(std::launch::async, create_partial_link, std::cref(configuration), output_path, members);
+            partial_links_in_progress.emplace_back(name, std::move(is_successful));
+        }
+    }
+
+    // Object files that do not belong to any source file.
+    for (const auto& entry : std::filesystem::directory_iterator(object_files_directory))
+    {
+        const auto& path = entry.path();
+
+        if (entry.is_regular_file() && path.extension() == ".o" && !grouped_object_files.contains(path))
+        {
+            link_inputs.push_back(path);
+        }
+    }
+
+    // Remove the partial links of directories that no longer exist or have a single object file.
+    for (const auto& entry : std::filesystem::directory_iterator(partial_links_directory))
+    {
+        auto name = entry.path().filename();
+        name.replace_extension(".o");
+
+        if (!new_signatures.contains(name.native()))
+        {
+            std::error_code error;
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+
+    std::vector<std::string> failed_partial_links;
+
+    for (auto& [name, is_successful] : partial_links_in_progress)
+    {
+        if (!is_successful.get())
+        {
+            new_signatures.erase(name);
+            failed_partial_links.push_back(name);
+        }
+    }
+
+    write_signatures(object_files_directory, new_signatures);
+
+    if (!failed_partial_links.empty())
+    {
+        std::ranges::sort(failed_partial_links);
+
+        return std::unexpected(
+            std::format("Error: Failed to create the partial link '{}'.", failed_partial_links.front()));
+    }
+
+    return link_inputs;
+}
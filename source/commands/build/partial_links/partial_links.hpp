@@ -0,0 +1,25 @@
+#ifndef SOURCE_COMMANDS_BUILD_PARTIAL_LINKS_PARTIAL_LINKS_HPP
+#define SOURCE_COMMANDS_BUILD_PARTIAL_LINKS_PARTIAL_LINKS_HPP
+
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace partial_links
+{
+    // Source files by their directory (relative to the root).
+    using Groups = std::map<std::filesystem::path, std::vector<std::filesystem::path>>;
+
+    auto group_by_directory(const std::vector<std::filesystem::path>& source_files) -> Groups;
+
+    auto update_partial_links(const Configuration& configuration,
+                              const std::filesystem::path& path_to_root,
+                              const std::vector<std::filesystem::path>& source_files)
+        -> std::expected<std::vector<std::filesystem::path>, std::string>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_PARTIAL_LINKS_PARTIAL_LINKS_HPP
@@ -0,0 +1,397 @@
+#include "source/commands/build/precompiled_headers/precompiled_headers.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <functional> // std::plus
+#include <print>
+#include <ranges>
+#include <string>
+#include <system_error> // std::error_code
+#include <unordered_set>
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_state.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+using build_caching::DependencyGraph;
+
+namespace
+{
+    struct PreviousState
+    {
+        bool exists             = false;                              // No state is stored before the first build.
+        std::uint64_t signature = 0;                                  // 0 means that no PCH was used.
+        std::vector<std::filesystem::path> headers;                    // Headers inside the previous PCH.
+        build_state::Cooldowns unstable_files;                         // File -> number of builds left in cooldown.
+    };
+}
+
+auto precompiled_headers::get_included_closure(const DependencyGraph& dependency_graph,
+                                               const std::vector<std::filesystem::path>& headers)
+    -> std::vector<std::filesystem::path>
+{
+    // An edge goes from an included file to the file that includes it, so walk the reversed graph.
+    auto closure = dependency_graph.get_reversed().get_reachable_nodes(headers);
+    std::ranges::sort(closure);
+
+    return closure;
+}
+
+/// @brief  Picks the project headers that are worth precompiling.
+/// @param  dependency_graph    The current include graph.
+/// @param  num_of_source_files Number of translation units in the configuration.
+/// @param  compilation_times   Compilation time (in seconds) of each source file in previous builds.
+/// @param  unstable_files      Files that changed recently.
+/// @return The selected headers, sorted.
+/// @note   A header's score is the total compilation time of the translation units that (transitively) include it,
+///         so a header that is included everywhere by slow files is preferred. Headers that include an unstable
+///         file are skipped, since every change to them would invalidate the PCH and force a full rebuild.
+auto precompiled_headers::select_headers(const DependencyGraph& dependency_graph,
+                                         const int num_of_source_files,
+                                         const std::unordered_map<std::filesystem::path, double>& compilation_times,
+                                         const std::vector<std::filesystem::path>& unstable_files)
+    -> std::vector<std::filesystem::path>
+{
+    const auto MAX_NUM_OF_HEADERS = 16UZ;
+    const auto min_fan_out        = std::max(2, num_of_source_files / 4);
+
+    // Files without history are assumed to be average.
+    const auto times_sum            = std::ranges::fold_left(std::views::values(compilation_times), 0.0, std::plus{});
+    const auto average_time         = compilation_times.empty() ? 1.0 : times_sum / compilation_times.size();
+    const auto get_compilation_time = [&](const std::filesystem::path& file)
+    { return compilation_times.contains(file) ? compilation_times.at(file) : average_time; };
+
+    const auto affected_by_unstable_files =
+        dependency_graph.get_reachable_nodes(unstable_files) | std::ranges::to<std::unordered_set>();
+
+    std::vector<std::pair<double, std::filesystem::path>> candidates;
+
+    for (const auto& header : std::views::keys(dependency_graph.data()))
+    {
+        if (!utils::is_header_file(header) || affected_by_unstable_files.contains(header))
+        {
+            continue;
+        }
+
+        const auto dependent_source_files = dependency_graph.get_reachable_nodes({header}) //
+                                            | std::views::filter(&utils::is_source_file)    //
+                                            | std::ranges::to<std::vector>();               //
+
+        const auto fan_out = static_cast<int>(dependent_source_files.size());
+
+        if (fan_out < min_fan_out)
+        {
+            continue;
+        }
+
+        const auto score = std::ranges::fold_left(
+            dependent_source_files | std::views::transform(get_compilation_time), 0.0, std::plus{});
+
+        candidates.emplace_back(score, header);
+    }
+
+    // Highest score first; break ties by path so the selection (and thus the PCH) is deterministic.
+    const auto by_score_then_path = [](const auto& a, const auto& b)
+    { return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second); };
+
+    std::ranges::sort(candidates, by_score_then_path);
+
+    auto selected = candidates                             //
+                    | std::views::take(MAX_NUM_OF_HEADERS) //
+                    | std::views::values                   //
+                    | std::ranges::to<std::vector>();      //
+
+    std::ranges::sort(selected);
+
+    return selected;
+}
+
+/// @brief  Estimates how much compilation time a PCH with `headers` saves in a full build.
+/// @note   Each translation unit is assumed to spend time in proportion to the size of the project files it includes.
+///         The share that is covered by the PCH is considered saved. System headers are not part of the graph,
+///         so this is only a rough estimate.
+auto precompiled_headers::estimate_seconds_saved(
+    const DependencyGraph& dependency_graph,
+    const std::vector<std::filesystem::path>& headers,
+    const std::unordered_map<std::filesystem::path, double>& compilation_times,
+    const std::filesystem::path& path_to_root) -> double
+{
+    const auto reversed_graph    = dependency_graph.get_reversed();
+    const auto precompiled_files = reversed_graph.get_reachable_nodes(headers) | std::ranges::to<std::unordered_set>();
+
+    std::unordered_map<std::filesystem::path, std::uintmax_t> file_sizes;
+    const auto get_file_size = [&](const std::filesystem::path& file)
+    {
+        if (!file_sizes.contains(file))
+        {
+            std::error_code error;
+            const auto size  = std::filesystem::file_size(path_to_root / file, error);
+            file_sizes[file] = error ? 0 : size;
+        }
+
+        return file_sizes.at(file);
+    };
+
+    auto seconds_saved = 0.0;
+
+    for (const auto& [file, seconds] : compilation_times)
+    {
+        if (!reversed_graph.data().contains(file))
+        {
+            continue; // The file does not include any project header.
+        }
+
+        auto total_size       = std::uintmax_t{0};
+        auto precompiled_size = std::uintmax_t{0};
+
+        for (const auto& included_file : reversed_graph.get_reachable_nodes({file}))
+        {
+            const auto size = get_file_size(included_file);
+            total_size += size;
+            precompiled_size += precompiled_files.contains(included_file) ? size : 0;
+        }
+
+        if (total_size > 0)
+        {
+            seconds_saved += seconds * static_cast<double>(precompiled_size) / static_cast<double>(total_size);
+        }
+    }
+
+    return seconds_saved;
+}
+
+static auto get_data_file_path(const std::string_view configuration_name,
+                               const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return build_state::get_data_file_path(
+        configuration_name, path_to_root, params::PRECOMPILED_HEADER_DATA_FILE_NAME);
+}
+
+static auto read_previous_state(const std::string_view configuration_name,
+                                const std::filesystem::path& path_to_root) -> PreviousState
+{
+    const auto json = build_state::read_data_file(get_data_file_path(configuration_name, path_to_root));
+
+    if (!json.has_value())
+    {
+        return {};
+    }
+
+    PreviousState state;
+    state.exists    = true;
+    state.signature = json->at("signature").get<std::uint64_t>();
+
+    for (const auto& header : json->at("headers"))
+    {
+        state.headers.emplace_back(header.get<std::string>());
+    }
+
+    for (const auto& [file, num_of_builds] : json->at("unstableFiles").items())
+    {
+        state.unstable_files[file] = num_of_builds.get<int>();
+    }
+
+    return state;
+}
+
+static auto write_state(const std::string_view configuration_name,
+                        const std::filesystem::path& path_to_root,
+                        const std::uint64_t signature,
+                        const std::vector<std::filesystem::path>& headers,
+                        const build_state::Cooldowns& unstable_files) -> void
+{
+    auto json = nlohmann::json{
+        {"signature",     signature                },
+        {"headers",       nlohmann::json::array()  },
+        {"unstableFiles", nlohmann::json::object() },
+    };
+
+    for (const auto& header : headers)
+    {
+        json["headers"].push_back(header.native());
+    }
+
+    for (const auto& [file, num_of_builds] : unstable_files)
+    {
+        json["unstableFiles"][file.native()] = num_of_builds;
+    }
+
+    build_state::write_data_file(get_data_file_path(configuration_name, path_to_root), json);
+}
+
+// The signature changes whenever the contents of the PCH would change:
+// different headers, a change in any file they include or a critical change to the configuration.
+static auto compute_signature(const Configuration& configuration,
+                              const DependencyGraph& dependency_graph,
+                              const std::vector<std::filesystem::path>& headers,
+                              const std::unordered_map<std::filesystem::path, std::uint64_t>& file_hashes)
+    -> std::uint64_t
+{
+    if (headers.empty())
+    {
+        return 0;
+    }
+
+    auto result = build_caching::hash_configuration(configuration);
+
+    for (const auto& header : headers)
+    {
+        result = build_caching::hash_string(header.native(), result);
+    }
+
+    for (const auto& file : precompiled_headers::get_included_closure(dependency_graph, headers))
+    {
+        result = build_caching::hash_string(file.native(), result);
+
+        if (file_hashes.contains(file))
+        {
+            result = build_caching::hash_string(std::to_string(file_hashes.at(file)), result);
+        }
+    }
+
+    return result;
+}
+
+static auto get_compiled_header_path(const Configuration& configuration,
+                                     const std::filesystem::path& header_path) -> std::filesystem::path
+{
+    // g++ looks for `<header>.gch`, clang++ looks for `<header>.pch`.
+    const auto extension = (*configuration.compiler == "clang++") ? ".pch" : ".gch";
+
+    return std::filesystem::path(header_path.native() + extension);
+}
+
+static auto build_precompiled_header(const Configuration& configuration,
+                                     const std::filesystem::path& header_path,
+                                     const std::filesystem::path& compiled_header_path) -> bool
+{
+    ASSERT(configuration.compiler.has_value());
+
+    const auto command = std::format("{} {} -fdiagnostics-color=always -x c++-header {} -o {}",
+                                     *configuration.compiler,
+                                     create_compilation_flags_string(configuration),
+                                     header_path.native(),
+                                     compiled_header_path.native());
+
+    const trace::Span span(
+        "Compile", "compile", {{"file", header_path.string()}, {"configuration", *configuration.name}});
+
+    return jobs::run(command).exit_status == EXIT_SUCCESS;
+}
+
+static auto remove_precompiled_header_files(const std::filesystem::path& header_path,
+                                            const std::filesystem::path& compiled_header_path) -> void
+{
+    std::error_code error;
+    std::filesystem::remove(header_path, error);
+    std::filesystem::remove(compiled_header_path, error);
+}
+
+auto precompiled_headers::handle_precompiled_headers(const Configuration& configuration,
+                                                     const std::filesystem::path& path_to_root,
+                                                     const build_caching::Info& build_info,
+                                                     const bool is_quiet) -> std::expected<Info, std::string>
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.precompiled_headers.value_or(false));
+
+    const auto previous_state = read_previous_state(*configuration.name, path_to_root);
+    // A header that is being actively edited is left out, since every change to the PCH forces a full rebuild.
+    const auto unstable_files = build_state::update_cooldowns(
+        previous_state.exists, previous_state.unstable_files, build_info.changed_files, &utils::is_header_file);
+
+    const auto num_of_source_files =
+        static_cast<int>(std::ranges::count_if(std::views::keys(build_info.file_hashes), &utils::is_source_file));
+    const auto compilation_times = build_caching::get_old_compilation_times(*configuration.name, path_to_root);
+
+    // Every change to the PCH recompiles the whole configuration. While the previous PCH is still valid,
+    // its headers are kept, so that a header whose cooldown expired is only added back
+    // once the PCH is rebuilt anyway (e.g. because one of its headers was edited).
+    const auto previous_pch_is_valid =
+        !previous_state.headers.empty() &&
+        compute_signature(configuration, build_info.dependency_graph, previous_state.headers, build_info.file_hashes) ==
+            previous_state.signature;
+
+    auto headers = previous_state.headers;
+
+    if (!previous_pch_is_valid)
+    {
+        headers = select_headers(build_info.dependency_graph,
+                                 num_of_source_files,
+                                 compilation_times,
+                                 std::views::keys(unstable_files) | std::ranges::to<std::vector>());
+    }
+
+    auto signature = compute_signature(configuration, build_info.dependency_graph, headers, build_info.file_hashes);
+
+    const auto header_path =
+        path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name / params::PRECOMPILED_HEADER_FILE_NAME;
+    const auto compiled_header_path = get_compiled_header_path(configuration, header_path);
+
+    const auto pch_is_outdated =
+        signature != previous_state.signature || !std::filesystem::exists(compiled_header_path);
+
+    if (!headers.empty() && pch_is_outdated)
+    {
+        if (!is_quiet)
+        {
+            std::println("Building precompiled header for configuration '{}'...", *configuration.name);
+        }
+
+        build_state::write_including_file(header_path, headers, path_to_root);
+
+        if (!build_precompiled_header(configuration, header_path, compiled_header_path))
+        {
+            // A header that cannot be compiled on its own should not break the build;
+            // continue without a PCH instead.
+            events::report_error("Failed to build the precompiled header; continuing without it.");
+            headers.clear();
+            signature = 0;
+        }
+    }
+
+    const auto requires_full_rebuild = signature != previous_state.signature;
+    write_state(*configuration.name, path_to_root, signature, headers, unstable_files);
+
+    if (headers.empty())
+    {
+        remove_precompiled_header_files(header_path, compiled_header_path);
+
+        return Info{
+            .header_path             = std::nullopt,
+            .headers                 = {},
+            .requires_full_rebuild   = requires_full_rebuild,
+            .estimated_seconds_saved = 0.0,
+        };
+    }
+
+    const auto estimated_seconds_saved =
+        estimate_seconds_saved(build_info.dependency_graph, headers, compilation_times, path_to_root);
+
+    if (!is_quiet)
+    {
+        const auto total_seconds = std::ranges::fold_left(std::views::values(compilation_times), 0.0, std::plus{});
+        const auto percentage    = total_seconds > 0 ? 100.0 * estimated_seconds_saved / total_seconds : 0.0;
+
+        std::println("Precompiled header contains {} header{}; estimated {:.1f}s ({:.0f}%) saved per full build.",
+                     headers.size(),
+                     headers.size() == 1 ? "" : "s",
+                     estimated_seconds_saved,
+                     percentage);
+    }
+
+    return Info{
+        .header_path             = header_path,
+        .headers                 = std::move(headers),
+        .requires_full_rebuild   = requires_full_rebuild,
+        .estimated_seconds_saved = estimated_seconds_saved,
+    };
+}
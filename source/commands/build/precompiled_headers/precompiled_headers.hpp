@@ -0,0 +1,44 @@
+#ifndef SOURCE_COMMANDS_BUILD_PRECOMPILED_HEADERS_PRECOMPILED_HEADERS_HPP
+#define SOURCE_COMMANDS_BUILD_PRECOMPILED_HEADERS_PRECOMPILED_HEADERS_HPP
+
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace precompiled_headers
+{
+    struct Info
+    {
+        std::optional<std::filesystem::path> header_path; // Generated header to force-include, if a PCH is used.
+        std::vector<std::filesystem::path> headers;       // Project headers inside the precompiled header.
+        bool requires_full_rebuild;                       // The PCH changed, so every source file must be recompiled.
+        double estimated_seconds_saved;                   // Per full build.
+    };
+
+    auto get_included_closure(const build_caching::DependencyGraph& dependency_graph,
+                              const std::vector<std::filesystem::path>& headers) -> std::vector<std::filesystem::path>;
+
+    auto select_headers(const build_caching::DependencyGraph& dependency_graph,
+                        int num_of_source_files,
+                        const std::unordered_map<std::filesystem::path, double>& compilation_times,
+                        const std::vector<std::filesystem::path>& unstable_files) -> std::vector<std::filesystem::path>;
+
+    auto estimate_seconds_saved(const build_caching::DependencyGraph& dependency_graph,
+                                const std::vector<std::filesystem::path>& headers,
+                                const std::unordered_map<std::filesystem::path, double>& compilation_times,
+                                const std::filesystem::path& path_to_root) -> double;
+
+    auto handle_precompiled_headers(const Configuration& configuration,
+                                    const std::filesystem::path& path_to_root,
+                                    const build_caching::Info& build_info,
+                                    bool is_quiet) -> std::expected<Info, std::string>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_PRECOMPILED_HEADERS_PRECOMPILED_HEADERS_HPP
@@ -0,0 +1,208 @@
+#include "source/commands/build/profile_guided_optimization/profile_guided_optimization.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <ranges>
+#include <string_view>
+#include <system_error> // std::error_code
+
+#include "source/commands/build/jobs.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+
+using namespace std::literals;
+
+static auto uses_clang(const Configuration& configuration) -> bool
+{
+    ASSERT(configuration.compiler.has_value());
+
+    return configuration.compiler->contains("clang");
+}
+
+static auto get_object_files_directory(const std::string_view configuration_name,
+                                       const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name;
+}
+
+static auto get_instrumented_name(const std::string_view name) -> std::string
+{
+    return std::format("{}{}", name, params::INSTRUMENTED_CONFIGURATION_SUFFIX);
+}
+
+auto profile_guided_optimization::get_instrumented_configuration(const Configuration& configuration,
+                                                                 const std::filesystem::path& path_to_root)
+    -> Configuration
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.output_name.has_value());
+
+    const auto raw_profile_directory = get_raw_profile_directory(configuration, path_to_root);
+    const auto generate_flag         = std::format("-fprofile-generate={}", raw_profile_directory.string());
+
+    auto instrumented_configuration        = configuration;
+    instrumented_configuration.name        = get_instrumented_name(*configuration.name);
+    instrumented_configuration.parent      = std::nullopt;
+    instrumented_configuration.output_name = get_instrumented_name(*configuration.output_name);
+    instrumented_configuration.profile     = std::nullopt;
+
+    auto compilation_flags = configuration.compilation_flags.value_or({});
+    compilation_flags.push_back(generate_flag);
+
+    // Training workloads are often multithreaded, and racing counter updates corrupt the profile.
+    if (!uses_clang(configuration))
+    {
+        compilation_flags.push_back("-fprofile-update=prefer-atomic");
+    }
+
+    auto link_flags = configuration.link_flags.value_or({});
+    link_flags.push_back(generate_flag); // Links the profiling runtime.
+
+    instrumented_configuration.compilation_flags = compilation_flags;
+    instrumented_configuration.link_flags        = link_flags;
+
+    return instrumented_configuration;
+}
+
+auto profile_guided_optimization::get_raw_profile_directory(const Configuration& configuration,
+                                                            const std::filesystem::path& path_to_root)
+    -> std::filesystem::path
+{
+    ASSERT(configuration.name.has_value());
+
+    return get_object_files_directory(get_instrumented_name(*configuration.name), path_to_root) /
+           params::RAW_PROFILE_DIRECTORY_NAME;
+}
+
+auto profile_guided_optimization::get_profile_path(const Configuration& configuration,
+                                                   const std::filesystem::path& path_to_root)
+    -> std::filesystem::path
+{
+    ASSERT(configuration.name.has_value());
+
+    const auto profile_directory =
+        get_object_files_directory(*configuration.name, path_to_root) / params::PROFILE_DIRECTORY_NAME;
+
+    return uses_clang(configuration) ? profile_directory / params::PROFILE_FILE_NAME : profile_directory;
+}
+
+auto profile_guided_optimization::find_profile(const Configuration& configuration,
+                                               const std::filesystem::path& path_to_root)
+    -> std::optional<std::string>
+{
+    const auto profile_path = get_profile_path(configuration, path_to_root);
+    auto error_code         = std::error_code{};
+
+    const auto profile_exists = uses_clang(configuration)
+                                    ? std::filesystem::is_regular_file(profile_path, error_code)
+                                    : std::filesystem::is_directory(profile_path, error_code) &&
+                                          !std::filesystem::is_empty(profile_path, error_code);
+
+    return profile_exists ? std::optional(profile_path.string()) : std::nullopt;
+}
+
+// Mirrors GCC, which replaces every directory separator with '#'.
+static auto mangle_path(const std::filesystem::path& path) -> std::string
+{
+    auto result = path.string();
+    std::ranges::replace(result, '/', '#');
+
+    return result;
+}
+
+auto profile_guided_optimization::get_profile_file_name(
+    const std::string& raw_profile_file_name,
+    const std::filesystem::path& instrumented_object_files_directory,
+    const std::filesystem::path& object_files_directory) -> std::string
+{
+    const auto instrumented_prefix = mangle_path(instrumented_object_files_directory) + '#';
+
+    if (!raw_profile_file_name.starts_with(instrumented_prefix))
+    {
+        return raw_profile_file_name;
+    }
+
+    return mangle_path(object_files_directory) + '#' + raw_profile_file_name.substr(instrumented_prefix.size());
+}
+
+// `llvm-profdata` is versioned like the compiler, e.g. `clang++-18` comes with `llvm-profdata-18`.
+static auto get_llvm_profdata(const std::string_view compiler) -> std::string
+{
+    for (const auto driver : {"clang++"sv, "clang"sv})
+    {
+        if (const auto position = compiler.find(driver); position != std::string_view::npos)
+        {
+            return std::format(
+                "{}llvm-profdata{}", compiler.substr(0, position), compiler.substr(position + driver.size()));
+        }
+    }
+
+    return "llvm-profdata";
+}
+
+auto profile_guided_optimization::merge_profile_data(const Configuration& configuration,
+                                                     const std::filesystem::path& path_to_root)
+    -> std::expected<void, std::string>
+{
+    ASSERT(configuration.name.has_value());
+
+    const auto raw_profile_directory = get_raw_profile_directory(configuration, path_to_root);
+    const auto profile_path          = get_profile_path(configuration, path_to_root);
+    const auto raw_extension         = uses_clang(configuration) ? ".profraw"sv : ".gcda"sv;
+    auto error_code                  = std::error_code{};
+
+    const auto raw_profile_files =
+        std::filesystem::recursive_directory_iterator(raw_profile_directory, error_code)                  //
+        | std::views::filter([&](const auto& entry) { return entry.path().extension() == raw_extension; }) //
+        | std::views::transform([](const auto& entry) { return entry.path(); })                            //
+        | std::ranges::to<std::vector>();                                                                   //
+
+    if (raw_profile_files.empty())
+    {
+        return std::unexpected(std::format("Error: The training command did not write any profile data to '{}'.",
+                                           raw_profile_directory.string()));
+    }
+
+    // The previous profile would otherwise leak into the new one.
+    std::filesystem::remove_all(uses_clang(configuration) ? profile_path.parent_path() : profile_path);
+
+    if (uses_clang(configuration))
+    {
+        std::filesystem::create_directories(profile_path.parent_path());
+
+        const auto merge_command = std::format("{} merge --output={} {}",
+                                               get_llvm_profdata(*configuration.compiler),
+                                               profile_path.string(),
+                                               raw_profile_directory.string());
+
+        if (jobs::run(merge_command).exit_status != EXIT_SUCCESS)
+        {
+            return std::unexpected(std::format("Error: Failed to merge the profile data in '{}'.",
+                                               raw_profile_directory.string()));
+        }
+
+        return {};
+    }
+
+    // GCC accumulates the counters of every run in the `.gcda` files, so they only have to be renamed.
+    const auto instrumented_object_files_directory = raw_profile_directory.parent_path();
+    const auto object_files_directory              = profile_path.parent_path();
+    std::filesystem::create_directories(profile_path);
+
+    for (const auto& raw_profile_file : raw_profile_files)
+    {
+        const auto profile_file_name = get_profile_file_name(
+            raw_profile_file.filename().string(), instrumented_object_files_directory, object_files_directory);
+
+        std::filesystem::copy_file(raw_profile_file, profile_path / profile_file_name, error_code);
+
+        if (error_code)
+        {
+            return std::unexpected(std::format(
+                "Error: Failed to copy profile data '{}': {}", raw_profile_file.string(), error_code.message()));
+        }
+    }
+
+    return {};
+}
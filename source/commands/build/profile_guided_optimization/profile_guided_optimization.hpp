@@ -0,0 +1,41 @@
+#ifndef SOURCE_COMMANDS_BUILD_PROFILE_GUIDED_OPTIMIZATION_PROFILE_GUIDED_OPTIMIZATION_HPP
+#define SOURCE_COMMANDS_BUILD_PROFILE_GUIDED_OPTIMIZATION_PROFILE_GUIDED_OPTIMIZATION_HPP
+
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace profile_guided_optimization
+{
+    // The instrumented variant of a configuration has its own object files directory and executable,
+    // so that switching between the variants does not recompile either of them.
+    auto get_instrumented_configuration(const Configuration& configuration,
+                                        const std::filesystem::path& path_to_root) -> Configuration;
+
+    // Where the instrumented executable writes its profile data while the training workload runs.
+    auto get_raw_profile_directory(const Configuration& configuration,
+                                   const std::filesystem::path& path_to_root) -> std::filesystem::path;
+
+    // GCC reads a directory of `.gcda` files, Clang reads a single `.profdata` file.
+    auto get_profile_path(const Configuration& configuration,
+                          const std::filesystem::path& path_to_root) -> std::filesystem::path;
+
+    // Returns the profile of the configuration if `easy-make pgo` recorded one.
+    auto find_profile(const Configuration& configuration,
+                      const std::filesystem::path& path_to_root) -> std::optional<std::string>;
+
+    // GCC names every `.gcda` file after the mangled path of its object file, e.g. `#root#build#a.cpp.gcda`.
+    // Returns the name under which the configuration's own object file looks for the profile data.
+    auto get_profile_file_name(const std::string& raw_profile_file_name,
+                               const std::filesystem::path& instrumented_object_files_directory,
+                               const std::filesystem::path& object_files_directory) -> std::string;
+
+    // Turns the raw profile data of the training run into the profile of the configuration.
+    auto merge_profile_data(const Configuration& configuration,
+                            const std::filesystem::path& path_to_root) -> std::expected<void, std::string>;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_PROFILE_GUIDED_OPTIMIZATION_PROFILE_GUIDED_OPTIMIZATION_HPP
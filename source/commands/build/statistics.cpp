@@ -0,0 +1,158 @@
+#include "source/commands/build/statistics.hpp"
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+
+#include <sys/resource.h> // getrusage
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/trace.hpp"
+#include "source/utils/allocation_counting.hpp"
+
+static constexpr auto NUM_OF_COUNTERS = static_cast<std::size_t>(statistics::Counter::NUM_OF_COUNTERS);
+
+static constexpr std::array<std::string_view, NUM_OF_COUNTERS> COUNTER_NAMES = {
+    "files_listed",
+    "files_hashed",
+    "files_scanned",
+    "bytes_read",
+    "include_resolutions",
+    "stat_calls",
+    "analysis_cache_hits",
+    "analysis_cache_misses",
+    "translation_units_compiled",
+    "translation_units_up_to_date",
+    "pool_tasks",
+    "pool_busy_us",
+    "pool_available_us",
+    "pool_queue_wait_us",
+    "remote_compilations",
+    "local_fallbacks",
+};
+
+static_assert(!COUNTER_NAMES.back().empty(), "Every counter must have a name.");
+
+static auto get_counters() -> std::array<std::atomic<std::int64_t>, NUM_OF_COUNTERS>&
+{
+    static std::array<std::atomic<std::int64_t>, NUM_OF_COUNTERS> counters{};
+
+    return counters;
+}
+
+static auto get_peak_memory_in_kilobytes() -> long
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss; // In kilobytes on Linux.
+}
+
+static auto get_ratio(const std::int64_t part, const std::int64_t total) -> double
+{
+    return total == 0 ? 0.0 : static_cast<double>(part) / static_cast<double>(total);
+}
+
+auto statistics::add(const Counter counter, const std::int64_t amount) -> void
+{
+    get_counters()[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+auto statistics::get(const Counter counter) -> std::int64_t
+{
+    return get_counters()[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+auto statistics::print() -> void
+{
+    const auto compiled   = get(Counter::TRANSLATION_UNITS_COMPILED);
+    const auto up_to_date = get(Counter::TRANSLATION_UNITS_UP_TO_DATE);
+    const auto hits       = get(Counter::ANALYSIS_CACHE_HITS);
+    const auto misses     = get(Counter::ANALYSIS_CACHE_MISSES);
+
+    std::println("Build statistics:");
+    std::println("  Translation units:   {} compiled, {} up to date ({:.1f}% cache hit ratio)",
+                 compiled,
+                 up_to_date,
+                 100 * get_ratio(up_to_date, compiled + up_to_date));
+    std::println("  Files:               {} listed, {} hashed, {} scanned, {} bytes read",
+                 get(Counter::FILES_LISTED),
+                 get(Counter::FILES_HASHED),
+                 get(Counter::FILES_SCANNED),
+                 get(Counter::BYTES_READ));
+    std::println("  File system:         {} include resolutions, {} stat calls",
+                 get(Counter::INCLUDE_RESOLUTIONS),
+                 get(Counter::STAT_CALLS));
+    std::println("  Analysis cache:      {} hits, {} misses ({:.1f}% hit ratio)",
+                 hits,
+                 misses,
+                 100 * get_ratio(hits, hits + misses));
+    std::println("  Compilation workers: {} tasks, {:.1f}% utilization, {:.1f} ms total queue wait",
+                 get(Counter::POOL_TASKS),
+                 100 * get_ratio(get(Counter::POOL_BUSY_MICROSECONDS), get(Counter::POOL_AVAILABLE_MICROSECONDS)),
+                 get(Counter::POOL_QUEUE_WAIT_MICROSECONDS) / 1000.0);
+    std::println("  Remote compilation:  {} remote, {} local fallbacks",
+                 get(Counter::REMOTE_COMPILATIONS),
+                 get(Counter::LOCAL_FALLBACKS));
+    std::println("  Peak memory:         {} KB", get_peak_memory_in_kilobytes());
+
+    if (const auto num_of_allocations = allocation_counting::get_num_of_allocations(); num_of_allocations.has_value())
+    {
+        std::println("  Heap allocations:    {}", *num_of_allocations);
+    }
+
+    const auto phases = trace::get_total_durations();
+
+    if (!phases.empty())
+    {
+        std::println("  Time per phase (summed over threads):");
+
+        for (const auto& [phase, duration] : phases)
+        {
+            std::println("    {:<24} {:>10.1f} ms", phase, duration.count() / 1000.0);
+        }
+    }
+}
+
+auto statistics::write(const std::filesystem::path& path) -> bool
+{
+    auto counters = nlohmann::json::object();
+
+    for (auto index = 0UZ; index < NUM_OF_COUNTERS; ++index)
+    {
+        counters[std::string(COUNTER_NAMES[index])] = get(static_cast<Counter>(index));
+    }
+
+    auto phases = nlohmann::json::object();
+
+    for (const auto& [phase, duration] : trace::get_total_durations())
+    {
+        phases[phase] = duration.count();
+    }
+
+    auto json = nlohmann::json{
+        {"counters",       counters                      },
+        {"phase_times_us", phases                        },
+        {"peak_rss_kb",    get_peak_memory_in_kilobytes()},
+    };
+
+    if (const auto num_of_allocations = allocation_counting::get_num_of_allocations(); num_of_allocations.has_value())
+    {
+        json["heap_allocations"] = *num_of_allocations;
+    }
+
+    auto file = std::ofstream(path);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << json.dump(4) << '\n';
+
+    return file.good();
+}
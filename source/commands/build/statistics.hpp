@@ -0,0 +1,45 @@
+#ifndef SOURCE_COMMANDS_BUILD_STATISTICS_HPP
+#define SOURCE_COMMANDS_BUILD_STATISTICS_HPP
+
+#include <cstdint>
+#include <filesystem>
+
+// Process-wide counters of the work a build does, printed by `easy-make build --stats`.
+// Counting is a relaxed atomic increment, so the counters are always on.
+namespace statistics
+{
+    enum class Counter
+    {
+        FILES_LISTED,                 // Entries of the source directories that were walked.
+        FILES_HASHED,
+        FILES_SCANNED,                // Files whose includes were read.
+        BYTES_READ,                   // By hashing and scanning.
+        INCLUDE_RESOLUTIONS,
+        STAT_CALLS,                   // Explicit `exists`, `is_regular_file` and `file_size` checks.
+        ANALYSIS_CACHE_HITS,
+        ANALYSIS_CACHE_MISSES,
+        TRANSLATION_UNITS_COMPILED,
+        TRANSLATION_UNITS_UP_TO_DATE,
+        POOL_TASKS,                   // Compilations that ran on the compilation thread pool.
+        POOL_BUSY_MICROSECONDS,       // Time the workers spent running tasks.
+        POOL_AVAILABLE_MICROSECONDS,  // Lifetime of the pools multiplied by their number of workers.
+        POOL_QUEUE_WAIT_MICROSECONDS, // Time tasks spent in the queue before a worker picked them up.
+        REMOTE_COMPILATIONS,          // Translation units compiled by `easy-make worker` daemons.
+        LOCAL_FALLBACKS,              // Translation units compiled locally since every worker was busy or unreachable.
+        NUM_OF_COUNTERS,
+    };
+
+    auto add(Counter counter, std::int64_t amount = 1) -> void;
+
+    auto get(Counter counter) -> std::int64_t;
+
+    // Prints the counters, the time spent in each traced phase and the peak memory of easy-make itself.
+    // Phase times are only recorded while tracing is enabled.
+    auto print() -> void;
+
+    // Writes the same information as `print` as JSON.
+    // Returns `false` if the file could not be written.
+    auto write(const std::filesystem::path& path) -> bool;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_STATISTICS_HPP
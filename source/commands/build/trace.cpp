@@ -0,0 +1,201 @@
+#include "source/commands/build/trace.hpp"
+
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+#include <utility> // std::move
+
+#include "third_party/nlohmann/json.hpp"
+
+namespace
+{
+    struct Event
+    {
+        std::string name;
+        std::string category;
+        std::chrono::steady_clock::time_point start_time;
+        std::chrono::steady_clock::time_point end_time;
+        int lane;
+        trace::Arguments arguments;
+    };
+
+    struct Recorder
+    {
+        std::atomic<bool> is_enabled = false;
+        std::chrono::steady_clock::time_point start_time;
+        std::mutex mutex;
+        std::vector<Event> events;
+        std::unordered_map<std::thread::id, int> lanes; // Assigned in the order in which the threads first record.
+    };
+}
+
+static auto get_recorder() -> Recorder&
+{
+    static Recorder recorder;
+
+    return recorder;
+}
+
+// Must be called with the mutex of the recorder held.
+static auto get_lane(Recorder& recorder) -> int
+{
+    const auto [iterator, _] =
+        recorder.lanes.try_emplace(std::this_thread::get_id(), static_cast<int>(recorder.lanes.size()));
+
+    return iterator->second;
+}
+
+auto trace::enable() -> void
+{
+    auto& recorder = get_recorder();
+
+    {
+        std::lock_guard lock(recorder.mutex);
+        recorder.start_time = std::chrono::steady_clock::now();
+        get_lane(recorder);
+    }
+
+    recorder.is_enabled = true;
+}
+
+auto trace::disable() -> void
+{
+    get_recorder().is_enabled = false;
+}
+
+auto trace::is_enabled() -> bool
+{
+    return get_recorder().is_enabled.load(std::memory_order_relaxed);
+}
+
+trace::Span::Span(const std::string_view name, const std::string_view category, Arguments arguments)
+    : is_recorded(is_enabled())
+{
+    if (is_recorded)
+    {
+        this->name      = name;
+        this->category  = category;
+        this->arguments = std::move(arguments);
+        start_time      = std::chrono::steady_clock::now();
+    }
+}
+
+trace::Span::~Span()
+{
+    if (!is_recorded)
+    {
+        return;
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    auto& recorder      = get_recorder();
+
+    std::lock_guard lock(recorder.mutex);
+    recorder.events.push_back({
+        .name       = std::move(name),
+        .category   = std::move(category),
+        .start_time = start_time,
+        .end_time   = end_time,
+        .lane       = get_lane(recorder),
+        .arguments  = std::move(arguments),
+    });
+}
+
+auto trace::Span::add_argument(std::string argument_name, Value value) -> void
+{
+    if (is_recorded)
+    {
+        arguments.emplace_back(std::move(argument_name), std::move(value));
+    }
+}
+
+static auto to_microseconds(const std::chrono::steady_clock::duration duration) -> std::int64_t
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+auto trace::get_total_durations() -> std::map<std::string, std::chrono::microseconds>
+{
+    auto& recorder = get_recorder();
+    std::lock_guard lock(recorder.mutex);
+
+    std::map<std::string, std::chrono::microseconds> durations;
+
+    for (const auto& event : recorder.events)
+    {
+        durations[event.name] += std::chrono::microseconds(to_microseconds(event.end_time - event.start_time));
+    }
+
+    return durations;
+}
+
+auto trace::clear() -> void
+{
+    auto& recorder = get_recorder();
+    std::lock_guard lock(recorder.mutex);
+
+    recorder.events.clear();
+    recorder.start_time = std::chrono::steady_clock::now();
+}
+
+auto trace::write(const std::filesystem::path& path) -> bool
+{
+    auto& recorder = get_recorder();
+    std::lock_guard lock(recorder.mutex);
+
+    auto trace_events = nlohmann::json::array();
+
+    // Complete events ("X") carry both their start and their duration.
+    for (const auto& event : recorder.events)
+    {
+        auto arguments = nlohmann::json::object();
+
+        for (const auto& [argument_name, value] : event.arguments)
+        {
+            std::visit([&](const auto& v) { arguments[argument_name] = v; }, value);
+        }
+
+        trace_events.push_back({
+            {"name", event.name                                             },
+            {"cat",  event.category                                         },
+            {"ph",   "X"                                                    },
+            {"ts",   to_microseconds(event.start_time - recorder.start_time)},
+            {"dur",  to_microseconds(event.end_time - event.start_time)     },
+            {"pid",  1                                                      },
+            {"tid",  event.lane                                             },
+            {"args", arguments                                              },
+        });
+    }
+
+    // Metadata events ("M") name the lanes.
+    for (const auto lane : recorder.lanes | std::views::values)
+    {
+        const auto lane_name = lane == 0 ? std::string("main") : std::format("worker {}", lane);
+
+        trace_events.push_back({
+            {"name", "thread_name"        },
+            {"ph",   "M"                  },
+            {"pid",  1                    },
+            {"tid",  lane                 },
+            {"args", {{"name", lane_name}}},
+        });
+    }
+
+    auto file = std::ofstream(path);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << nlohmann::json{
+        {"traceEvents",     trace_events},
+        {"displayTimeUnit", "ms"        },
+    };
+
+    return file.good();
+}
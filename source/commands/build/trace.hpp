@@ -0,0 +1,60 @@
+#ifndef SOURCE_COMMANDS_BUILD_TRACE_HPP
+#define SOURCE_COMMANDS_BUILD_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <variant>
+#include <vector>
+
+namespace trace
+{
+    using Value     = std::variant<std::string, std::int64_t>;
+    using Arguments = std::vector<std::pair<std::string, Value>>;
+
+    // Nothing is recorded until tracing is enabled, so that a span costs a single check otherwise.
+    // The calling thread is drawn in the first lane.
+    auto enable() -> void;
+
+    // Stops recording. The spans recorded so far are kept until `clear`.
+    auto disable() -> void;
+
+    auto is_enabled() -> bool;
+
+    // Records the time from its construction until its destruction, in the lane of the calling thread.
+    class Span
+    {
+      public:
+        Span(std::string_view name, std::string_view category, Arguments arguments = {});
+        ~Span();
+
+        Span(const Span&)                    = delete;
+        auto operator=(const Span&) -> Span& = delete;
+
+        // For values that are only known once the work is done.
+        auto add_argument(std::string argument_name, Value value) -> void;
+
+      private:
+        bool is_recorded;
+        std::string name;
+        std::string category;
+        Arguments arguments;
+        std::chrono::steady_clock::time_point start_time;
+    };
+
+    // The time spent in the spans of each name, summed over all lanes.
+    auto get_total_durations() -> std::map<std::string, std::chrono::microseconds>;
+
+    // Drops the recorded spans, so that consecutive runs in the same process are measured separately.
+    auto clear() -> void;
+
+    // Writes the recorded spans in the Chrome trace event format, which Perfetto and `chrome://tracing` open.
+    // Returns `false` if the file could not be written.
+    auto write(const std::filesystem::path& path) -> bool;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_TRACE_HPP
@@ -0,0 +1,687 @@
+#include "source/commands/build/unity_build/unity_build.hpp"
+
+#include <algorithm>
+#include <cmath> // std::lround
+#include <cstdint>
+#include <format>
+#include <functional> // std::plus
+#include <print>
+#include <ranges>
+#include <string>
+#include <system_error> // std::error_code
+#include <tuple>        // std::tie
+#include <unordered_set>
+
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_state.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/macros/assert.hpp"
+#include "source/utils/utils.hpp"
+
+using build_caching::DependencyGraph;
+using unity_build::Batch;
+
+namespace
+{
+    struct State
+    {
+        bool exists       = false; // No state is stored before the first unity build.
+        int next_batch_id = 0;
+        std::vector<Batch> batches;
+        build_state::Cooldowns recently_edited_files;                            // File -> number of builds left.
+        std::unordered_map<std::filesystem::path, std::uint64_t> isolated_files; // File -> hash when it was isolated.
+    };
+
+    struct OpenBatch
+    {
+        Batch batch;
+        double cost = 0.0;
+        std::unordered_set<std::filesystem::path> headers; // Headers included by any file in the batch.
+    };
+}
+
+/// @brief  Groups source files into batches that are compiled as a single translation unit.
+/// @param  dependency_graph The current include graph.
+/// @param  candidates       Source files that may be batched, sorted.
+/// @param  costs            Estimated compilation time of each candidate. Files without an estimate cost 1.
+/// @param  max_batch_cost   Maximal total cost of a batch.
+/// @param  previous_batches Batches of the previous build.
+/// @return Batches with at least two files. Candidates that are not in any batch are compiled on their own.
+/// @note   Previous batches are kept (minus files that are no longer candidates) so that an incremental build does
+///         not reshuffle every batch. Other candidates first join the previous batch they share the most headers
+///         with; the rest are ordered by their most widely included headers and cut into batches by cost.
+auto unity_build::group_into_batches(const DependencyGraph& dependency_graph,
+                                     const std::vector<std::filesystem::path>& candidates,
+                                     const std::unordered_map<std::filesystem::path, double>& costs,
+                                     const double max_batch_cost,
+                                     const std::vector<Batch>& previous_batches) -> std::vector<Batch>
+{
+    ASSERT(std::ranges::is_sorted(candidates));
+
+    const auto reversed_graph = dependency_graph.get_reversed();
+    const auto get_cost       = [&](const std::filesystem::path& file)
+    { return costs.contains(file) ? costs.at(file) : 1.0; };
+
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> included_headers;
+
+    for (const auto& file : candidates)
+    {
+        included_headers[file] = reversed_graph.get_reachable_nodes({file})   //
+                                 | std::views::filter(&utils::is_header_file) //
+                                 | std::ranges::to<std::vector>();            //
+    }
+
+    std::vector<OpenBatch> batches;
+    std::unordered_set<std::filesystem::path> assigned_files;
+
+    const auto add_to_batch = [&](OpenBatch& batch, const std::filesystem::path& file)
+    {
+        const auto& headers = included_headers.at(file);
+
+        batch.batch.files.push_back(file);
+        batch.cost += get_cost(file);
+        batch.headers.insert(headers.begin(), headers.end());
+        assigned_files.insert(file);
+    };
+
+    const auto has_room_for = [&](const OpenBatch& batch, const std::filesystem::path& file)
+    { return batch.batch.files.size() < MAX_FILES_PER_BATCH && batch.cost + get_cost(file) <= max_batch_cost; };
+
+    // Keep the previous batches.
+    for (const auto& previous_batch : previous_batches)
+    {
+        OpenBatch batch;
+        batch.batch.source_file = previous_batch.source_file;
+
+        for (const auto& file : previous_batch.files)
+        {
+            if (included_headers.contains(file) && !assigned_files.contains(file))
+            {
+                add_to_batch(batch, file);
+            }
+        }
+
+        if (batch.batch.files.size() == 1)
+        {
+            assigned_files.erase(batch.batch.files.front()); // Let the file join another batch.
+        }
+        else if (batch.batch.files.size() > 1)
+        {
+            batches.push_back(std::move(batch));
+        }
+    }
+
+    // Let the other candidates join the previous batch they share the most headers with.
+    std::unordered_map<std::filesystem::path, std::vector<std::size_t>> batches_including_header;
+
+    for (auto index = 0UZ; index < batches.size(); ++index)
+    {
+        for (const auto& header : batches[index].headers)
+        {
+            batches_including_header[header].push_back(index);
+        }
+    }
+
+    std::vector<std::filesystem::path> remaining_files;
+
+    for (const auto& file : candidates)
+    {
+        if (assigned_files.contains(file))
+        {
+            continue;
+        }
+
+        std::unordered_map<std::size_t, int> num_of_shared_headers;
+
+        for (const auto& header : included_headers.at(file))
+        {
+            if (batches_including_header.contains(header))
+            {
+                for (const auto index : batches_including_header.at(header))
+                {
+                    ++num_of_shared_headers[index];
+                }
+            }
+        }
+
+        std::optional<std::size_t> best_batch;
+
+        for (const auto& [index, count] : num_of_shared_headers)
+        {
+            if (!has_room_for(batches[index], file))
+            {
+                continue;
+            }
+
+            // Break ties by index so the result does not depend on the iteration order.
+            const auto is_better = !best_batch.has_value() || count > num_of_shared_headers.at(*best_batch) ||
+                                   (count == num_of_shared_headers.at(*best_batch) && index < *best_batch);
+
+            if (is_better)
+            {
+                best_batch = index;
+            }
+        }
+
+        if (!best_batch.has_value())
+        {
+            remaining_files.push_back(file);
+            continue;
+        }
+
+        for (const auto& header : included_headers.at(file))
+        {
+            if (!batches[*best_batch].headers.contains(header))
+            {
+                batches_including_header[header].push_back(*best_batch);
+            }
+        }
+
+        add_to_batch(batches[*best_batch], file);
+    }
+
+    // Order the remaining files by the headers they include, most widely included first,
+    // so that files that share headers end up next to each other.
+    std::unordered_map<std::filesystem::path, int> fan_out;
+
+    for (const auto& file : remaining_files)
+    {
+        for (const auto& header : included_headers.at(file))
+        {
+            ++fan_out[header];
+        }
+    }
+
+    const auto by_fan_out_then_path = [&](const auto& a, const auto& b)
+    { return (fan_out.at(a) != fan_out.at(b)) ? (fan_out.at(a) > fan_out.at(b)) : (a < b); };
+
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> signatures;
+
+    for (const auto& file : remaining_files)
+    {
+        auto signature = included_headers.at(file);
+        std::ranges::sort(signature, by_fan_out_then_path);
+        signatures[file] = std::move(signature);
+    }
+
+    std::ranges::sort(remaining_files,
+                      [&](const auto& a, const auto& b)
+                      { return std::tie(signatures.at(a), a) < std::tie(signatures.at(b), b); });
+
+    const auto num_of_previous_batches = batches.size();
+
+    for (const auto& file : remaining_files)
+    {
+        const auto start_new_batch = (batches.size() == num_of_previous_batches) || !has_room_for(batches.back(), file);
+
+        if (start_new_batch)
+        {
+            batches.emplace_back();
+        }
+
+        add_to_batch(batches.back(), file);
+    }
+
+    std::vector<Batch> result;
+
+    for (auto& batch : batches)
+    {
+        if (batch.batch.files.size() > 1)
+        {
+            std::ranges::sort(batch.batch.files);
+            result.push_back(std::move(batch.batch));
+        }
+    }
+
+    return result;
+}
+
+static auto get_data_file_path(const std::string_view configuration_name,
+                               const std::filesystem::path& path_to_root) -> std::filesystem::path
+{
+    return build_state::get_data_file_path(configuration_name, path_to_root, params::UNITY_BUILD_DATA_FILE_NAME);
+}
+
+static auto read_state(const std::string_view configuration_name, const std::filesystem::path& path_to_root) -> State
+{
+    const auto json = build_state::read_data_file(get_data_file_path(configuration_name, path_to_root));
+
+    if (!json.has_value())
+    {
+        return {};
+    }
+
+    State state;
+    state.exists        = true;
+    state.next_batch_id = json->at("nextBatchId").get<int>();
+
+    for (const auto& [source_file, files] : json->at("batches").items())
+    {
+        Batch batch;
+        batch.source_file = source_file;
+
+        for (const auto& file : files)
+        {
+            batch.files.push_back(file.get<std::string>());
+        }
+
+        state.batches.push_back(std::move(batch));
+    }
+
+    for (const auto& [file, num_of_builds] : json->at("recentlyEditedFiles").items())
+    {
+        state.recently_edited_files[file] = num_of_builds.get<int>();
+    }
+
+    for (const auto& [file, hash] : json->at("isolatedFiles").items())
+    {
+        state.isolated_files[file] = hash.get<std::uint64_t>();
+    }
+
+    return state;
+}
+
+static auto write_state(const std::string_view configuration_name,
+                        const std::filesystem::path& path_to_root,
+                        const State& state) -> void
+{
+    auto json = nlohmann::json{
+        {"nextBatchId",         state.next_batch_id     },
+        {"batches",             nlohmann::json::object()},
+        {"recentlyEditedFiles", nlohmann::json::object()},
+        {"isolatedFiles",       nlohmann::json::object()},
+    };
+
+    for (const auto& batch : state.batches)
+    {
+        auto files = nlohmann::json::array();
+
+        for (const auto& file : batch.files)
+        {
+            files.push_back(file.native());
+        }
+
+        json["batches"][batch.source_file.native()] = std::move(files);
+    }
+
+    for (const auto& [file, num_of_builds] : state.recently_edited_files)
+    {
+        json["recentlyEditedFiles"][file.native()] = num_of_builds;
+    }
+
+    for (const auto& [file, hash] : state.isolated_files)
+    {
+        json["isolatedFiles"][file.native()] = hash;
+    }
+
+    build_state::write_data_file(get_data_file_path(configuration_name, path_to_root), json);
+}
+
+// Estimated compilation time of each source file, based on previous builds.
+static auto get_estimated_costs(const std::string_view configuration_name,
+                                const std::filesystem::path& path_to_root,
+                                const std::vector<std::filesystem::path>& source_files)
+    -> std::unordered_map<std::filesystem::path, double>
+{
+    const auto compilation_times = build_caching::get_old_compilation_times(configuration_name, path_to_root);
+
+    // Files without history are assumed to be average.
+    const auto times_sum    = std::ranges::fold_left(std::views::values(compilation_times), 0.0, std::plus{});
+    const auto average_time = compilation_times.empty() ? 1.0 : times_sum / compilation_times.size();
+
+    std::unordered_map<std::filesystem::path, double> costs;
+
+    for (const auto& file : source_files)
+    {
+        costs[file] = compilation_times.contains(file) ? compilation_times.at(file) : average_time;
+    }
+
+    return costs;
+}
+
+static auto remove_object_file(const std::filesystem::path& object_files_directory,
+                               const std::filesystem::path& translation_unit) -> void
+{
+    std::error_code error;
+    utils::remove_object_file(object_files_directory, translation_unit, error);
+}
+
+static auto remove_batch_files(const std::filesystem::path& object_files_directory,
+                               const std::filesystem::path& path_to_root,
+                               const std::filesystem::path& source_file) -> void
+{
+    std::error_code error;
+    std::filesystem::remove(path_to_root / source_file, error);
+    remove_object_file(object_files_directory, source_file);
+}
+
+auto unity_build::get_translation_units(const std::string_view configuration_name,
+                                        const std::filesystem::path& path_to_root) -> build_caching::TranslationUnits
+{
+    build_caching::TranslationUnits translation_units;
+
+    for (const auto& batch : read_state(configuration_name, path_to_root).batches)
+    {
+        for (const auto& file : batch.files)
+        {
+            translation_units[file] = batch.source_file;
+        }
+    }
+
+    return translation_units;
+}
+
+/// @brief  Compiles the configuration's source files, batching stable files into generated unity translation units.
+/// @param  files_to_compile Source files that must be recompiled. A batch is recompiled if any of its files is.
+/// @return The compilation result in terms of the original source files.
+/// @note   If a batch fails to compile, its files are compiled on their own. When all of them succeed,
+///         the files clash with each other (e.g. same names in anonymous namespaces), so they are kept out of
+///         batches until they change.
+auto unity_build::compile_in_batches(const Configuration& configuration,
+                                     const std::filesystem::path& path_to_root,
+                                     const build_caching::Info& build_info,
+                                     const std::vector<std::filesystem::path>& files_to_compile,
+                                     const bool is_quiet,
+                                     const bool use_parallel_compilation,
+                                     const std::optional<std::filesystem::path>& precompiled_header)
+    -> CompilationResult
+{
+    ASSERT(configuration.name.has_value());
+    ASSERT(configuration.unity.value_or(false));
+
+    const auto object_files_directory = path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name;
+    const auto previous_state         = read_state(*configuration.name, path_to_root);
+
+    State state;
+    state.exists                = true;
+    state.next_batch_id         = previous_state.next_batch_id;
+    // A recently edited file is compiled on its own, so that editing it does not recompile the rest of its batch.
+    state.recently_edited_files = build_state::update_cooldowns(previous_state.exists,
+                                                                previous_state.recently_edited_files,
+                                                                build_info.changed_files,
+                                                                &utils::is_source_file);
+
+    // A file stays isolated until it changes.
+    for (const auto& [file, hash] : previous_state.isolated_files)
+    {
+        if (build_info.file_hashes.contains(file) && build_info.file_hashes.at(file) == hash)
+        {
+            state.isolated_files[file] = hash;
+        }
+    }
+
+    auto source_files = std::views::keys(build_info.file_hashes)     //
+                        | std::views::filter(&utils::is_source_file) //
+                        | std::ranges::to<std::vector>();            //
+    std::ranges::sort(source_files);
+
+    const auto is_candidate = [&](const std::filesystem::path& file)
+    { return !state.recently_edited_files.contains(file) && !state.isolated_files.contains(file); };
+
+    const auto candidates = source_files | std::views::filter(is_candidate) | std::ranges::to<std::vector>();
+    const auto costs      = get_estimated_costs(*configuration.name, path_to_root, source_files);
+    const auto get_cost   = [&](const std::filesystem::path& file) { return costs.at(file); };
+    const auto total_cost = std::ranges::fold_left(candidates | std::views::transform(get_cost), 0.0, std::plus{});
+
+    // Keep at least two batches per thread, so that batching does not leave threads idle.
+    const auto max_batch_cost = total_cost / (2 * get_num_of_compilation_threads(use_parallel_compilation));
+
+    state.batches = group_into_batches(
+        build_info.dependency_graph, candidates, costs, max_batch_cost, previous_state.batches);
+
+    for (auto& batch : state.batches)
+    {
+        if (batch.source_file.empty())
+        {
+            const auto file_name = std::format("{}{}.cpp", params::UNITY_BATCH_FILE_PREFIX, state.next_batch_id++);
+            batch.source_file    = params::BUILD_DIRECTORY_NAME / *configuration.name / file_name;
+        }
+    }
+
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> previous_batches;
+
+    for (const auto& batch : previous_state.batches)
+    {
+        previous_batches[batch.source_file] = batch.files;
+    }
+
+    const auto must_be_compiled   = files_to_compile | std::ranges::to<std::unordered_set>();
+    const auto object_file_exists = [&](const std::filesystem::path& translation_unit)
+    { return std::filesystem::exists(object_files_directory / utils::get_object_file_name(translation_unit)); };
+
+    std::vector<std::filesystem::path> translation_units;
+    std::unordered_set<std::filesystem::path> batch_source_files;
+    std::unordered_set<std::filesystem::path> batched_files;
+
+    for (const auto& batch : state.batches)
+    {
+        batch_source_files.insert(batch.source_file);
+        batched_files.insert(batch.files.begin(), batch.files.end());
+
+        const auto batch_is_unchanged =
+            previous_batches.contains(batch.source_file) && previous_batches.at(batch.source_file) == batch.files;
+        const auto batch_is_outdated = !batch_is_unchanged || !object_file_exists(batch.source_file) ||
+                                       std::ranges::any_of(batch.files, [&](const auto& file)
+                                                           { return must_be_compiled.contains(file); });
+
+        if (batch_is_outdated)
+        {
+            build_state::write_including_file(path_to_root / batch.source_file, batch.files, path_to_root);
+            translation_units.push_back(batch.source_file);
+
+            // Files that were compiled on their own before joining the batch would otherwise be linked twice.
+            for (const auto& file : batch.files)
+            {
+                remove_object_file(object_files_directory, file);
+            }
+        }
+    }
+
+    for (const auto& file : source_files)
+    {
+        // A file that has just left a batch has no object file of its own.
+        if (!batched_files.contains(file) && (must_be_compiled.contains(file) || !object_file_exists(file)))
+        {
+            translation_units.push_back(file);
+        }
+    }
+
+    for (const auto& batch : previous_state.batches)
+    {
+        if (!batch_source_files.contains(batch.source_file))
+        {
+            remove_batch_files(object_files_directory, path_to_root, batch.source_file);
+        }
+    }
+
+    std::ranges::sort(translation_units);
+
+    if (!is_quiet)
+    {
+        std::println("Unity build: {} files in {} batches, {} files compiled on their own.",
+                     batched_files.size(),
+                     state.batches.size(),
+                     source_files.size() - batched_files.size());
+    }
+
+    const auto result = compile_files(
+        configuration, path_to_root, translation_units, is_quiet, use_parallel_compilation, precompiled_header);
+
+    // A translation unit failed to compile exactly when it has no compilation time.
+    const auto compiled_successfully = [&](const std::filesystem::path& translation_unit)
+    { return result.compilation_times.contains(translation_unit); };
+
+    CompilationResult total_result{
+        .num_of_failures   = 0,
+        .compilation_times = {},
+    };
+
+    std::vector<Batch> failed_batches;
+
+    for (const auto& translation_unit : translation_units)
+    {
+        if (!batch_source_files.contains(translation_unit))
+        {
+            if (compiled_successfully(translation_unit))
+            {
+                total_result.compilation_times[translation_unit] = result.compilation_times.at(translation_unit);
+            }
+            else
+            {
+                ++total_result.num_of_failures;
+            }
+
+            if (result.peak_memory_in_kilobytes.contains(translation_unit))
+            {
+                total_result.peak_memory_in_kilobytes[translation_unit] =
+                    result.peak_memory_in_kilobytes.at(translation_unit);
+            }
+        }
+    }
+
+    for (const auto& batch : state.batches)
+    {
+        if (!std::ranges::binary_search(translation_units, batch.source_file))
+        {
+            continue; // The batch is up to date.
+        }
+
+        if (!compiled_successfully(batch.source_file))
+        {
+            failed_batches.push_back(batch);
+            continue;
+        }
+
+        // Split the time of the batch between its files, so that their estimates stay meaningful.
+        const auto batch_seconds = result.compilation_times.at(batch.source_file);
+        const auto batch_cost =
+            std::ranges::fold_left(batch.files | std::views::transform(get_cost), 0.0, std::plus{});
+
+        for (const auto& file : batch.files)
+        {
+            total_result.compilation_times[file] = batch_seconds * get_cost(file) / batch_cost;
+        }
+
+        // Memory does not add up like time: every file of the batch is reported with the peak of the whole batch.
+        const auto batch_memory = result.peak_memory_in_kilobytes.contains(batch.source_file)
+                                      ? result.peak_memory_in_kilobytes.at(batch.source_file)
+                                      : 0L;
+
+        if (batch_memory > 0)
+        {
+            for (const auto& file : batch.files)
+            {
+                total_result.peak_memory_in_kilobytes[file] = batch_memory;
+            }
+        }
+
+        // Budgets are per file, so every file is checked with its share of the batch, and a file over its budget
+        // does not fail the batch. The object file of the batch is removed, so that the next build checks it again.
+        auto exceeds_budget = false;
+
+        for (const auto& file : batch.files)
+        {
+            const auto share = get_cost(file) / batch_cost;
+            auto file_result = CompilationInfo{
+                .is_successful            = true,
+                .compiler_output          = "",
+                .duration_in_seconds      = total_result.compilation_times.at(file),
+                .peak_memory_in_kilobytes = std::lround(batch_memory * share),
+            };
+
+            enforce_budget(configuration, file, file_result);
+
+            if (!file_result.compiler_output.empty() && !events::is_enabled())
+            {
+                std::print("{}", file_result.compiler_output);
+            }
+
+            if (!file_result.is_successful)
+            {
+                ++total_result.num_of_failures;
+                total_result.compilation_times.erase(file);
+                exceeds_budget = true;
+            }
+        }
+
+        if (exceeds_budget)
+        {
+            remove_object_file(object_files_directory, batch.source_file);
+        }
+    }
+
+    if (!failed_batches.empty())
+    {
+        auto files_to_retry = failed_batches                        //
+                              | std::views::transform(&Batch::files) //
+                              | std::views::join                     //
+                              | std::ranges::to<std::vector>();      //
+        std::ranges::sort(files_to_retry);
+
+        if (!is_quiet)
+        {
+            std::println("Compiling the files of {} failed unity batch{} on their own...",
+                         failed_batches.size(),
+                         failed_batches.size() == 1 ? "" : "es");
+        }
+
+        const auto retry_result = compile_files(
+            configuration, path_to_root, files_to_retry, is_quiet, use_parallel_compilation, precompiled_header);
+
+        total_result.num_of_failures += retry_result.num_of_failures;
+        total_result.compilation_times.insert(retry_result.compilation_times.begin(),
+                                              retry_result.compilation_times.end());
+        total_result.peak_memory_in_kilobytes.insert(retry_result.peak_memory_in_kilobytes.begin(),
+                                                     retry_result.peak_memory_in_kilobytes.end());
+
+        for (const auto& batch : failed_batches)
+        {
+            const auto all_files_compiled = std::ranges::all_of(
+                batch.files, [&](const auto& file) { return retry_result.compilation_times.contains(file); });
+
+            if (all_files_compiled)
+            {
+                for (const auto& file : batch.files)
+                {
+                    state.isolated_files[file] = build_info.file_hashes.at(file);
+                }
+            }
+
+            remove_batch_files(object_files_directory, path_to_root, batch.source_file);
+        }
+
+        std::erase_if(state.batches,
+                      [&](const Batch& batch)
+                      {
+                          return std::ranges::any_of(failed_batches, [&](const Batch& failed_batch)
+                                                     { return failed_batch.source_file == batch.source_file; });
+                      });
+    }
+
+    write_state(*configuration.name, path_to_root, state);
+
+    return total_result;
+}
+
+auto unity_build::remove_unity_build_files(const std::string_view configuration_name,
+                                           const std::filesystem::path& path_to_root) -> void
+{
+    const auto state = read_state(configuration_name, path_to_root);
+
+    if (!state.exists)
+    {
+        return;
+    }
+
+    const auto object_files_directory = path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name;
+
+    for (const auto& batch : state.batches)
+    {
+        remove_batch_files(object_files_directory, path_to_root, batch.source_file);
+    }
+
+    std::error_code error;
+    std::filesystem::remove(get_data_file_path(configuration_name, path_to_root), error);
+}
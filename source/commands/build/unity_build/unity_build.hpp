@@ -0,0 +1,46 @@
+#ifndef SOURCE_COMMANDS_BUILD_UNITY_BUILD_UNITY_BUILD_HPP
+#define SOURCE_COMMANDS_BUILD_UNITY_BUILD_UNITY_BUILD_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace unity_build
+{
+    struct Batch
+    {
+        std::filesystem::path source_file;        // Generated translation unit. Empty for a batch that was just formed.
+        std::vector<std::filesystem::path> files; // Source files included by the generated translation unit.
+    };
+
+    inline constexpr auto MAX_FILES_PER_BATCH = 32UZ;
+
+    auto group_into_batches(const build_caching::DependencyGraph& dependency_graph,
+                            const std::vector<std::filesystem::path>& candidates,
+                            const std::unordered_map<std::filesystem::path, double>& costs,
+                            double max_batch_cost,
+                            const std::vector<Batch>& previous_batches) -> std::vector<Batch>;
+
+    auto get_translation_units(std::string_view configuration_name,
+                               const std::filesystem::path& path_to_root) -> build_caching::TranslationUnits;
+
+    auto compile_in_batches(const Configuration& configuration,
+                            const std::filesystem::path& path_to_root,
+                            const build_caching::Info& build_info,
+                            const std::vector<std::filesystem::path>& files_to_compile,
+                            bool is_quiet,
+                            bool use_parallel_compilation,
+                            const std::optional<std::filesystem::path>& precompiled_header) -> CompilationResult;
+
+    auto remove_unity_build_files(std::string_view configuration_name, const std::filesystem::path& path_to_root)
+        -> void;
+}
+
+#endif // SOURCE_COMMANDS_BUILD_UNITY_BUILD_UNITY_BUILD_HPP
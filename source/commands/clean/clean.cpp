@@ -4,8 +4,10 @@
 #include <string_view>
 
 #include "source/commands/build/configuration_resolution.hpp"
+#include "source/commands/build/profile_guided_optimization/profile_guided_optimization.hpp"
 #include "source/parameters/parameters.hpp"
 #include "source/utils/print.hpp"
+#include "source/utils/utils.hpp"
 
 auto commands::clean(const CleanCommandInfo& info,
                      const std::vector<Configuration>& configurations,
@@ -41,6 +43,15 @@ auto commands::clean(const CleanCommandInfo& info,
     const auto path_to_executable = path_to_root / output_path / *configuration_to_delete->output_name;
     const auto executable_deleted = std::filesystem::remove(path_to_executable);
 
+    // Remove the split debug info package, which is created next to the executable.
+    std::filesystem::remove(utils::get_split_debug_info_package_path(path_to_executable));
+
+    // Remove the instrumented variant that `easy-make pgo` builds next to the configuration.
+    const auto instrumented_configuration =
+        profile_guided_optimization::get_instrumented_configuration(*configuration_to_delete, path_to_root);
+    std::filesystem::remove_all(path_to_root / params::BUILD_DIRECTORY_NAME / *instrumented_configuration.name);
+    std::filesystem::remove(path_to_root / output_path / *instrumented_configuration.output_name);
+
     if (info.is_quiet)
     {
         return (build_directory_deleted || executable_deleted) ? EXIT_SUCCESS : EXIT_FAILURE;
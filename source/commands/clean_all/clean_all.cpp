@@ -4,6 +4,7 @@
 #include <print>
 
 #include "source/parameters/parameters.hpp"
+#include "source/utils/utils.hpp"
 
 auto commands::clean_all(const CleanAllCommandInfo& info,
                          const std::vector<Configuration>& configurations,
@@ -27,6 +28,7 @@ auto commands::clean_all(const CleanAllCommandInfo& info,
         const auto output_path        = configuration.output_path.value_or("");
         const auto path_to_executable = std::filesystem::path(path_to_root) / output_path / *configuration.output_name;
         const auto executable_removed = std::filesystem::remove(path_to_executable);
+        std::filesystem::remove(utils::get_split_debug_info_package_path(path_to_executable));
 
         if (executable_removed && !info.is_quiet)
         {
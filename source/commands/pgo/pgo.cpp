@@ -0,0 +1,106 @@
+#include "source/commands/pgo/pgo.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <print>
+
+#include "source/commands/build/build.hpp"
+#include "source/commands/build/configuration_resolution.hpp"
+#include "source/commands/build/linking.hpp"
+#include "source/commands/build/profile_guided_optimization/profile_guided_optimization.hpp"
+#include "source/utils/print.hpp"
+
+/// @brief  Builds the configuration with profile-guided optimization.
+/// @note   The instrumented variant is built into its own object files directory, so the regular object files
+///         stay valid. Running the training command writes the profile data, which is merged into the profile
+///         of the configuration. Every later build of the configuration uses that profile.
+auto commands::pgo(const PgoCommandInfo& info,
+                   const std::vector<Configuration>& configurations,
+                   const std::filesystem::path& path_to_root) -> int
+{
+    const auto configuration = get_resolved_configuration(configurations, info.configuration_name);
+
+    if (!configuration.has_value())
+    {
+        utils::print_error("{}", configuration.error());
+
+        return EXIT_FAILURE;
+    }
+
+    // Libraries have no workload of their own to train on.
+    if (configuration->type.value_or("executable") != "executable")
+    {
+        utils::print_error("Error: Configuration '{}' is a library, only executables can be built with PGO.",
+                           info.configuration_name);
+
+        return EXIT_FAILURE;
+    }
+
+    const auto instrumented_configuration =
+        profile_guided_optimization::get_instrumented_configuration(*configuration, path_to_root);
+
+    if (std::ranges::contains(configurations, instrumented_configuration.name, &Configuration::name))
+    {
+        utils::print_error("Error: Configuration '{}' is reserved for the instrumented variant of '{}'.",
+                           *instrumented_configuration.name,
+                           info.configuration_name);
+
+        return EXIT_FAILURE;
+    }
+
+    auto configurations_with_instrumented = configurations;
+    configurations_with_instrumented.push_back(instrumented_configuration);
+
+    const BuildCommandInfo instrumented_build_info = {
+        .configuration_name       = instrumented_configuration.name,
+        .build_all_configurations = false,
+        .is_quiet                 = info.is_quiet,
+        .use_parallel_compilation = info.use_parallel_compilation,
+    };
+
+    const auto instrumented_build_result =
+        commands::build(instrumented_build_info, configurations_with_instrumented, path_to_root);
+
+    if (instrumented_build_result.exit_status != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // The counters of previous training runs would be added to the new ones.
+    const auto raw_profile_directory =
+        profile_guided_optimization::get_raw_profile_directory(*configuration, path_to_root);
+    std::filesystem::remove_all(raw_profile_directory);
+    std::filesystem::create_directories(raw_profile_directory);
+
+    if (!info.is_quiet)
+    {
+        std::println("Training with '{}' (instrumented executable: '{}')...",
+                     info.training_command,
+                     get_output_path(instrumented_configuration).string());
+    }
+
+    if (std::system(info.training_command.c_str()) != EXIT_SUCCESS)
+    {
+        utils::print_error("Error: The training command '{}' failed.", info.training_command);
+
+        return EXIT_FAILURE;
+    }
+
+    const auto merge_result = profile_guided_optimization::merge_profile_data(*configuration, path_to_root);
+
+    if (!merge_result.has_value())
+    {
+        utils::print_error("{}", merge_result.error());
+
+        return EXIT_FAILURE;
+    }
+
+    const BuildCommandInfo build_info = {
+        .configuration_name       = info.configuration_name,
+        .build_all_configurations = false,
+        .is_quiet                 = info.is_quiet,
+        .use_parallel_compilation = info.use_parallel_compilation,
+    };
+
+    return commands::build(build_info, configurations, path_to_root).exit_status;
+}
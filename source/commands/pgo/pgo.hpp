@@ -0,0 +1,17 @@
+#ifndef SOURCE_COMMANDS_PGO_PGO_HPP
+#define SOURCE_COMMANDS_PGO_PGO_HPP
+
+#include <filesystem>
+#include <vector>
+
+#include "source/argument_parsing/command_info.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+
+namespace commands
+{
+    auto pgo(const PgoCommandInfo& info,
+             const std::vector<Configuration>& configurations,
+             const std::filesystem::path& path_to_root) -> int;
+}
+
+#endif // SOURCE_COMMANDS_PGO_PGO_HPP
@@ -0,0 +1,404 @@
+#include "source/commands/report/report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib> // `EXIT_SUCCESS`
+#include <format>
+#include <functional> // std::plus
+#include <iterator>   // std::distance
+#include <limits>
+#include <map>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <vector>
+
+// A file must have been compiled this many times before its compile time is considered to be growing.
+static constexpr auto MIN_NUM_OF_COMPILATIONS_FOR_GROWTH = 4;
+
+// Smaller changes are treated as noise, e.g. of a busy machine.
+static constexpr auto MIN_GROWTH_RATIO      = 1.2;
+static constexpr auto MIN_GROWTH_IN_SECONDS = 0.1;
+
+static constexpr auto NUM_OF_PRINTED_ENTRIES = 10UZ;
+static constexpr auto NUM_OF_PRINTED_DAYS    = 14UZ; // Per configuration.
+
+// Configuration name and file.
+using Key = std::pair<std::string, std::filesystem::path>;
+
+static auto get_key(const history::TranslationUnitRecord& record) -> Key
+{
+    return {record.configuration, record.file};
+}
+
+static auto format_date(const std::int64_t timestamp) -> std::string
+{
+    const auto time = std::chrono::sys_seconds(std::chrono::seconds(timestamp));
+
+    return std::format("{:%F}", std::chrono::floor<std::chrono::days>(time));
+}
+
+auto report::get_slowest_translation_units(const std::vector<history::TranslationUnitRecord>& records)
+    -> std::vector<SlowTranslationUnit>
+{
+    // The records are in the order they were written, so later compilations replace earlier ones.
+    std::map<Key, SlowTranslationUnit> latest_compilations;
+
+    for (const auto& record : records)
+    {
+        if (!record.is_successful)
+        {
+            continue;
+        }
+
+        latest_compilations.insert_or_assign(get_key(record),
+                                             SlowTranslationUnit{
+                                                 .configuration            = record.configuration,
+                                                 .file                     = record.file,
+                                                 .duration_in_seconds      = record.duration_in_seconds,
+                                                 .peak_memory_in_kilobytes = record.peak_memory_in_kilobytes,
+                                             });
+    }
+
+    auto result = latest_compilations | std::views::values | std::ranges::to<std::vector>();
+    std::ranges::stable_sort(result, std::ranges::greater{}, &SlowTranslationUnit::duration_in_seconds);
+
+    return result;
+}
+
+/// @brief  Finds the files whose compile time is growing.
+/// @return The files whose latest third of the compilations takes, on average, noticeably longer than the
+///         oldest third. Averaging over several compilations keeps a single slow build from being reported.
+auto report::get_growing_translation_units(const std::vector<history::TranslationUnitRecord>& records)
+    -> std::vector<GrowingTranslationUnit>
+{
+    std::map<Key, std::vector<double>> durations;
+
+    for (const auto& record : records)
+    {
+        if (record.is_successful)
+        {
+            durations[get_key(record)].push_back(record.duration_in_seconds);
+        }
+    }
+
+    std::vector<GrowingTranslationUnit> result;
+
+    for (const auto& [key, file_durations] : durations)
+    {
+        const auto num_of_compilations = std::ssize(file_durations);
+
+        if (num_of_compilations < MIN_NUM_OF_COMPILATIONS_FOR_GROWTH)
+        {
+            continue;
+        }
+
+        const auto window_size = std::max(1Z, num_of_compilations / 3);
+        const auto get_average = [&](const auto& window)
+        { return std::ranges::fold_left(window, 0.0, std::plus{}) / static_cast<double>(window_size); };
+
+        const auto old_duration = get_average(file_durations | std::views::take(window_size));
+        const auto new_duration = get_average(file_durations | std::views::drop(num_of_compilations - window_size));
+
+        if (new_duration < old_duration * MIN_GROWTH_RATIO || new_duration - old_duration < MIN_GROWTH_IN_SECONDS)
+        {
+            continue;
+        }
+
+        result.push_back({
+            .configuration           = key.first,
+            .file                    = key.second,
+            .old_duration_in_seconds = old_duration,
+            .new_duration_in_seconds = new_duration,
+            .num_of_compilations     = static_cast<int>(num_of_compilations),
+        });
+    }
+
+    const auto get_growth = [](const GrowingTranslationUnit& entry)
+    { return entry.new_duration_in_seconds - entry.old_duration_in_seconds; };
+    std::ranges::stable_sort(result, std::ranges::greater{}, get_growth);
+
+    return result;
+}
+
+// These causes rebuild every file of the configuration, so they say nothing about a specific file.
+static auto is_rebuild_of_every_file(const std::string_view cause) -> bool
+{
+    return cause == history::get_cause_name(explain::Cause::FIRST_BUILD) ||
+           cause == history::get_cause_name(explain::Cause::CONFIGURATION_CHANGED) ||
+           cause == history::get_cause_name(explain::Cause::PRECOMPILED_HEADER_CHANGED);
+}
+
+auto report::get_most_rebuilt_translation_units(const std::vector<history::BuildRecord>& builds,
+                                                const std::vector<history::TranslationUnitRecord>& records)
+    -> std::vector<RebuiltTranslationUnit>
+{
+    struct Counts
+    {
+        std::int64_t first_timestamp      = std::numeric_limits<std::int64_t>::max();
+        int num_of_rebuilds               = 0;
+        int num_of_rebuilds_of_every_file = 0;
+        std::map<std::string, int> causes;
+    };
+
+    std::map<Key, Counts> counts;
+
+    for (const auto& record : records)
+    {
+        auto& file_counts           = counts[get_key(record)];
+        file_counts.first_timestamp = std::min(file_counts.first_timestamp, record.timestamp);
+
+        if (is_rebuild_of_every_file(record.cause))
+        {
+            ++file_counts.num_of_rebuilds_of_every_file;
+            continue;
+        }
+
+        ++file_counts.num_of_rebuilds;
+        ++file_counts.causes[record.cause];
+    }
+
+    // Up-to-date files are not recorded, so a file is counted as part of every build of its configuration
+    // since it was first compiled. The translation units share the timestamp of their build.
+    std::map<std::string, std::vector<std::int64_t>> build_timestamps;
+
+    for (const auto& build : builds)
+    {
+        build_timestamps[build.configuration].push_back(build.timestamp);
+    }
+
+    for (auto& timestamps : build_timestamps | std::views::values)
+    {
+        std::ranges::sort(timestamps);
+    }
+
+    std::vector<RebuiltTranslationUnit> result;
+
+    for (const auto& [key, file_counts] : counts)
+    {
+        if (file_counts.num_of_rebuilds == 0)
+        {
+            continue;
+        }
+
+        const auto& timestamps = build_timestamps[key.first];
+        const auto num_of_builds_since_first_compilation =
+            std::distance(std::ranges::lower_bound(timestamps, file_counts.first_timestamp), timestamps.end());
+        const auto num_of_builds = std::max(
+            static_cast<int>(num_of_builds_since_first_compilation) - file_counts.num_of_rebuilds_of_every_file,
+            file_counts.num_of_rebuilds);
+
+        // Ties are broken by the name of the cause, so that the output is deterministic.
+        const auto most_common_cause = std::ranges::max_element(
+            file_counts.causes, [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+
+        result.push_back({
+            .configuration     = key.first,
+            .file              = key.second,
+            .num_of_rebuilds   = file_counts.num_of_rebuilds,
+            .num_of_builds     = num_of_builds,
+            .most_common_cause = most_common_cause->first,
+        });
+    }
+
+    std::ranges::stable_sort(result, std::ranges::greater{}, &RebuiltTranslationUnit::num_of_rebuilds);
+
+    return result;
+}
+
+auto report::get_build_trends(const std::vector<history::BuildRecord>& records) -> std::vector<BuildTrend>
+{
+    struct Totals
+    {
+        int num_of_builds               = 0;
+        double duration_in_seconds      = 0.0;
+        long long num_of_files_compiled = 0;
+    };
+
+    // Dates are formatted as `YYYY-MM-DD`, so they are ordered like strings.
+    std::map<std::pair<std::string, std::string>, Totals> totals;
+
+    for (const auto& record : records)
+    {
+        auto& day_totals = totals[{record.configuration, format_date(record.timestamp)}];
+        ++day_totals.num_of_builds;
+        day_totals.duration_in_seconds += record.duration_in_seconds;
+        day_totals.num_of_files_compiled += record.num_of_files_compiled;
+    }
+
+    std::vector<BuildTrend> result;
+
+    for (const auto& [key, day_totals] : totals)
+    {
+        const auto num_of_builds = static_cast<double>(day_totals.num_of_builds);
+
+        result.push_back({
+            .configuration                 = key.first,
+            .date                          = key.second,
+            .num_of_builds                 = day_totals.num_of_builds,
+            .average_duration_in_seconds   = day_totals.duration_in_seconds / num_of_builds,
+            .average_num_of_files_compiled = static_cast<double>(day_totals.num_of_files_compiled) / num_of_builds,
+        });
+    }
+
+    return result;
+}
+
+static auto format_memory(const long peak_memory_in_kilobytes) -> std::string
+{
+    // Files shared with another configuration have no memory usage.
+    if (peak_memory_in_kilobytes == 0)
+    {
+        return std::format("{:>10}", "-");
+    }
+
+    return std::format("{:6.1f} MiB", static_cast<double>(peak_memory_in_kilobytes) / 1024.0);
+}
+
+template <typename Entry>
+static auto print_section(const std::string_view title,
+                          const std::vector<Entry>& entries,
+                          const std::size_t max_num_of_entries,
+                          const auto& print_entry,
+                          std::ostream& output) -> void
+{
+    std::println(output, "{}:", title);
+
+    if (entries.empty())
+    {
+        std::println(output, "  None.");
+    }
+
+    for (const auto& entry : entries | std::views::take(max_num_of_entries))
+    {
+        print_entry(entry);
+    }
+
+    std::println(output);
+}
+
+static auto print_build_trends(const std::vector<report::BuildTrend>& trends,
+                               const std::size_t max_num_of_days,
+                               std::ostream& output) -> void
+{
+    std::println(output, "Build time per day (builds, average duration, average files compiled):");
+
+    const auto is_same_configuration = [](const report::BuildTrend& lhs, const report::BuildTrend& rhs)
+    { return lhs.configuration == rhs.configuration; };
+
+    for (const auto configuration_trends : trends | std::views::chunk_by(is_same_configuration))
+    {
+        std::println(output, "  {}", configuration_trends.front().configuration);
+
+        // Only the latest days, which are the last ones.
+        const auto num_of_days = std::ranges::distance(configuration_trends);
+        const auto num_of_skipped_days = std::max(0Z, num_of_days - static_cast<std::ptrdiff_t>(max_num_of_days));
+
+        for (const auto& trend : configuration_trends | std::views::drop(num_of_skipped_days))
+        {
+            std::println(output,
+                         "    {}  {:5}x  {:9.3f}s  {:8.1f}",
+                         trend.date,
+                         trend.num_of_builds,
+                         trend.average_duration_in_seconds,
+                         trend.average_num_of_files_compiled);
+        }
+    }
+
+    std::println(output);
+}
+
+auto commands::report(const ReportCommandInfo& info, const std::filesystem::path& path_to_root, std::ostream& output)
+    -> int
+{
+    auto build_history = history::read(path_to_root);
+
+    if (info.configuration_name.has_value())
+    {
+        const auto is_of_other_configuration = [&](const auto& record)
+        { return record.configuration != *info.configuration_name; };
+
+        std::erase_if(build_history.builds, is_of_other_configuration);
+        std::erase_if(build_history.translation_units, is_of_other_configuration);
+    }
+
+    if (build_history.builds.empty())
+    {
+        if (info.configuration_name.has_value())
+        {
+            std::println(output, "No builds of configuration '{}' were recorded.", *info.configuration_name);
+        }
+        else
+        {
+            std::println(output, "No builds were recorded.");
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    const auto unlimited          = std::numeric_limits<std::size_t>::max();
+    const auto max_num_of_entries = info.show_all_entries ? unlimited : NUM_OF_PRINTED_ENTRIES;
+    const auto max_num_of_days    = info.show_all_entries ? unlimited : NUM_OF_PRINTED_DAYS;
+
+    std::println(output,
+                 "{} {} recorded since {}.",
+                 build_history.builds.size(),
+                 build_history.builds.size() == 1 ? "build was" : "builds were",
+                 format_date(build_history.builds.front().timestamp));
+    std::println(output);
+
+    print_section("Slowest translation units (latest compilation, peak memory)",
+                  report::get_slowest_translation_units(build_history.translation_units),
+                  max_num_of_entries,
+                  [&](const report::SlowTranslationUnit& entry)
+                  {
+                      std::println(output,
+                                   "  {:9.3f}s  {}  {}  {}",
+                                   entry.duration_in_seconds,
+                                   format_memory(entry.peak_memory_in_kilobytes),
+                                   entry.configuration,
+                                   entry.file.native());
+                  },
+                  output);
+
+    print_section("Translation units whose compile time is growing (oldest and latest average, compilations)",
+                  report::get_growing_translation_units(build_history.translation_units),
+                  max_num_of_entries,
+                  [&](const report::GrowingTranslationUnit& entry)
+                  {
+                      const auto growth_in_percent =
+                          100.0 * (entry.new_duration_in_seconds / entry.old_duration_in_seconds - 1.0);
+
+                      std::println(output,
+                                   "  {:9.3f}s -> {:9.3f}s  {:+5.0f}%  {:5}x  {}  {}",
+                                   entry.old_duration_in_seconds,
+                                   entry.new_duration_in_seconds,
+                                   growth_in_percent,
+                                   entry.num_of_compilations,
+                                   entry.configuration,
+                                   entry.file.native());
+                  },
+                  output);
+
+    print_section("Most frequently rebuilt translation units (rebuilds of builds, most common reason)",
+                  report::get_most_rebuilt_translation_units(build_history.builds, build_history.translation_units),
+                  max_num_of_entries,
+                  [&](const report::RebuiltTranslationUnit& entry)
+                  {
+                      std::println(output,
+                                   "  {:5} of {:5}  {:<22}  {}  {}",
+                                   entry.num_of_rebuilds,
+                                   entry.num_of_builds,
+                                   entry.most_common_cause,
+                                   entry.configuration,
+                                   entry.file.native());
+                  },
+                  output);
+
+    print_build_trends(report::get_build_trends(build_history.builds), max_num_of_days, output);
+
+    return EXIT_SUCCESS;
+}
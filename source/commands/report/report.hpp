@@ -0,0 +1,75 @@
+#ifndef SOURCE_COMMANDS_REPORT_REPORT_HPP
+#define SOURCE_COMMANDS_REPORT_REPORT_HPP
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "source/argument_parsing/command_info.hpp"
+#include "source/commands/build/history.hpp"
+
+namespace report
+{
+    struct SlowTranslationUnit
+    {
+        std::string configuration;
+        std::filesystem::path file;
+        double duration_in_seconds;    // Of its latest successful compilation.
+        long peak_memory_in_kilobytes; // Same, zero if its object file was shared.
+    };
+
+    struct GrowingTranslationUnit
+    {
+        std::string configuration;
+        std::filesystem::path file;
+        double old_duration_in_seconds; // Average of its oldest compilations.
+        double new_duration_in_seconds; // Average of its latest compilations.
+        int num_of_compilations;
+    };
+
+    struct RebuiltTranslationUnit
+    {
+        std::string configuration;
+        std::filesystem::path file;
+        int num_of_rebuilds;
+        int num_of_builds;             // Including the builds in which it was up to date.
+        std::string most_common_cause; // See `history::get_cause_name`.
+    };
+
+    struct BuildTrend
+    {
+        std::string configuration;
+        std::string date; // `YYYY-MM-DD`, in UTC.
+        int num_of_builds;
+        double average_duration_in_seconds;
+        double average_num_of_files_compiled;
+    };
+
+    // Sorted by the duration of their latest successful compilation, slowest first.
+    auto get_slowest_translation_units(const std::vector<history::TranslationUnitRecord>& records)
+        -> std::vector<SlowTranslationUnit>;
+
+    // The files whose latest compilations are noticeably slower than their oldest ones, by growth (most first).
+    auto get_growing_translation_units(const std::vector<history::TranslationUnitRecord>& records)
+        -> std::vector<GrowingTranslationUnit>;
+
+    // Sorted by the number of rebuilds, most first. Rebuilds of every file of a configuration
+    // (its first build, or a change of the configuration or the precompiled header) are not counted.
+    // A file is part of the `builds` of its configuration since its first compilation.
+    auto get_most_rebuilt_translation_units(const std::vector<history::BuildRecord>& builds,
+                                            const std::vector<history::TranslationUnitRecord>& records)
+        -> std::vector<RebuiltTranslationUnit>;
+
+    // One entry per configuration and day on which it was built, ordered by configuration and then by date.
+    auto get_build_trends(const std::vector<history::BuildRecord>& records) -> std::vector<BuildTrend>;
+}
+
+namespace commands
+{
+    auto report(const ReportCommandInfo& info,
+                const std::filesystem::path& path_to_root,
+                std::ostream& output = std::cout) -> int;
+}
+
+#endif // SOURCE_COMMANDS_REPORT_REPORT_HPP
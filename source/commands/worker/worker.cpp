@@ -0,0 +1,307 @@
+#include "source/commands/worker/worker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>  // std::isalnum
+#include <cstdlib> // mkdtemp
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <memory>
+#include <optional>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error> // std::error_code
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/compilation/thread_pool.hpp"
+#include "source/commands/build/distributed/distributed.hpp"
+#include "source/commands/build/jobs.hpp"
+#include "source/utils/print.hpp"
+
+using namespace std::literals;
+
+// A client that does not send its request by then is disconnected, so that it does not hold a job.
+static constexpr auto REQUEST_TIMEOUT_IN_SECONDS = 60;
+
+// How often the stop token is checked while no connection arrives.
+static constexpr auto POLL_INTERVAL_IN_MILLISECONDS = 100;
+
+// Flags that take no path, so the compiler reads and writes no file besides the translation unit and the object file.
+static constexpr std::array ALLOWED_FLAGS = {
+    "-w"sv,
+    "-pedantic"sv,
+    "-pedantic-errors"sv,
+    "-pthread"sv,
+    "-fPIC"sv,
+    "-fpic"sv,
+    "-fPIE"sv,
+    "-fpie"sv,
+    "-flto"sv,
+    "-flto=thin"sv,
+    "-fexceptions"sv,
+    "-frtti"sv,
+    "-fopenmp"sv,
+    "-ffast-math"sv,
+};
+
+static constexpr std::array ALLOWED_FLAG_PREFIXES = {
+    "-std="sv,
+    "-O"sv,
+    "-g"sv,
+    "-W"sv, // Except the options that are passed on to the assembler, the linker, or the preprocessor.
+    "-m"sv,
+    "-fno-"sv,
+    "-fsanitize="sv,
+    "-fvisibility="sv,
+    "-ftemplate-depth="sv,
+    "-fconstexpr-depth="sv,
+    "-fconstexpr-steps="sv,
+};
+
+static auto is_allowed_flag_character(const char character) -> bool
+{
+    return std::isalnum(static_cast<unsigned char>(character)) || "-_=+.,: "sv.contains(character);
+}
+
+static auto is_allowed_flag(const std::string_view flag) -> bool
+{
+    // `-Wa,`, `-Wl,` and `-Wp,`.
+    if (flag.starts_with("-W") && flag.size() > 3 && flag[3] == ',')
+    {
+        return false;
+    }
+
+    return std::ranges::contains(ALLOWED_FLAGS, flag) ||
+           std::ranges::any_of(ALLOWED_FLAG_PREFIXES, [&](const auto prefix) { return flag.starts_with(prefix); });
+}
+
+auto worker::is_allowed(const distributed::Request& request) -> bool
+{
+    const auto is_supported_compiler = request.compiler == "g++" || request.compiler == "clang++";
+
+    if (!is_supported_compiler || !std::ranges::all_of(request.compilation_flags, &is_allowed_flag_character))
+    {
+        return false;
+    }
+
+    for (const auto flag_range : request.compilation_flags | std::views::split(' '))
+    {
+        const auto flag = std::string_view(flag_range.begin(), flag_range.end());
+
+        if (!flag.empty() && !is_allowed_flag(flag))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static auto read_file(const std::filesystem::path& path) -> std::string
+{
+    auto file = std::ifstream(path, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// `mkdtemp` creates a directory that no other process owns, unlike a predictable name.
+static auto create_working_directory() -> std::optional<std::filesystem::path>
+{
+    auto path_template = (std::filesystem::temp_directory_path() / "easy-make-worker-XXXXXX").native();
+
+    if (mkdtemp(path_template.data()) == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    return path_template;
+}
+
+auto worker::compile(const distributed::Request& request) -> distributed::Response
+{
+    using Status = distributed::Response::Status;
+
+    // An object file of another compiler version may not link with the objects that the client compiles itself.
+    if (!is_allowed(request) || request.compiler_version != distributed::get_compiler_version(request.compiler))
+    {
+        return {
+            .status              = Status::REJECTED,
+            .compiler_output     = "",
+            .object_file         = "",
+            .duration_in_seconds = 0.0,
+        };
+    }
+
+    const auto working_directory = create_working_directory();
+
+    if (!working_directory.has_value())
+    {
+        return {
+            .status              = Status::REJECTED,
+            .compiler_output     = "",
+            .object_file         = "",
+            .duration_in_seconds = 0.0,
+        };
+    }
+
+    const auto source_file_path     = *working_directory / "translation_unit.ii"; // Compiled as preprocessed C++.
+    const auto object_file_path     = *working_directory / "translation_unit.o";
+    const auto compiler_output_path = *working_directory / "compiler_output.txt";
+
+    {
+        auto source_file = std::ofstream(source_file_path, std::ios::binary);
+        source_file << request.preprocessed_source;
+    }
+
+    const auto compilation_command = std::format("{} {} -fdiagnostics-color=always -c {} -o {} > {} 2>&1",
+                                                 request.compiler,
+                                                 request.compilation_flags,
+                                                 source_file_path.native(),
+                                                 object_file_path.native(),
+                                                 compiler_output_path.native());
+
+    const auto job_result = jobs::run(compilation_command,
+                                      {
+                                          .max_seconds             = request.max_compile_seconds,
+                                          .max_memory_in_megabytes = request.max_memory_in_megabytes,
+                                      });
+
+    // The shell exits with 127 if the compiler is not installed on this machine.
+    const auto compiler_is_missing =
+        WIFEXITED(job_result.exit_status) && WEXITSTATUS(job_result.exit_status) == 127;
+    const auto is_compiled = job_result.exit_status == EXIT_SUCCESS;
+    const auto status      = compiler_is_missing ? Status::REJECTED : is_compiled ? Status::COMPILED : Status::FAILED;
+
+    auto response = distributed::Response{
+        .status                   = status,
+        .compiler_output          = read_file(compiler_output_path),
+        .object_file              = is_compiled ? read_file(object_file_path) : "",
+        .duration_in_seconds      = job_result.duration_in_seconds,
+        .peak_memory_in_kilobytes = job_result.peak_memory_in_kilobytes,
+    };
+
+    std::error_code error;
+    std::filesystem::remove_all(*working_directory, error);
+
+    return response;
+}
+
+static auto handle_connection(const distributed::Socket& connection) -> void
+{
+    const timeval timeout{.tv_sec = REQUEST_TIMEOUT_IN_SECONDS, .tv_usec = 0};
+    setsockopt(connection.get(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const auto request = distributed::receive_request(connection);
+
+    // A client with another protocol version or a broken connection gets no answer.
+    if (!request.has_value())
+    {
+        return;
+    }
+
+    distributed::send_response(connection, worker::compile(*request));
+}
+
+auto worker::serve(const distributed::Socket& listener, const int max_num_of_jobs, std::stop_token stop_token) -> void
+{
+    std::atomic<int> num_of_running_jobs = 0;
+
+    // Declared after the counter, so that the running compilations finish before it is destroyed.
+    ThreadPool thread_pool(max_num_of_jobs);
+
+    while (!stop_token.stop_requested())
+    {
+        pollfd poll_info{.fd = listener.get(), .events = POLLIN, .revents = 0};
+
+        if (poll(&poll_info, 1, POLL_INTERVAL_IN_MILLISECONDS) != 1)
+        {
+            continue;
+        }
+
+        const auto file_descriptor = accept4(listener.get(), nullptr, nullptr, SOCK_CLOEXEC);
+
+        if (file_descriptor == -1)
+        {
+            continue;
+        }
+
+        // The thread pool copies its tasks, so the connection is shared with the task that handles it.
+        auto connection = std::make_shared<distributed::Socket>(file_descriptor);
+
+        if (num_of_running_jobs.load() >= max_num_of_jobs)
+        {
+            distributed::send_response(*connection,
+                                       {
+                                           .status              = distributed::Response::Status::BUSY,
+                                           .compiler_output     = "",
+                                           .object_file         = "",
+                                           .duration_in_seconds = 0.0,
+                                       });
+
+            continue;
+        }
+
+        ++num_of_running_jobs;
+        thread_pool.add_task(
+            [connection, &num_of_running_jobs]
+            {
+                // A connection that throws must not keep its job, or the worker would eventually stay busy.
+                try
+                {
+                    handle_connection(*connection);
+                }
+                catch (const std::exception& exception)
+                {
+                    utils::print_error("Error: Failed to handle a request: {}", exception.what());
+                }
+
+                --num_of_running_jobs;
+            });
+    }
+}
+
+auto commands::worker(const WorkerCommandInfo& info) -> int
+{
+    const auto address = distributed::parse_address(info.address);
+
+    if (!address.has_value())
+    {
+        utils::print_error("{}", address.error());
+
+        return EXIT_FAILURE;
+    }
+
+    const auto listener = distributed::listen(*address);
+
+    if (!listener.has_value())
+    {
+        utils::print_error("{}", listener.error());
+
+        return EXIT_FAILURE;
+    }
+
+    const auto max_num_of_jobs = get_num_of_compilation_threads(info.use_parallel_compilation);
+
+    if (!info.is_quiet)
+    {
+        std::println("Listening on '{}' with {} {}.",
+                     distributed::to_string(*address),
+                     max_num_of_jobs,
+                     max_num_of_jobs == 1 ? "job" : "jobs");
+    }
+
+    // The worker runs until the process is stopped.
+    const std::stop_source stop_source;
+    worker::serve(*listener, max_num_of_jobs, stop_source.get_token());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,33 @@
+#ifndef SOURCE_COMMANDS_WORKER_WORKER_HPP
+#define SOURCE_COMMANDS_WORKER_WORKER_HPP
+
+#include <stop_token>
+
+#include "source/argument_parsing/command_info.hpp"
+#include "source/commands/build/distributed/protocol.hpp"
+
+namespace commands
+{
+    // Compiles the translation units that `easy-make build --workers` sends, until the process is stopped.
+    auto worker(const WorkerCommandInfo& info) -> int;
+}
+
+namespace worker
+{
+    // Whether the worker runs the compiler of `request`.
+    // Only the supported compilers are run, and only with flags that take no path, since the flags are passed to the
+    // shell and the compiler must not read or write the worker's files.
+    auto is_allowed(const distributed::Request& request) -> bool;
+
+    // Compiles the preprocessed translation unit of `request` in a directory of its own, within its budget.
+    // Rejects the request if the compiler of the worker has another version than the client's.
+    auto compile(const distributed::Request& request) -> distributed::Response;
+
+    /// @brief Accepts connections on `listener` and answers each of them with the result of its compilation.
+    /// @param max_num_of_jobs  Compilations that run at the same time. Connections beyond them are answered with
+    ///                         `Response::Status::BUSY`, so that easy-make tries another worker instead of waiting.
+    /// @param stop_token       Checked between connections; once stopped, the running compilations are finished.
+    auto serve(const distributed::Socket& listener, int max_num_of_jobs, std::stop_token stop_token) -> void;
+}
+
+#endif // SOURCE_COMMANDS_WORKER_WORKER_HPP
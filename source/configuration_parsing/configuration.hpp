@@ -5,6 +5,14 @@
 #include <string>
 #include <vector>
 
+// A budget for the translation units under `path`, which is a source file or a directory.
+struct BudgetOverride
+{
+    std::string path;
+    std::optional<double> max_compile_seconds{};
+    std::optional<double> max_memory_in_megabytes{};
+};
+
 struct Configuration
 {
     std::optional<std::string> name;
@@ -23,6 +31,24 @@ struct Configuration
     std::optional<std::vector<std::string>> excluded_directories;
     std::optional<std::string> output_name;
     std::optional<std::string> output_path;
+    std::optional<bool> precompiled_headers;
+    std::optional<bool> unity;
+    std::optional<bool> partial_links;
+    std::optional<std::string> linker;
+    std::optional<std::string> debug_info;
+    std::optional<std::string> lto;
+    std::optional<std::string> type;
+    std::optional<std::vector<std::string>> dependencies;
+    std::optional<double> max_compile_seconds;
+    std::optional<double> max_memory_in_megabytes;
+    std::optional<std::string> budget_action;
+    std::optional<std::vector<BudgetOverride>> budget_overrides;
+
+    // Not read from the configurations file. Set by the build when `easy-make pgo` recorded a profile.
+    std::optional<std::string> profile;
+
+    // Not read from the configurations file. Set by the build when a shared library depends on the configuration.
+    std::optional<bool> position_independent_code;
 };
 
 #endif // SOURCE_CONFIGURATION_PARSING_CONFIGURATION_HPP
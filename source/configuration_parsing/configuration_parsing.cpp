@@ -114,6 +114,89 @@ static auto parse_configuration(const nlohmann::json& json) -> Configuration
         }
     }
 
+    if (json.contains(key_to_string(JsonKey::PrecompiledHeaders)))
+    {
+        configuration.precompiled_headers = json[key_to_string(JsonKey::PrecompiledHeaders)].get<bool>();
+    }
+
+    if (json.contains(key_to_string(JsonKey::Unity)))
+    {
+        configuration.unity = json[key_to_string(JsonKey::Unity)].get<bool>();
+    }
+
+    if (json.contains(key_to_string(JsonKey::Linker)))
+    {
+        configuration.linker = json[key_to_string(JsonKey::Linker)];
+    }
+
+    if (json.contains(key_to_string(JsonKey::DebugInfo)))
+    {
+        configuration.debug_info = json[key_to_string(JsonKey::DebugInfo)];
+    }
+
+    if (json.contains(key_to_string(JsonKey::Type)))
+    {
+        configuration.type = json[key_to_string(JsonKey::Type)];
+    }
+
+    if (json.contains(key_to_string(JsonKey::Dependencies)))
+    {
+        configuration.dependencies = json[key_to_string(JsonKey::Dependencies)];
+    }
+
+    if (json.contains(key_to_string(JsonKey::Lto)))
+    {
+        configuration.lto = json[key_to_string(JsonKey::Lto)];
+    }
+
+    if (json.contains(key_to_string(JsonKey::PartialLinks)))
+    {
+        configuration.partial_links = json[key_to_string(JsonKey::PartialLinks)].get<bool>();
+    }
+
+    if (json.contains(key_to_string(JsonKey::Budgets)))
+    {
+        const auto& budgets = json[key_to_string(JsonKey::Budgets)];
+
+        if (budgets.contains(key_to_string(JsonKey::BudgetCompileSeconds)))
+        {
+            configuration.max_compile_seconds = budgets[key_to_string(JsonKey::BudgetCompileSeconds)].get<double>();
+        }
+
+        if (budgets.contains(key_to_string(JsonKey::BudgetMemoryMegabytes)))
+        {
+            configuration.max_memory_in_megabytes =
+                budgets[key_to_string(JsonKey::BudgetMemoryMegabytes)].get<double>();
+        }
+
+        if (budgets.contains(key_to_string(JsonKey::BudgetAction)))
+        {
+            configuration.budget_action = budgets[key_to_string(JsonKey::BudgetAction)];
+        }
+
+        if (budgets.contains(key_to_string(JsonKey::BudgetOverrides)))
+        {
+            configuration.budget_overrides.emplace();
+
+            for (const auto& [path, budget] : budgets[key_to_string(JsonKey::BudgetOverrides)].items())
+            {
+                auto& budget_override = configuration.budget_overrides->emplace_back(BudgetOverride{.path = path});
+
+                if (budget.contains(key_to_string(JsonKey::BudgetCompileSeconds)))
+                {
+                    budget_override.max_compile_seconds =
+                        budget[key_to_string(JsonKey::BudgetCompileSeconds)].get<double>();
+                }
+
+                if (budget.contains(key_to_string(JsonKey::BudgetMemoryMegabytes)))
+                {
+                    budget_override.max_memory_in_megabytes =
+                        budget[key_to_string(JsonKey::BudgetMemoryMegabytes)].get<double>();
+                }
+            }
+        }
+    }
+
     return configuration;
 }
 
@@ -7,25 +7,38 @@
 using namespace json_keys;
 
 static const std::flat_map<JsonKey, std::string> key_to_string_map = {
-    {JsonKey::Name,                "name"              },
-    {JsonKey::Parent,              "parent"            },
-    {JsonKey::Warnings,            "warnings"          },
-    {JsonKey::CompilationFlags,    "compilationFlags"  },
-    {JsonKey::LinkFlags,           "linkFlags"         },
-    {JsonKey::Optimization,        "optimization"      },
-    {JsonKey::Compiler,            "compiler"          },
-    {JsonKey::Standard,            "standard"          },
-    {JsonKey::Defines,             "defines"           },
-    {JsonKey::IncludeDirectories,  "includeDirectories"},
-    {JsonKey::Source,              "sources"           },
-    {JsonKey::SourceFiles,         "files"             },
-    {JsonKey::SourceDirectories,   "directories"       },
-    {JsonKey::Excludes,            "exclude"           },
-    {JsonKey::ExcludedFiles,       "files"             },
-    {JsonKey::ExcludedDirectories, "directories"       },
-    {JsonKey::Output,              "output"            },
-    {JsonKey::OutputName,          "name"              },
-    {JsonKey::OutputPath,          "path"              },
+    {JsonKey::Name,                  "name"              },
+    {JsonKey::Parent,                "parent"            },
+    {JsonKey::Warnings,              "warnings"          },
+    {JsonKey::CompilationFlags,      "compilationFlags"  },
+    {JsonKey::LinkFlags,             "linkFlags"         },
+    {JsonKey::Optimization,          "optimization"      },
+    {JsonKey::Compiler,              "compiler"          },
+    {JsonKey::Standard,              "standard"          },
+    {JsonKey::Defines,               "defines"           },
+    {JsonKey::IncludeDirectories,    "includeDirectories"},
+    {JsonKey::Source,                "sources"           },
+    {JsonKey::SourceFiles,           "files"             },
+    {JsonKey::SourceDirectories,     "directories"       },
+    {JsonKey::Excludes,              "exclude"           },
+    {JsonKey::ExcludedFiles,         "files"             },
+    {JsonKey::ExcludedDirectories,   "directories"       },
+    {JsonKey::Output,                "output"            },
+    {JsonKey::OutputName,            "name"              },
+    {JsonKey::OutputPath,            "path"              },
+    {JsonKey::PrecompiledHeaders,    "precompiledHeaders"},
+    {JsonKey::Unity,                 "unity"             },
+    {JsonKey::Linker,                "linker"            },
+    {JsonKey::DebugInfo,             "debugInfo"         },
+    {JsonKey::Type,                  "type"              },
+    {JsonKey::Dependencies,          "dependencies"      },
+    {JsonKey::PartialLinks,          "partialLinks"      },
+    {JsonKey::Lto,                   "lto"               },
+    {JsonKey::Budgets,               "budgets"           },
+    {JsonKey::BudgetCompileSeconds,  "compileSeconds"    },
+    {JsonKey::BudgetMemoryMegabytes, "memoryMegabytes"   },
+    {JsonKey::BudgetAction,          "action"            },
+    {JsonKey::BudgetOverrides,       "overrides"         },
 };
 
 static const auto string_to_key_map = []
@@ -54,6 +67,15 @@ static const std::flat_set<std::string> valid_outer_json_keys = {
     key_to_string(JsonKey::Source),
     key_to_string(JsonKey::Excludes),
     key_to_string(JsonKey::Output),
+    key_to_string(JsonKey::PrecompiledHeaders),
+    key_to_string(JsonKey::Unity),
+    key_to_string(JsonKey::Linker),
+    key_to_string(JsonKey::DebugInfo),
+    key_to_string(JsonKey::Type),
+    key_to_string(JsonKey::Dependencies),
+    key_to_string(JsonKey::PartialLinks),
+    key_to_string(JsonKey::Lto),
+    key_to_string(JsonKey::Budgets),
 };
 
 static const std::flat_set<std::string> valid_inner_json_keys = {
@@ -63,6 +85,10 @@ static const std::flat_set<std::string> valid_inner_json_keys = {
     key_to_string(JsonKey::ExcludedDirectories),
     key_to_string(JsonKey::OutputName),
     key_to_string(JsonKey::OutputPath),
+    key_to_string(JsonKey::BudgetCompileSeconds),
+    key_to_string(JsonKey::BudgetMemoryMegabytes),
+    key_to_string(JsonKey::BudgetAction),
+    key_to_string(JsonKey::BudgetOverrides),
 };
 
 auto json_keys::key_to_string(const JsonKey key) -> std::string
@@ -104,6 +130,15 @@ auto json_keys::get_related_inner_key_names(const std::string& key_name) -> std:
         related_keys = {JsonKey::OutputName, JsonKey::OutputPath};
         break;
 
+    case JsonKey::Budgets:
+        related_keys = {
+            JsonKey::BudgetCompileSeconds,
+            JsonKey::BudgetMemoryMegabytes,
+            JsonKey::BudgetAction,
+            JsonKey::BudgetOverrides,
+        };
+        break;
+
     default:
         related_keys = {};
     }
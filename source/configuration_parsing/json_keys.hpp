@@ -27,6 +27,19 @@ namespace json_keys
         Output,
         OutputName,
         OutputPath,
+        PrecompiledHeaders,
+        Unity,
+        Linker,
+        DebugInfo,
+        Type,
+        Dependencies,
+        PartialLinks,
+        Lto,
+        Budgets,
+        BudgetCompileSeconds,
+        BudgetMemoryMegabytes,
+        BudgetAction,
+        BudgetOverrides,
     };
 
     auto key_to_string(JsonKey key) -> std::string;
@@ -7,6 +7,7 @@
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "source/configuration_parsing/json_keys.hpp"
 #include "source/utils/find_closest_word.hpp"
@@ -54,7 +55,8 @@ static auto create_invalid_key_massage(const std::string_view key_name,
 
     // If `key_name` is a concatenation of outer and inner keys (e.g "output.path"),
     // we need to extract them separately as `utils::find_closest_word` cannot handle concatenated keys.
-    const auto dot_position   = key_name.find('.');
+    // The last key never contains a dot, unlike the paths in "budgets.overrides".
+    const auto dot_position   = key_name.rfind('.');
     const auto has_nested_key = dot_position != std::string_view::npos;
     const auto outer_key      = has_nested_key ? key_name.substr(0, dot_position + 1) : std::string_view{};
     const auto inner_key      = has_nested_key ? key_name.substr(dot_position + 1) : key_name;
@@ -97,6 +99,12 @@ static auto create_invalid_type_message(const std::string_view key,
                        actual_type);
 }
 
+// Integers and floating-point numbers are both accepted where a number is expected.
+static auto has_expected_type(const json& value, const json::value_t expected_type) -> bool
+{
+    return expected_type == json::value_t::number_float ? value.is_number() : value.type() == expected_type;
+}
+
 static auto get_expected_outer_value_type(const std::string& key_name) -> std::optional<json::value_t>
 {
     if (!is_valid_outer_key(key_name))
@@ -113,6 +121,10 @@ static auto get_expected_outer_value_type(const std::string& key_name) -> std::o
     case JsonKey::Compiler:
     case JsonKey::Standard:
     case JsonKey::Optimization:
+    case JsonKey::Linker:
+    case JsonKey::DebugInfo:
+    case JsonKey::Type:
+    case JsonKey::Lto:
         return json::value_t::string;
 
     case JsonKey::Warnings:
@@ -120,13 +132,20 @@ static auto get_expected_outer_value_type(const std::string& key_name) -> std::o
     case JsonKey::LinkFlags:
     case JsonKey::Defines:
     case JsonKey::IncludeDirectories:
+    case JsonKey::Dependencies:
         return json::value_t::array;
 
     case JsonKey::Source:
     case JsonKey::Excludes:
     case JsonKey::Output:
+    case JsonKey::Budgets:
         return json::value_t::object;
 
+    case JsonKey::PrecompiledHeaders:
+    case JsonKey::Unity:
+    case JsonKey::PartialLinks:
+        return json::value_t::boolean;
+
     default:
         return std::nullopt;
     }
@@ -159,6 +178,62 @@ static auto get_expected_inner_value_type(const std::string& key_name,
             return json::value_t::string;
         }
     }
+    else if (parent_key_name == key_to_string(JsonKey::Budgets))
+    {
+        if (key_name == key_to_string(JsonKey::BudgetCompileSeconds) ||
+            key_name == key_to_string(JsonKey::BudgetMemoryMegabytes))
+        {
+            return json::value_t::number_float;
+        }
+        else if (key_name == key_to_string(JsonKey::BudgetAction))
+        {
+            return json::value_t::string;
+        }
+        else if (key_name == key_to_string(JsonKey::BudgetOverrides))
+        {
+            return json::value_t::object;
+        }
+    }
+
+    return std::nullopt;
+}
+
+// "budgets.overrides" maps paths to budgets, so it is the only value nested deeper than the inner keys.
+static auto validate_budget_overrides_structure(const json& overrides,
+                                                const int configuration_index) -> std::optional<std::string>
+{
+    const auto budget_keys = std::vector{
+        key_to_string(JsonKey::BudgetCompileSeconds),
+        key_to_string(JsonKey::BudgetMemoryMegabytes),
+    };
+
+    for (const auto& [path, budget] : overrides.items())
+    {
+        const auto budget_key_name = std::format(
+            "{}.{}.{}", key_to_string(JsonKey::Budgets), key_to_string(JsonKey::BudgetOverrides), path);
+
+        if (!budget.is_object())
+        {
+            return create_invalid_type_message(
+                budget_key_name, "object", type_to_string(budget.type()), configuration_index);
+        }
+
+        for (const auto& [key, value] : budget.items())
+        {
+            const auto key_name = std::format("{}.{}", budget_key_name, key);
+
+            if (!std::ranges::contains(budget_keys, key))
+            {
+                return create_invalid_key_massage(key_name, configuration_index, budget_keys);
+            }
+
+            if (!value.is_number())
+            {
+                return create_invalid_type_message(
+                    key_name, "number", type_to_string(value.type()), configuration_index);
+            }
+        }
+    }
 
     return std::nullopt;
 }
@@ -215,7 +290,7 @@ static auto validate_configuration_structure(const json& json,
                 }
 
                 const auto actual_inner_value_type = inner_value.type();
-                const auto inner_type_is_correct   = *expected_inner_value_type == actual_inner_value_type;
+                const auto inner_type_is_correct   = has_expected_type(inner_value, *expected_inner_value_type);
 
                 if (!inner_type_is_correct)
                 {
@@ -224,6 +299,16 @@ static auto validate_configuration_structure(const json& json,
                                                        type_to_string(actual_inner_value_type),
                                                        configuration_index);
                 }
+
+                if (inner_key == key_to_string(JsonKey::BudgetOverrides))
+                {
+                    const auto overrides_error = validate_budget_overrides_structure(inner_value, configuration_index);
+
+                    if (overrides_error.has_value())
+                    {
+                        return overrides_error;
+                    }
+                }
             }
         }
     }
@@ -227,6 +227,202 @@ static auto validate_optimization(const Configuration& configuration) -> std::op
                        *configuration.optimization);
 }
 
+static auto validate_dependencies(const std::vector<Configuration>& configurations) -> std::optional<std::string>
+{
+    const auto configuration_names = [&]
+    {
+        std::vector<std::string_view> names;
+        names.reserve(configurations.size());
+
+        for (const auto& configuration : configurations)
+        {
+            ASSERT(configuration.name.has_value());
+            names.push_back(*configuration.name);
+        }
+
+        std::ranges::sort(names); // So we can use binary search.
+
+        return names;
+    }();
+
+    utils::DirectedGraph<std::string_view> dependency_graph{};
+
+    for (const auto& configuration : configurations)
+    {
+        const auto configuration_has_dependencies = configuration.dependencies.has_value();
+
+        // The graph keeps views of the names, so they must outlive it.
+        if (!configuration_has_dependencies)
+        {
+            continue;
+        }
+
+        for (const auto& dependency : *configuration.dependencies)
+        {
+            if (dependency == *configuration.name)
+            {
+                return std::format("Error: Configuration '{}' depends on itself.", *configuration.name);
+            }
+
+            ASSERT(std::ranges::is_sorted(configuration_names));
+            const auto dependency_exists = std::ranges::binary_search(configuration_names, dependency);
+
+            if (dependency_exists)
+            {
+                dependency_graph.add_edge(*configuration.name, dependency);
+                continue;
+            }
+
+            auto non_existent_dependency_error =
+                std::format("Error: Configuration '{}' depends on a non-existent configuration '{}'.",
+                            *configuration.name,
+                            dependency);
+
+            if (const auto closest_name = utils::find_closest_word(dependency, configuration_names);
+                closest_name.has_value())
+            {
+                std::format_to(std::back_inserter(non_existent_dependency_error), " Did you mean '{}'?", *closest_name);
+            }
+
+            return non_existent_dependency_error;
+        }
+    }
+
+    const auto cycle_info   = dependency_graph.check_for_cycle();
+    const auto cycle_exists = cycle_info.has_value();
+
+    if (cycle_exists)
+    {
+        return std::format("Error: Circular dependency between configurations detected.\n\n"
+                           "The following configurations form a cycle:\n"
+                           "{}",
+                           *cycle_info);
+    }
+
+    return std::nullopt;
+}
+
+static auto validate_type(const Configuration& configuration) -> std::optional<std::string>
+{
+    const auto valid_types = std::vector{
+        "executable"sv,
+        "static"sv,
+        "shared"sv,
+    };
+
+    if (!configuration.type.has_value() || std::ranges::contains(valid_types, *configuration.type))
+    {
+        return std::nullopt;
+    }
+
+    return std::format("Error: Configuration '{}' has an unknown type '{}'.", *configuration.name, *configuration.type);
+}
+
+static auto validate_linker(const Configuration& configuration) -> std::optional<std::string>
+{
+    const auto valid_linkers = std::vector{
+        "default"sv,
+        "auto"sv,
+        "bfd"sv,
+        "gold"sv,
+        "lld"sv,
+        "mold"sv,
+    };
+
+    if (!configuration.linker.has_value() || std::ranges::contains(valid_linkers, *configuration.linker))
+    {
+        return std::nullopt;
+    }
+
+    return std::format(
+        "Error: Configuration '{}' has an unknown linker '{}'.", *configuration.name, *configuration.linker);
+}
+
+static auto validate_debug_info(const Configuration& configuration) -> std::optional<std::string>
+{
+    const auto valid_debug_info_modes = std::vector{
+        "none"sv,
+        "full"sv,
+        "split"sv,
+        "packaged"sv,
+    };
+
+    if (!configuration.debug_info.has_value() ||
+        std::ranges::contains(valid_debug_info_modes, *configuration.debug_info))
+    {
+        return std::nullopt;
+    }
+
+    return std::format("Error: Configuration '{}' has an unknown debug info mode '{}'.",
+                       *configuration.name,
+                       *configuration.debug_info);
+}
+
+static auto validate_lto(const Configuration& configuration) -> std::optional<std::string>
+{
+    const auto valid_lto_modes = std::vector{
+        "none"sv,
+        "full"sv,
+        "thin"sv,
+    };
+
+    if (!configuration.lto.has_value() || std::ranges::contains(valid_lto_modes, *configuration.lto))
+    {
+        return std::nullopt;
+    }
+
+    return std::format(
+        "Error: Configuration '{}' has an unknown LTO mode '{}'.", *configuration.name, *configuration.lto);
+}
+
+static auto validate_budgets(const Configuration& configuration,
+                             const std::filesystem::path& path_to_root) -> std::optional<std::string>
+{
+    const auto valid_budget_actions = std::vector{
+        "warn"sv,
+        "fail"sv,
+        "kill"sv,
+    };
+
+    if (configuration.budget_action.has_value() &&
+        !std::ranges::contains(valid_budget_actions, *configuration.budget_action))
+    {
+        return std::format("Error: Configuration '{}' has an unknown budget action '{}'.",
+                           *configuration.name,
+                           *configuration.budget_action);
+    }
+
+    const auto is_positive = [](const std::optional<double>& limit) { return !limit.has_value() || *limit > 0; };
+
+    if (!is_positive(configuration.max_compile_seconds) || !is_positive(configuration.max_memory_in_megabytes))
+    {
+        return std::format("Error: Configuration '{}' has a budget that is not positive.", *configuration.name);
+    }
+
+    if (configuration.budget_overrides.has_value())
+    {
+        for (const auto& budget_override : *configuration.budget_overrides)
+        {
+            if (!std::filesystem::exists(path_to_root / budget_override.path))
+            {
+                return std::format("Error: Configuration '{}' has a budget for a non-existent path '{}'.",
+                                   *configuration.name,
+                                   budget_override.path);
+            }
+
+            if (!is_positive(budget_override.max_compile_seconds) ||
+                !is_positive(budget_override.max_memory_in_megabytes))
+            {
+                return std::format("Error: Configuration '{}' has a budget for '{}' that is not positive.",
+                                   *configuration.name,
+                                   budget_override.path);
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
 static auto validate_sources_and_excludes(const Configuration& configuration,
                                           const std::filesystem::path& path_to_root) -> std::optional<std::string>
 {
@@ -329,6 +525,26 @@ static auto validate_arguments(const std::vector<Configuration>& configurations,
         {
             return *optimization_error;
         }
+        if (const auto type_error = validate_type(configuration); type_error.has_value())
+        {
+            return *type_error;
+        }
+        if (const auto linker_error = validate_linker(configuration); linker_error.has_value())
+        {
+            return *linker_error;
+        }
+        if (const auto debug_info_error = validate_debug_info(configuration); debug_info_error.has_value())
+        {
+            return *debug_info_error;
+        }
+        if (const auto lto_error = validate_lto(configuration); lto_error.has_value())
+        {
+            return *lto_error;
+        }
+        if (const auto budgets_error = validate_budgets(configuration, path_to_root); budgets_error.has_value())
+        {
+            return *budgets_error;
+        }
         if (const auto sources_error = validate_sources_and_excludes(configuration, path_to_root);
             sources_error.has_value())
         {
@@ -358,6 +574,14 @@ auto validate_configuration_values(const std::vector<Configuration>& configurati
         return *parent_error;
     }
 
+    const auto dependency_error              = validate_dependencies(configurations);
+    const auto found_error_with_dependencies = dependency_error.has_value();
+
+    if (found_error_with_dependencies)
+    {
+        return *dependency_error;
+    }
+
     const auto argument_error             = validate_arguments(configurations, path_to_root);
     const auto found_error_with_arguments = argument_error.has_value();
 
@@ -1,17 +1,26 @@
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <format>
 #include <type_traits>
 #include <utility> // std::unreachable
 #include <vector>
 
 #include "source/argument_parsing/argument_parsing.hpp"
+#include "source/commands/analyze_includes/analyze_includes.hpp"
 #include "source/commands/build/build.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "source/commands/build/trace.hpp"
 #include "source/commands/clean/clean.hpp"
 #include "source/commands/clean_all/clean_all.hpp"
 #include "source/commands/init/init.hpp"
 #include "source/commands/list_configurations/list_configurations.hpp"
 #include "source/commands/list_files/list_files.hpp"
+#include "source/commands/pgo/pgo.hpp"
 #include "source/commands/print_version/print_version.hpp"
+#include "source/commands/report/report.hpp"
+#include "source/commands/worker/worker.hpp"
 #include "source/configuration_parsing/configuration.hpp"
 #include "source/configuration_parsing/configuration_parsing.hpp"
 #include "source/parameters/parameters.hpp"
@@ -39,24 +48,53 @@ auto main(const int num_of_arguments, const char* arguments[]) -> int
         return commands::init(init_command_info, current_path);
     }
 
+    // The "worker" command compiles for other machines, so it does not belong to a project.
+    if (std::holds_alternative<WorkerCommandInfo>(*command_info))
+    {
+        const auto& worker_command_info = std::get<WorkerCommandInfo>(*command_info);
+        return commands::worker(worker_command_info);
+    }
+
+    const auto* const build_command_info = std::get_if<BuildCommandInfo>(&*command_info);
+
+    // Enabled before the configurations file is checked, so that its errors are events as well.
+    if (build_command_info != nullptr && build_command_info->output_format == OutputFormat::JSONL)
+    {
+        events::enable();
+    }
+
     // The rest of the commands do require a configurations file.
     const auto configuration_file_exists = utils::check_if_configurations_file_exists(current_path);
 
     if (!configuration_file_exists)
     {
-        utils::print_error("The file '{}' could not be located in '{}'.",
-                           params::CONFIGURATIONS_FILE_NAME.native(),
-                           current_path.native());
+        events::report_error(std::format("The file '{}' could not be located in '{}'.",
+                                         params::CONFIGURATIONS_FILE_NAME.native(),
+                                         current_path.native()));
 
         return EXIT_FAILURE;
     }
 
-    const auto configurations              = parse_configurations(current_path);
+    // Tracing starts before the configurations file is parsed, so that parsing is part of the trace.
+    // The statistics take their phase times from the trace.
+    if (build_command_info != nullptr &&
+        (build_command_info->trace_file.has_value() || build_command_info->print_statistics))
+    {
+        trace::enable();
+    }
+
+    const auto configurations = [&]
+    {
+        const trace::Span span("Parse configurations", "parsing");
+
+        return parse_configurations(current_path);
+    }();
+
     const auto configuration_file_is_valid = configurations.has_value();
 
     if (!configuration_file_is_valid)
     {
-        utils::print_error("{}", configurations.error());
+        events::report_error(configurations.error());
 
         return EXIT_FAILURE;
     }
@@ -66,9 +104,59 @@ auto main(const int num_of_arguments, const char* arguments[]) -> int
         {
             using CommandType = std::decay_t<decltype(info)>;
 
-            if constexpr (std::is_same_v<CommandType, BuildCommandInfo>)
+            if constexpr (std::is_same_v<CommandType, AnalyzeIncludesCommandInfo>)
+            {
+                return commands::analyze_includes(info, *configurations, current_path);
+            }
+            else if constexpr (std::is_same_v<CommandType, BuildCommandInfo>)
             {
-                return commands::build(info, *configurations, current_path).exit_status;
+                if (events::is_enabled())
+                {
+                    events::emit("build_start",
+                                 {
+                                     {"configuration", info.configuration_name.value_or("")},
+                                     {"all",           info.build_all_configurations       },
+                                     {"parallel",      info.use_parallel_compilation       },
+                                 });
+                }
+
+                const auto result = commands::build(info, *configurations, current_path);
+
+                if (events::is_enabled())
+                {
+                    const auto up_to_date = statistics::get(statistics::Counter::TRANSLATION_UNITS_UP_TO_DATE);
+
+                    events::emit("build_end",
+                                 {
+                                     {"exit_code",            std::int64_t{result.exit_status}                },
+                                     {"files_compiled",       std::int64_t{result.num_of_files_compiled}      },
+                                     {"files_up_to_date",     up_to_date                                      },
+                                     {"compilation_failures", std::int64_t{result.num_of_compilation_failures}},
+                                 });
+                }
+
+                if (info.trace_file.has_value() && !trace::write(*info.trace_file))
+                {
+                    events::report_error(std::format("Error: Failed to write the trace to '{}'.", *info.trace_file));
+
+                    return EXIT_FAILURE;
+                }
+
+                // The statistics are not events, so only the file is written with `--output-format=jsonl`.
+                if (info.print_statistics && !events::is_enabled())
+                {
+                    statistics::print();
+                }
+
+                if (info.statistics_file.has_value() && !statistics::write(*info.statistics_file))
+                {
+                    events::report_error(
+                        std::format("Error: Failed to write the statistics to '{}'.", *info.statistics_file));
+
+                    return EXIT_FAILURE;
+                }
+
+                return result.exit_status;
             }
             else if constexpr (std::is_same_v<CommandType, CleanCommandInfo>)
             {
@@ -92,10 +180,24 @@ auto main(const int num_of_arguments, const char* arguments[]) -> int
             {
                 return commands::list_files(info, *configurations, current_path);
             }
+            else if constexpr (std::is_same_v<CommandType, PgoCommandInfo>)
+            {
+                return commands::pgo(info, *configurations, current_path);
+            }
             else if constexpr (std::is_same_v<CommandType, PrintVersionCommandInfo>)
             {
                 return commands::print_version(info);
             }
+            else if constexpr (std::is_same_v<CommandType, ReportCommandInfo>)
+            {
+                return commands::report(info, current_path);
+            }
+            else if constexpr (std::is_same_v<CommandType, WorkerCommandInfo>)
+            {
+                // The flow will never reach here as the "worker" command is executed
+                // before the configurations file is checked.
+                std::unreachable();
+            }
         },
         *command_info);
 
@@ -11,6 +11,27 @@ namespace params
     const std::string_view BUILD_DATA_FILE_NAME              = "build-data.json";
     const std::string_view DEPENDENCY_GRAPH_DATA_FILE_NAME   = "dependencies.json";
     const std::string_view CONFIGURATION_HASH_DATA_FILE_NAME = "configuration-hash.json";
+    const std::string_view COMPILATION_TIMES_DATA_FILE_NAME  = "compilation-times.json";
+    const std::string_view PRECOMPILED_HEADER_DATA_FILE_NAME = "precompiled-header.json";
+    const std::string_view PRECOMPILED_HEADER_FILE_NAME      = "easy-make-pch.hpp";
+    const std::string_view UNITY_BUILD_DATA_FILE_NAME        = "unity-build.json";
+    const std::string_view UNITY_BATCH_FILE_PREFIX           = "easy-make-unity-";
+    const std::string_view MODULES_DATA_FILE_NAME            = "modules.json";
+    const std::string_view MODULE_SCAN_DATA_FILE_NAME        = "module-scan.json";
+    const std::string_view MODULE_DEPENDENCIES_FILE_NAME     = "module-dependencies.json";
+    const std::string_view MODULE_MAPPER_FILE_NAME           = "module-mapper.txt";
+    const std::string_view MODULES_DIRECTORY_NAME            = "modules";
+    const std::string_view LINK_DATA_FILE_NAME               = "link.json";
+    const std::string_view PARTIAL_LINKS_DATA_FILE_NAME      = "partial-links.json";
+    const std::string_view PARTIAL_LINKS_DIRECTORY_NAME      = "partial-links";
+    const std::string_view LTO_CACHE_DIRECTORY_NAME          = "lto-cache";
+    const std::string_view COMPILE_TIME_REPORT_FILE_NAME     = "compile-time-report.json";
+    const std::string_view HISTORY_FILE_NAME                 = "history.jsonl";
+    const std::string_view OLD_HISTORY_FILE_NAME             = "history.old.jsonl";
+    const std::string_view PROFILE_DIRECTORY_NAME            = "profile";
+    const std::string_view PROFILE_FILE_NAME                 = "default.profdata";
+    const std::string_view RAW_PROFILE_DIRECTORY_NAME        = "raw-profile";
+    const std::string_view INSTRUMENTED_CONFIGURATION_SUFFIX = "-instrumented";
     const auto ENABLE_MSVC                                   = false;
 }
 
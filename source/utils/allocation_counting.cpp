@@ -0,0 +1,71 @@
+#include "source/utils/allocation_counting.hpp"
+
+#ifdef EASY_MAKE_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The only replacements of the global allocator in easy-make, so every binary that links this file counts the same way.
+static std::atomic<std::int64_t> num_of_allocations = 0;
+
+auto operator new(const std::size_t size) -> void*
+{
+    num_of_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size); pointer != nullptr)
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+auto operator new(const std::size_t size, const std::align_val_t alignment) -> void*
+{
+    num_of_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    const auto alignment_in_bytes = static_cast<std::size_t>(alignment);
+    const auto rounded_size       = (size + alignment_in_bytes - 1) / alignment_in_bytes * alignment_in_bytes;
+
+    if (auto* pointer = std::aligned_alloc(alignment_in_bytes, rounded_size); pointer != nullptr)
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+auto operator delete(void* pointer) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::align_val_t) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t, std::align_val_t) noexcept -> void
+{
+    std::free(pointer);
+}
+
+auto allocation_counting::get_num_of_allocations() -> std::optional<std::int64_t>
+{
+    return num_of_allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+auto allocation_counting::get_num_of_allocations() -> std::optional<std::int64_t>
+{
+    return std::nullopt;
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef SOURCE_UTILS_ALLOCATION_COUNTING_HPP
+#define SOURCE_UTILS_ALLOCATION_COUNTING_HPP
+
+#include <cstdint>
+#include <optional>
+
+namespace allocation_counting
+{
+    // The heap allocations of the process so far.
+    // Counting replaces the global allocator, which affects every allocation of the process, so it is opt-in:
+    // returns `std::nullopt` unless easy-make was compiled with `EASY_MAKE_COUNT_ALLOCATIONS` defined.
+    auto get_num_of_allocations() -> std::optional<std::int64_t>;
+}
+
+#endif // SOURCE_UTILS_ALLOCATION_COUNTING_HPP
@@ -33,6 +33,13 @@ namespace utils
 
         auto get_reachable_nodes(const std::vector<T>& initial) const -> std::vector<T>;
 
+        // Returns the same graph with every edge pointing the other way.
+        auto get_reversed() const -> DirectedGraph<T>;
+
+        // Groups the nodes into sorted levels so that every edge goes from a lower level to a higher one.
+        // Each node is placed in the lowest possible level. The graph must not contain a cycle.
+        auto get_topological_levels() const -> std::vector<std::vector<T>>;
+
         auto operator<=>(const DirectedGraph<T>& other) const = default;
 
         auto data() const -> const std::unordered_map<T, std::unordered_set<T>>&
@@ -226,4 +233,70 @@ auto utils::DirectedGraph<T>::get_reachable_nodes(const std::vector<T>& initial)
     return reached | std::ranges::to<std::vector>();
 }
 
+template <typename T>
+auto utils::DirectedGraph<T>::get_reversed() const -> DirectedGraph<T>
+{
+    DirectedGraph<T> result;
+
+    for (const auto& [node, neighbors] : edges)
+    {
+        result.add_node(node);
+
+        for (const auto& neighbor : neighbors)
+        {
+            result.add_edge(neighbor, node);
+        }
+    }
+
+    return result;
+}
+
+template <typename T>
+auto utils::DirectedGraph<T>::get_topological_levels() const -> std::vector<std::vector<T>>
+{
+    std::unordered_map<T, int> in_degrees;
+
+    for (const auto& [node, neighbors] : edges)
+    {
+        in_degrees.try_emplace(node, 0);
+
+        for (const auto& neighbor : neighbors)
+        {
+            ++in_degrees[neighbor];
+        }
+    }
+
+    std::vector<std::vector<T>> levels;
+    auto current_level = in_degrees                                                                //
+                         | std::views::filter([](const auto& entry) { return entry.second == 0; }) //
+                         | std::views::keys                                                        //
+                         | std::ranges::to<std::vector>();                                         //
+    auto num_of_visited_nodes = 0UZ;
+
+    while (!current_level.empty())
+    {
+        std::vector<T> next_level;
+
+        for (const auto& node : current_level)
+        {
+            for (const auto& neighbor : edges.at(node))
+            {
+                if (--in_degrees.at(neighbor) == 0)
+                {
+                    next_level.push_back(neighbor);
+                }
+            }
+        }
+
+        std::ranges::sort(current_level);
+        num_of_visited_nodes += current_level.size();
+        levels.push_back(std::move(current_level));
+        current_level = std::move(next_level);
+    }
+
+    ASSERT(num_of_visited_nodes == edges.size()); // Nodes on a cycle are never reached.
+
+    return levels;
+}
+
 #endif // SOURCE_UTILS_GRAPH_HPP
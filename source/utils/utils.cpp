@@ -20,6 +20,29 @@ auto utils::get_object_file_name(const std::filesystem::path& path) -> std::stri
     return result;
 }
 
+auto utils::get_split_debug_info_file_name(const std::filesystem::path& path) -> std::string
+{
+    return std::filesystem::path(get_object_file_name(path)).replace_extension(".dwo").native();
+}
+
+auto utils::get_split_debug_info_package_path(const std::filesystem::path& path_to_executable)
+    -> std::filesystem::path
+{
+    return std::format("{}.dwp", path_to_executable.native());
+}
+
+auto utils::remove_object_file(const std::filesystem::path& object_files_directory,
+                               const std::filesystem::path& path,
+                               std::error_code& error) -> void
+{
+    std::filesystem::remove(object_files_directory / get_object_file_name(path), error);
+
+    if (!error)
+    {
+        std::filesystem::remove(object_files_directory / get_split_debug_info_file_name(path), error);
+    }
+}
+
 auto utils::get_ordinal_indicator(const int index) -> const char*
 {
     // Special cases.
@@ -51,11 +74,18 @@ auto utils::is_header_file(const std::filesystem::path& path) -> bool
     return extension == ".h" || extension == ".hpp" || extension == ".hh" || extension == ".hxx";
 }
 
+auto utils::is_module_interface_file(const std::filesystem::path& path) -> bool
+{
+    const auto extension = path.extension();
+
+    return extension == ".cppm" || extension == ".ixx";
+}
+
 auto utils::is_source_file(const std::filesystem::path& path) -> bool
 {
     const auto extension = path.extension();
 
-    return extension == ".cpp" || extension == ".cc" || extension == ".cxx";
+    return extension == ".cpp" || extension == ".cc" || extension == ".cxx" || is_module_interface_file(path);
 }
 
 auto utils::is_code_file(const std::filesystem::path& path) -> bool
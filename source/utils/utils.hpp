@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <system_error>
 #include <vector>
 
 namespace utils
@@ -12,10 +13,23 @@ namespace utils
 
     auto get_object_file_name(const std::filesystem::path& path) -> std::string;
 
+    // The compiler writes the split debug info of an object file next to it.
+    auto get_split_debug_info_file_name(const std::filesystem::path& path) -> std::string;
+
+    // Debuggers look for the packaged split debug info of an executable next to it.
+    auto get_split_debug_info_package_path(const std::filesystem::path& path_to_executable) -> std::filesystem::path;
+
+    // Removes the object file of `path` together with its split debug info file.
+    auto remove_object_file(const std::filesystem::path& object_files_directory,
+                            const std::filesystem::path& path,
+                            std::error_code& error) -> void;
+
     auto get_ordinal_indicator(int index) -> const char*;
 
     auto is_header_file(const std::filesystem::path& path) -> bool;
 
+    auto is_module_interface_file(const std::filesystem::path& path) -> bool;
+
     auto is_source_file(const std::filesystem::path& path) -> bool;
 
     auto is_code_file(const std::filesystem::path& path) -> bool;
@@ -0,0 +1,221 @@
+#include "source/utils/work_stealing_pool.hpp"
+
+#include <algorithm> // std::max
+
+#include "source/utils/macros/assert.hpp"
+
+// Identifies the pool (if any) that owns the current thread, so that tasks submitted
+// from inside a task go to the submitting worker's own queue.
+static thread_local const utils::WorkStealingPool* current_pool = nullptr;
+static thread_local std::size_t current_queue_index             = 0;
+
+auto utils::SpinLock::lock() -> void
+{
+    while (is_locked.exchange(true, std::memory_order_acquire))
+    {
+        // Wait on a plain load to avoid bouncing the cache line between cores.
+        while (is_locked.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto utils::SpinLock::try_lock() -> bool
+{
+    return !is_locked.load(std::memory_order_relaxed) && !is_locked.exchange(true, std::memory_order_acquire);
+}
+
+auto utils::SpinLock::unlock() -> void
+{
+    is_locked.store(false, std::memory_order_release);
+}
+
+utils::WorkStealingPool::WorkStealingPool(const int num_of_threads)
+    : num_of_queues(static_cast<std::size_t>(num_of_threads)),
+      queues(std::make_unique<WorkerQueue[]>(static_cast<std::size_t>(num_of_threads)))
+{
+    ASSERT(num_of_threads > 0);
+
+    workers.reserve(num_of_queues);
+
+    for (auto index = 0UZ; index < num_of_queues; ++index)
+    {
+        workers.emplace_back([this, index](std::stop_token stop_token) { run_worker(stop_token, index); });
+    }
+}
+
+utils::WorkStealingPool::~WorkStealingPool()
+{
+    wait_for_all();
+
+    for (auto& worker : workers)
+    {
+        worker.request_stop();
+    }
+
+    // Wake up sleeping workers so they can observe the stop request.
+    num_of_queued_tasks.fetch_add(1, std::memory_order_release);
+    num_of_queued_tasks.notify_all();
+}
+
+auto utils::WorkStealingPool::get_num_of_threads() const -> int
+{
+    return static_cast<int>(num_of_queues);
+}
+
+auto utils::WorkStealingPool::push(Task task) -> void
+{
+    const auto submitted_by_worker = current_pool == this;
+    const auto queue_index         = submitted_by_worker
+                                         ? current_queue_index
+                                         : next_queue.fetch_add(1, std::memory_order_relaxed) % num_of_queues;
+    auto& queue                    = queues[queue_index];
+
+    num_of_unfinished_tasks.fetch_add(1, std::memory_order_relaxed);
+    auto task_was_queued = false;
+
+    {
+        const std::lock_guard lock(queue.lock);
+        const auto queue_is_full = (queue.bottom - queue.top) == QUEUE_CAPACITY;
+
+        if (!queue_is_full)
+        {
+            queue.tasks[queue.bottom % QUEUE_CAPACITY] = task;
+            ++queue.bottom;
+            num_of_queued_tasks.fetch_add(1, std::memory_order_release);
+            task_was_queued = true;
+        }
+    }
+
+    if (task_was_queued)
+    {
+        num_of_queued_tasks.notify_one();
+    }
+    else
+    {
+        // Run the task on the submitting thread instead of growing the queue,
+        // which keeps submission allocation-free and applies natural back pressure.
+        execute(task);
+    }
+}
+
+auto utils::WorkStealingPool::pop_own_task(const std::size_t queue_index, Task& task) -> bool
+{
+    auto& queue = queues[queue_index];
+    const std::lock_guard lock(queue.lock);
+
+    if (queue.bottom == queue.top)
+    {
+        return false;
+    }
+
+    --queue.bottom;
+    task = queue.tasks[queue.bottom % QUEUE_CAPACITY];
+    num_of_queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+auto utils::WorkStealingPool::steal_task(const std::size_t thief_index, Task& task) -> bool
+{
+    // Start from the thief's neighbour so that thieves spread over different victims.
+    for (auto offset = 1UZ; offset <= num_of_queues; ++offset)
+    {
+        auto& queue = queues[(thief_index + offset) % num_of_queues];
+
+        if (!queue.lock.try_lock())
+        {
+            continue; // The queue is busy; try another victim rather than waiting.
+        }
+
+        const std::lock_guard lock(queue.lock, std::adopt_lock);
+
+        if (queue.bottom == queue.top)
+        {
+            continue;
+        }
+
+        task = queue.tasks[queue.top % QUEUE_CAPACITY];
+        ++queue.top;
+        num_of_queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    return false;
+}
+
+auto utils::WorkStealingPool::execute(Task& task) -> void
+{
+    task();
+    num_of_unfinished_tasks.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+auto utils::WorkStealingPool::run_pending_task() -> bool
+{
+    const auto is_worker = current_pool == this;
+    Task task;
+
+    if (is_worker && pop_own_task(current_queue_index, task))
+    {
+        execute(task);
+        return true;
+    }
+
+    if (steal_task(is_worker ? current_queue_index : 0, task))
+    {
+        execute(task);
+        return true;
+    }
+
+    return false;
+}
+
+auto utils::WorkStealingPool::wait_for_all() -> void
+{
+    while (num_of_unfinished_tasks.load(std::memory_order_acquire) > 0)
+    {
+        if (!run_pending_task())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto utils::WorkStealingPool::run_worker(const std::stop_token stop_token, const std::size_t index) -> void
+{
+    current_pool        = this;
+    current_queue_index = index;
+
+    // Spin for a short while before sleeping, since tasks tend to arrive in bursts.
+    const auto NUM_OF_SPINS_BEFORE_SLEEP = 64;
+    auto num_of_failed_attempts          = 0;
+
+    while (!stop_token.stop_requested())
+    {
+        if (run_pending_task())
+        {
+            num_of_failed_attempts = 0;
+            continue;
+        }
+
+        if (++num_of_failed_attempts < NUM_OF_SPINS_BEFORE_SLEEP)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        num_of_failed_attempts = 0;
+        num_of_queued_tasks.wait(0, std::memory_order_acquire);
+    }
+
+    current_pool = nullptr;
+}
+
+auto utils::get_shared_pool() -> WorkStealingPool&
+{
+    static WorkStealingPool pool(static_cast<int>(std::max(1U, std::thread::hardware_concurrency())));
+
+    return pool;
+}
@@ -0,0 +1,235 @@
+#ifndef SOURCE_UTILS_WORK_STEALING_POOL_HPP
+#define SOURCE_UTILS_WORK_STEALING_POOL_HPP
+
+#include <algorithm> // std::min
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new> // std::launder
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils
+{
+    // A lightweight lock for the per-worker queues.
+    // Critical sections are a handful of instructions, so spinning is cheaper than a `std::mutex`.
+    class SpinLock
+    {
+      public:
+        auto lock() -> void;
+        auto try_lock() -> bool;
+        auto unlock() -> void;
+
+      private:
+        std::atomic<bool> is_locked = false;
+    };
+
+    // A type-erased callable that is stored inline, so submitting a task never allocates.
+    // Only small, trivially copyable callables are accepted (e.g. lambdas that capture by reference).
+    class Task
+    {
+      public:
+        static constexpr auto STORAGE_SIZE = 48UZ;
+
+        Task() = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, Task>)
+        explicit Task(F&& f);
+
+        auto operator()() -> void
+        {
+            invoke(storage.data());
+        }
+
+      private:
+        alignas(std::max_align_t) std::array<std::byte, STORAGE_SIZE> storage{};
+        void (*invoke)(std::byte*) = nullptr;
+    };
+
+    // A thread pool for fine-grained in-process work (hashing, include scanning, directory walking).
+    // Every worker owns a bounded deque: it pushes and pops its own tasks at the bottom (LIFO, cache friendly)
+    // while idle workers steal from the top of other deques (FIFO, oldest and usually largest work first).
+    // Unlike `ThreadPool`, detached tasks are not wrapped in `std::function` and `std::packaged_task`,
+    // so submitting them does not allocate.
+    class WorkStealingPool
+    {
+      public:
+        explicit WorkStealingPool(int num_of_threads);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&)                    = delete;
+        auto operator=(const WorkStealingPool&) -> WorkStealingPool& = delete;
+
+        // An exception thrown by the task is stored in the returned future.
+        // Allocates the future's shared state, like `ThreadPool::add_task`.
+        template <typename F>
+        auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>&>>;
+
+        // Same, but without a future, so that submission does not allocate.
+        // The task must be `noexcept`, since nothing could receive its exception.
+        template <typename F>
+        auto submit_detached(F&& f) -> void;
+
+        // Blocks until every submitted task has finished.
+        // The calling thread executes pending tasks while it waits instead of sleeping.
+        // Must not be called from inside a task, since that task would wait for itself.
+        auto wait_for_all() -> void;
+
+        // Runs a single pending task on the calling thread, if there is one.
+        // Returns `true` if a task was executed.
+        auto run_pending_task() -> bool;
+
+        auto get_num_of_threads() const -> int;
+
+      private:
+        static constexpr auto QUEUE_CAPACITY = 1024UZ;
+
+        struct alignas(64) WorkerQueue
+        {
+            SpinLock lock;
+            std::array<Task, QUEUE_CAPACITY> tasks; // Ring buffer.
+            std::size_t top    = 0;                 // Oldest task; thieves take from here.
+            std::size_t bottom = 0;                 // One past the newest task; the owner pushes and pops here.
+        };
+
+        auto push(Task task) -> void;
+        auto pop_own_task(std::size_t queue_index, Task& task) -> bool;
+        auto steal_task(std::size_t thief_index, Task& task) -> bool;
+        auto execute(Task& task) -> void;
+        auto run_worker(std::stop_token stop_token, std::size_t index) -> void;
+
+        const std::size_t num_of_queues;
+        std::unique_ptr<WorkerQueue[]> queues;
+        std::atomic<int> num_of_queued_tasks     = 0; // Used by idle workers to sleep.
+        std::atomic<int> num_of_unfinished_tasks = 0; // Used by `wait_for_all`.
+        std::atomic<std::size_t> next_queue      = 0; // Round-robin target for tasks submitted by non-workers.
+        std::vector<std::jthread> workers;            // Declared last so the workers stop before the queues die.
+    };
+
+    // A pool with a thread per core for the analysis of the project (hashing and include scanning).
+    // It is shared by every configuration, so that configurations that are built concurrently do not oversubscribe.
+    auto get_shared_pool() -> WorkStealingPool&;
+
+    // Calls `body(index)` for every `index` in [`begin`, `end`), splitting the range into chunks that run on `pool`.
+    // The calling thread participates in the work and the function returns only after all the chunks are done.
+    // If `body` throws, the first exception is rethrown on the calling thread after the remaining chunks finish.
+    template <typename F>
+    auto parallel_for(WorkStealingPool& pool, std::size_t begin, std::size_t end, F&& body) -> void;
+}
+
+template <typename F>
+    requires(!std::is_same_v<std::decay_t<F>, utils::Task>)
+utils::Task::Task(F&& f)
+{
+    using Function = std::decay_t<F>;
+
+    static_assert(sizeof(Function) <= STORAGE_SIZE, "Task is too large to be stored inline; capture by reference.");
+    static_assert(alignof(Function) <= alignof(std::max_align_t), "Task is over-aligned.");
+    static_assert(std::is_trivially_copyable_v<Function>, "Task must be trivially copyable; capture by reference.");
+
+    std::construct_at(reinterpret_cast<Function*>(storage.data()), std::forward<F>(f));
+    invoke = [](std::byte* data) { (*std::launder(reinterpret_cast<Function*>(data)))(); };
+}
+
+template <typename F>
+auto utils::WorkStealingPool::submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>&>>
+{
+    using Result = std::invoke_result_t<std::decay_t<F>&>;
+
+    // Only the pointer is stored in the task, so any callable can be submitted.
+    auto* const packaged_task = new std::packaged_task<Result()>(std::forward<F>(f));
+    auto future               = packaged_task->get_future();
+
+    submit_detached(
+        [packaged_task]() noexcept
+        {
+            (*packaged_task)();
+            delete packaged_task;
+        });
+
+    return future;
+}
+
+template <typename F>
+auto utils::WorkStealingPool::submit_detached(F&& f) -> void
+{
+    static_assert(std::is_nothrow_invocable_v<std::decay_t<F>&>, "Detached tasks must not throw; use `submit`.");
+
+    push(Task(std::forward<F>(f)));
+}
+
+template <typename F>
+auto utils::parallel_for(WorkStealingPool& pool, const std::size_t begin, const std::size_t end, F&& body) -> void
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    // A few chunks per thread balance the load without paying for a task per index.
+    const auto CHUNKS_PER_THREAD = 4UZ;
+    const auto size              = end - begin;
+    const auto num_of_threads    = static_cast<std::size_t>(pool.get_num_of_threads()) + 1; // Including the caller.
+    const auto num_of_chunks     = std::min(size, num_of_threads * CHUNKS_PER_THREAD);
+    const auto chunk_size        = size / num_of_chunks;
+    const auto remainder         = size % num_of_chunks;
+
+    struct SharedState
+    {
+        std::atomic<std::size_t> num_of_remaining_chunks;
+        std::once_flag exception_flag;
+        std::exception_ptr exception;
+    };
+
+    SharedState state;
+    state.num_of_remaining_chunks.store(num_of_chunks, std::memory_order_relaxed);
+
+    auto chunk_begin = begin;
+
+    for (auto chunk = 0UZ; chunk < num_of_chunks; ++chunk)
+    {
+        // The first `remainder` chunks take one extra index.
+        const auto chunk_end = chunk_begin + chunk_size + (chunk < remainder ? 1 : 0);
+
+        pool.submit_detached(
+            [&body, &state, chunk_begin, chunk_end]() noexcept
+            {
+                try
+                {
+                    for (auto index = chunk_begin; index < chunk_end; ++index)
+                    {
+                        body(index);
+                    }
+                }
+                catch (...)
+                {
+                    std::call_once(state.exception_flag, [&] { state.exception = std::current_exception(); });
+                }
+
+                state.num_of_remaining_chunks.fetch_sub(1, std::memory_order_acq_rel);
+            });
+
+        chunk_begin = chunk_end;
+    }
+
+    while (state.num_of_remaining_chunks.load(std::memory_order_acquire) > 0)
+    {
+        if (!pool.run_pending_task())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (state.exception != nullptr)
+    {
+        std::rethrow_exception(state.exception);
+    }
+}
+
+#endif // SOURCE_UTILS_WORK_STEALING_POOL_HPP
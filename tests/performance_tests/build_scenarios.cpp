@@ -0,0 +1,291 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <format>
+#include <map>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/argument_parsing/command_info.hpp"
+#include "source/commands/build/build.hpp"
+#include "source/commands/build/trace.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "tests/performance_tests/utils/resources_directory.hpp"
+#include "tests/performance_tests/utils/synthetic_project.hpp"
+
+// Sizes are chosen with `EASY_MAKE_BENCHMARK_SIZES`, e.g. "1000,10000,100000". Only the smallest size runs by
+// default, since a full build of the larger projects takes minutes.
+// The results are written to `EASY_MAKE_BENCHMARK_RESULTS` if it is set, and compared to the results in
+// `EASY_MAKE_BENCHMARK_BASELINE` if it is set.
+
+namespace
+{
+    // Only the read and write system calls (`syscr` and `syscw` in `/proc/<pid>/io`), not every system call.
+    struct ReadWriteSyscallCounts
+    {
+        std::int64_t reads;
+        std::int64_t writes;
+    };
+
+    struct Measurement
+    {
+        std::string scenario;
+        std::int64_t num_of_files;
+        std::int64_t wall_time_in_milliseconds;
+        std::int64_t num_of_files_compiled;
+        ReadWriteSyscallCounts read_write_syscalls;
+        std::map<std::string, std::chrono::microseconds> phases;
+    };
+
+    // Records the phases of every build.
+    class SyntheticProjectBuilder : public ResourcesDirectory
+    {
+      public:
+        SyntheticProjectBuilder();
+        ~SyntheticProjectBuilder();
+    };
+}
+
+SyntheticProjectBuilder::SyntheticProjectBuilder()
+{
+    trace::enable();
+}
+
+// Tests that run later in the same process are not traced.
+SyntheticProjectBuilder::~SyntheticProjectBuilder()
+{
+    trace::disable();
+    trace::clear();
+}
+
+static auto get_sizes() -> std::vector<int>
+{
+    const auto* sizes = std::getenv("EASY_MAKE_BENCHMARK_SIZES");
+
+    if (sizes == nullptr)
+    {
+        return {1'000};
+    }
+
+    std::vector<int> result;
+
+    for (const auto size : std::string_view(sizes) | std::views::split(','))
+    {
+        result.push_back(std::stoi(std::string(size.begin(), size.end())));
+    }
+
+    return result;
+}
+
+// Counts the read and write system calls of the process so far (Linux only).
+static auto get_read_write_syscall_counts() -> ReadWriteSyscallCounts
+{
+    auto file = std::ifstream("/proc/self/io");
+    ReadWriteSyscallCounts counts{.reads = 0, .writes = 0};
+    std::string key;
+    std::int64_t value = 0;
+
+    while (file >> key >> value)
+    {
+        if (key == "syscr:")
+        {
+            counts.reads = value;
+        }
+        else if (key == "syscw:")
+        {
+            counts.writes = value;
+        }
+    }
+
+    return counts;
+}
+
+static auto append_line(const std::filesystem::path& path) -> void
+{
+    auto file = std::ofstream(path, std::ios::app);
+    std::println(file, "// Edited by the benchmark.");
+}
+
+static auto measure(const std::string_view scenario,
+                    const std::filesystem::path& path_to_root,
+                    const Configuration& configuration,
+                    const int num_of_files) -> Measurement
+{
+    const auto info = BuildCommandInfo{
+        .configuration_name       = configuration.name,
+        .build_all_configurations = false,
+        .is_quiet                 = true,
+        .use_parallel_compilation = true,
+    };
+
+    trace::clear();
+    const auto syscalls_before = get_read_write_syscall_counts();
+    const auto start_time      = std::chrono::steady_clock::now();
+    const auto result          = commands::build(info, {configuration}, path_to_root);
+    const auto end_time        = std::chrono::steady_clock::now();
+    const auto syscalls_after  = get_read_write_syscall_counts();
+    const auto wall_time       = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    REQUIRE_EQ(result.exit_status, EXIT_SUCCESS);
+
+    return {
+        .scenario                  = std::string(scenario),
+        .num_of_files              = num_of_files,
+        .wall_time_in_milliseconds = wall_time.count(),
+        .num_of_files_compiled     = result.num_of_files_compiled,
+        .read_write_syscalls       = {.reads  = syscalls_after.reads - syscalls_before.reads,
+                                      .writes = syscalls_after.writes - syscalls_before.writes},
+        .phases                    = trace::get_total_durations(),
+    };
+}
+
+static auto run_scenarios(const int num_of_files) -> std::vector<Measurement>
+{
+    const auto path_to_root = std::filesystem::current_path() / std::format("project_{}", num_of_files);
+    std::filesystem::remove_all(path_to_root);
+
+    const auto project = tests::utils::create_synthetic_project(path_to_root,
+                                                                {.num_of_files         = num_of_files,
+                                                                 .include_depth        = 4,
+                                                                 .fan_out              = 4,
+                                                                 .header_size_in_lines = 50});
+
+    Configuration configuration;
+    configuration.name                = "benchmark";
+    configuration.compiler            = "g++";
+    configuration.output_name         = "output.exe";
+    configuration.optimization        = "0";
+    configuration.source_directories  = {"."};
+    configuration.include_directories = {"."};
+
+    // Like `easy-make`, the builds run in the root of the project.
+    const auto resources_path = std::filesystem::current_path();
+    std::filesystem::current_path(path_to_root);
+
+    std::vector<Measurement> measurements;
+
+    measurements.push_back(measure("full build", path_to_root, configuration, num_of_files));
+    measurements.push_back(measure("no-op build", path_to_root, configuration, num_of_files));
+
+    append_line(path_to_root / project.source_files.front());
+    measurements.push_back(measure("single leaf edit", path_to_root, configuration, num_of_files));
+
+    append_line(path_to_root / project.widely_included_header);
+    measurements.push_back(measure("widely included header edit", path_to_root, configuration, num_of_files));
+
+    std::filesystem::remove(path_to_root / project.source_files.front());
+    measurements.push_back(measure("file deletion", path_to_root, configuration, num_of_files));
+
+    std::filesystem::current_path(resources_path);
+    std::filesystem::remove_all(path_to_root);
+
+    return measurements;
+}
+
+static auto to_json(const Measurement& measurement) -> nlohmann::json
+{
+    auto phases = nlohmann::json::object();
+
+    for (const auto& [phase, duration] : measurement.phases)
+    {
+        phases[phase] = duration.count();
+    }
+
+    return {
+        {"scenario",       measurement.scenario                  },
+        {"files",          measurement.num_of_files              },
+        {"wall_time_ms",   measurement.wall_time_in_milliseconds },
+        {"files_compiled", measurement.num_of_files_compiled     },
+        {"read_syscalls",  measurement.read_write_syscalls.reads },
+        {"write_syscalls", measurement.read_write_syscalls.writes},
+        {"phase_times_us", phases                                },
+    };
+}
+
+static auto read_baseline() -> std::map<std::pair<std::string, std::int64_t>, std::int64_t>
+{
+    const auto* path = std::getenv("EASY_MAKE_BENCHMARK_BASELINE");
+
+    if (path == nullptr)
+    {
+        return {};
+    }
+
+    auto file = std::ifstream(path);
+
+    if (!file.is_open())
+    {
+        std::println("Could not open the baseline '{}'.", path);
+
+        return {};
+    }
+
+    std::map<std::pair<std::string, std::int64_t>, std::int64_t> wall_times;
+
+    for (const auto& entry : nlohmann::json::parse(file))
+    {
+        const auto key  = std::pair(entry["scenario"].get<std::string>(), entry["files"].get<std::int64_t>());
+        wall_times[key] = entry["wall_time_ms"].get<std::int64_t>();
+    }
+
+    return wall_times;
+}
+
+static auto print_measurement(const Measurement& measurement,
+                              const std::map<std::pair<std::string, std::int64_t>, std::int64_t>& baseline) -> void
+{
+    std::print("{:>7} files, {:<28} {:>8} ms, {:>6} compiled, {:>8} read syscalls, {:>8} write syscalls",
+               measurement.num_of_files,
+               measurement.scenario,
+               measurement.wall_time_in_milliseconds,
+               measurement.num_of_files_compiled,
+               measurement.read_write_syscalls.reads,
+               measurement.read_write_syscalls.writes);
+
+    const auto key = std::pair(measurement.scenario, measurement.num_of_files);
+
+    if (baseline.contains(key) && baseline.at(key) > 0)
+    {
+        const auto change = 100.0 * (measurement.wall_time_in_milliseconds - baseline.at(key)) / baseline.at(key);
+        std::print(" ({:+.1f}% vs baseline)", change);
+    }
+
+    std::println();
+
+    for (const auto& [phase, duration] : measurement.phases)
+    {
+        std::println("    {:<26} {:>10.1f} ms", phase, duration.count() / 1000.0);
+    }
+}
+
+TEST_CASE_FIXTURE(SyntheticProjectBuilder, "Build scenarios of synthetic projects [performance]")
+{
+    const auto baseline = read_baseline();
+    auto results        = nlohmann::json::array();
+
+    for (const auto num_of_files : get_sizes())
+    {
+        for (const auto& measurement : run_scenarios(num_of_files))
+        {
+            print_measurement(measurement, baseline);
+            results.push_back(to_json(measurement));
+        }
+    }
+
+    if (const auto* path = std::getenv("EASY_MAKE_BENCHMARK_RESULTS"); path != nullptr)
+    {
+        // Relative to the directory the tests were started from.
+        auto file = std::ofstream(old_path / path);
+        file << results.dump(4);
+    }
+}
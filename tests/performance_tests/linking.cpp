@@ -0,0 +1,132 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/linking.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "tests/performance_tests/utils/resources_directory.hpp"
+
+using namespace std::literals;
+
+namespace
+{
+    class ObjectFilesBuilder : public ResourcesDirectory
+    {
+      public:
+        ObjectFilesBuilder();
+
+      private:
+        auto create_file_content(int index) -> std::string;
+    };
+}
+
+static const auto NUM_OF_FILES     = 400;
+static const auto NUM_OF_FUNCTIONS = 200; // Per file, so the linker has many symbols and relocations to resolve.
+
+// Build the project and compile it once, since only linking is measured.
+ObjectFilesBuilder::ObjectFilesBuilder()
+{
+    std::vector<std::filesystem::path> files;
+
+    for (auto index = 1; index <= NUM_OF_FILES; ++index)
+    {
+        const auto filename = std::format("file_{:03}.cpp", index);
+        auto file           = std::ofstream(new_path / filename);
+        file << create_file_content(index);
+        files.push_back(filename);
+    }
+
+    // Closed before compiling, so that the compiler reads the whole file.
+    std::ofstream(new_path / "main.cpp")
+        << std::format("int function_{:03}_0();\nint main() {{ return function_{:03}_0(); }}\n", 1, 1);
+    files.push_back("main.cpp");
+
+    Configuration configuration;
+    configuration.name     = "config";
+    configuration.compiler = "g++";
+
+    std::filesystem::create_directories(params::BUILD_DIRECTORY_NAME / "config");
+    compile_files(configuration, std::filesystem::current_path(), files, true, true, std::nullopt);
+}
+
+// Every function calls a function of the previous file, so no object file can be linked on its own.
+auto ObjectFilesBuilder::create_file_content(const int index) -> std::string
+{
+    std::string content;
+
+    for (auto function = 0; function < NUM_OF_FUNCTIONS; ++function)
+    {
+        if (index > 1)
+        {
+            content += std::format("int function_{:03}_{}();\n", index - 1, function);
+        }
+
+        const auto call = (index > 1) ? std::format("function_{:03}_{}()", index - 1, function) : "0"s;
+        content += std::format("int function_{:03}_{}() {{ return {} + {}; }}\n", index, function, call, function);
+    }
+
+    return content;
+}
+
+static auto get_average_linking_duration(const std::string& linker) -> std::int64_t
+{
+    Configuration configuration;
+    configuration.name        = "config";
+    configuration.compiler    = "g++";
+    configuration.output_name = "output.exe";
+    configuration.linker      = linker;
+
+    const auto num_of_warm_up_runs  = 1;
+    const auto num_of_measured_runs = 3;
+    auto total                      = 0LL;
+
+    for (auto i = 1; i <= (num_of_warm_up_runs + num_of_measured_runs); ++i)
+    {
+        // Otherwise the executable is up to date and linking is skipped.
+        std::filesystem::remove("output.exe");
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const auto linking_successful = link_object_files(configuration, std::filesystem::current_path(), {}, {}, true);
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        const auto runtime  = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+        REQUIRE(linking_successful);
+
+        const auto should_measure_run = i > num_of_warm_up_runs;
+
+        if (should_measure_run)
+        {
+            total += runtime;
+        }
+    }
+
+    return total / num_of_measured_runs;
+}
+
+TEST_CASE_FIXTURE(ObjectFilesBuilder, "Make sure the detected linker is not slower than the default one [performance]")
+{
+    const auto fastest_linker = detect_fastest_linker();
+
+    if (fastest_linker == "default")
+    {
+        std::println("No faster linker is installed.");
+        return;
+    }
+
+    const auto average_default_linking_duration = get_average_linking_duration("default");
+    const auto average_fastest_linking_duration = get_average_linking_duration(fastest_linker);
+
+    std::println("default linking duration == {}", average_default_linking_duration);
+    std::println("{} linking duration == {}", fastest_linker, average_fastest_linking_duration);
+
+    CHECK_GE(average_default_linking_duration, average_fastest_linking_duration);
+}
@@ -12,20 +12,17 @@
 #include "source/commands/build/compilation/compilation.hpp"
 #include "source/configuration_parsing/configuration.hpp"
 #include "source/parameters/parameters.hpp"
+#include "tests/performance_tests/utils/resources_directory.hpp"
 
 namespace
 {
-    class ProjectBuilder
+    class ProjectBuilder : public ResourcesDirectory
     {
       public:
         ProjectBuilder();
-        ~ProjectBuilder();
 
       private:
         auto create_file_content(int index) -> std::string;
-
-        const std::filesystem::path old_path;
-        const std::filesystem::path new_path;
     };
 }
 
@@ -33,11 +30,7 @@ static const auto NUM_OF_FILES = 35;
 
 // Build the project.
 ProjectBuilder::ProjectBuilder()
-    : old_path(std::filesystem::current_path()), new_path(old_path / "tests" / "performance_tests" / "resources")
 {
-    std::filesystem::create_directories(new_path);
-    std::filesystem::current_path(new_path);
-
     for (auto index = 1; index <= NUM_OF_FILES; ++index)
     {
         const auto filename = std::format("file_{:02}.cpp", index);
@@ -46,13 +39,6 @@ ProjectBuilder::ProjectBuilder()
     }
 }
 
-// Remove the project
-ProjectBuilder::~ProjectBuilder()
-{
-    std::filesystem::current_path(old_path);
-    std::filesystem::remove_all(new_path);
-}
-
 auto ProjectBuilder::create_file_content(const int index) -> std::string
 {
     constexpr auto content = R"(   
@@ -112,7 +98,8 @@ static auto get_average_compilation_duration(const bool use_parallel_compilation
         std::filesystem::create_directories(params::BUILD_DIRECTORY_NAME / "config");
 
         const auto start_time = std::chrono::high_resolution_clock::now();
-        compile_files(configuration, std::filesystem::current_path(), files, true, use_parallel_compilation);
+        compile_files(
+            configuration, std::filesystem::current_path(), files, true, use_parallel_compilation, std::nullopt);
         const auto end_time = std::chrono::high_resolution_clock::now();
         const auto runtime  = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
 
@@ -0,0 +1,14 @@
+#include "tests/performance_tests/utils/resources_directory.hpp"
+
+ResourcesDirectory::ResourcesDirectory()
+    : old_path(std::filesystem::current_path()), new_path(old_path / "tests" / "performance_tests" / "resources")
+{
+    std::filesystem::create_directories(new_path);
+    std::filesystem::current_path(new_path);
+}
+
+ResourcesDirectory::~ResourcesDirectory()
+{
+    std::filesystem::current_path(old_path);
+    std::filesystem::remove_all(new_path);
+}
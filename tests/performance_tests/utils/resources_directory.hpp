@@ -0,0 +1,25 @@
+#ifndef TESTS_PERFORMANCE_TESTS_UTILS_RESOURCES_DIRECTORY_HPP
+#define TESTS_PERFORMANCE_TESTS_UTILS_RESOURCES_DIRECTORY_HPP
+
+#include <filesystem>
+
+// Creates `tests/performance_tests/resources` and makes it the working directory for the lifetime of the object.
+// Performance test fixtures derive from it and generate their project inside it.
+class ResourcesDirectory
+{
+  public:
+    // Called before the test.
+    ResourcesDirectory();
+
+    // Called after the test. Restores the working directory and removes the generated project.
+    ~ResourcesDirectory();
+
+    ResourcesDirectory(const ResourcesDirectory&)                    = delete;
+    auto operator=(const ResourcesDirectory&) -> ResourcesDirectory& = delete;
+
+  protected:
+    const std::filesystem::path old_path; // The working directory the tests were started from.
+    const std::filesystem::path new_path;
+};
+
+#endif // TESTS_PERFORMANCE_TESTS_UTILS_RESOURCES_DIRECTORY_HPP
@@ -0,0 +1,124 @@
+#include "tests/performance_tests/utils/synthetic_project.hpp"
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <fstream>
+#include <print>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+static const auto NUM_OF_FILES_PER_DIRECTORY = 100;
+
+static auto get_header_path(const int level, const int index) -> std::filesystem::path
+{
+    return std::format("include/level_{}/group_{:03}/header_{:06}.hpp",
+                       level,
+                       index / NUM_OF_FILES_PER_DIRECTORY,
+                       index);
+}
+
+static auto get_source_path(const int index) -> std::filesystem::path
+{
+    return std::format("source/group_{:04}/file_{:06}.cpp", index / NUM_OF_FILES_PER_DIRECTORY, index);
+}
+
+static auto open_file(const std::filesystem::path& path) -> std::ofstream
+{
+    std::filesystem::create_directories(path.parent_path());
+    auto file = std::ofstream(path, std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        throw std::runtime_error(std::format("Failed to open '{}'.", path.native()));
+    }
+
+    return file;
+}
+
+// Spreads the includes of the `index`-th file over the level below, so that every file of that level is used.
+static auto get_included_indices(const int index, const int fan_out, const int level_size) -> std::set<int>
+{
+    std::set<int> indices;
+
+    for (auto i = 0; i < fan_out; ++i)
+    {
+        indices.insert((index * fan_out + i) % level_size);
+    }
+
+    return indices;
+}
+
+static auto write_header(const std::filesystem::path& path_to_root,
+                         const int level,
+                         const int index,
+                         const std::set<int>& included_indices,
+                         const int header_size_in_lines) -> void
+{
+    auto file = open_file(path_to_root / get_header_path(level, index));
+    std::println(file, "#pragma once");
+
+    for (const auto included_index : included_indices)
+    {
+        std::println(file, "#include \"{}\"", get_header_path(level - 1, included_index).native());
+    }
+
+    for (auto line = 0; line < header_size_in_lines; ++line)
+    {
+        std::println(file, "inline constexpr int value_{}_{}_{} = {};", level, index, line, line);
+    }
+}
+
+auto tests::utils::create_synthetic_project(const std::filesystem::path& path_to_root,
+                                            const SyntheticProjectShape& shape) -> SyntheticProject
+{
+    // About a quarter of the files are headers, with a single header at the bottom level.
+    const auto num_of_upper_levels = shape.include_depth - 1;
+    std::vector<int> level_sizes   = {1};
+
+    for (auto level = 1; level <= num_of_upper_levels; ++level)
+    {
+        level_sizes.push_back(std::max(1, shape.num_of_files / 4 / num_of_upper_levels));
+    }
+
+    const auto num_of_headers = std::ranges::fold_left(level_sizes, 0, std::plus{});
+    const auto num_of_sources = shape.num_of_files - num_of_headers - 1; // `main.cpp` is the last file.
+
+    SyntheticProject project;
+
+    for (auto level = 0; level < shape.include_depth; ++level)
+    {
+        for (auto index = 0; index < level_sizes[level]; ++index)
+        {
+            const auto included_indices =
+                (level == 0) ? std::set<int>{} : get_included_indices(index, shape.fan_out, level_sizes[level - 1]);
+
+            write_header(path_to_root, level, index, included_indices, shape.header_size_in_lines);
+            project.header_files.push_back(get_header_path(level, index));
+        }
+    }
+
+    const auto top_level = shape.include_depth - 1;
+
+    for (auto index = 0; index < num_of_sources; ++index)
+    {
+        auto file = open_file(path_to_root / get_source_path(index));
+
+        for (const auto included_index : get_included_indices(index, shape.fan_out, level_sizes[top_level]))
+        {
+            std::println(file, "#include \"{}\"", get_header_path(top_level, included_index).native());
+        }
+
+        std::println(file, "int function_{}() {{ return value_0_0_0 + {}; }}", index, index);
+        project.source_files.push_back(get_source_path(index));
+    }
+
+    auto main_file = open_file(path_to_root / "main.cpp");
+    std::println(main_file, "int main() {{ return 0; }}");
+    project.source_files.push_back("main.cpp");
+
+    project.widely_included_header = get_header_path(0, 0);
+
+    return project;
+}
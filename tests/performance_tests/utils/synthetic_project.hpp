@@ -0,0 +1,31 @@
+#ifndef TESTS_PERFORMANCE_TESTS_UTILS_SYNTHETIC_PROJECT_HPP
+#define TESTS_PERFORMANCE_TESTS_UTILS_SYNTHETIC_PROJECT_HPP
+
+#include <filesystem>
+#include <vector>
+
+namespace tests::utils
+{
+    struct SyntheticProjectShape
+    {
+        int num_of_files;         // Sources and headers together.
+        int include_depth;        // Levels of headers between the sources and the most widely included header.
+        int fan_out;              // Number of files each source or header includes.
+        int header_size_in_lines; // Declarations in every header, which the include scanner has to read through.
+    };
+
+    struct SyntheticProject
+    {
+        std::vector<std::filesystem::path> source_files; // Relative to the root of the project.
+        std::vector<std::filesystem::path> header_files; // Relative to the root of the project.
+        std::filesystem::path widely_included_header;    // Transitively included by every source file.
+    };
+
+    // Generates a layered project: every source file includes headers of the top level, every header includes
+    // headers of the level below it, and the bottom level is a single header that everything depends on.
+    // Files are spread over directories of 100 files, like in a real source tree.
+    auto create_synthetic_project(const std::filesystem::path& path_to_root, const SyntheticProjectShape& shape)
+        -> SyntheticProject;
+}
+
+#endif // TESTS_PERFORMANCE_TESTS_UTILS_SYNTHETIC_PROJECT_HPP
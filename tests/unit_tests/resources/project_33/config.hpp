@@ -0,0 +1,6 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+#define VALUE 2
+
+#endif // CONFIG_HPP
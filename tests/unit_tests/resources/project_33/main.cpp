@@ -0,0 +1,8 @@
+import math;
+import <iostream>;
+import "config.hpp";
+
+auto main() -> int
+{
+    std::cout << square(add(1, VALUE)) << '\n';
+}
@@ -0,0 +1,6 @@
+export module math:arithmetic;
+
+export auto add(int x, int y) -> int
+{
+    return x + y;
+}
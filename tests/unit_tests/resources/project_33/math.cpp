@@ -0,0 +1,6 @@
+module math;
+
+auto square(std::int64_t x) -> std::int64_t
+{
+    return x * x;
+}
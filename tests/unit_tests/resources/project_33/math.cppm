@@ -0,0 +1,9 @@
+module;
+
+#include <cstdint>
+
+export module math;
+
+export import :arithmetic;
+
+export auto square(std::int64_t x) -> std::int64_t;
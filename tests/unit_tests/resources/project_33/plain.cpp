@@ -0,0 +1,6 @@
+#include "config.hpp"
+
+auto get_value() -> int
+{
+    return VALUE;
+}
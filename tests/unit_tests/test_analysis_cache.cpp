@@ -0,0 +1,50 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/build_caching/analysis_cache.hpp"
+#include "tests/parameters.hpp"
+
+static auto write_file(const std::filesystem::path& path, const std::string& contents) -> void
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+
+TEST_SUITE("analysis_cache" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("Results are reused only while a scope exists")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-analysis-cache-test";
+        const auto file      = directory / "f.cpp";
+        std::filesystem::create_directories(directory);
+        std::string buffer;
+
+        write_file(file, "#include \"a.hpp\"\n");
+        const auto hash_without_scope = analysis_cache::hash_file_contents(file, buffer);
+        write_file(file, "#include \"b.hpp\"\n");
+        CHECK_NE(analysis_cache::hash_file_contents(file, buffer), hash_without_scope);
+
+        {
+            const analysis_cache::Scope scope;
+            const auto hash       = analysis_cache::hash_file_contents(file, buffer);
+            const auto includes   = analysis_cache::get_included_files(file);
+            const auto code_files = analysis_cache::get_code_files_in_directory(directory, ".");
+
+            write_file(file, "#include \"c.hpp\"\n");
+            write_file(directory / "g.cpp", "");
+
+            CHECK_EQ(analysis_cache::hash_file_contents(file, buffer), hash);
+            CHECK_EQ(analysis_cache::get_included_files(file), includes);
+            CHECK_EQ(analysis_cache::get_code_files_in_directory(directory, "."), code_files);
+        }
+
+        CHECK_EQ(analysis_cache::get_included_files(file), std::vector<std::filesystem::path>{"c.hpp"});
+        CHECK_EQ(analysis_cache::get_code_files_in_directory(directory, ".").size(), 2);
+
+        std::filesystem::remove_all(directory);
+    }
+}
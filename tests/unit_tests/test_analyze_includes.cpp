@@ -0,0 +1,100 @@
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/analyze_includes/analyze_includes.hpp"
+#include "tests/parameters.hpp"
+
+using Paths = std::vector<std::filesystem::path>;
+
+// `a.cpp` and `b.cpp` include `common.hpp` through `a.hpp` and `b.hpp`.
+// `c.cpp` includes `common.hpp` directly.
+// `unused.hpp` is not included by any source file.
+static auto create_dependency_graph() -> build_caching::DependencyGraph
+{
+    build_caching::DependencyGraph graph;
+
+    for (const auto* file : {"a.cpp", "b.cpp", "c.cpp", "a.hpp", "b.hpp", "common.hpp", "unused.hpp"})
+    {
+        graph.add_node(file);
+    }
+
+    graph.add_edge("a.hpp", "a.cpp");
+    graph.add_edge("b.hpp", "b.cpp");
+    graph.add_edge("common.hpp", "a.hpp");
+    graph.add_edge("common.hpp", "b.hpp");
+    graph.add_edge("common.hpp", "c.cpp");
+
+    return graph;
+}
+
+TEST_SUITE("include_analysis" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_header_costs")
+    {
+        const auto graph = create_dependency_graph();
+
+        SUBCASE("Weighted by compilation times")
+        {
+            const std::unordered_map<std::filesystem::path, double> compilation_times = {
+                {"a.cpp", 1.0},
+                {"b.cpp", 5.0},
+                {"c.cpp", 2.0},
+            };
+
+            const auto costs = include_analysis::get_header_costs(graph, compilation_times);
+
+            REQUIRE_EQ(costs.size(), 3);
+
+            CHECK_EQ(costs[0].header, "common.hpp");
+            CHECK_EQ(costs[0].num_of_translation_units, 3);
+            CHECK_EQ(costs[0].rebuild_time_in_seconds, doctest::Approx(8.0));
+
+            CHECK_EQ(costs[1].header, "b.hpp");
+            CHECK_EQ(costs[1].num_of_translation_units, 1);
+            CHECK_EQ(costs[1].rebuild_time_in_seconds, doctest::Approx(5.0));
+
+            CHECK_EQ(costs[2].header, "a.hpp");
+            CHECK_EQ(costs[2].rebuild_time_in_seconds, doctest::Approx(1.0));
+        }
+
+        SUBCASE("Without compilation times")
+        {
+            const auto costs = include_analysis::get_header_costs(graph, {});
+
+            REQUIRE_EQ(costs.size(), 3);
+
+            // Ties are broken by path.
+            CHECK_EQ(costs[0].header, "common.hpp");
+            CHECK_EQ(costs[1].header, "a.hpp");
+            CHECK_EQ(costs[2].header, "b.hpp");
+        }
+    }
+
+    TEST_CASE("get_include_chain")
+    {
+        const auto graph = create_dependency_graph();
+
+        SUBCASE("Shortest chain is chosen")
+        {
+            CHECK_EQ(include_analysis::get_include_chain(graph, "common.hpp"), Paths{"c.cpp", "common.hpp"});
+        }
+
+        SUBCASE("Indirect include")
+        {
+            build_caching::DependencyGraph graph_without_direct_include;
+            graph_without_direct_include.add_edge("a.hpp", "a.cpp");
+            graph_without_direct_include.add_edge("common.hpp", "a.hpp");
+
+            CHECK_EQ(include_analysis::get_include_chain(graph_without_direct_include, "common.hpp"),
+                     Paths{"a.cpp", "a.hpp", "common.hpp"});
+        }
+
+        SUBCASE("Header that is not included by a source file")
+        {
+            CHECK_EQ(include_analysis::get_include_chain(graph, "unused.hpp"), Paths{"unused.hpp"});
+        }
+    }
+}
@@ -128,6 +128,181 @@ TEST_SUITE("argument_parsing" * doctest::test_suite(test_type::unit))
             CHECK_FALSE(build_command_info.use_parallel_compilation);
         }
 
+        SUBCASE("Valid case with '--trace' flag")
+        {
+            const std::vector arguments = {"./easy-make", "build", "--trace", "trace.json", "config-name"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK_EQ(build_command_info.configuration_name, "config-name");
+            CHECK_EQ(build_command_info.trace_file, "trace.json");
+        }
+
+        SUBCASE("Valid case with '--analyze-compile-time' flag")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--analyze-compile-time"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK_EQ(build_command_info.configuration_name, "config-name");
+            CHECK(build_command_info.analyze_compile_time);
+        }
+
+        SUBCASE("Valid case with '--stats-json' flag")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--stats-json", "stats.json"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK_EQ(build_command_info.configuration_name, "config-name");
+            CHECK(build_command_info.print_statistics);
+            CHECK_EQ(build_command_info.statistics_file, "stats.json");
+        }
+
+        SUBCASE("Valid case with '--explain' flag")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--explain"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK(build_command_info.explain);
+            CHECK_FALSE(build_command_info.is_dry_run);
+        }
+
+        SUBCASE("'--dry-run' flag implies '--explain'")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--dry-run"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK(build_command_info.explain);
+            CHECK(build_command_info.is_dry_run);
+        }
+
+        SUBCASE("'--dry-run' flag together with '--analyze-compile-time' flag")
+        {
+            const std::vector arguments = {
+                "./easy-make", "build", "config-name", "--dry-run", "--analyze-compile-time"};
+            const auto command_info = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: The 'build' command does not allow using '--analyze-compile-time' together with "
+                     "'--dry-run'.");
+        }
+
+        SUBCASE("Missing statistics file")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--stats-json"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Flag '--stats-json' of command 'build' must be followed by a file name.");
+        }
+
+        SUBCASE("Missing trace file")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--trace"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(), "Error: Flag '--trace' of command 'build' must be followed by a file name.");
+        }
+
+        SUBCASE("'--output-format=jsonl' flag implies '--quiet'")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--output-format=jsonl"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK_EQ(build_command_info.output_format, OutputFormat::JSONL);
+            CHECK(build_command_info.is_quiet);
+        }
+
+        SUBCASE("Unknown output format")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--output-format=xml"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Unknown output format 'xml' for command 'build'. Expected 'text' or 'jsonl'.");
+        }
+
+        SUBCASE("Missing output format")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--output-format"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Flag '--output-format' of command 'build' must be followed by '=text' or '=jsonl'.");
+        }
+
+        SUBCASE("Output format provided more than once")
+        {
+            const std::vector arguments = {
+                "./easy-make", "build", "config-name", "--output-format=text", "--output-format=jsonl"};
+            const auto command_info = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Flag '--output-format' was provided to command 'build' more than once.");
+        }
+
+        SUBCASE("'--output-format=jsonl' flag together with '--dry-run' flag")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--output-format=jsonl", "--dry-run"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: The 'build' command does not allow using '--dry-run' together with "
+                     "'--output-format=jsonl'.");
+        }
+
+        SUBCASE("Valid case with '--workers' flag")
+        {
+            const std::vector arguments = {
+                "./easy-make", "build", "config-name", "--workers", "build-box:3633/16,unix:/tmp/worker.sock"};
+            const auto command_info = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<BuildCommandInfo>(*command_info));
+
+            const auto& build_command_info = std::get<BuildCommandInfo>(*command_info);
+            CHECK_EQ(build_command_info.workers, "build-box:3633/16,unix:/tmp/worker.sock");
+        }
+
+        SUBCASE("Missing list of workers")
+        {
+            const std::vector arguments = {"./easy-make", "build", "config-name", "--workers"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Flag '--workers' of command 'build' must be followed by a list of workers.");
+        }
+
         SUBCASE("Specifying configuration name together with '--all' flag")
         {
             const std::vector arguments = {"./easy-make", "build", "config-name", "--all"};
@@ -700,6 +875,176 @@ TEST_SUITE("argument_parsing" * doctest::test_suite(test_type::unit))
         }
     }
 
+    TEST_CASE("'pgo' command")
+    {
+        SUBCASE("Valid case")
+        {
+            const std::vector arguments = {
+                "./easy-make", "pgo", "release", "--parallel", "--", "./app-instrumented", "--iterations", "10"};
+            const auto command_info = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<PgoCommandInfo>(*command_info));
+
+            const auto& pgo_command_info = std::get<PgoCommandInfo>(*command_info);
+            CHECK_EQ(pgo_command_info.configuration_name, "release");
+            CHECK_EQ(pgo_command_info.training_command, "./app-instrumented --iterations 10");
+            CHECK_FALSE(pgo_command_info.is_quiet);
+            CHECK(pgo_command_info.use_parallel_compilation);
+        }
+
+        SUBCASE("Missing configuration name")
+        {
+            const std::vector arguments = {"./easy-make", "pgo", "--", "./app-instrumented"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(), "Error: Must specify a configuration name when using 'pgo' command.");
+        }
+
+        SUBCASE("Missing training command")
+        {
+            const std::vector arguments = {"./easy-make", "pgo", "release", "--"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Must specify a training command after '--' when using 'pgo' command.");
+        }
+
+        SUBCASE("Invalid flag")
+        {
+            const std::vector arguments = {"./easy-make", "pgo", "release", "--all", "--", "./app-instrumented"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(), "Error: Unknown flag '--all' provided to command 'pgo'.");
+        }
+    }
+
+    TEST_CASE("'analyze-includes' command")
+    {
+        SUBCASE("Valid case")
+        {
+            const std::vector arguments = {"./easy-make", "analyze-includes", "debug", "--all"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<AnalyzeIncludesCommandInfo>(*command_info));
+
+            const auto& analyze_includes_command_info = std::get<AnalyzeIncludesCommandInfo>(*command_info);
+            CHECK_EQ(analyze_includes_command_info.configuration_name, "debug");
+            CHECK(analyze_includes_command_info.show_all_headers);
+            CHECK_FALSE(analyze_includes_command_info.porcelain_output);
+        }
+
+        SUBCASE("Missing configuration name")
+        {
+            const std::vector arguments = {"./easy-make", "analyze-includes", "--porcelain"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Must specify a configuration name when using 'analyze-includes' command.");
+        }
+
+        SUBCASE("Duplicate flag")
+        {
+            const std::vector arguments = {"./easy-make", "analyze-includes", "debug", "--all", "--all"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Flag '--all' was provided to command 'analyze-includes' more than once.");
+        }
+    }
+
+    TEST_CASE("'report' command")
+    {
+        SUBCASE("Every configuration")
+        {
+            const std::vector arguments = {"./easy-make", "report"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<ReportCommandInfo>(*command_info));
+
+            const auto& report_command_info = std::get<ReportCommandInfo>(*command_info);
+            CHECK_FALSE(report_command_info.configuration_name.has_value());
+            CHECK_FALSE(report_command_info.show_all_entries);
+        }
+
+        SUBCASE("One configuration with flags")
+        {
+            const std::vector arguments = {"./easy-make", "report", "debug", "--all"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<ReportCommandInfo>(*command_info));
+
+            const auto& report_command_info = std::get<ReportCommandInfo>(*command_info);
+            CHECK_EQ(report_command_info.configuration_name, "debug");
+            CHECK(report_command_info.show_all_entries);
+        }
+
+        SUBCASE("Multiple configuration names")
+        {
+            const std::vector arguments = {"./easy-make", "report", "debug", "release"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Command 'report' requires one configuration name, instead got both 'debug' and "
+                     "'release'.");
+        }
+
+        SUBCASE("Unknown flag")
+        {
+            const std::vector arguments = {"./easy-make", "report", "--porcelain"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(), "Error: Unknown flag '--porcelain' provided to command 'report'.");
+        }
+    }
+
+    TEST_CASE("'worker' command")
+    {
+        SUBCASE("Valid case with flags")
+        {
+            const std::vector arguments = {"./easy-make", "worker", "0.0.0.0:3633", "--parallel", "--quiet"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE(command_info.has_value());
+            REQUIRE(std::holds_alternative<WorkerCommandInfo>(*command_info));
+
+            const auto& worker_command_info = std::get<WorkerCommandInfo>(*command_info);
+            CHECK_EQ(worker_command_info.address, "0.0.0.0:3633");
+            CHECK(worker_command_info.use_parallel_compilation);
+            CHECK(worker_command_info.is_quiet);
+        }
+
+        SUBCASE("Missing address")
+        {
+            const std::vector arguments = {"./easy-make", "worker", "--parallel"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(), "Error: Must specify an address when using 'worker' command.");
+        }
+
+        SUBCASE("Multiple addresses")
+        {
+            const std::vector arguments = {"./easy-make", "worker", "localhost:3633", "unix:/tmp/worker.sock"};
+            const auto command_info     = parse_arguments(arguments);
+
+            REQUIRE_FALSE(command_info.has_value());
+            CHECK_EQ(command_info.error(),
+                     "Error: Command 'worker' requires one address, instead got both 'localhost:3633' and "
+                     "'unix:/tmp/worker.sock'.");
+        }
+    }
+
     TEST_CASE("Invalid commands")
     {
         SUBCASE("No command")
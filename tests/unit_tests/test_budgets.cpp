@@ -0,0 +1,95 @@
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/budgets.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("budgets" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_budget")
+    {
+        Configuration configuration;
+        configuration.max_compile_seconds     = 30;
+        configuration.max_memory_in_megabytes = 2048;
+        configuration.budget_overrides        = {
+            {.path = "source/gen", .max_compile_seconds = 1}, // Not a parent of "source/generated".
+            {.path = "source/generated/", .max_compile_seconds = 120, .max_memory_in_megabytes = 4096},
+            {.path = "source/generated/parser.cpp", .max_compile_seconds = 300},
+        };
+
+        SUBCASE("A file without an override")
+        {
+            const auto budget = budgets::get_budget(configuration, "source/main.cpp");
+
+            CHECK_EQ(budget.max_compile_seconds, 30);
+            CHECK_EQ(budget.max_memory_in_megabytes, 2048);
+            CHECK_EQ(budget.action, budgets::Action::Warn);
+        }
+
+        SUBCASE("A file inside an overridden directory")
+        {
+            const auto budget = budgets::get_budget(configuration, "source/generated/lexer.cpp");
+
+            CHECK_EQ(budget.max_compile_seconds, 120);
+            CHECK_EQ(budget.max_memory_in_megabytes, 4096);
+        }
+
+        SUBCASE("The longest path takes precedence, and the limits it does not set are inherited")
+        {
+            const auto budget = budgets::get_budget(configuration, "./source/generated/parser.cpp");
+
+            CHECK_EQ(budget.max_compile_seconds, 300);
+            CHECK_EQ(budget.max_memory_in_megabytes, 2048);
+        }
+
+        SUBCASE("An override of the whole project applies to the files without a longer override")
+        {
+            configuration.budget_overrides->push_back({.path = ".", .max_compile_seconds = 60});
+
+            CHECK_EQ(budgets::get_budget(configuration, "source/main.cpp").max_compile_seconds, 60);
+            CHECK_EQ(budgets::get_budget(configuration, "./main.cpp").max_compile_seconds, 60);
+            CHECK_EQ(budgets::get_budget(configuration, "source/generated/lexer.cpp").max_compile_seconds, 120);
+        }
+
+        SUBCASE("The action")
+        {
+            configuration.budget_action = "kill";
+
+            CHECK_EQ(budgets::get_budget(configuration, "source/main.cpp").action, budgets::Action::Kill);
+        }
+    }
+
+    TEST_CASE("check")
+    {
+        const budgets::Budget budget = {
+            .max_compile_seconds     = 10,
+            .max_memory_in_megabytes = 1024,
+            .action                  = budgets::Action::Fail,
+        };
+
+        CHECK_FALSE(budgets::check(budget, 9.5, 512 * 1024).has_value());
+        CHECK_EQ(budgets::check(budget, 12.345, 512 * 1024),
+                 "took 12.35 seconds to compile, which exceeds its budget of 10 seconds");
+        CHECK_EQ(budgets::check(budget, 1.0, 2048 * 1024),
+                 "used 2048 MB of memory to compile, which exceeds its budget of 1024 MB");
+        CHECK_EQ(budgets::check(budget, 12.0, 2048 * 1024),
+                 "took 12.00 seconds to compile, which exceeds its budget of 10 seconds, "
+                 "and used 2048 MB of memory to compile, which exceeds its budget of 1024 MB");
+        CHECK_FALSE(budgets::check({.action = budgets::Action::Warn}, 1000.0, 1024 * 1024).has_value());
+    }
+
+    TEST_CASE("get_limits")
+    {
+        const auto limits = budgets::get_limits(
+            {.max_compile_seconds = 30, .max_memory_in_megabytes = 1.5, .action = budgets::Action::Kill});
+
+        CHECK_EQ(limits.max_seconds, 30);
+        CHECK_EQ(limits.max_memory_in_megabytes, 1.5);
+
+        const auto fail_limits = budgets::get_limits(
+            {.max_compile_seconds = 30, .max_memory_in_megabytes = 1.5, .action = budgets::Action::Fail});
+
+        CHECK_FALSE(fail_limits.max_seconds.has_value());
+        CHECK_FALSE(fail_limits.max_memory_in_megabytes.has_value());
+    }
+}
@@ -1,18 +1,71 @@
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <fcntl.h> // open
+#include <sys/wait.h>
+#include <unistd.h> // dup, dup2
+
 #include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
 
 #include "source/commands/build/build.hpp"
 #include "source/commands/build/compilation/compilation.hpp"
 #include "source/commands/build/configuration_resolution.hpp"
+#include "source/commands/build/events.hpp"
+#include "source/commands/build/history.hpp"
 #include "source/configuration_parsing/configuration.hpp"
 #include "source/configuration_parsing/configuration_parsing.hpp"
 #include "source/parameters/parameters.hpp"
 #include "tests/parameters.hpp"
 #include "tests/unit_tests/utils/utils.hpp"
 
+static auto create_library(const std::string& name,
+                           const std::string& type,
+                           const std::vector<std::string>& dependencies) -> Configuration
+{
+    Configuration configuration;
+    configuration.name         = name;
+    configuration.compiler     = "g++";
+    configuration.output_name  = (type == "static") ? "lib" + name + ".a" : "lib" + name + ".so";
+    configuration.type         = type;
+    configuration.dependencies = dependencies;
+
+    return configuration;
+}
+
+static auto get_names(const std::vector<Configuration>& configurations) -> std::vector<std::string>
+{
+    const auto get_name = [](const Configuration& configuration) { return *configuration.name; };
+
+    return configurations | std::views::transform(get_name) | std::ranges::to<std::vector>();
+}
+
+// A project in a temporary directory whose configurations each compile one source file of their own.
+static auto create_project(const std::filesystem::path& path_to_root,
+                           std::vector<Configuration>& configurations,
+                           const std::vector<std::string>& sources) -> void
+{
+    std::filesystem::remove_all(path_to_root);
+    std::filesystem::create_directories(path_to_root);
+
+    for (auto i = 0UZ; i < configurations.size(); ++i)
+    {
+        const auto file_name = *configurations[i].name + ".cpp";
+        std::ofstream(path_to_root / file_name) << sources[i];
+
+        configurations[i].source_files = std::vector{(path_to_root / file_name).native()};
+        configurations[i].output_path  = path_to_root.native();
+    }
+}
+
 TEST_SUITE("commands::build" * doctest::test_suite(test_type::unit))
 {
     TEST_CASE("get_resolved_configurations")
@@ -255,5 +308,303 @@ TEST_SUITE("commands::build" * doctest::test_suite(test_type::unit))
 
             CHECK_EQ(create_compilation_flags_string(configuration), "");
         }
+
+        SUBCASE("Debug info and shared library")
+        {
+            Configuration configuration;
+            configuration.name       = "test";
+            configuration.compiler   = "g++";
+            configuration.debug_info = "split";
+            configuration.type       = "shared";
+
+            CHECK_EQ(create_compilation_flags_string(configuration), "-g -gsplit-dwarf -fPIC");
+        }
+
+        SUBCASE("LTO")
+        {
+            Configuration configuration;
+            configuration.name     = "test";
+            configuration.compiler = "clang++";
+            configuration.lto      = "thin";
+
+            CHECK_EQ(create_compilation_flags_string(configuration), "-flto=thin");
+
+            // GCC has no ThinLTO.
+            configuration.compiler = "g++";
+            CHECK_EQ(create_compilation_flags_string(configuration), "-flto");
+
+            configuration.lto = "none";
+            CHECK_EQ(create_compilation_flags_string(configuration), "");
+        }
+
+        SUBCASE("Profile")
+        {
+            Configuration configuration;
+            configuration.name     = "test";
+            configuration.compiler = "clang++";
+            configuration.profile  = "easy-make-build/test/profile/default.profdata";
+
+            CHECK_EQ(create_compilation_flags_string(configuration),
+                     "-fprofile-use=easy-make-build/test/profile/default.profdata "
+                     "-Wno-profile-instr-out-of-date -Wno-profile-instr-unprofiled");
+
+            configuration.compiler = "g++";
+            configuration.profile  = "easy-make-build/test/profile";
+            CHECK_EQ(create_compilation_flags_string(configuration),
+                     "-fprofile-use=easy-make-build/test/profile -fprofile-partial-training "
+                     "-Wno-missing-profile -Wno-coverage-mismatch");
+        }
+
+        SUBCASE("With a precompiled header")
+        {
+            Configuration configuration;
+            configuration.name     = "test";
+            configuration.compiler = "g++";
+            configuration.standard = "20";
+
+            CHECK_EQ(create_compilation_flags_string(configuration, "easy-make-build/test/easy-make-pch.hpp"),
+                     "-std=c++20 -include easy-make-build/test/easy-make-pch.hpp");
+        }
+
+        SUBCASE("Only a precompiled header")
+        {
+            Configuration configuration;
+            configuration.name     = "test";
+            configuration.compiler = "g++";
+
+            CHECK_EQ(create_compilation_flags_string(configuration, "pch.hpp"), "-include pch.hpp");
+        }
+    }
+
+    TEST_CASE("get_dependencies")
+    {
+        const std::vector configurations{
+            create_library("core", "static", {}),
+            create_library("io", "static", {"core"}),
+            create_library("network", "shared", {"io", "core"}),
+        };
+        std::unordered_map<std::string, Configuration> name_to_configuration;
+
+        for (const auto& configuration : configurations)
+        {
+            name_to_configuration.emplace(*configuration.name, configuration);
+        }
+
+        SUBCASE("Every library comes before the libraries it depends on")
+        {
+            auto app         = create_library("app", "executable", {"core", "network"});
+            app.output_name  = "app.exe";
+            const auto result = get_dependencies(app, name_to_configuration);
+
+            REQUIRE(result.has_value());
+            CHECK_EQ(get_names(*result), std::vector<std::string>{"network", "io", "core"});
+        }
+
+        SUBCASE("A configuration without dependencies has none")
+        {
+            const auto result = get_dependencies(configurations[0], name_to_configuration);
+
+            REQUIRE(result.has_value());
+            CHECK(result->empty());
+        }
+
+        SUBCASE("A cycle is rejected")
+        {
+            name_to_configuration.insert_or_assign("core", create_library("core", "static", {"network"}));
+
+            CHECK_FALSE(get_dependencies(configurations[2], name_to_configuration).has_value());
+        }
+
+        SUBCASE("A dependency that is not a library is rejected")
+        {
+            auto app        = create_library("app", "executable", {"core"});
+            app.output_name = "app.exe";
+            name_to_configuration.emplace("app", app);
+            const auto tool = create_library("tool", "static", {"app"});
+
+            CHECK_FALSE(get_dependencies(tool, name_to_configuration).has_value());
+        }
+
+        SUBCASE("A dependency that is incomplete is rejected")
+        {
+            const auto tool = create_library("tool", "static", {"missing"});
+
+            CHECK_FALSE(get_dependencies(tool, name_to_configuration).has_value());
+        }
+    }
+
+    TEST_CASE("get_position_independent_configurations")
+    {
+        const std::vector configurations{
+            create_library("base", "static", {}),
+            create_library("util", "static", {"base"}),
+            create_library("plugin", "shared", {"util"}),
+            create_library("other", "static", {}),
+            create_library("app", "executable", {"other", "plugin"}),
+        };
+
+        const auto result = get_position_independent_configurations(configurations);
+
+        CHECK_EQ(result, std::unordered_set<std::string>{"base", "util"});
+    }
+
+    TEST_CASE("Dependencies are linked before their dependents")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-dependencies";
+
+        BuildCommandInfo info{};
+        info.configuration_name = "app";
+        info.is_quiet           = true;
+
+        // `base` uses a global variable, so it has to be position independent to be linked into `plugin`.
+        std::vector configurations{
+            create_library("base", "static", {}),
+            create_library("util", "static", {"base"}),
+            create_library("plugin", "shared", {"util"}),
+            create_library("app", "executable", {"base", "plugin"}),
+        };
+        configurations[3].output_name = "app.exe";
+        create_project(path_to_root,
+                       configurations,
+                       {
+                           "int value = 1;\nauto base() -> int { return value; }\n",
+                           "auto base() -> int;\nauto util() -> int { return base() + 1; }\n",
+                           "auto util() -> int;\nauto plugin() -> int { return util() + 1; }\n",
+                           "auto plugin() -> int;\nauto base() -> int;\n"
+                           "auto main() -> int { return plugin() + base(); }\n",
+                       });
+
+        const auto result = commands::build(info, configurations, path_to_root);
+
+        REQUIRE_EQ(result.exit_status, EXIT_SUCCESS);
+        CHECK_EQ(result.num_of_files_compiled, 4);
+
+        const auto exit_status = std::system((path_to_root / "app.exe").c_str());
+        CHECK(WIFEXITED(exit_status));
+        CHECK_EQ(WEXITSTATUS(exit_status), 4);
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("A configuration whose build throws fails, and so do its dependents")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-build-throws";
+
+        BuildCommandInfo info{};
+        info.configuration_name = "app";
+        info.is_quiet           = true;
+
+        std::vector configurations{
+            create_library("base", "static", {}),
+            create_library("app", "executable", {"base"}),
+        };
+        configurations[1].output_name = "app.exe";
+        create_project(path_to_root,
+                       configurations,
+                       {
+                           "auto base() -> int { return 1; }\n",
+                           "auto base() -> int;\nauto main() -> int { return base(); }\n",
+                       });
+
+        // A file where the build directory of `base` should be, so that its build fails to create it.
+        std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME);
+        std::ofstream(path_to_root / params::BUILD_DIRECTORY_NAME / "base") << "not a directory";
+
+        BuildCommandResult result{};
+        CHECK_NOTHROW(result = commands::build(info, configurations, path_to_root));
+
+        CHECK_NE(result.exit_status, EXIT_SUCCESS);
+        CHECK_FALSE(std::filesystem::exists(path_to_root / "app.exe"));
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("The history records the compiled files and counts the up-to-date ones")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-build-history";
+
+        BuildCommandInfo info{};
+        info.configuration_name = "app";
+        info.is_quiet           = true;
+
+        std::vector configurations{create_library("app", "executable", {})};
+        configurations[0].output_name = "app.exe";
+        create_project(path_to_root, configurations, {"auto main() -> int {}\n"});
+
+        REQUIRE_EQ(commands::build(info, configurations, path_to_root).exit_status, EXIT_SUCCESS);
+        REQUIRE_EQ(commands::build(info, configurations, path_to_root).exit_status, EXIT_SUCCESS);
+
+        const auto build_history = history::read(path_to_root);
+
+        REQUIRE_EQ(build_history.builds.size(), 2);
+        CHECK_EQ(build_history.builds[0].num_of_files_compiled, 1);
+        CHECK_EQ(build_history.builds[0].num_of_files_up_to_date, 0);
+        CHECK_EQ(build_history.builds[1].num_of_files_compiled, 0);
+        CHECK_EQ(build_history.builds[1].num_of_files_up_to_date, 1);
+
+        REQUIRE_EQ(build_history.translation_units.size(), 1);
+        CHECK_EQ(build_history.translation_units[0].cause, "first_build");
+        CHECK_EQ(build_history.translation_units[0].timestamp, build_history.builds[0].timestamp);
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("Every line of the JSONL output is JSON when a compilation fails")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-jsonl-failure";
+        const auto output_path  = path_to_root.native() + ".jsonl";
+
+        BuildCommandInfo info{};
+        info.configuration_name = "app";
+        info.is_quiet           = true;
+        info.output_format      = OutputFormat::JSONL;
+
+        // The failure of the library is reported again by `app`, which is not linked because of it.
+        std::vector configurations{
+            create_library("base", "static", {}),
+            create_library("app", "executable", {"base"}),
+        };
+        configurations[1].output_name = "app.exe";
+        create_project(path_to_root,
+                       configurations,
+                       {
+                           "auto base() -> int { return undeclared; }\n",
+                           "auto base() -> int;\nauto main() -> int { return base(); }\n",
+                       });
+
+        // The events and the errors are written to stdout, which is redirected to a file meanwhile.
+        std::fflush(stdout);
+        const auto stdout_copy = dup(STDOUT_FILENO);
+        const auto output      = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        dup2(output, STDOUT_FILENO);
+
+        events::enable();
+        const auto result = commands::build(info, configurations, path_to_root);
+        events::disable();
+
+        std::fflush(stdout);
+        dup2(stdout_copy, STDOUT_FILENO);
+        close(output);
+        close(stdout_copy);
+
+        CHECK_NE(result.exit_status, EXIT_SUCCESS);
+
+        auto file          = std::ifstream(output_path);
+        auto num_of_errors = 0;
+        auto num_of_lines  = 0;
+
+        for (std::string line; std::getline(file, line); ++num_of_lines)
+        {
+            const auto json = nlohmann::json::parse(line, nullptr, false);
+            REQUIRE_MESSAGE(json.is_object(), line);
+
+            num_of_errors += json["event"] == "error" ? 1 : 0;
+        }
+
+        CHECK_GT(num_of_lines, 0);
+        CHECK_GT(num_of_errors, 0);
+
+        std::filesystem::remove(output_path);
+        std::filesystem::remove_all(path_to_root);
     }
 }
@@ -1,14 +1,53 @@
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "third_party/doctest/doctest.hpp"
 
 #include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/utils.hpp"
 #include "tests/parameters.hpp"
 #include "tests/unit_tests/utils/utils.hpp"
 
+// A project whose compiler creates `started` before it runs `g++`, and `finished` once it is done.
+static auto create_pipelined_project(const std::filesystem::path& path_to_root,
+                                     const std::string& configuration_name) -> Configuration
+{
+    std::filesystem::remove_all(path_to_root);
+    std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name);
+
+    const auto compiler_path = path_to_root / "marking-g++";
+    std::ofstream(compiler_path) << "#!/bin/sh\ntouch " << (path_to_root / "started").native() << "\ng++ \"$@\"\n"
+                                 << "status=$?\ntouch " << (path_to_root / "finished").native() << "\nexit $status\n";
+    std::filesystem::permissions(compiler_path, std::filesystem::perms::owner_exec, std::filesystem::perm_options::add);
+
+    Configuration configuration{};
+    configuration.name     = configuration_name;
+    configuration.compiler = compiler_path.native();
+
+    return configuration;
+}
+
+static auto wait_for_file(const std::filesystem::path& path) -> bool
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+    while (!std::filesystem::exists(path) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return std::filesystem::exists(path);
+}
+
 TEST_SUITE("build_caching" * doctest::test_suite(test_type::unit))
 {
     TEST_CASE("'hash_file_contents' works.")
@@ -97,6 +136,44 @@ TEST_SUITE("build_caching" * doctest::test_suite(test_type::unit))
             REQUIRE_NE(hash_before_change, hash_after_change);
         }
 
+        SUBCASE("changes when debug info changes")
+        {
+            Configuration config{};
+            config.compiler               = "g++";
+            config.debug_info             = "full";
+            const auto hash_before_change = build_caching::hash_configuration(config);
+
+            config.debug_info            = "split";
+            const auto hash_after_change = build_caching::hash_configuration(config);
+
+            REQUIRE_NE(hash_before_change, hash_after_change);
+        }
+
+        SUBCASE("changes when LTO changes")
+        {
+            Configuration config{};
+            config.compiler               = "clang++";
+            config.lto                    = "full";
+            const auto hash_before_change = build_caching::hash_configuration(config);
+
+            config.lto                   = "thin";
+            const auto hash_after_change = build_caching::hash_configuration(config);
+
+            REQUIRE_NE(hash_before_change, hash_after_change);
+        }
+
+        SUBCASE("changes when profile changes")
+        {
+            Configuration config{};
+            config.compiler               = "clang++";
+            const auto hash_before_change = build_caching::hash_configuration(config);
+
+            config.profile               = "easy-make-build/release/profile/default.profdata";
+            const auto hash_after_change = build_caching::hash_configuration(config);
+
+            REQUIRE_NE(hash_before_change, hash_after_change);
+        }
+
         SUBCASE("changes when defines change")
         {
             Configuration config{};
@@ -166,6 +243,36 @@ TEST_SUITE("build_caching" * doctest::test_suite(test_type::unit))
         }
     }
 
+    TEST_CASE("'get_changed_configuration_fields' names the fields that changed.")
+    {
+        Configuration old_config{};
+        old_config.compiler     = "g++";
+        old_config.optimization = "0";
+        old_config.warnings     = {"-Wall"};
+
+        auto new_config         = old_config;
+        new_config.optimization = "3";
+        new_config.warnings     = std::nullopt;
+        new_config.defines      = {"DEBUG=1"};
+
+        const auto changed_fields = build_caching::get_changed_configuration_fields(
+            build_caching::hash_configuration_fields(old_config), build_caching::hash_configuration_fields(new_config));
+
+        CHECK_EQ(changed_fields, std::vector<std::string>{"defines", "optimization", "warnings"});
+    }
+
+    TEST_CASE("'hash_configuration_fields' ignores empty lists.")
+    {
+        Configuration config{};
+        config.compiler   = "g++";
+        const auto before = build_caching::hash_configuration_fields(config);
+
+        config.defines   = std::vector<std::string>{};
+        const auto after = build_caching::hash_configuration_fields(config);
+
+        CHECK_EQ(before, after);
+    }
+
     TEST_CASE("'get_old_file_hashes' returns expected results for existing config.")
     {
         const auto path_to_project_7 = tests::utils::get_path_to_resources_project(7);
@@ -193,6 +300,25 @@ TEST_SUITE("build_caching" * doctest::test_suite(test_type::unit))
         CHECK(hashes.empty());
     }
 
+    TEST_CASE("'get_new_file_hashes' reports every file as soon as it is hashed.")
+    {
+        const auto path_to_project_6 = tests::utils::get_path_to_resources_project(6);
+        const std::vector<std::filesystem::path> code_files{path_to_project_6 / "f_1.cpp",
+                                                            path_to_project_6 / "f_3.cpp"};
+
+        std::unordered_map<std::filesystem::path, std::uint64_t> reported_hashes;
+        const auto hashes = build_caching::get_new_file_hashes(
+            code_files,
+            [&](const std::filesystem::path& file, const std::uint64_t hash)
+            {
+                CHECK_FALSE(reported_hashes.contains(file));
+                reported_hashes[file] = hash;
+            });
+
+        CHECK_EQ(reported_hashes, hashes);
+        CHECK_EQ(hashes.size(), 2);
+    }
+
     TEST_CASE("'get_files_to_delete' works correctly.")
     {
         const std::unordered_map<std::filesystem::path, std::uint64_t> old_file_hashes{
@@ -250,4 +376,116 @@ TEST_SUITE("build_caching" * doctest::test_suite(test_type::unit))
         CHECK_FALSE(std::ranges::contains(changed_files, "bb.cpp"));
         CHECK_FALSE(std::ranges::contains(changed_files, "f.hpp"));
     }
+
+    TEST_CASE("'get_changed_files' looks for the object file of the translation unit.")
+    {
+        const std::unordered_map<std::filesystem::path, std::uint64_t> file_hashes{
+            {"a.cpp", 1},
+            {"d.cpp", 2},
+        };
+
+        // `a.cpp` is compiled as part of `bb.cpp`, whose object file exists.
+        const build_caching::TranslationUnits translation_units{
+            {"a.cpp", "bb.cpp"},
+        };
+
+        const auto path_to_project_8 = tests::utils::get_path_to_resources_project(8);
+        const auto changed_files =
+            build_caching::get_changed_files("conf", path_to_project_8, file_hashes, file_hashes, translation_units);
+
+        CHECK_EQ(changed_files, std::vector<std::filesystem::path>{"d.cpp"});
+    }
+
+    TEST_CASE("Outdated source files start compiling before the analysis ends")
+    {
+        const auto path_to_root  = std::filesystem::temp_directory_path() / "easy-make-test-pipelined-compilation";
+        const auto configuration = create_pipelined_project(path_to_root, "pipelined");
+        std::ofstream(path_to_root / "pipelined.cpp") << "#include \"pipelined.hpp\"\nauto f() -> int { return 42; }\n";
+        std::ofstream(path_to_root / "pipelined.hpp") << "#pragma once\n";
+
+        {
+            const tests::utils::CurrentPathGuard guard(path_to_root);
+            const std::vector<std::filesystem::path> code_files{"pipelined.cpp", "pipelined.hpp"};
+
+            CompilationPipeline pipeline(configuration, ".", false, std::nullopt);
+            auto started_during_analysis = false;
+
+            // The analysis waits for the compiler, which only starts during the analysis if it runs in the background.
+            const auto build_info = build_caching::handle_build_caching(
+                configuration,
+                ".",
+                code_files,
+                {},
+                [&](const std::filesystem::path& file)
+                {
+                    pipeline.add(file);
+                    started_during_analysis = wait_for_file(path_to_root / "started");
+                });
+
+            REQUIRE(build_info.has_value());
+            CHECK(started_during_analysis);
+            CHECK(pipeline.contains("pipelined.cpp"));
+            CHECK_EQ(build_info->files_to_compile, std::vector<std::filesystem::path>{"pipelined.cpp"});
+
+            const auto result = pipeline.finish(true);
+
+            CHECK_EQ(result.num_of_failures, 0);
+            CHECK(std::filesystem::is_regular_file(params::BUILD_DIRECTORY_NAME / "pipelined" /
+                                                   utils::get_object_file_name("pipelined.cpp")));
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("An include cycle found after files were queued cancels their compilation")
+    {
+        const auto path_to_root  = std::filesystem::temp_directory_path() / "easy-make-test-pipelined-cycle";
+        const auto configuration = create_pipelined_project(path_to_root, "pipelined-cycle");
+        std::ofstream(path_to_root / "queued.cpp") << "auto f() -> int { return 42; }\n";
+        std::ofstream(path_to_root / "cyclic.cpp") << "#include \"x.hpp\"\n";
+        std::ofstream(path_to_root / "x.hpp") << "#pragma once\n#include \"y.hpp\"\n";
+        std::ofstream(path_to_root / "y.hpp") << "#pragma once\n#include \"x.hpp\"\n";
+
+        {
+            const tests::utils::CurrentPathGuard guard(path_to_root);
+            const std::vector<std::filesystem::path> code_files{"cyclic.cpp", "queued.cpp", "x.hpp", "y.hpp"};
+            const auto object_files_directory = params::BUILD_DIRECTORY_NAME / "pipelined-cycle";
+
+            // The object file of an earlier build is stale as soon as its source file changed.
+            std::ofstream(object_files_directory / utils::get_object_file_name("queued.cpp")) << "stale";
+
+            CompilationPipeline pipeline(configuration, ".", false, std::nullopt);
+            auto compiled_during_analysis = true;
+
+            // Every queued file is compiled by the time the cycle is found, so their object files exist.
+            const auto build_info = build_caching::handle_build_caching(
+                configuration,
+                ".",
+                code_files,
+                {},
+                [&](const std::filesystem::path& file)
+                {
+                    std::filesystem::remove(path_to_root / "finished");
+                    pipeline.add(file);
+                    compiled_during_analysis = wait_for_file(path_to_root / "finished") && compiled_during_analysis;
+                });
+
+            REQUIRE_FALSE(build_info.has_value());
+            CHECK(compiled_during_analysis);
+            CHECK(build_info.error().contains("Circular header dependency"));
+            CHECK(pipeline.contains("queued.cpp"));
+
+            pipeline.cancel();
+
+            CHECK(pipeline.is_empty());
+            CHECK_FALSE(pipeline.contains("queued.cpp"));
+
+            for (const auto& entry : std::filesystem::directory_iterator(object_files_directory))
+            {
+                CHECK_NE(entry.path().extension(), ".o");
+            }
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
 }
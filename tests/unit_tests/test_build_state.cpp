@@ -0,0 +1,91 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/build_state.hpp"
+#include "source/utils/utils.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("build_state" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("update_cooldowns")
+    {
+        const build_state::Cooldowns previous_cooldowns{
+            {"a.hpp", 3},
+            {"b.hpp", 1},
+        };
+
+        SUBCASE("No cooldown is started in the first build")
+        {
+            const auto cooldowns =
+                build_state::update_cooldowns(false, {}, {"a.hpp", "c.hpp"}, &utils::is_header_file);
+
+            CHECK(cooldowns.empty());
+        }
+
+        SUBCASE("Cooldowns are aged and expire")
+        {
+            const auto cooldowns = build_state::update_cooldowns(true, previous_cooldowns, {}, &utils::is_header_file);
+
+            CHECK_EQ(cooldowns, build_state::Cooldowns{{"a.hpp", 2}});
+        }
+
+        SUBCASE("Changed files that are relevant start a cooldown")
+        {
+            const auto cooldowns = build_state::update_cooldowns(
+                true, previous_cooldowns, {"b.hpp", "c.hpp", "c.cpp"}, &utils::is_header_file);
+
+            const build_state::Cooldowns expected{
+                {"a.hpp", 2                            },
+                {"b.hpp", build_state::STABILITY_WINDOW},
+                {"c.hpp", build_state::STABILITY_WINDOW},
+            };
+
+            CHECK_EQ(cooldowns, expected);
+        }
+    }
+
+    TEST_CASE("Data files are written and read back")
+    {
+        const auto directory      = std::filesystem::temp_directory_path() / "easy-make-test-build-state";
+        const auto data_file_path = build_state::get_data_file_path("debug", directory, "state.json");
+        std::filesystem::remove_all(directory);
+
+        CHECK_FALSE(build_state::read_data_file(data_file_path).has_value());
+
+        const auto json = nlohmann::json{
+            {"signature", 42},
+        };
+        build_state::write_data_file(data_file_path, json);
+
+        CHECK_EQ(build_state::read_data_file(data_file_path), json);
+
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST_CASE("The generated file includes every file in order")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-build-state-including-file";
+        std::filesystem::remove_all(directory);
+
+        build_state::write_including_file(directory / "generated" / "unity.cpp", {"b.cpp", "dir/a.cpp"}, directory);
+
+        auto file = std::ifstream(directory / "generated" / "unity.cpp");
+        std::stringstream contents;
+        contents << file.rdbuf();
+
+        const auto absolute_directory = std::filesystem::absolute(directory).lexically_normal();
+        const auto expected           = "// Generated by easy-make. Do not edit.\n"
+                                        "#include \"" +
+                                        (absolute_directory / "b.cpp").native() + "\"\n#include \"" +
+                                        (absolute_directory / "dir/a.cpp").native() + "\"\n";
+
+        CHECK_EQ(contents.str(), expected);
+
+        std::filesystem::remove_all(directory);
+    }
+}
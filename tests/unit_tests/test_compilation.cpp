@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/utils.hpp"
+#include "tests/parameters.hpp"
+
+static auto read_file(const std::filesystem::path& path) -> std::string
+{
+    auto file = std::ifstream(path);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// A project with one source file, and a compiler that records every invocation before running `g++`.
+static auto create_project(const std::filesystem::path& path_to_root) -> void
+{
+    std::filesystem::remove_all(path_to_root);
+    std::filesystem::create_directories(path_to_root);
+
+    std::ofstream(path_to_root / "f.cpp") << "auto f() -> int { return 42; }\n";
+
+    const auto compiler_path = path_to_root / "counting-g++";
+    std::ofstream(compiler_path) << "#!/bin/sh\necho >> " << (path_to_root / "invocations").native()
+                                 << "\nexec g++ \"$@\"\n";
+    std::filesystem::permissions(compiler_path, std::filesystem::perms::owner_exec, std::filesystem::perm_options::add);
+}
+
+static auto get_num_of_invocations(const std::filesystem::path& path_to_root) -> std::size_t
+{
+    return std::ranges::count(read_file(path_to_root / "invocations"), '\n');
+}
+
+static auto create_configuration(const std::filesystem::path& path_to_root, const std::string& name) -> Configuration
+{
+    Configuration configuration{};
+    configuration.name     = name;
+    configuration.compiler = (path_to_root / "counting-g++").native();
+    std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / name);
+
+    return configuration;
+}
+
+static auto get_object_file_path(const std::filesystem::path& path_to_root,
+                                 const Configuration& configuration,
+                                 const std::filesystem::path& file) -> std::filesystem::path
+{
+    return path_to_root / params::BUILD_DIRECTORY_NAME / *configuration.name / utils::get_object_file_name(file);
+}
+
+TEST_SUITE("compilation" * doctest::test_suite(test_type::unit))
+{
+    // Object files are shared between the compilations of one run, so every test case uses a project of its own.
+
+    TEST_CASE("A file that two configurations compile with the same command is compiled once")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-shared-object";
+        create_project(path_to_root);
+
+        const auto file            = path_to_root / "f.cpp";
+        const auto configuration_1 = create_configuration(path_to_root, "shared-1");
+        auto configuration_2       = create_configuration(path_to_root, "shared-2");
+        configuration_2.link_flags = std::vector<std::string>{"-lm"}; // Does not affect compilation.
+
+        const auto result_1 = compile_files(configuration_1, path_to_root, {file}, true, false, std::nullopt);
+        const auto result_2 = compile_files(configuration_2, path_to_root, {file}, true, false, std::nullopt);
+
+        CHECK_EQ(result_1.num_of_failures, 0);
+        CHECK_EQ(result_2.num_of_failures, 0);
+        CHECK_EQ(get_num_of_invocations(path_to_root), 1);
+        CHECK(std::filesystem::is_regular_file(get_object_file_path(path_to_root, configuration_1, file)));
+        CHECK(std::filesystem::is_regular_file(get_object_file_path(path_to_root, configuration_2, file)));
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("A file that fails to compile for one configuration is not compiled again by another")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-shared-failure";
+        create_project(path_to_root);
+        std::ofstream(path_to_root / "f.cpp") << "auto f() -> int { return undeclared; }\n";
+
+        const auto file            = path_to_root / "f.cpp";
+        const auto configuration_1 = create_configuration(path_to_root, "shared-failure-1");
+        const auto configuration_2 = create_configuration(path_to_root, "shared-failure-2");
+
+        const auto result_1 = compile_files(configuration_1, path_to_root, {file}, true, false, std::nullopt);
+        const auto result_2 = compile_files(configuration_2, path_to_root, {file}, true, false, std::nullopt);
+
+        CHECK_EQ(result_1.num_of_failures, 1);
+        CHECK_EQ(result_2.num_of_failures, 1);
+        CHECK_EQ(get_num_of_invocations(path_to_root), 1);
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("A file that two configurations compile with different flags is compiled by each of them")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-unshared-object";
+        create_project(path_to_root);
+
+        const auto file              = path_to_root / "f.cpp";
+        const auto configuration_1   = create_configuration(path_to_root, "unshared-1");
+        auto configuration_2         = create_configuration(path_to_root, "unshared-2");
+        configuration_2.optimization = "2";
+
+        const auto result_1 = compile_files(configuration_1, path_to_root, {file}, true, false, std::nullopt);
+        const auto result_2 = compile_files(configuration_2, path_to_root, {file}, true, false, std::nullopt);
+
+        CHECK_EQ(result_1.num_of_failures, 0);
+        CHECK_EQ(result_2.num_of_failures, 0);
+        CHECK_EQ(get_num_of_invocations(path_to_root), 2);
+        CHECK(std::filesystem::is_regular_file(get_object_file_path(path_to_root, configuration_1, file)));
+        CHECK(std::filesystem::is_regular_file(get_object_file_path(path_to_root, configuration_2, file)));
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("A file that is compiled for a compile time report is compiled by each configuration")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-unshared-time-report";
+        create_project(path_to_root);
+
+        const auto file                   = path_to_root / "f.cpp";
+        auto configuration_1              = create_configuration(path_to_root, "time-report-1");
+        configuration_1.compilation_flags = std::vector<std::string>{"-ftime-report"};
+        auto configuration_2              = create_configuration(path_to_root, "time-report-2");
+        configuration_2.compilation_flags = configuration_1.compilation_flags;
+
+        const auto result_1 = compile_files(configuration_1, path_to_root, {file}, true, false, std::nullopt);
+        const auto result_2 = compile_files(configuration_2, path_to_root, {file}, true, false, std::nullopt);
+
+        CHECK_EQ(result_1.num_of_failures, 0);
+        CHECK_EQ(result_2.num_of_failures, 0);
+        CHECK_EQ(get_num_of_invocations(path_to_root), 2);
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("share_object_file")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-share-object-file";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const auto source      = directory / "source.o";
+        const auto destination = directory / "destination.o";
+        std::ofstream(source) << "object";
+
+        SUBCASE("The object file is hard linked")
+        {
+            CHECK(share_object_file(source, destination));
+            CHECK_EQ(std::filesystem::hard_link_count(source), 2);
+            CHECK_EQ(read_file(destination), "object");
+        }
+
+        SUBCASE("The object file is copied when it cannot be hard linked")
+        {
+            // A hard link cannot replace an existing file.
+            std::ofstream(destination) << "stale object";
+
+            CHECK(share_object_file(source, destination));
+            CHECK_EQ(std::filesystem::hard_link_count(source), 1);
+            CHECK_EQ(read_file(destination), "object");
+        }
+
+        SUBCASE("Sharing fails when the object file cannot be copied either")
+        {
+            CHECK_FALSE(share_object_file(directory / "missing.o", destination));
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+}
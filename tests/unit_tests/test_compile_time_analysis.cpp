@@ -0,0 +1,99 @@
+#include <string>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/compile_time_analysis/compile_time_analysis.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("compile_time_analysis" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_compilation_flag")
+    {
+        Configuration configuration;
+        configuration.compiler = "clang++";
+        CHECK_EQ(compile_time_analysis::get_compilation_flag(configuration), "-ftime-trace");
+
+        configuration.compiler = "g++";
+        CHECK_EQ(compile_time_analysis::get_compilation_flag(configuration), "-ftime-report");
+    }
+
+    TEST_CASE("get_time_trace_path")
+    {
+        Configuration configuration;
+        configuration.compiler = "clang++";
+        CHECK_EQ(compile_time_analysis::get_time_trace_path(configuration, "build/src-main.cpp.o"),
+                 "build/src-main.cpp.json");
+
+        configuration.compiler = "g++";
+        CHECK_EQ(compile_time_analysis::get_time_trace_path(configuration, "build/src-main.cpp.o"),
+                 "build/src-main.cpp.time-report");
+    }
+
+    TEST_CASE("parse_clang_time_trace")
+    {
+        const auto contents = R"({
+            "traceEvents": [
+                {"ph": "X", "name": "Source", "dur": 300000, "args": {"detail": "vector"}},
+                {"ph": "X", "name": "Source", "dur": 200000, "args": {"detail": "big.hpp"}},
+                {"ph": "X", "name": "InstantiateClass", "dur": 50000, "args": {"detail": "std::vector<int>"}},
+                {"ph": "X", "name": "InstantiateFunction", "dur": 25000, "args": {"detail": "f<int>"}},
+                {"ph": "X", "name": "Frontend", "dur": 1000000},
+                {"ph": "X", "name": "Total Source", "dur": 500000, "args": {"count": 2}},
+                {"ph": "M", "name": "process_name", "args": {"name": "clang"}}
+            ]
+        })";
+
+        const auto times = compile_time_analysis::parse_clang_time_trace(contents);
+
+        CHECK_EQ(times.headers.size(), 2);
+        CHECK_EQ(times.headers.at("vector"), doctest::Approx(0.3));
+        CHECK_EQ(times.headers.at("big.hpp"), doctest::Approx(0.2));
+        CHECK_EQ(times.templates.size(), 2);
+        CHECK_EQ(times.templates.at("std::vector<int>"), doctest::Approx(0.05));
+        CHECK_EQ(times.phases.size(), 1);
+        CHECK_EQ(times.phases.at("Frontend"), doctest::Approx(1.0));
+    }
+
+    TEST_CASE("parse_gcc_time_report")
+    {
+        const auto contents =
+            "Time variable                                   usr           sys          wall           GGC\n"
+            " phase parsing                      :   0.51 ( 65%)   0.19 ( 86%)   0.71 ( 70%)    54M ( 73%)\n"
+            " template instantiation             :   0.10 ( 13%)   0.01 (  5%)   0.12 ( 12%)  8192k ( 11%)\n"
+            " TOTAL                              :   0.78          0.22          1.01           74M\n";
+
+        const auto times = compile_time_analysis::parse_gcc_time_report(contents);
+
+        CHECK(times.headers.empty());
+        CHECK_EQ(times.phases.size(), 2);
+        CHECK_EQ(times.phases.at("phase parsing"), doctest::Approx(0.71));
+        CHECK_EQ(times.phases.at("template instantiation"), doctest::Approx(0.12));
+    }
+
+    TEST_CASE("extract_time_report")
+    {
+        SUBCASE("Diagnostics are kept")
+        {
+            std::string compiler_output = "main.cpp:1:1: warning: unused variable\n"
+                                          "\n"
+                                          "Time variable   usr   sys   wall\n"
+                                          " TOTAL      :   0.78  0.22  1.01   74M\n";
+
+            const auto report = compile_time_analysis::extract_time_report(compiler_output);
+
+            CHECK_EQ(report, "Time variable   usr   sys   wall\n TOTAL      :   0.78  0.22  1.01   74M\n");
+            CHECK_EQ(compiler_output, "main.cpp:1:1: warning: unused variable\n\n");
+        }
+
+        SUBCASE("Nothing is left without diagnostics")
+        {
+            std::string compiler_output = "\n"
+                                          "Time variable   usr   sys   wall\n"
+                                          " TOTAL      :   0.78  0.22  1.01   74M\n";
+
+            compile_time_analysis::extract_time_report(compiler_output);
+
+            CHECK(compiler_output.empty());
+        }
+    }
+}
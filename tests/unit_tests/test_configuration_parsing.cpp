@@ -171,6 +171,43 @@ TEST_SUITE("configuration_parsing" * doctest::test_suite(test_type::unit))
         }
     }
 
+    TEST_CASE("Budgets are parsed correctly")
+    {
+        const auto project_34_path = tests::utils::get_path_to_resources_project(34);
+        const auto configurations  = parse_configurations(project_34_path);
+
+        REQUIRE(configurations.has_value());
+        REQUIRE_EQ(configurations->size(), 2);
+
+        const auto& configuration = configurations->front();
+        CHECK_EQ(configuration.max_compile_seconds, 30);
+        CHECK_EQ(configuration.max_memory_in_megabytes, 1536.5);
+        CHECK_EQ(configuration.budget_action, "fail");
+        REQUIRE(configuration.budget_overrides.has_value());
+        REQUIRE_EQ(configuration.budget_overrides->size(), 2);
+        CHECK_EQ(configuration.budget_overrides->at(0).path, "dir_1");
+        CHECK_EQ(configuration.budget_overrides->at(0).max_compile_seconds, 120);
+        CHECK_FALSE(configuration.budget_overrides->at(0).max_memory_in_megabytes.has_value());
+        CHECK_EQ(configuration.budget_overrides->at(1).path, "f_1.cpp");
+        CHECK_EQ(configuration.budget_overrides->at(1).max_memory_in_megabytes, 4096);
+
+        const auto& child = configurations->back();
+        CHECK_EQ(child.budget_action, "kill");
+        CHECK_FALSE(child.max_compile_seconds.has_value()); // Inherited only when the configurations are resolved.
+    }
+
+    TEST_CASE("Invalid key inside 'budgets.overrides' object")
+    {
+        const auto project_35_path = tests::utils::get_path_to_resources_project(35);
+        const auto configurations  = parse_configurations(project_35_path);
+
+        REQUIRE(!configurations.has_value());
+        CHECK_EQ(configurations.error(),
+                 "Error: Invalid JSON - the 1st configuration contains an unknown key "
+                 "'budgets.overrides.source/generated.cpp.compileSecond'. "
+                 "Did you mean 'budgets.overrides.source/generated.cpp.compileSeconds'?");
+    }
+
     TEST_CASE("JSON is not an array")
     {
         const auto project_26_path = tests::utils::get_path_to_resources_project(26);
@@ -468,6 +505,144 @@ TEST_SUITE("configuration_parsing" * doctest::test_suite(test_type::unit))
             CHECK_EQ(*error, "Error: Configuration 'config' has an unknown optimization '7'.");
         }
 
+        SUBCASE("valid linker")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name   = "config";
+            configurations[0].linker = "mold";
+
+            CHECK_FALSE(validate_configuration_values(configurations, "").has_value());
+        }
+
+        SUBCASE("invalid linker")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name   = "config";
+            configurations[0].linker = "ld";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has an unknown linker 'ld'.");
+        }
+
+        SUBCASE("invalid type")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name = "config";
+            configurations[0].type = "dynamic";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has an unknown type 'dynamic'.");
+        }
+
+        SUBCASE("valid dependencies")
+        {
+            std::vector<Configuration> configurations(3);
+            configurations[0].name         = "app";
+            configurations[0].dependencies = {"core", "io"};
+            configurations[1].name         = "io";
+            configurations[1].type         = "shared";
+            configurations[1].dependencies = {"core"};
+            configurations[2].name         = "core";
+            configurations[2].type         = "static";
+
+            CHECK_FALSE(validate_configuration_values(configurations, "").has_value());
+        }
+
+        SUBCASE("configuration depends on itself")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name         = "config";
+            configurations[0].dependencies = {"config"};
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' depends on itself.");
+        }
+
+        SUBCASE("non-existent dependency")
+        {
+            std::vector<Configuration> configurations(2);
+            configurations[0].name         = "app";
+            configurations[0].dependencies = {"cor"};
+            configurations[1].name         = "core";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error,
+                     "Error: Configuration 'app' depends on a non-existent configuration 'cor'. Did you mean 'core'?");
+        }
+
+        SUBCASE("circular dependency")
+        {
+            std::vector<Configuration> configurations(2);
+            configurations[0].name         = "a";
+            configurations[0].dependencies = {"b"};
+            configurations[1].name         = "b";
+            configurations[1].dependencies = {"a"};
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK(error->starts_with("Error: Circular dependency between configurations detected."));
+        }
+
+        SUBCASE("invalid LTO mode")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name = "config";
+            configurations[0].lto  = "fat";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has an unknown LTO mode 'fat'.");
+        }
+
+        SUBCASE("invalid debug info mode")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name       = "config";
+            configurations[0].debug_info = "dwarf";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has an unknown debug info mode 'dwarf'.");
+        }
+
+        SUBCASE("invalid budget action")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name          = "config";
+            configurations[0].budget_action = "abort";
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has an unknown budget action 'abort'.");
+        }
+
+        SUBCASE("budget that is not positive")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name                = "config";
+            configurations[0].max_compile_seconds = 0;
+
+            const auto error = validate_configuration_values(configurations, "");
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has a budget that is not positive.");
+        }
+
+        SUBCASE("budget for a non-existent path")
+        {
+            std::vector<Configuration> configurations(1);
+            configurations[0].name             = "config";
+            configurations[0].budget_overrides = {{.path = "dir_2", .max_compile_seconds = 60}};
+
+            const auto error =
+                validate_configuration_values(configurations, tests::utils::get_path_to_resources_project(34));
+            REQUIRE(error.has_value());
+            CHECK_EQ(*error, "Error: Configuration 'config' has a budget for a non-existent path 'dir_2'.");
+        }
+
         SUBCASE("header file in source files")
         {
             const auto project_31_path = tests::utils::get_path_to_resources_project(31);
@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/distributed/distributed.hpp"
+#include "source/commands/build/distributed/protocol.hpp"
+#include "source/commands/worker/worker.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "tests/parameters.hpp"
+
+static auto create_configuration() -> Configuration
+{
+    Configuration configuration{};
+    configuration.name     = "distributed";
+    configuration.compiler = "g++";
+
+    return configuration;
+}
+
+static auto create_file(const std::filesystem::path& path, const std::string& contents) -> void
+{
+    auto file = std::ofstream(path);
+    file << contents;
+}
+
+TEST_SUITE("distributed" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("parse_address")
+    {
+        const auto tcp_address = distributed::parse_address("build-box:3633");
+        REQUIRE(tcp_address.has_value());
+        CHECK_EQ(tcp_address->host, "build-box");
+        CHECK_EQ(tcp_address->port, 3633);
+        CHECK_FALSE(tcp_address->socket_path.has_value());
+
+        const auto ipv6_address = distributed::parse_address("[::1]:3633");
+        REQUIRE(ipv6_address.has_value());
+        CHECK_EQ(ipv6_address->host, "::1");
+
+        const auto unix_address = distributed::parse_address("unix:/tmp/worker.sock");
+        REQUIRE(unix_address.has_value());
+        CHECK_EQ(unix_address->socket_path, "/tmp/worker.sock");
+
+        CHECK_EQ(distributed::parse_address("build-box").error(),
+                 "Error: Invalid worker address 'build-box'. Expected 'host:port' or 'unix:<path>'.");
+        CHECK_EQ(distributed::parse_address("build-box:http").error(),
+                 "Error: Invalid port 'http' in worker address 'build-box:http'.");
+        CHECK_EQ(distributed::parse_address("unix:").error(),
+                 "Error: Invalid Unix socket path in worker address 'unix:'.");
+    }
+
+    TEST_CASE("parse_workers")
+    {
+        const auto workers = distributed::parse_workers("build-box:3633/16,unix:/tmp/worker.sock");
+
+        REQUIRE(workers.has_value());
+        REQUIRE_EQ(workers->size(), 2);
+        CHECK_EQ((*workers)[0].address.host, "build-box");
+        CHECK_EQ((*workers)[0].max_num_of_jobs, 16);
+        CHECK_EQ((*workers)[1].address.socket_path, "/tmp/worker.sock");
+        CHECK_EQ((*workers)[1].max_num_of_jobs, distributed::DEFAULT_NUM_OF_JOBS_PER_WORKER);
+
+        CHECK_EQ(distributed::parse_workers("build-box:3633/0").error(),
+                 "Error: Invalid number of jobs in worker 'build-box:3633/0'.");
+        CHECK_EQ(distributed::parse_workers("").error(), "Error: The list of workers is empty.");
+    }
+
+    TEST_CASE("Files that depend on local files are compiled locally")
+    {
+        const auto configuration = create_configuration();
+
+        CHECK(distributed::can_compile_remotely(configuration, "-std=c++23 -O2 -DNDEBUG -Iinclude"));
+        CHECK_FALSE(distributed::can_compile_remotely(configuration, "-std=c++23 -include pch.hpp"));
+        CHECK_FALSE(distributed::can_compile_remotely(configuration, "-O2 -fprofile-use=build/profile"));
+        CHECK_FALSE(distributed::can_compile_remotely(configuration, "-g -gsplit-dwarf"));
+
+        CHECK_EQ(distributed::get_remote_compilation_flags("-std=c++23 -O2 -DNDEBUG -Iinclude -fPIC"),
+                 "-std=c++23 -O2 -fPIC");
+    }
+
+    TEST_CASE("Workers only run supported compilers with flags that take no path")
+    {
+        const auto is_allowed = [](const std::string& compiler, const std::string& compilation_flags)
+        {
+            return worker::is_allowed(
+                {.compiler = compiler, .compilation_flags = compilation_flags, .preprocessed_source = ""});
+        };
+
+        CHECK(is_allowed("g++", "-std=c++23 -O2 -g -Wall -Wno-unused -fPIC -fno-rtti -fsanitize=address,undefined"));
+        CHECK_FALSE(is_allowed("rm", ""));
+        CHECK_FALSE(is_allowed("g++", "-O2; rm -rf ~"));
+        CHECK_FALSE(is_allowed("g++", "-fplugin=x.so"));
+        CHECK_FALSE(is_allowed("g++", "-fprofile-use=profile"));
+        CHECK_FALSE(is_allowed("g++", "-Wa,-adhln=listing"));
+        CHECK_FALSE(is_allowed("g++", "-save-temps"));
+    }
+
+    TEST_CASE("Workers reject compilers of another version")
+    {
+        const auto response = worker::compile({
+            .compiler            = "g++",
+            .compilation_flags   = "-std=c++23",
+            .preprocessed_source = "auto f() -> int { return 42; }\n",
+            .compiler_version    = "g++ (GCC) 1.0.0\nvax-dec-ultrix\n",
+        });
+
+        CHECK_EQ(response.status, distributed::Response::Status::REJECTED);
+        CHECK_FALSE(distributed::get_compiler_version("g++").empty());
+    }
+
+    TEST_CASE("Workers stop compilers that exceed a kill budget")
+    {
+        // Slow to compile, so that the compiler is still running when its memory is checked.
+        const auto source = "constexpr auto sum() -> long\n"
+                            "{\n"
+                            "    long result = 0;\n"
+                            "    for (long i = 0; i < 100000; ++i) result += i;\n"
+                            "    return result;\n"
+                            "}\n"
+                            "static_assert(sum() > 0);\n";
+
+        const auto response = worker::compile({
+            .compiler                = "g++",
+            .compilation_flags       = "-std=c++23",
+            .preprocessed_source     = source,
+            .compiler_version        = distributed::get_compiler_version("g++"),
+            .max_compile_seconds     = std::nullopt,
+            .max_memory_in_megabytes = 1.0,
+        });
+
+        CHECK_EQ(response.status, distributed::Response::Status::FAILED);
+    }
+
+    TEST_CASE("Messages with fields of the wrong type are invalid")
+    {
+        int file_descriptors[2];
+        REQUIRE_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, file_descriptors), 0);
+        const distributed::Socket sender(file_descriptors[0]);
+        const distributed::Socket receiver(file_descriptors[1]);
+
+        SUBCASE("Requests")
+        {
+            const auto header = nlohmann::json{
+                {"protocol",         std::to_string(distributed::PROTOCOL_VERSION)},
+                {"compiler",         "g++"                                        },
+                {"compilationFlags", "-std=c++23"                                 },
+                {"compilerVersion",  "g++ 14"                                     },
+            };
+
+            REQUIRE(distributed::send_message(sender, header.dump()));
+            REQUIRE(distributed::send_message(sender, "auto f() -> int { return 42; }\n"));
+
+            CHECK_FALSE(distributed::receive_request(receiver).has_value());
+        }
+
+        SUBCASE("Responses")
+        {
+            const auto header = nlohmann::json{
+                {"status",              "compiled"},
+                {"compilerOutput",      ""        },
+                {"durationInSeconds",   "fast"    },
+                {"peakMemoryKilobytes", 1024      },
+            };
+
+            REQUIRE(distributed::send_message(sender, header.dump()));
+            REQUIRE(distributed::send_message(sender, "object"));
+
+            CHECK_FALSE(distributed::receive_response(receiver).has_value());
+        }
+    }
+
+    TEST_CASE("A worker keeps its jobs after invalid requests")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-distributed-invalid";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        const auto address = distributed::parse_address("unix:" + (directory / "worker.sock").string());
+        REQUIRE(address.has_value());
+        const auto listener = distributed::listen(*address);
+        REQUIRE(listener.has_value());
+
+        std::jthread worker([&](const std::stop_token stop_token) { worker::serve(*listener, 1, stop_token); });
+
+        // More invalid requests than the worker has jobs. The worker closes each connection without an answer.
+        for (auto i = 0; i < 3; ++i)
+        {
+            const auto connection = distributed::connect(*address, std::chrono::seconds(1));
+            REQUIRE(connection.has_value());
+            REQUIRE(distributed::send_message(*connection, R"({"protocol": "2"})"));
+            CHECK_FALSE(distributed::receive_response(*connection).has_value());
+        }
+
+        const auto connection = distributed::connect(*address, std::chrono::seconds(1));
+        REQUIRE(connection.has_value());
+        REQUIRE(distributed::send_request(*connection,
+                                          {
+                                              .compiler            = "g++",
+                                              .compilation_flags   = "-std=c++23",
+                                              .preprocessed_source = "auto f() -> int { return 42; }\n",
+                                              .compiler_version    = distributed::get_compiler_version("g++"),
+                                          }));
+
+        const auto response = distributed::receive_response(*connection);
+        REQUIRE(response.has_value());
+        CHECK_EQ(response->status, distributed::Response::Status::COMPILED);
+
+        worker.request_stop();
+        worker.join();
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST_CASE("Compilation on several workers on localhost")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-distributed";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory / "include");
+
+        create_file(directory / "include" / "value.hpp", "#define VALUE 42\n");
+        create_file(directory / "good.cpp", "#include \"value.hpp\"\nauto f() -> int { return VALUE; }\n");
+        create_file(directory / "bad.cpp", "auto f() -> int { return undeclared; }\n");
+
+        const auto configuration = create_configuration();
+        const auto flags         = std::format("-std=c++23 -I{}", (directory / "include").native());
+
+        const auto first_address  = distributed::parse_address("unix:" + (directory / "1.sock").string());
+        const auto second_address = distributed::parse_address("unix:" + (directory / "2.sock").string());
+        REQUIRE(first_address.has_value());
+        REQUIRE(second_address.has_value());
+
+        const auto first_listener  = distributed::listen(*first_address);
+        const auto second_listener = distributed::listen(*second_address);
+        REQUIRE(first_listener.has_value());
+        REQUIRE(second_listener.has_value());
+
+        // Stopped and joined when the test case ends.
+        std::jthread first_worker([&](const std::stop_token stop_token)
+                                  { worker::serve(*first_listener, 1, stop_token); });
+        std::jthread second_worker([&](const std::stop_token stop_token)
+                                   { worker::serve(*second_listener, 1, stop_token); });
+
+        distributed::set_workers({
+            {.address = *first_address,  .max_num_of_jobs = 1},
+            {.address = *second_address, .max_num_of_jobs = 1},
+        });
+        CHECK_EQ(distributed::get_num_of_remote_jobs(), 2);
+
+        SUBCASE("Objects are sent back")
+        {
+            const auto result =
+                distributed::compile(directory / "good.cpp", directory / "good.o", flags, configuration);
+
+            REQUIRE(result.has_value());
+            CHECK(result->is_successful);
+            CHECK_GT(result->peak_memory_in_kilobytes, 0);
+            CHECK_GT(std::filesystem::file_size(directory / "good.o"), 0);
+        }
+
+        SUBCASE("Diagnostics are sent back")
+        {
+            const auto result = distributed::compile(directory / "bad.cpp", directory / "bad.o", flags, configuration);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->is_successful);
+            CHECK(result->compiler_output.contains("undeclared"));
+            CHECK_FALSE(std::filesystem::exists(directory / "bad.o"));
+        }
+
+        SUBCASE("Files that the workers cannot compile are compiled locally")
+        {
+            const auto pch_flags = flags + " -include value.hpp";
+
+            const auto result =
+                distributed::compile(directory / "good.cpp", directory / "good.o", pch_flags, configuration);
+
+            CHECK_FALSE(result.has_value());
+        }
+
+        distributed::set_workers({});
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST_CASE("Files are not preprocessed for a worker that just answered that it is busy")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-distributed-busy";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        create_file(directory / "main.cpp", "auto main() -> int {}\n");
+
+        // A compiler that records every invocation before running `g++`.
+        const auto compiler_path = directory / "counting-g++";
+        create_file(compiler_path,
+                    std::format("#!/bin/sh\necho >> {}\nexec g++ \"$@\"\n", (directory / "invocations").native()));
+        std::filesystem::permissions(
+            compiler_path, std::filesystem::perms::owner_exec, std::filesystem::perm_options::add);
+        const auto get_num_of_invocations = [&]
+        {
+            auto file = std::ifstream(directory / "invocations");
+            return std::ranges::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+        };
+
+        auto configuration     = create_configuration();
+        configuration.compiler = compiler_path.native();
+
+        const auto address = distributed::parse_address("unix:" + (directory / "busy.sock").string());
+        REQUIRE(address.has_value());
+        const auto listener = distributed::listen(*address);
+        REQUIRE(listener.has_value());
+        distributed::set_workers({{.address = *address, .max_num_of_jobs = 1}});
+
+        // A worker that is busy with the files of another client, and answers a single connection.
+        std::jthread busy_worker(
+            [&]
+            {
+                const distributed::Socket connection(accept(listener->get(), nullptr, nullptr));
+                distributed::receive_request(connection);
+                distributed::send_response(connection,
+                                           {
+                                               .status              = distributed::Response::Status::BUSY,
+                                               .compiler_output     = "",
+                                               .object_file         = "",
+                                               .duration_in_seconds = 0.0,
+                                           });
+            });
+
+        const auto compile = [&]
+        { return distributed::compile(directory / "main.cpp", directory / "main.o", "-std=c++23", configuration); };
+
+        CHECK_FALSE(compile().has_value());
+        const auto num_of_invocations = get_num_of_invocations();
+        CHECK_GT(num_of_invocations, 0);
+
+        CHECK_FALSE(compile().has_value());
+        CHECK_EQ(get_num_of_invocations(), num_of_invocations);
+
+        busy_worker.join();
+        distributed::set_workers({});
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST_CASE("Files are compiled locally when no worker is reachable")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-distributed-unreachable";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        create_file(directory / "main.cpp", "auto main() -> int {}\n");
+
+        const auto workers = distributed::parse_workers("unix:" + (directory / "missing.sock").string());
+        REQUIRE(workers.has_value());
+        distributed::set_workers(*workers);
+
+        const auto result =
+            distributed::compile(directory / "main.cpp", directory / "main.o", "-std=c++23", create_configuration());
+
+        CHECK_FALSE(result.has_value());
+
+        distributed::set_workers({});
+        std::filesystem::remove_all(directory);
+    }
+}
@@ -0,0 +1,100 @@
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+
+#include <sys/wait.h>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/events.hpp"
+#include "tests/parameters.hpp"
+
+static auto read_lines(std::FILE* const file) -> std::vector<std::string>
+{
+    std::rewind(file);
+
+    std::vector<std::string> lines;
+    std::string line;
+
+    for (auto character = std::fgetc(file); character != EOF; character = std::fgetc(file))
+    {
+        if (character == '\n')
+        {
+            lines.push_back(std::move(line));
+            line.clear();
+        }
+        else
+        {
+            line.push_back(static_cast<char>(character));
+        }
+    }
+
+    return lines;
+}
+
+TEST_SUITE("events" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("Every event is a JSON object on a line of its own")
+    {
+        auto* const output = std::tmpfile();
+        REQUIRE(output != nullptr);
+
+        events::enable(output);
+        events::emit("tu_finished",
+                     {
+                         {"file",        "main.cpp"         },
+                         {"success",     true               },
+                         {"duration_s",  1.5                },
+                         {"peak_rss_kb", std::int64_t{1024}},
+                     });
+
+        // Lines of concurrent events are not interleaved.
+        {
+            std::vector<std::jthread> threads;
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                threads.emplace_back(
+                    []
+                    {
+                        for (auto j = 0; j < 100; ++j)
+                        {
+                            events::emit("diagnostics", {{"output", std::string(1000, 'x')}});
+                        }
+                    });
+            }
+        }
+
+        events::disable();
+        events::emit("ignored");
+
+        const auto lines = read_lines(output);
+        std::fclose(output);
+
+        REQUIRE_EQ(lines.size(), 401);
+
+        const auto first_event = nlohmann::json::parse(lines.front());
+        CHECK_EQ(lines.front().find("{\"event\":\"tu_finished\",\"time_us\":"), 0);
+        CHECK_EQ(first_event["file"], "main.cpp");
+        CHECK_EQ(first_event["success"], true);
+        CHECK_EQ(first_event["duration_s"], 1.5);
+        CHECK_EQ(first_event["peak_rss_kb"], 1024);
+
+        for (const auto& line : lines)
+        {
+            CHECK(nlohmann::json::accept(line));
+        }
+    }
+
+    TEST_CASE("get_exit_code")
+    {
+        CHECK_EQ(events::get_exit_code(0), 0);
+        CHECK_EQ(events::get_exit_code(1 << 8), 1); // `exit(1)`.
+        CHECK_EQ(events::get_exit_code(SIGKILL), 128 + SIGKILL);
+    }
+}
@@ -0,0 +1,107 @@
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/explain.hpp"
+#include "tests/parameters.hpp"
+
+using Paths = std::vector<std::filesystem::path>;
+
+// `main.cpp` includes `a.hpp`, which includes `b.hpp`.
+// `other.cpp` included `removed.hpp` in the previous build.
+static auto create_build_info() -> build_caching::Info
+{
+    build_caching::Info build_info{};
+
+    build_info.dependency_graph.add_edge("a.hpp", "main.cpp");
+    build_info.dependency_graph.add_edge("b.hpp", "a.hpp");
+    build_info.dependency_graph.add_node("other.cpp");
+    build_info.dependency_graph.add_node("new.cpp");
+
+    build_info.old_dependency_graph.add_edge("a.hpp", "main.cpp");
+    build_info.old_dependency_graph.add_edge("b.hpp", "a.hpp");
+    build_info.old_dependency_graph.add_edge("removed.hpp", "other.cpp");
+
+    build_info.file_hashes     = {{"main.cpp", 1}, {"a.hpp", 2}, {"b.hpp", 3}, {"other.cpp", 4}, {"new.cpp", 5}};
+    build_info.old_file_hashes = {{"main.cpp", 1}, {"a.hpp", 2}, {"b.hpp", 3}, {"other.cpp", 4}};
+
+    return build_info;
+}
+
+TEST_SUITE("explain" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("A changed header is explained by the shortest include chain.")
+    {
+        auto build_info                 = create_build_info();
+        build_info.file_hashes["b.hpp"] = 30;
+        build_info.changed_files        = {"b.hpp"};
+        build_info.files_to_compile     = {"main.cpp"};
+
+        const auto reasons = explain::get_reasons(build_info);
+
+        REQUIRE_EQ(reasons.size(), 1);
+        CHECK_EQ(reasons.at("main.cpp").cause, explain::Cause::INCLUDED_FILE_CHANGED);
+        CHECK_EQ(reasons.at("main.cpp").include_chain, Paths{"main.cpp", "a.hpp", "b.hpp"});
+        CHECK_EQ(explain::to_string(reasons.at("main.cpp")), "'b.hpp' changed (main.cpp -> a.hpp -> b.hpp)");
+    }
+
+    TEST_CASE("Changes to the file itself are told apart.")
+    {
+        auto build_info                    = create_build_info();
+        build_info.file_hashes["main.cpp"] = 10;
+        build_info.changed_files           = {"main.cpp", "other.cpp", "new.cpp"};
+        build_info.files_to_compile        = {"main.cpp", "new.cpp", "other.cpp"};
+
+        const auto reasons = explain::get_reasons(build_info);
+
+        REQUIRE_EQ(reasons.size(), 3);
+        CHECK_EQ(reasons.at("main.cpp").cause, explain::Cause::CONTENTS_CHANGED);
+        CHECK_EQ(reasons.at("new.cpp").cause, explain::Cause::NEW_FILE);
+        CHECK_EQ(reasons.at("other.cpp").cause, explain::Cause::MISSING_OBJECT);
+    }
+
+    TEST_CASE("A removed include is reported.")
+    {
+        auto build_info             = create_build_info();
+        build_info.files_to_compile = {"other.cpp"};
+
+        const auto reasons = explain::get_reasons(build_info);
+
+        REQUIRE_EQ(reasons.size(), 1);
+        CHECK_EQ(reasons.at("other.cpp").cause, explain::Cause::DEPENDENCY_REMOVED);
+        CHECK_EQ(explain::to_string(reasons.at("other.cpp")), "it included 'removed.hpp', which was removed");
+    }
+
+    TEST_CASE("A configuration change names the fields that changed.")
+    {
+        auto build_info                         = create_build_info();
+        build_info.configuration_changed        = true;
+        build_info.changed_configuration_fields = {"optimization", "warnings"};
+        build_info.files_to_compile             = {"main.cpp", "new.cpp", "other.cpp"};
+
+        const auto reasons = explain::get_reasons(build_info);
+
+        REQUIRE_EQ(reasons.size(), 3);
+        CHECK_EQ(explain::to_string(reasons.at("new.cpp")),
+                 "the configuration changed ('optimization', 'warnings')");
+
+        build_info.is_first_build = true;
+        CHECK_EQ(explain::get_reasons(build_info).at("main.cpp").cause, explain::Cause::FIRST_BUILD);
+    }
+
+    TEST_CASE("'format_reasons' lists the outdated translation units.")
+    {
+        std::map<std::filesystem::path, explain::Reason> reasons;
+        reasons.emplace("main.cpp", explain::Reason{.cause = explain::Cause::CONTENTS_CHANGED});
+
+        CHECK_EQ(explain::format_reasons("debug", reasons, 3),
+                 "Configuration 'debug': 1 of 3 translation units are outdated.\n"
+                 "  main.cpp: its contents changed\n");
+        CHECK_EQ(explain::format_reasons("debug", {}, 3),
+                 "Configuration 'debug': all 3 translation units are up to date.\n");
+    }
+}
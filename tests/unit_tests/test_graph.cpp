@@ -225,4 +225,68 @@ TEST_SUITE("DirectedGraph class" * doctest::test_suite(test_type::unit))
             CHECK_EQ(*cycle, "b -> c -> b");
         }
     }
+
+    TEST_CASE("get_reversed")
+    {
+        SUBCASE("Edges are reversed")
+        {
+            utils::DirectedGraph<std::string> graph;
+            graph.add_edge("a", "b");
+            graph.add_edge("a", "c");
+            graph.add_edge("c", "d");
+
+            utils::DirectedGraph<std::string> expected;
+            expected.add_edge("b", "a");
+            expected.add_edge("c", "a");
+            expected.add_edge("d", "c");
+
+            CHECK_EQ(graph.get_reversed(), expected);
+        }
+
+        SUBCASE("Isolated nodes are kept")
+        {
+            utils::DirectedGraph<std::string> graph;
+            graph.add_node("a");
+
+            CHECK(graph.get_reversed().data().contains("a"));
+        }
+
+        SUBCASE("Reversing twice gives the original graph")
+        {
+            utils::DirectedGraph<std::string> graph;
+            graph.add_edge("a", "b");
+            graph.add_edge("b", "c");
+            graph.add_edge("d", "b");
+
+            CHECK_EQ(graph.get_reversed().get_reversed(), graph);
+        }
+    }
+
+    TEST_CASE("get_topological_levels")
+    {
+        SUBCASE("Empty graph")
+        {
+            utils::DirectedGraph<std::string> graph;
+
+            CHECK(graph.get_topological_levels().empty());
+        }
+
+        SUBCASE("Nodes are placed in the lowest possible level")
+        {
+            utils::DirectedGraph<std::string> graph;
+            graph.add_edge("a", "b");
+            graph.add_edge("b", "d");
+            graph.add_edge("c", "d");
+            graph.add_edge("a", "d");
+            graph.add_node("e");
+
+            const std::vector<std::vector<std::string>> expected{
+                {"a", "c", "e"},
+                {"b"},
+                {"d"},
+            };
+
+            CHECK_EQ(graph.get_topological_levels(), expected);
+        }
+    }
 }
@@ -0,0 +1,99 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/history.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("history" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("Records are appended and read back")
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "easy-make-test-history";
+        std::filesystem::remove_all(directory);
+
+        const std::vector<history::TranslationUnitRecord> records = {
+            {
+                .timestamp                = 1'700'000'000,
+                .configuration            = "debug",
+                .file                     = "source/parser.cpp",
+                .cause                    = "contents_changed",
+                .reason                   = "its contents changed",
+                .is_successful            = true,
+                .duration_in_seconds      = 1.5,
+                .peak_memory_in_kilobytes = 183'012,
+            },
+        };
+
+        history::append(directory, records);
+        history::append(directory,
+                        history::BuildRecord{
+                            .timestamp               = 1'700'000'000,
+                            .configuration           = "debug",
+                            .duration_in_seconds     = 2.0,
+                            .exit_status             = 0,
+                            .num_of_files_compiled   = 1,
+                            .num_of_files_up_to_date = 3,
+                        });
+
+        SUBCASE("Every record is read")
+        {
+            const auto build_history = history::read(directory);
+
+            REQUIRE_EQ(build_history.builds.size(), 1);
+            CHECK_EQ(build_history.builds[0].configuration, "debug");
+            CHECK_EQ(build_history.builds[0].duration_in_seconds, doctest::Approx(2.0));
+            CHECK_EQ(build_history.builds[0].num_of_files_compiled, 1);
+            CHECK_EQ(build_history.builds[0].num_of_files_up_to_date, 3);
+
+            REQUIRE_EQ(build_history.translation_units.size(), 1);
+            CHECK_EQ(build_history.translation_units[0].file, "source/parser.cpp");
+            CHECK_EQ(build_history.translation_units[0].cause, "contents_changed");
+            CHECK_EQ(build_history.translation_units[0].reason, "its contents changed");
+            CHECK(build_history.translation_units[0].is_successful);
+            CHECK_EQ(build_history.translation_units[0].duration_in_seconds, doctest::Approx(1.5));
+            CHECK_EQ(build_history.translation_units[0].peak_memory_in_kilobytes, 183'012);
+        }
+
+        SUBCASE("A full history is moved aside and still read")
+        {
+            std::filesystem::resize_file(history::get_history_file_path(directory), history::MAX_HISTORY_FILE_SIZE);
+
+            history::append(directory, records);
+
+            CHECK(std::filesystem::exists(history::get_old_history_file_path(directory)));
+            CHECK_LT(std::filesystem::file_size(history::get_history_file_path(directory)), 1024);
+
+            const auto build_history = history::read(directory);
+
+            CHECK_EQ(build_history.builds.size(), 1);
+            CHECK_EQ(build_history.translation_units.size(), 2);
+        }
+
+        SUBCASE("Incomplete lines are skipped")
+        {
+            {
+                auto history_file = std::ofstream(history::get_history_file_path(directory), std::ios::app);
+                history_file << "{\"type\":\"build\",\"timestamp\":17000\n";
+                history_file << "{\"type\":\"tu\",\"timestamp\":1700000000}\n";
+            }
+
+            const auto build_history = history::read(directory);
+
+            CHECK_EQ(build_history.builds.size(), 1);
+            CHECK_EQ(build_history.translation_units.size(), 1);
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST_CASE("A project without a history")
+    {
+        const auto build_history = history::read(std::filesystem::temp_directory_path() / "easy-make-test-no-history");
+
+        CHECK(build_history.builds.empty());
+        CHECK(build_history.translation_units.empty());
+    }
+}
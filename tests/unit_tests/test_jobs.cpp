@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/jobs.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("jobs" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("'run' returns the exit status of the command")
+    {
+        CHECK_EQ(jobs::run("true").exit_status, EXIT_SUCCESS);
+        CHECK_NE(jobs::run("false").exit_status, EXIT_SUCCESS);
+    }
+
+    TEST_CASE("'run' reports the peak memory of the command")
+    {
+        CHECK_GT(jobs::run("true").peak_memory_in_kilobytes, 0);
+    }
+
+    TEST_CASE("'run' stops the processes of a command that exceeds its time limit")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "easy-make-test-jobs-time-limit";
+        std::filesystem::remove(path);
+
+        // The shell waits for `sleep`, which is stopped with it.
+        const auto result = jobs::run("sleep 0.5; touch " + path.native(), {.max_seconds = 0.1});
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        CHECK(WIFSIGNALED(result.exit_status));
+        CHECK_LT(result.duration_in_seconds, 0.5);
+        CHECK_FALSE(std::filesystem::exists(path));
+    }
+
+    TEST_CASE("'run' stops a command that exceeds its memory limit")
+    {
+        // `tail` keeps the whole input in memory, since it has no newlines.
+        const auto result = jobs::run("head -c 1000000000 /dev/zero | tail > /dev/null",
+                                      {.max_memory_in_megabytes = 50});
+
+        CHECK(WIFSIGNALED(result.exit_status));
+        CHECK_GT(result.peak_memory_in_kilobytes, 50 * 1024);
+    }
+
+    TEST_CASE("'run' does not stop a command within its limits")
+    {
+        CHECK_EQ(jobs::run("true", {.max_seconds = 10, .max_memory_in_megabytes = 1024}).exit_status, EXIT_SUCCESS);
+    }
+
+    TEST_CASE("'run' does not exceed the maximum number of jobs")
+    {
+        jobs::set_max_num_of_jobs(2);
+
+        const auto start_time = std::chrono::steady_clock::now();
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                threads.emplace_back([] { CHECK_EQ(jobs::run("sleep 0.2").exit_status, EXIT_SUCCESS); });
+            }
+        }
+
+        const auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+
+        // Four jobs, at most two at a time.
+        CHECK_GE(elapsed_time, std::chrono::milliseconds(400));
+
+        jobs::set_max_num_of_jobs(std::numeric_limits<int>::max());
+    }
+}
@@ -0,0 +1,112 @@
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/linking.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "tests/parameters.hpp"
+
+using Strings = std::vector<std::string>;
+
+TEST_SUITE("linking" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_linker_flags")
+    {
+        SUBCASE("The default linker needs no flags")
+        {
+            CHECK(get_linker_flags("default", 8).empty());
+        }
+
+        SUBCASE("bfd is single-threaded")
+        {
+            CHECK_EQ(get_linker_flags("bfd", 8), Strings{"-fuse-ld=bfd"});
+        }
+
+        SUBCASE("gold")
+        {
+            CHECK_EQ(get_linker_flags("gold", 8), Strings{"-fuse-ld=gold", "-Wl,--threads", "-Wl,--thread-count=8"});
+        }
+
+        SUBCASE("lld")
+        {
+            CHECK_EQ(get_linker_flags("lld", 4), Strings{"-fuse-ld=lld", "-Wl,--threads=4"});
+        }
+
+        SUBCASE("mold")
+        {
+            CHECK_EQ(get_linker_flags("mold", 2), Strings{"-fuse-ld=mold", "-Wl,--thread-count=2"});
+        }
+    }
+
+    TEST_CASE("'detect_fastest_linker' returns a resolved linker")
+    {
+        const auto linker = detect_fastest_linker();
+
+        CHECK_NE(linker, "auto");
+        CHECK_EQ(detect_fastest_linker(), linker);
+    }
+
+    TEST_CASE("An up to date output is not linked again")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-link-signature";
+        const auto library_path = path_to_root / "libraries";
+        std::filesystem::remove_all(path_to_root);
+        std::filesystem::create_directories(library_path);
+        std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / "config");
+
+        // `main` calls a function of `libgreeting.a`, which is linked by name.
+        const auto create_library = [&](const std::string_view content)
+        {
+            std::ofstream(library_path / "greeting.cpp") << content;
+
+            const auto command = std::format("cd {} && g++ -c greeting.cpp -o greeting.o && ar rcs libgreeting.a "
+                                             "greeting.o && rm greeting.o",
+                                             library_path.native());
+            REQUIRE_EQ(std::system(command.c_str()), EXIT_SUCCESS);
+        };
+
+        create_library("auto greeting() -> int { return 0; }\n");
+        std::ofstream(path_to_root / "main.cpp") << "auto greeting() -> int;\n"
+                                                    "auto main() -> int { return greeting(); }\n";
+
+        Configuration configuration;
+        configuration.name        = "config";
+        configuration.compiler    = "g++";
+        configuration.output_name = "output.exe";
+        configuration.output_path = path_to_root.native();
+
+        REQUIRE_EQ(
+            compile_files(configuration, path_to_root, {path_to_root / "main.cpp"}, true, false, std::nullopt)
+                .num_of_failures,
+            0);
+
+        const auto output_path = path_to_root / "output.exe";
+        const auto flags       = std::vector<std::string>{std::format("-L{}", library_path.native()), "-lgreeting"};
+
+        REQUIRE(link_object_files(configuration, path_to_root, flags, {}, true));
+        const auto last_write_time = std::filesystem::last_write_time(output_path);
+
+        SUBCASE("Nothing changed")
+        {
+            REQUIRE(link_object_files(configuration, path_to_root, flags, {}, true));
+            CHECK_EQ(std::filesystem::last_write_time(output_path), last_write_time);
+        }
+
+        SUBCASE("A library that is linked by name changed")
+        {
+            create_library("auto greeting() -> int { return 0; }\nauto farewell() -> int { return 1; }\n");
+
+            REQUIRE(link_object_files(configuration, path_to_root, flags, {}, true));
+            CHECK_NE(std::filesystem::last_write_time(output_path), last_write_time);
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
+}
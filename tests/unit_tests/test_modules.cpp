@@ -0,0 +1,178 @@
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/modules/modules.hpp"
+#include "tests/parameters.hpp"
+#include "tests/unit_tests/utils/utils.hpp"
+
+using Paths   = std::vector<std::filesystem::path>;
+using Strings = std::vector<std::string>;
+
+TEST_SUITE("modules" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("scan_file")
+    {
+        const auto project_33_path = tests::utils::get_path_to_resources_project(33);
+
+        SUBCASE("Primary module interface")
+        {
+            const auto info = modules::scan_file(project_33_path / "math.cppm");
+
+            CHECK_EQ(info.provided_module, "math");
+            CHECK(info.is_interface);
+            CHECK_EQ(info.required_modules, Strings{"math:arithmetic"});
+            CHECK(info.header_units.empty());
+        }
+
+        SUBCASE("Partition")
+        {
+            const auto info = modules::scan_file(project_33_path / "math-arithmetic.cppm");
+
+            CHECK_EQ(info.provided_module, "math:arithmetic");
+            CHECK(info.is_interface);
+            CHECK(info.required_modules.empty());
+        }
+
+        SUBCASE("Implementation unit")
+        {
+            const auto info = modules::scan_file(project_33_path / "math.cpp");
+
+            CHECK_FALSE(info.provided_module.has_value());
+            CHECK_EQ(info.required_modules, Strings{"math"});
+        }
+
+        SUBCASE("Importer")
+        {
+            const auto info = modules::scan_file(project_33_path / "main.cpp");
+
+            CHECK_FALSE(info.provided_module.has_value());
+            CHECK_EQ(info.required_modules, Strings{"math"});
+            CHECK_EQ(info.header_units, Strings{"<iostream>", "\"config.hpp\""});
+        }
+    }
+
+    TEST_CASE("scan_files")
+    {
+        const auto project_33_path = tests::utils::get_path_to_resources_project(33);
+        const Paths code_files     = {
+            "config.hpp", "main.cpp", "math-arithmetic.cppm", "math.cpp", "math.cppm", "plain.cpp"};
+        modules::ScanCache scan_cache;
+        const auto module_infos = modules::scan_files(project_33_path, code_files, scan_cache);
+
+        CHECK_EQ(module_infos.size(), 4);
+        CHECK_FALSE(module_infos.contains("config.hpp"));
+        CHECK_FALSE(module_infos.contains("plain.cpp"));
+
+        SUBCASE("Every source file is recorded")
+        {
+            CHECK_EQ(scan_cache.size(), 5);
+            CHECK(scan_cache.contains("plain.cpp"));
+            CHECK_FALSE(scan_cache.contains("config.hpp"));
+        }
+
+        SUBCASE("Files whose contents did not change are not scanned again")
+        {
+            // A file that is recorded with its current hash keeps its recorded info.
+            scan_cache.at("plain.cpp").info.provided_module = "cached";
+
+            const auto cached_module_infos = modules::scan_files(project_33_path, code_files, scan_cache);
+
+            REQUIRE(cached_module_infos.contains("plain.cpp"));
+            CHECK_EQ(cached_module_infos.at("plain.cpp").provided_module, "cached");
+        }
+
+        SUBCASE("Files whose contents changed are scanned again")
+        {
+            ++scan_cache.at("math.cppm").hash;
+            scan_cache.at("math.cppm").info = {};
+
+            const auto rescanned_module_infos = modules::scan_files(project_33_path, code_files, scan_cache);
+
+            REQUIRE(rescanned_module_infos.contains("math.cppm"));
+            CHECK_EQ(rescanned_module_infos.at("math.cppm").provided_module, "math");
+        }
+
+        SUBCASE("Removed files are forgotten")
+        {
+            modules::scan_files(project_33_path, {"main.cpp"}, scan_cache);
+
+            CHECK_EQ(scan_cache.size(), 1);
+        }
+    }
+
+    TEST_CASE("The scan cache is written and read back")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-module-scan";
+        std::filesystem::remove_all(path_to_root);
+
+        const modules::ModuleInfo math_info{
+            .provided_module  = "math",
+            .is_interface     = true,
+            .required_modules = {"math:arithmetic"},
+            .header_units     = {"<vector>"},
+        };
+
+        modules::ScanCache scan_cache;
+        scan_cache["main.cpp"]  = {.hash = 1, .info = {}};
+        scan_cache["math.cppm"] = {.hash = 2, .info = math_info};
+
+        CHECK(modules::read_scan_cache("debug", path_to_root).empty());
+
+        modules::write_scan_cache("debug", path_to_root, scan_cache);
+        const auto read_scan_cache = modules::read_scan_cache("debug", path_to_root);
+
+        REQUIRE_EQ(read_scan_cache.size(), 2);
+        CHECK_EQ(read_scan_cache.at("main.cpp").hash, 1);
+        CHECK_FALSE(modules::uses_modules(read_scan_cache.at("main.cpp").info));
+        CHECK_EQ(read_scan_cache.at("math.cppm").hash, 2);
+        CHECK_EQ(read_scan_cache.at("math.cppm").info.provided_module, "math");
+        CHECK(read_scan_cache.at("math.cppm").info.is_interface);
+        CHECK_EQ(read_scan_cache.at("math.cppm").info.required_modules, Strings{"math:arithmetic"});
+        CHECK_EQ(read_scan_cache.at("math.cppm").info.header_units, Strings{"<vector>"});
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("get_module_graph")
+    {
+        std::unordered_map<std::filesystem::path, modules::ModuleInfo> module_infos;
+        module_infos["math.cppm"]            = {.provided_module  = "math",
+                                                .is_interface     = true,
+                                                .required_modules = {"math:arithmetic"},
+                                                .header_units     = {}};
+        module_infos["math-arithmetic.cppm"] = {
+            .provided_module = "math:arithmetic", .is_interface = true, .required_modules = {}, .header_units = {}};
+        module_infos["main.cpp"]             = {.provided_module  = std::nullopt,
+                                                .is_interface     = false,
+                                                .required_modules = {"math", "std"},
+                                                .header_units     = {}};
+
+        SUBCASE("Edges go from the provider to the importer")
+        {
+            const auto graph = modules::get_module_graph(module_infos);
+
+            REQUIRE(graph.has_value());
+            CHECK_EQ(graph->get_topological_levels(),
+                     std::vector<Paths>{{"math-arithmetic.cppm"}, {"math.cppm"}, {"main.cpp"}});
+        }
+
+        SUBCASE("Importing an unknown module is an error")
+        {
+            module_infos["main.cpp"].required_modules.push_back("geometry");
+
+            CHECK_FALSE(modules::get_module_graph(module_infos).has_value());
+        }
+
+        SUBCASE("Declaring a module twice is an error")
+        {
+            module_infos["other.cppm"] = {
+                .provided_module = "math", .is_interface = true, .required_modules = {}, .header_units = {}};
+
+            CHECK_FALSE(modules::get_module_graph(module_infos).has_value());
+        }
+    }
+}
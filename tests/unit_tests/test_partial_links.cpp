@@ -0,0 +1,149 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/build_state.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/partial_links/partial_links.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/utils.hpp"
+#include "tests/parameters.hpp"
+
+using Paths = std::vector<std::filesystem::path>;
+
+// Writes the source files (relative to `path_to_root`), each defining a function of its own, and compiles them.
+static auto compile(const Configuration& configuration,
+                    const std::filesystem::path& path_to_root,
+                    const Paths& source_files,
+                    const std::string& contents) -> void
+{
+    Paths files;
+
+    for (const auto& file : source_files)
+    {
+        std::filesystem::create_directories((path_to_root / file).parent_path());
+        const auto function = std::format("auto {}() -> int {{ return 1; }}\n", file.stem().native());
+        std::ofstream(path_to_root / file) << contents << function;
+        files.push_back(path_to_root / file);
+    }
+
+    REQUIRE_EQ(compile_files(configuration, path_to_root, files, true, false, std::nullopt).num_of_failures, 0);
+}
+
+TEST_SUITE("partial_links" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("group_by_directory")
+    {
+        SUBCASE("No files")
+        {
+            CHECK(partial_links::group_by_directory({}).empty());
+        }
+
+        SUBCASE("Files are grouped by their own directory")
+        {
+            const Paths source_files = {"main.cpp", "net/socket.cpp", "net/http/client.cpp", "net/dns.cpp", "util.cpp"};
+            const auto groups        = partial_links::group_by_directory(source_files);
+
+            const partial_links::Groups expected = {
+                {"",         {"main.cpp", "util.cpp"}          },
+                {"net",      {"net/dns.cpp", "net/socket.cpp"} },
+                {"net/http", {"net/http/client.cpp"}           },
+            };
+
+            CHECK_EQ(groups, expected);
+        }
+    }
+
+    TEST_CASE("update_partial_links")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-partial-links";
+        std::filesystem::remove_all(path_to_root);
+        std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / "config");
+
+        Configuration configuration;
+        configuration.name     = "config";
+        configuration.compiler = "g++";
+
+        const Paths source_files = {"net/dns.cpp", "net/socket.cpp", "util/log.cpp", "util/string.cpp"};
+        compile(configuration, path_to_root, source_files, "");
+
+        const auto object_files_directory  = path_to_root / params::BUILD_DIRECTORY_NAME / "config";
+        const auto partial_links_directory = object_files_directory / params::PARTIAL_LINKS_DIRECTORY_NAME;
+        const auto data_file_path          = object_files_directory / params::PARTIAL_LINKS_DATA_FILE_NAME;
+        const auto net_partial_link_name   = utils::get_object_file_name(path_to_root / "net");
+        const auto util_partial_link_name  = utils::get_object_file_name(path_to_root / "util");
+        const auto net_partial_link        = partial_links_directory / net_partial_link_name;
+        const auto util_partial_link       = partial_links_directory / util_partial_link_name;
+
+        const auto get_absolute_paths = [&](const Paths& files)
+        {
+            Paths result;
+
+            for (const auto& file : files)
+            {
+                result.push_back(path_to_root / file);
+            }
+
+            return result;
+        };
+
+        const auto link_inputs = partial_links::update_partial_links(
+            configuration, path_to_root, get_absolute_paths(source_files));
+
+        REQUIRE(link_inputs.has_value());
+        CHECK_EQ(*link_inputs, Paths{net_partial_link, util_partial_link});
+
+        const auto net_write_time  = std::filesystem::last_write_time(net_partial_link);
+        const auto util_write_time = std::filesystem::last_write_time(util_partial_link);
+
+        SUBCASE("A group whose members did not change is not linked again")
+        {
+            REQUIRE(
+                partial_links::update_partial_links(configuration, path_to_root, get_absolute_paths(source_files))
+                    .has_value());
+
+            CHECK_EQ(std::filesystem::last_write_time(net_partial_link), net_write_time);
+            CHECK_EQ(std::filesystem::last_write_time(util_partial_link), util_write_time);
+        }
+
+        SUBCASE("A group whose member changed is linked again")
+        {
+            compile(configuration, path_to_root, {"net/dns.cpp"}, "static int cache = 0;\n");
+
+            REQUIRE(
+                partial_links::update_partial_links(configuration, path_to_root, get_absolute_paths(source_files))
+                    .has_value());
+
+            CHECK_NE(std::filesystem::last_write_time(net_partial_link), net_write_time);
+            CHECK_EQ(std::filesystem::last_write_time(util_partial_link), util_write_time);
+        }
+
+        SUBCASE("The partial link of a removed directory is deleted")
+        {
+            for (const auto& file : {"util/log.cpp", "util/string.cpp"})
+            {
+                std::filesystem::remove(object_files_directory / utils::get_object_file_name(path_to_root / file));
+            }
+
+            const auto remaining_inputs = partial_links::update_partial_links(
+                configuration, path_to_root, get_absolute_paths({"net/dns.cpp", "net/socket.cpp"}));
+
+            REQUIRE(remaining_inputs.has_value());
+            CHECK_EQ(*remaining_inputs, Paths{net_partial_link});
+            CHECK_FALSE(std::filesystem::exists(util_partial_link));
+
+            const auto signatures = build_state::read_data_file(data_file_path);
+            REQUIRE(signatures.has_value());
+            CHECK(signatures->contains(net_partial_link_name));
+            CHECK_FALSE(signatures->contains(util_partial_link_name));
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
+}
@@ -0,0 +1,165 @@
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/build_state.hpp"
+#include "source/commands/build/precompiled_headers/precompiled_headers.hpp"
+#include "tests/parameters.hpp"
+
+using Paths = std::vector<std::filesystem::path>;
+
+// common.hpp <- core.hpp <- {a.cpp, b.cpp, c.cpp, d.cpp}
+// rare.hpp <- a.cpp
+static auto create_graph() -> build_caching::DependencyGraph
+{
+    build_caching::DependencyGraph graph;
+    graph.add_edge("common.hpp", "core.hpp");
+
+    for (const auto* source_file : {"a.cpp", "b.cpp", "c.cpp", "d.cpp"})
+    {
+        graph.add_edge("core.hpp", source_file);
+    }
+
+    graph.add_edge("rare.hpp", "a.cpp");
+
+    return graph;
+}
+
+TEST_SUITE("precompiled_headers" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_included_closure")
+    {
+        const auto graph = create_graph();
+
+        CHECK_EQ(precompiled_headers::get_included_closure(graph, {"core.hpp"}), Paths{"common.hpp", "core.hpp"});
+        CHECK_EQ(precompiled_headers::get_included_closure(graph, {"a.cpp"}),
+                 Paths{"a.cpp", "common.hpp", "core.hpp", "rare.hpp"});
+        CHECK_EQ(precompiled_headers::get_included_closure(graph, {}), Paths{});
+    }
+
+    TEST_CASE("select_headers")
+    {
+        const auto graph = create_graph();
+
+        SUBCASE("Headers with a high fan-out are selected")
+        {
+            const auto headers = precompiled_headers::select_headers(graph, 4, {}, {});
+
+            CHECK_EQ(headers, Paths{"common.hpp", "core.hpp"});
+        }
+
+        SUBCASE("Headers that depend on unstable files are skipped")
+        {
+            CHECK_EQ(precompiled_headers::select_headers(graph, 4, {}, {"common.hpp"}), Paths{});
+            CHECK_EQ(precompiled_headers::select_headers(graph, 4, {}, {"core.hpp"}), Paths{"common.hpp"});
+        }
+
+        SUBCASE("Unstable source files do not affect headers")
+        {
+            CHECK_EQ(precompiled_headers::select_headers(graph, 4, {}, {"a.cpp"}), Paths{"common.hpp", "core.hpp"});
+        }
+
+        SUBCASE("No headers in a small project")
+        {
+            build_caching::DependencyGraph small_graph;
+            small_graph.add_edge("f.hpp", "f.cpp");
+
+            CHECK_EQ(precompiled_headers::select_headers(small_graph, 1, {}, {}), Paths{});
+        }
+
+        SUBCASE("Fan-out threshold grows with the number of source files")
+        {
+            // With 40 translation units a header must be included by at least 10 of them.
+            CHECK_EQ(precompiled_headers::select_headers(graph, 40, {}, {}), Paths{});
+        }
+
+        SUBCASE("Compilation times do not change the selection when all headers fit")
+        {
+            const std::unordered_map<std::filesystem::path, double> compilation_times{
+                {"a.cpp", 10.0},
+                {"b.cpp", 0.1 },
+            };
+
+            CHECK_EQ(precompiled_headers::select_headers(graph, 4, compilation_times, {}),
+                     Paths{"common.hpp", "core.hpp"});
+        }
+    }
+
+    TEST_CASE("A header whose cooldown expired does not change a valid PCH")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-precompiled-headers";
+        std::filesystem::remove_all(path_to_root);
+        std::filesystem::create_directories(path_to_root);
+
+        // common.hpp <- core.hpp <- {a.cpp, b.cpp, c.cpp, d.cpp}
+        // util.hpp <- {a.cpp, b.cpp, c.cpp, d.cpp}
+        build_caching::Info build_info{};
+        build_info.dependency_graph.add_edge("common.hpp", "core.hpp");
+        build_info.file_hashes = {
+            {"common.hpp", 1},
+            {"core.hpp",   1},
+            {"util.hpp",   1},
+        };
+
+        for (const auto* source_file : {"a.cpp", "b.cpp", "c.cpp", "d.cpp"})
+        {
+            build_info.dependency_graph.add_edge("core.hpp", source_file);
+            build_info.dependency_graph.add_edge("util.hpp", source_file);
+            build_info.file_hashes[source_file] = 1;
+        }
+
+        std::ofstream(path_to_root / "common.hpp") << "#pragma once\n";
+        std::ofstream(path_to_root / "core.hpp") << "#pragma once\n#include \"common.hpp\"\n";
+        std::ofstream(path_to_root / "util.hpp") << "#pragma once\n";
+
+        Configuration configuration{};
+        configuration.name                = "test";
+        configuration.compiler            = "g++";
+        configuration.precompiled_headers = true;
+
+        const auto build = [&](const Paths& changed_files)
+        {
+            build_info.changed_files = changed_files;
+
+            for (const auto& file : changed_files)
+            {
+                ++build_info.file_hashes[file];
+            }
+
+            const auto result =
+                precompiled_headers::handle_precompiled_headers(configuration, path_to_root, build_info, true);
+            REQUIRE(result.has_value());
+
+            return *result;
+        };
+
+        const auto first_build = build({});
+        CHECK_EQ(first_build.headers, Paths{"common.hpp", "core.hpp", "util.hpp"});
+        CHECK(first_build.requires_full_rebuild);
+
+        // Editing `util.hpp` rebuilds the PCH without it.
+        const auto edit_build = build({"util.hpp"});
+        CHECK_EQ(edit_build.headers, Paths{"common.hpp", "core.hpp"});
+        CHECK(edit_build.requires_full_rebuild);
+
+        // The cooldown of `util.hpp` expires, but adding it back would recompile every file.
+        for (auto i = 0; i <= build_state::STABILITY_WINDOW; ++i)
+        {
+            const auto unchanged_build = build({});
+            CHECK_EQ(unchanged_build.headers, Paths{"common.hpp", "core.hpp"});
+            CHECK_FALSE(unchanged_build.requires_full_rebuild);
+        }
+
+        // Once the PCH is rebuilt anyway, `util.hpp` is added back.
+        const auto core_edit_build = build({"core.hpp"});
+        CHECK_EQ(core_edit_build.headers, Paths{"common.hpp", "util.hpp"});
+        CHECK(core_edit_build.requires_full_rebuild);
+
+        std::filesystem::remove_all(path_to_root);
+    }
+}
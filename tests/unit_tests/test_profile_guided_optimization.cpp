@@ -0,0 +1,75 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/build/profile_guided_optimization/profile_guided_optimization.hpp"
+#include "tests/parameters.hpp"
+
+using Strings = std::vector<std::string>;
+
+TEST_SUITE("profile_guided_optimization" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_instrumented_configuration")
+    {
+        Configuration configuration;
+        configuration.name              = "release";
+        configuration.parent            = "base";
+        configuration.compiler          = "clang++";
+        configuration.output_name       = "app";
+        configuration.compilation_flags = {"-march=native"};
+        configuration.profile           = "/project/easy-make-build/release/profile/default.profdata";
+
+        const auto instrumented_configuration =
+            profile_guided_optimization::get_instrumented_configuration(configuration, "/project");
+
+        CHECK_EQ(instrumented_configuration.name, "release-instrumented");
+        CHECK_EQ(instrumented_configuration.output_name, "app-instrumented");
+        CHECK_FALSE(instrumented_configuration.parent.has_value());
+        CHECK_FALSE(instrumented_configuration.profile.has_value());
+        CHECK_EQ(instrumented_configuration.compilation_flags,
+                 Strings{"-march=native",
+                         "-fprofile-generate=/project/easy-make-build/release-instrumented/raw-profile"});
+        CHECK_EQ(instrumented_configuration.link_flags,
+                 Strings{"-fprofile-generate=/project/easy-make-build/release-instrumented/raw-profile"});
+    }
+
+    TEST_CASE("get_profile_path")
+    {
+        Configuration configuration;
+        configuration.name     = "release";
+        configuration.compiler = "clang++-18";
+
+        CHECK_EQ(profile_guided_optimization::get_profile_path(configuration, "/project"),
+                 "/project/easy-make-build/release/profile/default.profdata");
+
+        configuration.compiler = "g++";
+        CHECK_EQ(profile_guided_optimization::get_profile_path(configuration, "/project"),
+                 "/project/easy-make-build/release/profile");
+    }
+
+    TEST_CASE("get_profile_file_name")
+    {
+        const auto instrumented_directory = std::filesystem::path("/project/easy-make-build/release-instrumented");
+        const auto directory              = std::filesystem::path("/project/easy-make-build/release");
+
+        SUBCASE("Profile data of an instrumented object file")
+        {
+            const auto raw_profile_file_name = "#project#easy-make-build#release-instrumented#src-main.cpp.gcda";
+            const auto profile_file_name     = profile_guided_optimization::get_profile_file_name(
+                raw_profile_file_name, instrumented_directory, directory);
+
+            CHECK_EQ(profile_file_name, "#project#easy-make-build#release#src-main.cpp.gcda");
+        }
+
+        SUBCASE("Other profile data is kept as is")
+        {
+            const auto raw_profile_file_name = "#project#easy-make-build#debug#main.cpp.gcda";
+            const auto profile_file_name     = profile_guided_optimization::get_profile_file_name(
+                raw_profile_file_name, instrumented_directory, directory);
+
+            CHECK_EQ(profile_file_name, raw_profile_file_name);
+        }
+    }
+}
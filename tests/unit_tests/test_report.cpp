@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/commands/report/report.hpp"
+#include "tests/parameters.hpp"
+
+static constexpr std::int64_t DAY_IN_SECONDS = 24 * 60 * 60;
+static constexpr std::int64_t FIRST_DAY      = 1'700'006'400; // 2023-11-15, 00:00 UTC.
+
+static auto create_compilation(const std::filesystem::path& file,
+                               const double duration_in_seconds,
+                               const std::string& cause     = "contents_changed",
+                               const std::int64_t timestamp = FIRST_DAY) -> history::TranslationUnitRecord
+{
+    return {
+        .timestamp                = timestamp,
+        .configuration            = "debug",
+        .file                     = file,
+        .cause                    = cause,
+        .reason                   = "",
+        .is_successful            = true,
+        .duration_in_seconds      = duration_in_seconds,
+        .peak_memory_in_kilobytes = 1024,
+    };
+}
+
+static auto create_build(const std::int64_t timestamp) -> history::BuildRecord
+{
+    return {
+        .timestamp             = timestamp,
+        .configuration         = "debug",
+        .duration_in_seconds   = 1.0,
+        .exit_status           = EXIT_SUCCESS,
+        .num_of_files_compiled = 1,
+    };
+}
+
+TEST_SUITE("report" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("get_slowest_translation_units")
+    {
+        const std::vector records = {
+            create_compilation("a.cpp", 5.0),
+            create_compilation("b.cpp", 2.0),
+            create_compilation("a.cpp", 1.0), // The latest compilation counts.
+        };
+
+        const auto slowest = report::get_slowest_translation_units(records);
+
+        REQUIRE_EQ(slowest.size(), 2);
+        CHECK_EQ(slowest[0].file, "b.cpp");
+        CHECK_EQ(slowest[0].duration_in_seconds, doctest::Approx(2.0));
+        CHECK_EQ(slowest[1].file, "a.cpp");
+        CHECK_EQ(slowest[1].duration_in_seconds, doctest::Approx(1.0));
+        CHECK_EQ(slowest[1].peak_memory_in_kilobytes, 1024);
+    }
+
+    TEST_CASE("get_growing_translation_units")
+    {
+        std::vector<history::TranslationUnitRecord> records;
+
+        for (const auto duration : {1.0, 1.1, 1.0, 1.5, 2.0, 2.1})
+        {
+            records.push_back(create_compilation("growing.cpp", duration));
+        }
+
+        for (const auto duration : {1.0, 1.2, 0.9, 1.1, 1.0, 1.05})
+        {
+            records.push_back(create_compilation("stable.cpp", duration));
+        }
+
+        // Too few compilations to tell.
+        records.push_back(create_compilation("new.cpp", 1.0));
+        records.push_back(create_compilation("new.cpp", 3.0));
+
+        const auto growing = report::get_growing_translation_units(records);
+
+        REQUIRE_EQ(growing.size(), 1);
+        CHECK_EQ(growing[0].file, "growing.cpp");
+        CHECK_EQ(growing[0].old_duration_in_seconds, doctest::Approx(1.05));
+        CHECK_EQ(growing[0].new_duration_in_seconds, doctest::Approx(2.05));
+        CHECK_EQ(growing[0].num_of_compilations, 6);
+    }
+
+    TEST_CASE("get_most_rebuilt_translation_units")
+    {
+        // `b.cpp` is up to date in the second and the fourth build, and `c.cpp` is added in the third one.
+        const std::vector builds = {
+            create_build(FIRST_DAY),
+            create_build(FIRST_DAY + 1),
+            create_build(FIRST_DAY + 2),
+            create_build(FIRST_DAY + 3),
+        };
+        const std::vector records = {
+            create_compilation("a.cpp", 1.0, "first_build", FIRST_DAY),
+            create_compilation("b.cpp", 1.0, "first_build", FIRST_DAY),
+            create_compilation("a.cpp", 1.0, "included_file_changed", FIRST_DAY + 1),
+            create_compilation("a.cpp", 1.0, "included_file_changed", FIRST_DAY + 2),
+            create_compilation("b.cpp", 1.0, "contents_changed", FIRST_DAY + 2),
+            create_compilation("c.cpp", 1.0, "new_file", FIRST_DAY + 2),
+            create_compilation("a.cpp", 1.0, "contents_changed", FIRST_DAY + 3),
+            create_compilation("c.cpp", 1.0, "contents_changed", FIRST_DAY + 3),
+        };
+
+        const auto rebuilt = report::get_most_rebuilt_translation_units(builds, records);
+
+        REQUIRE_EQ(rebuilt.size(), 3);
+        CHECK_EQ(rebuilt[0].file, "a.cpp");
+        CHECK_EQ(rebuilt[0].num_of_rebuilds, 3);
+        CHECK_EQ(rebuilt[0].num_of_builds, 3);
+        CHECK_EQ(rebuilt[0].most_common_cause, "included_file_changed");
+        CHECK_EQ(rebuilt[1].file, "c.cpp");
+        CHECK_EQ(rebuilt[1].num_of_rebuilds, 2);
+        CHECK_EQ(rebuilt[1].num_of_builds, 2);
+        CHECK_EQ(rebuilt[2].file, "b.cpp");
+        CHECK_EQ(rebuilt[2].num_of_rebuilds, 1);
+        CHECK_EQ(rebuilt[2].num_of_builds, 3);
+    }
+
+    TEST_CASE("get_build_trends")
+    {
+        const std::vector<history::BuildRecord> records = {
+            {.timestamp             = FIRST_DAY,
+             .configuration         = "release",
+             .duration_in_seconds   = 10.0,
+             .exit_status           = EXIT_SUCCESS,
+             .num_of_files_compiled = 4},
+            {.timestamp             = FIRST_DAY + 60,
+             .configuration         = "release",
+             .duration_in_seconds   = 20.0,
+             .exit_status           = EXIT_SUCCESS,
+             .num_of_files_compiled = 2},
+            {.timestamp             = FIRST_DAY + DAY_IN_SECONDS,
+             .configuration         = "release",
+             .duration_in_seconds   = 5.0,
+             .exit_status           = EXIT_FAILURE,
+             .num_of_files_compiled = 1},
+            {.timestamp             = FIRST_DAY,
+             .configuration         = "debug",
+             .duration_in_seconds   = 3.0,
+             .exit_status           = EXIT_SUCCESS,
+             .num_of_files_compiled = 1},
+        };
+
+        const auto trends = report::get_build_trends(records);
+
+        REQUIRE_EQ(trends.size(), 3);
+        CHECK_EQ(trends[0].configuration, "debug");
+        CHECK_EQ(trends[1].configuration, "release");
+        CHECK_EQ(trends[1].date, "2023-11-15");
+        CHECK_EQ(trends[1].num_of_builds, 2);
+        CHECK_EQ(trends[1].average_duration_in_seconds, doctest::Approx(15.0));
+        CHECK_EQ(trends[1].average_num_of_files_compiled, doctest::Approx(3.0));
+        CHECK_EQ(trends[2].date, "2023-11-16");
+        CHECK_EQ(trends[2].num_of_builds, 1);
+    }
+
+    TEST_CASE("A project without a history")
+    {
+        std::ostringstream output;
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-no-report";
+
+        CHECK_EQ(commands::report({.configuration_name = "debug", .show_all_entries = false}, path_to_root, output),
+                 EXIT_SUCCESS);
+        CHECK_EQ(output.str(), "No builds of configuration 'debug' were recorded.\n");
+    }
+}
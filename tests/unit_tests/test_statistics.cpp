@@ -0,0 +1,47 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_caching/build_caching.hpp"
+#include "source/commands/build/statistics.hpp"
+#include "tests/parameters.hpp"
+#include "tests/unit_tests/utils/utils.hpp"
+
+TEST_SUITE("statistics" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("Hashing a file is counted")
+    {
+        const auto path = tests::utils::get_path_to_resources_project(6) / "f_1.cpp";
+
+        const auto files_hashed_before = statistics::get(statistics::Counter::FILES_HASHED);
+        const auto bytes_read_before   = statistics::get(statistics::Counter::BYTES_READ);
+
+        std::string buffer;
+        build_caching::hash_file_contents(path, buffer);
+
+        CHECK_EQ(statistics::get(statistics::Counter::FILES_HASHED), files_hashed_before + 1);
+        CHECK_EQ(statistics::get(statistics::Counter::BYTES_READ),
+                 bytes_read_before + static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    }
+
+    TEST_CASE("Counters are written as JSON")
+    {
+        statistics::add(statistics::Counter::TRANSLATION_UNITS_COMPILED, 3);
+
+        const auto path = std::filesystem::temp_directory_path() / "easy-make-test-statistics.json";
+        REQUIRE(statistics::write(path));
+
+        auto file       = std::ifstream(path);
+        const auto json = nlohmann::json::parse(file);
+
+        CHECK_GE(json["counters"]["translation_units_compiled"].get<std::int64_t>(), 3);
+        CHECK(json["counters"].contains("pool_queue_wait_us"));
+        CHECK_GT(json["peak_rss_kb"].get<long>(), 0);
+
+        std::filesystem::remove(path);
+    }
+}
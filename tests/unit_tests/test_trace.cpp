@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/trace.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("trace" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("Spans are written as Chrome trace events")
+    {
+        trace::enable();
+
+        {
+            trace::Span span("Compile", "compile", {{"file", "main.cpp"}});
+            span.add_argument("peak_rss_kb", 1024);
+        }
+
+        // Spans of another thread are drawn in another lane.
+        std::jthread([] { const trace::Span span("Link", "link"); }).join();
+
+        const auto trace_path = std::filesystem::temp_directory_path() / "easy-make-test-trace.json";
+        REQUIRE(trace::write(trace_path));
+
+        auto trace_file       = std::ifstream(trace_path);
+        const auto events     = nlohmann::json::parse(trace_file)["traceEvents"];
+        const auto find_event = [&](const std::string& name)
+        {
+            return *std::ranges::find_if(events, [&](const auto& event) { return event["name"] == name; });
+        };
+
+        const auto compile_event = find_event("Compile");
+        CHECK_EQ(compile_event["ph"], "X");
+        CHECK_EQ(compile_event["cat"], "compile");
+        CHECK_EQ(compile_event["args"]["file"], "main.cpp");
+        CHECK_EQ(compile_event["args"]["peak_rss_kb"], 1024);
+        CHECK_GE(compile_event["dur"].get<std::int64_t>(), 0);
+
+        const auto link_event = find_event("Link");
+        CHECK_NE(link_event["tid"], compile_event["tid"]);
+
+        std::filesystem::remove(trace_path);
+    }
+
+    TEST_CASE("Total durations are summed by name until cleared")
+    {
+        trace::enable();
+        trace::clear();
+
+        {
+            const trace::Span span_1("Hash files", "analysis");
+            const trace::Span span_2("Hash files", "analysis");
+            const trace::Span span_3("Link", "link");
+        }
+
+        const auto durations = trace::get_total_durations();
+        CHECK_EQ(durations.size(), 2);
+        CHECK(durations.contains("Hash files"));
+        CHECK(durations.contains("Link"));
+
+        trace::clear();
+        CHECK(trace::get_total_durations().empty());
+    }
+}
@@ -0,0 +1,258 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+#include "third_party/nlohmann/json.hpp"
+
+#include "source/commands/build/build_caching/dependency_graph.hpp"
+#include "source/commands/build/compilation/compilation.hpp"
+#include "source/commands/build/unity_build/unity_build.hpp"
+#include "source/configuration_parsing/configuration.hpp"
+#include "source/parameters/parameters.hpp"
+#include "source/utils/utils.hpp"
+#include "tests/parameters.hpp"
+#include "tests/unit_tests/utils/utils.hpp"
+
+using Paths = std::vector<std::filesystem::path>;
+
+// a.hpp <- {x_1.cpp, y_2.cpp}
+// b.hpp <- {x_2.cpp, y_1.cpp}
+static auto create_graph() -> build_caching::DependencyGraph
+{
+    build_caching::DependencyGraph graph;
+    graph.add_edge("a.hpp", "x_1.cpp");
+    graph.add_edge("a.hpp", "y_2.cpp");
+    graph.add_edge("b.hpp", "x_2.cpp");
+    graph.add_edge("b.hpp", "y_1.cpp");
+
+    return graph;
+}
+
+static const Paths ALL_FILES = {"x_1.cpp", "x_2.cpp", "y_1.cpp", "y_2.cpp"};
+
+static auto create_unity_configuration(const std::string& name) -> Configuration
+{
+    Configuration configuration{};
+    configuration.name     = name;
+    configuration.compiler = "g++";
+    configuration.unity    = true;
+    std::filesystem::create_directories(params::BUILD_DIRECTORY_NAME / name);
+
+    return configuration;
+}
+
+// {a, b, c, d}.cpp include common.hpp and are batched. `single.cpp` and `shared.cpp` were edited recently,
+// so they are compiled on their own.
+static auto create_unity_project(const std::filesystem::path& path_to_root,
+                                 const std::string& configuration_name,
+                                 const std::string& single_source) -> build_caching::Info
+{
+    std::filesystem::remove_all(path_to_root);
+    std::filesystem::create_directories(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name);
+
+    build_caching::Info build_info{};
+    std::ofstream(path_to_root / "common.hpp") << "#pragma once\n";
+    build_info.file_hashes["common.hpp"] = 0;
+
+    for (const auto name : {"a", "b", "c", "d"})
+    {
+        const auto file = std::format("{}.cpp", name);
+        std::ofstream(path_to_root / file) << "#include \"common.hpp\"\n"
+                                           << std::format("auto {}() -> int {{ return 1; }}\n", name);
+        build_info.file_hashes[file] = 0;
+        build_info.dependency_graph.add_edge("common.hpp", file);
+    }
+
+    std::ofstream(path_to_root / "single.cpp") << single_source;
+    std::ofstream(path_to_root / "shared.cpp") << "auto shared() -> int { return 2; }\n";
+    build_info.file_hashes["single.cpp"] = 0;
+    build_info.file_hashes["shared.cpp"] = 0;
+
+    std::ofstream(path_to_root / params::BUILD_DIRECTORY_NAME / configuration_name /
+                  params::UNITY_BUILD_DATA_FILE_NAME)
+        << R"({"nextBatchId": 0, "batches": {}, "recentlyEditedFiles": {"single.cpp": 2, "shared.cpp": 2},)"
+        << R"( "isolatedFiles": {}})";
+
+    return build_info;
+}
+
+TEST_SUITE("unity_build" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("group_into_batches")
+    {
+        const auto graph = create_graph();
+
+        SUBCASE("Files that share headers are batched together")
+        {
+            const auto batches = unity_build::group_into_batches(graph, ALL_FILES, {}, 2.0, {});
+
+            REQUIRE_EQ(batches.size(), 2);
+            CHECK_EQ(batches[0].files, Paths{"x_1.cpp", "y_2.cpp"});
+            CHECK_EQ(batches[1].files, Paths{"x_2.cpp", "y_1.cpp"});
+            CHECK(batches[0].source_file.empty());
+            CHECK(batches[1].source_file.empty());
+        }
+
+        SUBCASE("Batches are limited by cost")
+        {
+            CHECK(unity_build::group_into_batches(graph, ALL_FILES, {}, 1.5, {}).empty());
+
+            const std::unordered_map<std::filesystem::path, double> costs{
+                {"x_1.cpp", 0.5},
+                {"y_2.cpp", 0.5},
+            };
+
+            const auto batches = unity_build::group_into_batches(graph, ALL_FILES, costs, 1.5, {});
+
+            REQUIRE_EQ(batches.size(), 1);
+            CHECK_EQ(batches[0].files, Paths{"x_1.cpp", "y_2.cpp"});
+        }
+
+        SUBCASE("Batches are limited by size")
+        {
+            build_caching::DependencyGraph large_graph;
+            Paths files;
+
+            for (auto i = 0; i < 40; ++i)
+            {
+                files.push_back(std::format("f_{:02}.cpp", i));
+                large_graph.add_edge("common.hpp", files.back());
+            }
+
+            const auto batches = unity_build::group_into_batches(large_graph, files, {}, 100.0, {});
+
+            REQUIRE_EQ(batches.size(), 2);
+            CHECK_EQ(batches[0].files.size(), unity_build::MAX_FILES_PER_BATCH);
+            CHECK_EQ(batches[1].files.size(), files.size() - unity_build::MAX_FILES_PER_BATCH);
+        }
+
+        SUBCASE("Previous batches are kept")
+        {
+            const std::vector<unity_build::Batch> previous_batches{
+                {.source_file = "unity-0.cpp", .files = {"x_1.cpp", "x_2.cpp"}},
+            };
+
+            const auto batches = unity_build::group_into_batches(graph, ALL_FILES, {}, 2.0, previous_batches);
+
+            REQUIRE_EQ(batches.size(), 2);
+            CHECK_EQ(batches[0].source_file, "unity-0.cpp");
+            CHECK_EQ(batches[0].files, Paths{"x_1.cpp", "x_2.cpp"});
+            CHECK(batches[1].source_file.empty());
+            CHECK_EQ(batches[1].files, Paths{"y_1.cpp", "y_2.cpp"});
+        }
+
+        SUBCASE("Files that are no longer candidates leave their batch")
+        {
+            const std::vector<unity_build::Batch> previous_batches{
+                {.source_file = "unity-0.cpp", .files = {"x_1.cpp", "x_2.cpp", "y_1.cpp"}},
+            };
+
+            const auto batches =
+                unity_build::group_into_batches(graph, {"x_1.cpp", "x_2.cpp", "y_2.cpp"}, {}, 3.0, previous_batches);
+
+            REQUIRE_EQ(batches.size(), 1);
+            CHECK_EQ(batches[0].source_file, "unity-0.cpp");
+            CHECK_EQ(batches[0].files, Paths{"x_1.cpp", "x_2.cpp", "y_2.cpp"});
+        }
+
+        SUBCASE("A batch with a single file left is dissolved")
+        {
+            const std::vector<unity_build::Batch> previous_batches{
+                {.source_file = "unity-0.cpp", .files = {"x_1.cpp", "y_1.cpp"}},
+            };
+
+            const auto batches =
+                unity_build::group_into_batches(graph, {"x_1.cpp", "y_2.cpp"}, {}, 2.0, previous_batches);
+
+            REQUIRE_EQ(batches.size(), 1);
+            CHECK(batches[0].source_file.empty());
+            CHECK_EQ(batches[0].files, Paths{"x_1.cpp", "y_2.cpp"});
+        }
+    }
+
+    TEST_CASE("compile_in_batches counts the files that fail to compile on their own")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-unity-failures";
+        const Paths all_files   = {"a.cpp", "b.cpp", "c.cpp", "d.cpp", "shared.cpp", "single.cpp"};
+
+        SUBCASE("A file that fails to compile is a failure, even though its memory is known")
+        {
+            auto build_info = create_unity_project(
+                path_to_root, "unity-failing", "auto single() -> int { return undeclared; }\n");
+            const tests::utils::CurrentPathGuard guard(path_to_root);
+
+            const auto result = unity_build::compile_in_batches(
+                create_unity_configuration("unity-failing"), ".", build_info, all_files, true, false, std::nullopt);
+
+            CHECK_EQ(result.num_of_failures, 1);
+            CHECK_FALSE(result.compilation_times.contains("single.cpp"));
+            CHECK(result.peak_memory_in_kilobytes.contains("single.cpp"));
+            CHECK(result.compilation_times.contains("a.cpp"));
+        }
+
+        SUBCASE("A file whose object file is shared is not a failure, even though its memory is unknown")
+        {
+            auto build_info = create_unity_project(
+                path_to_root, "unity-sharing", "auto single() -> int { return 1; }\n");
+            const tests::utils::CurrentPathGuard guard(path_to_root);
+
+            // Another configuration that compiles `shared.cpp` with the same command owns its object file.
+            // The define keeps the command apart from the ones of the other subcase, whose objects are removed.
+            auto configuration    = create_unity_configuration("unity-sharing");
+            configuration.defines = std::vector<std::string>{"SHARING"};
+            auto owner            = create_unity_configuration("unity-sharing-owner");
+            owner.defines         = configuration.defines;
+            owner.unity           = std::nullopt;
+            REQUIRE_EQ(compile_files(owner, ".", {"shared.cpp"}, true, false, std::nullopt).num_of_failures, 0);
+
+            const auto result = unity_build::compile_in_batches(
+                configuration, ".", build_info, all_files, true, false, std::nullopt);
+
+            CHECK_EQ(result.num_of_failures, 0);
+            CHECK(result.compilation_times.contains("shared.cpp"));
+            CHECK_FALSE(result.peak_memory_in_kilobytes.contains("shared.cpp"));
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
+
+    TEST_CASE("compile_in_batches checks the files of a batch against their own budgets")
+    {
+        const auto path_to_root = std::filesystem::temp_directory_path() / "easy-make-test-unity-budgets";
+        const Paths all_files   = {"a.cpp", "b.cpp", "c.cpp", "d.cpp", "shared.cpp", "single.cpp"};
+
+        auto build_info = create_unity_project(path_to_root, "unity-budgets", "auto single() -> int { return 1; }\n");
+        const tests::utils::CurrentPathGuard guard(path_to_root);
+
+        // Every compiler uses more memory than that, so every file exceeds its budget.
+        auto configuration                    = create_unity_configuration("unity-budgets");
+        configuration.max_memory_in_megabytes = 1.0;
+        configuration.budget_action           = "kill";
+
+        const auto result =
+            unity_build::compile_in_batches(configuration, ".", build_info, all_files, true, false, std::nullopt);
+
+        CHECK_EQ(result.num_of_failures, all_files.size());
+        CHECK(result.compilation_times.empty());
+
+        // The batches were compiled rather than killed, and are kept, since the files do not clash.
+        auto state_file  = std::ifstream(params::BUILD_DIRECTORY_NAME / "unity-budgets" /
+                                        params::UNITY_BUILD_DATA_FILE_NAME);
+        const auto state = nlohmann::json::parse(state_file);
+
+        CHECK_EQ(state.at("batches").size(), 2);
+        CHECK(state.at("isolatedFiles").empty());
+
+        for (const auto& [batch_file, files] : state.at("batches").items())
+        {
+            const auto object_file_name = utils::get_object_file_name(batch_file);
+            CHECK_FALSE(std::filesystem::exists(params::BUILD_DIRECTORY_NAME / "unity-budgets" / object_file_name));
+        }
+
+        std::filesystem::remove_all(path_to_root);
+    }
+}
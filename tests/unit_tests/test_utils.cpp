@@ -27,6 +27,11 @@ TEST_SUITE("Basic utils" * doctest::test_suite(test_type::unit))
         CHECK_EQ(utils::get_object_file_name(std::filesystem::path("a") / "b" / "c.cpp"), "a-b-c.cpp.o");
     }
 
+    TEST_CASE("'get_split_debug_info_file_name' works.")
+    {
+        CHECK_EQ(utils::get_split_debug_info_file_name(std::filesystem::path("a") / "b" / "c.cpp"), "a-b-c.cpp.dwo");
+    }
+
     TEST_CASE("utils::count_digits")
     {
         SUBCASE("Zero")
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "third_party/doctest/doctest.hpp"
+
+#include "source/utils/work_stealing_pool.hpp"
+#include "tests/parameters.hpp"
+
+TEST_SUITE("WorkStealingPool class" * doctest::test_suite(test_type::unit))
+{
+    TEST_CASE("submit")
+    {
+        SUBCASE("Every task runs exactly once")
+        {
+            utils::WorkStealingPool pool(4);
+            std::atomic<int> counter = 0;
+
+            for (auto i = 0; i < 10'000; ++i)
+            {
+                pool.submit([&counter] { counter.fetch_add(1); });
+            }
+
+            pool.wait_for_all();
+
+            CHECK_EQ(counter.load(), 10'000);
+        }
+
+        SUBCASE("More tasks than the queues can hold")
+        {
+            utils::WorkStealingPool pool(1);
+            std::atomic<int> counter = 0;
+
+            for (auto i = 0; i < 50'000; ++i)
+            {
+                pool.submit([&counter] { counter.fetch_add(1); });
+            }
+
+            pool.wait_for_all();
+
+            CHECK_EQ(counter.load(), 50'000);
+        }
+
+        SUBCASE("Tasks can submit tasks")
+        {
+            utils::WorkStealingPool pool(2);
+            std::atomic<int> counter = 0;
+
+            for (auto i = 0; i < 100; ++i)
+            {
+                pool.submit(
+                    [&pool, &counter]
+                    {
+                        for (auto j = 0; j < 10; ++j)
+                        {
+                            pool.submit([&counter] { counter.fetch_add(1); });
+                        }
+                    });
+            }
+
+            pool.wait_for_all();
+
+            CHECK_EQ(counter.load(), 1'000);
+        }
+
+        SUBCASE("The result is returned through the future")
+        {
+            utils::WorkStealingPool pool(2);
+
+            auto future = pool.submit([] { return 42; });
+
+            CHECK_EQ(future.get(), 42);
+        }
+
+        SUBCASE("Exceptions are stored in the future")
+        {
+            utils::WorkStealingPool pool(2);
+
+            auto failed_task    = pool.submit([]() -> int { throw std::runtime_error("Failure."); });
+            auto following_task = pool.submit([] { return 1; });
+
+            CHECK_THROWS_AS(failed_task.get(), std::runtime_error);
+            CHECK_EQ(following_task.get(), 1); // The worker survived the exception.
+        }
+    }
+
+    TEST_CASE("submit_detached")
+    {
+        utils::WorkStealingPool pool(4);
+        std::atomic<int> counter = 0;
+
+        for (auto i = 0; i < 10'000; ++i)
+        {
+            pool.submit_detached([&counter]() noexcept { counter.fetch_add(1); });
+        }
+
+        pool.wait_for_all();
+
+        CHECK_EQ(counter.load(), 10'000);
+    }
+
+    TEST_CASE("parallel_for")
+    {
+        SUBCASE("Visits every index exactly once")
+        {
+            utils::WorkStealingPool pool(4);
+            std::vector<std::atomic<int>> visits(12'345);
+
+            utils::parallel_for(pool, 0, visits.size(), [&](const std::size_t index) { visits[index].fetch_add(1); });
+
+            CHECK(std::ranges::all_of(visits, [](const auto& count) { return count.load() == 1; }));
+        }
+
+        SUBCASE("Respects the range bounds")
+        {
+            utils::WorkStealingPool pool(2);
+            std::vector<std::atomic<int>> visits(10);
+
+            utils::parallel_for(pool, 3, 7, [&](const std::size_t index) { visits[index].fetch_add(1); });
+
+            CHECK_EQ(visits[2].load(), 0);
+            CHECK_EQ(visits[3].load(), 1);
+            CHECK_EQ(visits[6].load(), 1);
+            CHECK_EQ(visits[7].load(), 0);
+        }
+
+        SUBCASE("Empty range")
+        {
+            utils::WorkStealingPool pool(2);
+            auto called = false;
+
+            utils::parallel_for(pool, 5, 5, [&](std::size_t) { called = true; });
+
+            CHECK_FALSE(called);
+        }
+
+        SUBCASE("Nested loops")
+        {
+            utils::WorkStealingPool pool(3);
+            std::atomic<int> counter = 0;
+
+            utils::parallel_for(pool,
+                                0,
+                                50,
+                                [&](std::size_t)
+                                { utils::parallel_for(pool, 0, 50, [&](std::size_t) { counter.fetch_add(1); }); });
+
+            CHECK_EQ(counter.load(), 2'500);
+        }
+
+        SUBCASE("Exceptions are propagated to the caller")
+        {
+            utils::WorkStealingPool pool(2);
+
+            const auto throw_in_the_middle = [](const std::size_t index)
+            {
+                if (index == 500)
+                {
+                    throw std::runtime_error("Failure.");
+                }
+            };
+
+            CHECK_THROWS_AS(utils::parallel_for(pool, 0, 1'000, throw_in_the_middle), std::runtime_error);
+        }
+    }
+}
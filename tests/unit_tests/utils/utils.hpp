@@ -9,6 +9,28 @@ namespace tests::utils
     const auto MAX_PROJECT_INDEX = 99;
 
     auto get_path_to_resources_project(int index) -> std::filesystem::path;
+
+    // Changes the current path for the lifetime of the guard.
+    // Build steps take source files by their path relative to the root of the project, as in a real build.
+    class CurrentPathGuard
+    {
+      public:
+        explicit CurrentPathGuard(const std::filesystem::path& path) : original_path(std::filesystem::current_path())
+        {
+            std::filesystem::current_path(path);
+        }
+
+        ~CurrentPathGuard()
+        {
+            std::filesystem::current_path(original_path);
+        }
+
+        CurrentPathGuard(const CurrentPathGuard&)                    = delete;
+        auto operator=(const CurrentPathGuard&) -> CurrentPathGuard& = delete;
+
+      private:
+        std::filesystem::path original_path;
+    };
 }
 
 #endif // TESTS_UTILS_UTILS_HPP